@@ -74,5 +74,50 @@ if(SEAL_USE_INTRIN)
         SEAL__SUBBORROW_U64_FOUND
     )
 
+    # Check for AVX2 intrinsics enabled per function; AVX2 kernels are selected at run-time,
+    # so only compilation is checked and the build machine need not support AVX2
+    if(MSVC)
+        set(SEAL_AVX2_TEST_ATTRIBUTE "")
+        set(SEAL_AVX2_TEST_DETECT "int regs[4]; __cpuidex(regs, 7, 0); return regs[1] & 0;")
+    else()
+        set(SEAL_AVX2_TEST_ATTRIBUTE "__attribute__((target(\"avx2\")))")
+        set(SEAL_AVX2_TEST_DETECT "__builtin_cpu_init(); return __builtin_cpu_supports(\"avx2\") & 0;")
+    endif()
+    check_cxx_source_compiles("
+        #include <${SEAL_INTRIN_HEADER}>
+        #include <immintrin.h>
+        ${SEAL_AVX2_TEST_ATTRIBUTE} long long avx2_test(long long a) {
+            __m256i b = _mm256_set1_epi64x(a);
+            b = _mm256_permute4x64_epi64(_mm256_mul_epu32(b, b), 0xA0);
+            return _mm256_extract_epi64(b, 0);
+        }
+        int main() {
+            ${SEAL_AVX2_TEST_DETECT}
+        }"
+        SEAL_AVX2_FOUND
+    )
+
+    # Check for AES-NI intrinsics enabled per function; as for AVX2, only compilation is checked
+    if(MSVC)
+        set(SEAL_AES_NI_TEST_ATTRIBUTE "")
+        set(SEAL_AES_NI_TEST_DETECT "int regs[4]; __cpuid(regs, 1); return regs[2] & 0;")
+    else()
+        set(SEAL_AES_NI_TEST_ATTRIBUTE "__attribute__((target(\"aes\")))")
+        set(SEAL_AES_NI_TEST_DETECT "__builtin_cpu_init(); return __builtin_cpu_supports(\"aes\") & 0;")
+    endif()
+    check_cxx_source_compiles("
+        #include <${SEAL_INTRIN_HEADER}>
+        #include <immintrin.h>
+        ${SEAL_AES_NI_TEST_ATTRIBUTE} long long aes_ni_test(long long a) {
+            __m128i b = _mm_set1_epi64x(a);
+            b = _mm_aesenclast_si128(_mm_aesenc_si128(b, b), b);
+            return _mm_cvtsi128_si64(b);
+        }
+        int main() {
+            ${SEAL_AES_NI_TEST_DETECT}
+        }"
+        SEAL_AES_NI_FOUND
+    )
+
     cmake_pop_check_state()
 endif()
@@ -0,0 +1,18 @@
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT license.
+
+# Check for mmap with transparent huge pages and NUMA memory policies (Linux)
+check_cxx_source_compiles("
+    #include <linux/mempolicy.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    int main(void)
+    {
+        void *ptr = mmap(nullptr, 4096, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        unsigned long nodemask = 1;
+        madvise(ptr, 4096, MADV_HUGEPAGE);
+        syscall(SYS_mbind, ptr, 4096, MPOL_PREFERRED, &nodemask, 65, 0);
+        return munmap(ptr, 4096);
+    }"
+    SEAL_HUGE_PAGES_FOUND)
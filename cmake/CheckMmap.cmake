@@ -0,0 +1,19 @@
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT license.
+
+# Check for POSIX file mappings
+check_cxx_source_compiles("
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    int main(void)
+    {
+        int fd = open(\"\", O_RDONLY);
+        struct stat file_stat;
+        fstat(fd, &file_stat);
+        void *ptr = mmap(nullptr, 4096, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+        return munmap(ptr, 4096);
+    }"
+    SEAL_MMAP_FOUND)
@@ -150,6 +150,45 @@ namespace Microsoft.Research.SEAL
             }
         }
 
+        /// <summary>
+        /// Returns the number of special primes of the SEALContext the keys were
+        /// generated for.
+        /// </summary>
+        public ulong SpecialPrimeCount
+        {
+            get
+            {
+                NativeMethods.KSwitchKeys_GetSpecialPrimeCount(NativePtr, out ulong result);
+                return result;
+            }
+        }
+
+        /// <summary>
+        /// Returns the number of keyswitching digits of the SEALContext the keys
+        /// were generated for.
+        /// </summary>
+        public ulong Dnum
+        {
+            get
+            {
+                NativeMethods.KSwitchKeys_GetDnum(NativePtr, out ulong result);
+                return result;
+            }
+        }
+
+        /// <summary>
+        /// Returns the number of primes in each keyswitching digit of the
+        /// SEALContext the keys were generated for.
+        /// </summary>
+        public ulong DigitSize
+        {
+            get
+            {
+                NativeMethods.KSwitchKeys_GetDigitSize(NativePtr, out ulong result);
+                return result;
+            }
+        }
+
         /// <summary>
         /// Returns an upper bound on the size of the KSwitchKeys, as if it was written
         /// to an output stream.
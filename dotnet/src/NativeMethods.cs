@@ -251,6 +251,15 @@ namespace Microsoft.Research.SEAL
         [DllImport(sealc, PreserveSig = false)]
         internal static extern void SEALContext_UsingKeyswitching(IntPtr thisptr, out bool usingKeySwitching);
 
+        [DllImport(sealc, PreserveSig = false)]
+        internal static extern void SEALContext_SpecialPrimeCount(IntPtr thisptr, out ulong specialPrimeCount);
+
+        [DllImport(sealc, PreserveSig = false)]
+        internal static extern void SEALContext_Dnum(IntPtr thisptr, out ulong dnum);
+
+        [DllImport(sealc, PreserveSig = false)]
+        internal static extern void SEALContext_DigitSize(IntPtr thisptr, out ulong digitSize);
+
 #endregion
 
 #region ContextData methods
@@ -643,6 +652,24 @@ namespace Microsoft.Research.SEAL
         [DllImport(sealc, PreserveSig = false)]
         internal static extern void KSwitchKeys_SetParmsId(IntPtr thisptr, ulong[] parmsId);
 
+        [DllImport(sealc, PreserveSig = false)]
+        internal static extern void KSwitchKeys_GetSpecialPrimeCount(IntPtr thisptr, out ulong specialPrimeCount);
+
+        [DllImport(sealc, PreserveSig = false)]
+        internal static extern void KSwitchKeys_SetSpecialPrimeCount(IntPtr thisptr, ulong specialPrimeCount);
+
+        [DllImport(sealc, PreserveSig = false)]
+        internal static extern void KSwitchKeys_GetDnum(IntPtr thisptr, out ulong dnum);
+
+        [DllImport(sealc, PreserveSig = false)]
+        internal static extern void KSwitchKeys_SetDnum(IntPtr thisptr, ulong dnum);
+
+        [DllImport(sealc, PreserveSig = false)]
+        internal static extern void KSwitchKeys_GetDigitSize(IntPtr thisptr, out ulong digitSize);
+
+        [DllImport(sealc, PreserveSig = false)]
+        internal static extern void KSwitchKeys_SetDigitSize(IntPtr thisptr, ulong digitSize);
+
         [DllImport(sealc, PreserveSig = false)]
         internal static extern void KSwitchKeys_Pool(IntPtr thisptr, out IntPtr pool);
 
@@ -238,6 +238,45 @@ namespace Microsoft.Research.SEAL
             }
         }
 
+        /// <summary>
+        /// Returns the number of primes in the special modulus, i.e., the number
+        /// of primes dropped from the key level to the first data level.
+        /// </summary>
+        public ulong SpecialPrimeCount
+        {
+            get
+            {
+                NativeMethods.SEALContext_SpecialPrimeCount(NativePtr, out ulong result);
+                return result;
+            }
+        }
+
+        /// <summary>
+        /// Returns the number of digits keyswitching decomposes a ciphertext at
+        /// the first data level into, or 0 if keyswitching is not supported.
+        /// </summary>
+        public ulong Dnum
+        {
+            get
+            {
+                NativeMethods.SEALContext_Dnum(NativePtr, out ulong result);
+                return result;
+            }
+        }
+
+        /// <summary>
+        /// Returns the number of primes in each keyswitching digit, or 0 if
+        /// keyswitching is not supported.
+        /// </summary>
+        public ulong DigitSize
+        {
+            get
+            {
+                NativeMethods.SEALContext_DigitSize(NativePtr, out ulong result);
+                return result;
+            }
+        }
+
         /// <summary>
         /// Destroy native object.
         /// </summary>
@@ -25,7 +25,19 @@ namespace Microsoft.Research.SEAL
         ZLIB = 1,
 
         /// <summary>Use Zstandard compression.</summary>
-        ZSTD = 2
+        ZSTD = 2,
+
+        /// <summary>Pack every 64-bit word to the bit width of its coefficient modulus.</summary>
+        Packed = 3,
+
+        /// <summary>Pack every 64-bit word and use Zstandard compression.</summary>
+        PackedZSTD = 4,
+
+        /// <summary>Use ZLIB compression on independent frames in parallel.</summary>
+        ZLIBChunked = 5,
+
+        /// <summary>Use Zstandard compression on independent frames in parallel.</summary>
+        ZSTDChunked = 6
     }
 
     /// <summary>Class to provide functionality for serialization.</summary>
@@ -6,6 +6,7 @@ using Microsoft.VisualStudio.TestTools.UnitTesting;
 using System;
 using System.Collections.Generic;
 using System.IO;
+using System.Linq;
 
 namespace SEALNetTest
 {
@@ -44,6 +45,35 @@ namespace SEALNetTest
             Assert.AreEqual(1ul, copy2.Size);
         }
 
+        [TestMethod]
+        public void KeyswitchingConfigurationTest()
+        {
+            SEALContext context = GlobalContext.BFVContext;
+            KeyGenerator keygen = new KeyGenerator(context);
+
+            keygen.CreateRelinKeys(out RelinKeys keys);
+
+            Assert.AreEqual(1ul, context.SpecialPrimeCount);
+            Assert.AreEqual(1ul, context.DigitSize);
+            Assert.AreEqual((ulong)context.KeyContextData.Parms.CoeffModulus.Count() - 1, context.Dnum);
+            Assert.AreEqual(context.SpecialPrimeCount, keys.SpecialPrimeCount);
+            Assert.AreEqual(context.Dnum, keys.Dnum);
+            Assert.AreEqual(context.DigitSize, keys.DigitSize);
+
+            RelinKeys copy = new RelinKeys(keys);
+
+            Assert.AreEqual(keys.SpecialPrimeCount, copy.SpecialPrimeCount);
+            Assert.AreEqual(keys.Dnum, copy.Dnum);
+            Assert.AreEqual(keys.DigitSize, copy.DigitSize);
+            Assert.IsTrue(ValCheck.IsValidFor(copy, context));
+
+            RelinKeys empty = new RelinKeys();
+
+            Assert.AreEqual(0ul, empty.SpecialPrimeCount);
+            Assert.AreEqual(0ul, empty.Dnum);
+            Assert.AreEqual(0ul, empty.DigitSize);
+        }
+
         [TestMethod]
         public void SaveLoadTest()
         {
@@ -3,7 +3,9 @@
 
 #include "seal/seal.h"
 #include "bench.h"
+#include <algorithm>
 #include <iomanip>
+#include <thread>
 
 using namespace benchmark;
 using namespace seal;
@@ -25,6 +27,35 @@ namespace sealbench
         ->Unit(benchmark::kMicrosecond)                                                                               \
         ->Iterations(10);
 
+    /**
+    Like SEAL_BENCHMARK_REGISTER but runs the benchmark with 1 up to hardware_concurrency threads and reports real
+    time, so that the results show how the benchmarked operation scales with the number of threads.
+    */
+#define SEAL_BENCHMARK_REGISTER_THREADED(category, n, log_q, name, func, ...)                                         \
+    RegisterBenchmark(                                                                                                \
+        (string("n=") + to_string(n) + string(" / log(q)=") + to_string(log_q) + string(" / " #category " / " #name)) \
+            .c_str(),                                                                                                 \
+        [=](State &st) { func(st, __VA_ARGS__); })                                                                    \
+        ->Unit(benchmark::kMicrosecond)                                                                               \
+        ->ThreadRange(1, max(static_cast<int>(thread::hardware_concurrency()), 1))                                    \
+        ->UseRealTime();
+
+    /**
+    Like SEAL_BENCHMARK_REGISTER but passes a ThreadPool size from 1 up to hardware_concurrency in powers of two as
+    state.range(0) and reports real time, for operations that parallelize across the ThreadPool of a SEALContext.
+    */
+#define SEAL_BENCHMARK_REGISTER_THREAD_POOL(category, n, log_q, name, func, ...)                                      \
+    RegisterBenchmark(                                                                                                \
+        (string("n=") + to_string(n) + string(" / log(q)=") + to_string(log_q) + string(" / " #category " / " #name)) \
+            .c_str(),                                                                                                 \
+        [=](State &st) { func(st, __VA_ARGS__); })                                                                    \
+        ->Unit(benchmark::kMicrosecond)                                                                               \
+        ->Iterations(10)                                                                                              \
+        ->RangeMultiplier(2)                                                                                          \
+        ->Range(1, max(static_cast<int>(thread::hardware_concurrency()), 1))                                          \
+        ->ArgName("threads")                                                                                          \
+        ->UseRealTime();
+
     void register_bm_family(
         const pair<size_t, vector<Modulus>> &parms, unordered_map<EncryptionParameters, shared_ptr<BMEnv>> &bm_env_map)
     {
@@ -46,6 +77,7 @@ namespace sealbench
         // 2. BFV
         // 3. CKKS
         // 4. Util
+        // 5. Serialization
         int n = static_cast<int>(parms.first);
         int log_q = static_cast<int>(
             bm_env_map.find(parms_ckks)->second->context().key_context_data()->total_coeff_modulus_bit_count());
@@ -55,9 +87,14 @@ namespace sealbench
         {
             SEAL_BENCHMARK_REGISTER(KeyGen, n, log_q, Relin, bm_keygen_relin, bm_env_ckks);
             SEAL_BENCHMARK_REGISTER(KeyGen, n, log_q, Galois, bm_keygen_galois, bm_env_ckks);
+            SEAL_BENCHMARK_REGISTER_THREAD_POOL(
+                KeyGen, n, log_q, RelinThreadPool, bm_keygen_relin_thread_pool, bm_env_ckks);
+            SEAL_BENCHMARK_REGISTER_THREAD_POOL(
+                KeyGen, n, log_q, GaloisAllThreadPool, bm_keygen_galois_all_thread_pool, bm_env_ckks);
         }
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EncryptSecret, bm_bfv_encrypt_secret, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EncryptPublic, bm_bfv_encrypt_public, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EncryptPublicMany, bm_bfv_encrypt_public_many, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, Decrypt, bm_bfv_decrypt, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EncodeBatch, bm_bfv_encode_batch, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, DecodeBatch, bm_bfv_decode_batch, bm_env_bfv);
@@ -67,6 +104,7 @@ namespace sealbench
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateSubCt, bm_bfv_sub_ct, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateSubPt, bm_bfv_sub_pt, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateMulCt, bm_bfv_mul_ct, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateMulCtWorkspace, bm_bfv_mul_ct_workspace, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateMulPt, bm_bfv_mul_pt, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateSquare, bm_bfv_square, bm_env_bfv);
         if (bm_env_bfv->context().first_context_data()->parms().coeff_modulus().size() > 1)
@@ -76,8 +114,11 @@ namespace sealbench
         if (bm_env_bfv->context().using_keyswitching())
         {
             SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateRelinInplace, bm_bfv_relin_inplace, bm_env_bfv);
+            SEAL_BENCHMARK_REGISTER(
+                BFV, n, log_q, EvaluateRelinInplaceWorkspace, bm_bfv_relin_inplace_workspace, bm_env_bfv);
             SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateRotateRows, bm_bfv_rotate_rows, bm_env_bfv);
             SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateRotateCols, bm_bfv_rotate_cols, bm_env_bfv);
+            SEAL_BENCHMARK_REGISTER(BFV, n, log_q, EvaluateRotateRowsMany, bm_bfv_rotate_rows_many, bm_env_bfv);
         }
 
         SEAL_BENCHMARK_REGISTER(CKKS, n, log_q, EncryptSecret, bm_ckks_encrypt_secret, bm_env_ckks);
@@ -101,6 +142,7 @@ namespace sealbench
         {
             SEAL_BENCHMARK_REGISTER(CKKS, n, log_q, EvaluateRelinInplace, bm_ckks_relin_inplace, bm_env_ckks);
             SEAL_BENCHMARK_REGISTER(CKKS, n, log_q, EvaluateRotate, bm_ckks_rotate, bm_env_ckks);
+            SEAL_BENCHMARK_REGISTER(CKKS, n, log_q, EvaluateRotateMany, bm_ckks_rotate_many, bm_env_ckks);
         }
         SEAL_BENCHMARK_REGISTER(UTIL, n, log_q, NTTForward, bm_util_ntt_forward, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(UTIL, n, log_q, NTTInverse, bm_util_ntt_inverse, bm_env_bfv);
@@ -108,6 +150,73 @@ namespace sealbench
         SEAL_BENCHMARK_REGISTER(UTIL, n, 0, NTTInverseLowLevel, bm_util_ntt_inverse_low_level, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(UTIL, n, 0, NTTForwardLowLevelLazy, bm_util_ntt_forward_low_level_lazy, bm_env_bfv);
         SEAL_BENCHMARK_REGISTER(UTIL, n, 0, NTTInverseLowLevelLazy, bm_util_ntt_inverse_low_level_lazy, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER(UTIL, n, 0, NTTForwardRadix2, bm_util_ntt_forward_radix2, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER(UTIL, n, 0, NTTForwardRadix4, bm_util_ntt_forward_radix4, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER(UTIL, n, 0, NTTInverseRadix2, bm_util_ntt_inverse_radix2, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER(UTIL, n, 0, NTTInverseRadix4, bm_util_ntt_inverse_radix4, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER(UTIL, n, log_q, NTTForwardBatched, bm_util_ntt_forward_batched, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER(UTIL, n, log_q, NTTInverseBatched, bm_util_ntt_inverse_batched, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER(
+            UTIL, n, 0, NTTForwardSmallPrime64, bm_util_ntt_forward_small_prime, bm_env_bfv, false);
+        SEAL_BENCHMARK_REGISTER(
+            UTIL, n, 0, NTTForwardSmallPrime32, bm_util_ntt_forward_small_prime, bm_env_bfv, true);
+        SEAL_BENCHMARK_REGISTER(
+            UTIL, n, 0, NTTInverseSmallPrime64, bm_util_ntt_inverse_small_prime, bm_env_bfv, false);
+        SEAL_BENCHMARK_REGISTER(
+            UTIL, n, 0, NTTInverseSmallPrime32, bm_util_ntt_inverse_small_prime, bm_env_bfv, true);
+        SEAL_BENCHMARK_REGISTER(UTIL, n, 0, DyadicProductBarrett, bm_util_dyadic_product_barrett, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER(UTIL, n, 0, DyadicProductMontgomery, bm_util_dyadic_product_montgomery, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER(
+            UTIL, n, 0, MultiplyPolyScalarBarrett, bm_util_multiply_poly_scalar_barrett, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER(
+            UTIL, n, 0, MultiplyPolyScalarMontgomery, bm_util_multiply_poly_scalar_montgomery, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER_THREADED(UTIL, n, log_q, MemoryPoolGetPool, bm_util_mempool_get_pool, bm_env_bfv);
+        SEAL_BENCHMARK_REGISTER(
+            UTIL, n, log_q, SamplePolyUniformBlake2xb, bm_util_sample_poly_uniform, bm_env_ckks, prng_type::blake2xb);
+        SEAL_BENCHMARK_REGISTER(
+            UTIL, n, log_q, SamplePolyUniformShake256, bm_util_sample_poly_uniform, bm_env_ckks, prng_type::shake256);
+        SEAL_BENCHMARK_REGISTER(
+            UTIL, n, log_q, SamplePolyUniformAes256Ctr, bm_util_sample_poly_uniform, bm_env_ckks,
+            prng_type::aes256ctr);
+
+        if (bm_env_ckks->context().using_keyswitching())
+        {
+            size_t thread_count = static_cast<size_t>(max(static_cast<int>(thread::hardware_concurrency()), 1));
+            SEAL_BENCHMARK_REGISTER(
+                SERIALIZATION, n, log_q, SaveGaloisKeys, bm_serialization_save, bm_env_ckks, compr_mode_type::none,
+                size_t(1));
+            SEAL_BENCHMARK_REGISTER(
+                SERIALIZATION, n, log_q, LoadGaloisKeys, bm_serialization_load, bm_env_ckks, compr_mode_type::none,
+                size_t(1));
+#ifdef SEAL_USE_ZLIB
+            SEAL_BENCHMARK_REGISTER(
+                SERIALIZATION, n, log_q, SaveGaloisKeysZLIB, bm_serialization_save, bm_env_ckks,
+                compr_mode_type::zlib, size_t(1));
+            SEAL_BENCHMARK_REGISTER(
+                SERIALIZATION, n, log_q, LoadGaloisKeysZLIB, bm_serialization_load, bm_env_ckks,
+                compr_mode_type::zlib, size_t(1));
+            SEAL_BENCHMARK_REGISTER(
+                SERIALIZATION, n, log_q, SaveGaloisKeysZLIBChunked, bm_serialization_save, bm_env_ckks,
+                compr_mode_type::zlib_chunked, thread_count);
+            SEAL_BENCHMARK_REGISTER(
+                SERIALIZATION, n, log_q, LoadGaloisKeysZLIBChunked, bm_serialization_load, bm_env_ckks,
+                compr_mode_type::zlib_chunked, thread_count);
+#endif
+#ifdef SEAL_USE_ZSTD
+            SEAL_BENCHMARK_REGISTER(
+                SERIALIZATION, n, log_q, SaveGaloisKeysZSTD, bm_serialization_save, bm_env_ckks,
+                compr_mode_type::zstd, size_t(1));
+            SEAL_BENCHMARK_REGISTER(
+                SERIALIZATION, n, log_q, LoadGaloisKeysZSTD, bm_serialization_load, bm_env_ckks,
+                compr_mode_type::zstd, size_t(1));
+            SEAL_BENCHMARK_REGISTER(
+                SERIALIZATION, n, log_q, SaveGaloisKeysZSTDChunked, bm_serialization_save, bm_env_ckks,
+                compr_mode_type::zstd_chunked, thread_count);
+            SEAL_BENCHMARK_REGISTER(
+                SERIALIZATION, n, log_q, LoadGaloisKeysZSTDChunked, bm_serialization_load, bm_env_ckks,
+                compr_mode_type::zstd_chunked, thread_count);
+#endif
+        }
     }
 
 } // namespace sealbench
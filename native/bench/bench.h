@@ -41,7 +41,7 @@ namespace sealbench
             if (context_.using_keyswitching())
             {
                 keygen_->create_relin_keys(rlk_);
-                galois_elts_all_ = context_.key_context_data()->galois_tool()->get_elts_from_steps({ 1 });
+                galois_elts_all_ = context_.key_context_data()->galois_tool()->get_elts_from_steps({ 1, 2, 4, 8 });
                 galois_elts_all_.emplace_back(2 * static_cast<uint32_t>(parms_.poly_modulus_degree()) - 1);
                 // galois_elts_all_ = context_.key_context_data()->galois_tool()->get_elts_all();
                 keygen_->create_galois_keys(galois_elts_all_, glk_);
@@ -330,16 +330,47 @@ namespace sealbench
     void bm_util_ntt_inverse_low_level(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_util_ntt_forward_low_level_lazy(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_util_ntt_inverse_low_level_lazy(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_util_ntt_forward_radix2(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_util_ntt_forward_radix4(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_util_ntt_inverse_radix2(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_util_ntt_inverse_radix4(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_util_ntt_forward_batched(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_util_ntt_inverse_batched(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_util_ntt_forward_small_prime(benchmark::State &state, std::shared_ptr<BMEnv> bm_env, bool use_uint32);
+    void bm_util_ntt_inverse_small_prime(benchmark::State &state, std::shared_ptr<BMEnv> bm_env, bool use_uint32);
+
+    // Modular arithmetic backend benchmark cases
+    void bm_util_dyadic_product_barrett(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_util_dyadic_product_montgomery(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_util_multiply_poly_scalar_barrett(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_util_multiply_poly_scalar_montgomery(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+
+    // Memory pool benchmark cases
+    void bm_util_mempool_get_pool(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+
+    // PRNG benchmark cases
+    void bm_util_sample_poly_uniform(benchmark::State &state, std::shared_ptr<BMEnv> bm_env, seal::prng_type type);
+
+    // Serialization benchmark cases
+    void bm_serialization_save(
+        benchmark::State &state, std::shared_ptr<BMEnv> bm_env, seal::compr_mode_type compr_mode,
+        std::size_t thread_count);
+    void bm_serialization_load(
+        benchmark::State &state, std::shared_ptr<BMEnv> bm_env, seal::compr_mode_type compr_mode,
+        std::size_t thread_count);
 
     // KeyGen benchmark cases
     void bm_keygen_secret(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_keygen_public(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_keygen_relin(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_keygen_galois(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_keygen_relin_thread_pool(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_keygen_galois_all_thread_pool(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
 
     // BFV-specific benchmark cases
     void bm_bfv_encrypt_secret(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_encrypt_public(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_bfv_encrypt_public_many(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_decrypt(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_encode_batch(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_decode_batch(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
@@ -353,8 +384,11 @@ namespace sealbench
     void bm_bfv_square(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_modswitch_inplace(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_relin_inplace(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_bfv_mul_ct_workspace(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_bfv_relin_inplace_workspace(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_rotate_rows(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_bfv_rotate_cols(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_bfv_rotate_rows_many(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
 
     // CKKS-specific benchmark cases
     void bm_ckks_encrypt_secret(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
@@ -373,4 +407,5 @@ namespace sealbench
     void bm_ckks_rescale_inplace(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_ckks_relin_inplace(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
     void bm_ckks_rotate(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
+    void bm_ckks_rotate_many(benchmark::State &state, std::shared_ptr<BMEnv> bm_env);
 } // namespace sealbench
@@ -44,6 +44,25 @@ namespace sealbench
         }
     }
 
+    void bm_bfv_encrypt_public_many(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        constexpr size_t count = 16;
+        vector<Plaintext> pt(count, bm_env->pt()[0]);
+        vector<Ciphertext> ct;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            for (auto &p : pt)
+            {
+                bm_env->randomize_pt_bfv(p);
+            }
+
+            state.ResumeTiming();
+            bm_env->encryptor()->encrypt_many(pt, ct);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    }
+
     void bm_bfv_decrypt(State &state, shared_ptr<BMEnv> bm_env)
     {
         vector<Ciphertext> &ct = bm_env->ct();
@@ -227,6 +246,36 @@ namespace sealbench
         }
     }
 
+    void bm_bfv_mul_ct_workspace(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        vector<Ciphertext> &ct = bm_env->ct();
+        EvaluatorWorkspace workspace(bm_env->context());
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_ct_bfv(ct[0]);
+            bm_env->randomize_ct_bfv(ct[1]);
+
+            state.ResumeTiming();
+            bm_env->evaluator()->multiply(ct[0], ct[1], ct[2], workspace);
+        }
+    }
+
+    void bm_bfv_relin_inplace_workspace(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        Ciphertext ct;
+        EvaluatorWorkspace workspace(bm_env->context());
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            ct.resize(bm_env->context(), size_t(3));
+            bm_env->randomize_ct_bfv(ct);
+
+            state.ResumeTiming();
+            bm_env->evaluator()->relinearize_inplace(ct, bm_env->rlk(), workspace);
+        }
+    }
+
     void bm_bfv_rotate_rows(State &state, shared_ptr<BMEnv> bm_env)
     {
         vector<Ciphertext> &ct = bm_env->ct();
@@ -252,4 +301,18 @@ namespace sealbench
             bm_env->evaluator()->rotate_columns(ct[0], bm_env->glk(), ct[2]);
         }
     }
+
+    void bm_bfv_rotate_rows_many(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        vector<Ciphertext> &ct = bm_env->ct();
+        vector<Ciphertext> rotated;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_ct_bfv(ct[0]);
+
+            state.ResumeTiming();
+            bm_env->evaluator()->rotate_rows_many(ct[0], { 1, 2, 4, 8 }, bm_env->glk(), rotated);
+        }
+    }
 } // namespace sealbench
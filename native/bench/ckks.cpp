@@ -266,4 +266,18 @@ namespace sealbench
             bm_env->evaluator()->rotate_vector(ct[0], 1, bm_env->glk(), ct[2]);
         }
     }
+
+    void bm_ckks_rotate_many(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        vector<Ciphertext> &ct = bm_env->ct();
+        vector<Ciphertext> rotated;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_ct_ckks(ct[0]);
+
+            state.ResumeTiming();
+            bm_env->evaluator()->rotate_vector_many(ct[0], { 1, 2, 4, 8 }, bm_env->glk(), rotated);
+        }
+    }
 } // namespace sealbench
@@ -73,4 +73,31 @@ namespace sealbench
             keygen->create_galois_keys({ random_one_step() }, glk);
         }
     }
+
+    void bm_keygen_relin_thread_pool(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        // Same parameters as the environment context, plus a ThreadPool of state.range(0) threads
+        SEALContext context(
+            bm_env->parms(), true, sec_level_type::none, 1, 0, mod_arith_type::barrett,
+            make_shared<ThreadPool>(static_cast<size_t>(state.range(0))));
+        KeyGenerator keygen(context, bm_env->sk());
+        RelinKeys rlk;
+        for (auto _ : state)
+        {
+            keygen.create_relin_keys(rlk);
+        }
+    }
+
+    void bm_keygen_galois_all_thread_pool(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        SEALContext context(
+            bm_env->parms(), true, sec_level_type::none, 1, 0, mod_arith_type::barrett,
+            make_shared<ThreadPool>(static_cast<size_t>(state.range(0))));
+        KeyGenerator keygen(context, bm_env->sk());
+        GaloisKeys glk;
+        for (auto _ : state)
+        {
+            keygen.create_galois_keys(glk);
+        }
+    }
 } // namespace sealbench
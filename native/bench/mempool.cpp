@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/seal.h"
+#include "seal/util/polycore.h"
+#include "bench.h"
+
+using namespace benchmark;
+using namespace sealbench;
+using namespace seal;
+using namespace seal::util;
+using namespace std;
+
+/**
+This file defines benchmarks for the global memory pool under concurrent use. Each iteration allocates and releases
+the temporaries of one key switching operation, so running with multiple threads shows how allocation scales.
+*/
+
+namespace sealbench
+{
+    void bm_util_mempool_get_pool(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        auto context_data = bm_env->context().first_context_data();
+        size_t coeff_count = context_data->parms().poly_modulus_degree();
+        size_t coeff_modulus_size = context_data->parms().coeff_modulus().size();
+        size_t decomp_modulus_size = coeff_modulus_size + 1;
+        MemoryPoolHandle pool = seal::MemoryManager::GetPool();
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < decomp_modulus_size; i++)
+            {
+                auto t_target = allocate_poly(coeff_count, coeff_modulus_size, pool);
+                auto t_poly_prod = allocate_poly_array(2, coeff_count, decomp_modulus_size, pool);
+                auto t_poly_lazy = allocate_poly_array(2, coeff_count, 2, pool);
+                auto t_ntt = allocate_poly(coeff_count, 1, pool);
+                DoNotOptimize(t_target.get());
+                DoNotOptimize(t_poly_prod.get());
+                DoNotOptimize(t_poly_lazy.get());
+                DoNotOptimize(t_ntt.get());
+            }
+        }
+    }
+} // namespace sealbench
@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/seal.h"
+#include "seal/util/polyarithsmallmod.h"
+#include "bench.h"
+
+using namespace benchmark;
+using namespace sealbench;
+using namespace seal;
+using namespace seal::util;
+using namespace std;
+
+/**
+This file defines benchmarks comparing the Barrett/Shoup and Montgomery modular arithmetic backends per operation.
+All operations act on the first RNS component of a ciphertext polynomial.
+*/
+
+namespace sealbench
+{
+    void bm_util_dyadic_product_barrett(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        const Modulus &modulus = bm_env->parms().coeff_modulus()[0];
+        size_t coeff_count = bm_env->parms().poly_modulus_degree();
+        vector<Ciphertext> &ct = bm_env->ct();
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_ct_bfv(ct[0]);
+            bm_env->randomize_ct_bfv(ct[1]);
+
+            state.ResumeTiming();
+            dyadic_product_coeffmod(ct[0].data(0), ct[1].data(0), coeff_count, modulus, ct[2].data(0));
+        }
+    }
+
+    void bm_util_dyadic_product_montgomery(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        const Modulus &modulus = bm_env->parms().coeff_modulus()[0];
+        size_t coeff_count = bm_env->parms().poly_modulus_degree();
+        vector<Ciphertext> &ct = bm_env->ct();
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_ct_bfv(ct[0]);
+            bm_env->randomize_ct_bfv(ct[1]);
+
+            state.ResumeTiming();
+            dyadic_product_montgomery_coeffmod(ct[0].data(0), ct[1].data(0), coeff_count, modulus, ct[2].data(0));
+        }
+    }
+
+    void bm_util_multiply_poly_scalar_barrett(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        const Modulus &modulus = bm_env->parms().coeff_modulus()[0];
+        size_t coeff_count = bm_env->parms().poly_modulus_degree();
+        MultiplyUIntModOperand scalar;
+        scalar.set(modulus.value() / 3, modulus);
+        vector<Ciphertext> &ct = bm_env->ct();
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_ct_bfv(ct[0]);
+
+            state.ResumeTiming();
+            multiply_poly_scalar_coeffmod(ct[0].data(0), coeff_count, scalar, modulus, ct[2].data(0));
+        }
+    }
+
+    void bm_util_multiply_poly_scalar_montgomery(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        const Modulus &modulus = bm_env->parms().coeff_modulus()[0];
+        size_t coeff_count = bm_env->parms().poly_modulus_degree();
+        MontgomeryOperand scalar;
+        scalar.set(modulus.value() / 3, modulus);
+        vector<Ciphertext> &ct = bm_env->ct();
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_ct_bfv(ct[0]);
+
+            state.ResumeTiming();
+            multiply_poly_scalar_montgomery_coeffmod(ct[0].data(0), coeff_count, scalar, modulus, ct[2].data(0));
+        }
+    }
+} // namespace sealbench
@@ -4,10 +4,13 @@
 #include "seal/seal.h"
 #include "seal/util/rlwe.h"
 #include "bench.h"
+#include <algorithm>
+#include <thread>
 
 using namespace benchmark;
 using namespace sealbench;
 using namespace seal;
+using namespace seal::util;
 using namespace std;
 
 /**
@@ -106,4 +109,159 @@ namespace sealbench
             inverse_ntt_negacyclic_harvey_lazy(ct[0].data(), small_ntt_tables[0]);
         }
     }
+
+    void bm_util_ntt_forward_radix2(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        parms_id_type parms_id = bm_env->context().first_parms_id();
+        auto context_data = bm_env->context().get_context_data(parms_id);
+        const auto &tables = context_data->small_ntt_tables()[0];
+        vector<Ciphertext> &ct = bm_env->ct();
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_ct_bfv(ct[0]);
+
+            state.ResumeTiming();
+            tables.ntt_handler().transform_to_rev(
+                ct[0].data(), tables.coeff_count_power(), tables.get_from_root_powers());
+        }
+    }
+
+    void bm_util_ntt_forward_radix4(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        parms_id_type parms_id = bm_env->context().first_parms_id();
+        auto context_data = bm_env->context().get_context_data(parms_id);
+        const auto &tables = context_data->small_ntt_tables()[0];
+        vector<Ciphertext> &ct = bm_env->ct();
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_ct_bfv(ct[0]);
+
+            state.ResumeTiming();
+            tables.ntt_handler().transform_to_rev_radix4(
+                ct[0].data(), tables.coeff_count_power(), tables.get_from_root_powers());
+        }
+    }
+
+    void bm_util_ntt_inverse_radix2(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        parms_id_type parms_id = bm_env->context().first_parms_id();
+        auto context_data = bm_env->context().get_context_data(parms_id);
+        const auto &tables = context_data->small_ntt_tables()[0];
+        MultiplyUIntModOperand inv_degree_modulo = tables.inv_degree_modulo();
+        vector<Ciphertext> &ct = bm_env->ct();
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_ct_bfv(ct[0]);
+
+            state.ResumeTiming();
+            tables.ntt_handler().transform_from_rev(
+                ct[0].data(), tables.coeff_count_power(), tables.get_from_inv_root_powers(), &inv_degree_modulo);
+        }
+    }
+
+    void bm_util_ntt_inverse_radix4(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        parms_id_type parms_id = bm_env->context().first_parms_id();
+        auto context_data = bm_env->context().get_context_data(parms_id);
+        const auto &tables = context_data->small_ntt_tables()[0];
+        MultiplyUIntModOperand inv_degree_modulo = tables.inv_degree_modulo();
+        vector<Ciphertext> &ct = bm_env->ct();
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_ct_bfv(ct[0]);
+
+            state.ResumeTiming();
+            tables.ntt_handler().transform_from_rev_radix4(
+                ct[0].data(), tables.coeff_count_power(), tables.get_from_inv_root_powers(), &inv_degree_modulo);
+        }
+    }
+
+    void bm_util_ntt_forward_batched(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        parms_id_type parms_id = bm_env->context().first_parms_id();
+        auto context_data = bm_env->context().get_context_data(parms_id);
+        const auto &small_ntt_tables = context_data->small_ntt_tables();
+        ThreadPool thread_pool(max<size_t>(thread::hardware_concurrency(), 1));
+        vector<Ciphertext> &ct = bm_env->ct();
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_ct_bfv(ct[0]);
+
+            state.ResumeTiming();
+            ntt_negacyclic_harvey_lazy(PolyIter(ct[0]), ct[0].size(), small_ntt_tables, &thread_pool);
+        }
+    }
+
+    void bm_util_ntt_inverse_batched(State &state, shared_ptr<BMEnv> bm_env)
+    {
+        parms_id_type parms_id = bm_env->context().first_parms_id();
+        auto context_data = bm_env->context().get_context_data(parms_id);
+        const auto &small_ntt_tables = context_data->small_ntt_tables();
+        ThreadPool thread_pool(max<size_t>(thread::hardware_concurrency(), 1));
+        vector<Ciphertext> &ct = bm_env->ct();
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_ct_bfv(ct[0]);
+
+            state.ResumeTiming();
+            inverse_ntt_negacyclic_harvey_lazy(PolyIter(ct[0]), ct[0].size(), small_ntt_tables, &thread_pool);
+        }
+    }
+
+    void bm_util_ntt_forward_small_prime(State &state, shared_ptr<BMEnv> bm_env, bool use_uint32)
+    {
+        // Compare the std::uint32_t transform with the std::uint64_t transform on the same 30-bit prime
+        size_t coeff_count = bm_env->parms().poly_modulus_degree();
+        int coeff_count_power = get_power_of_two(coeff_count);
+        NTTTables tables(coeff_count_power, get_prime(coeff_count << 1, small_modulus_bit_count_max));
+        vector<uint64_t> values(coeff_count);
+        vector<uint32_t> values32(coeff_count);
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_array_mod(values.data(), coeff_count, tables.modulus());
+            copy(values.cbegin(), values.cend(), values32.begin());
+
+            state.ResumeTiming();
+            if (use_uint32)
+            {
+                ntt_negacyclic_harvey_lazy(values32.data(), tables);
+            }
+            else
+            {
+                ntt_negacyclic_harvey_lazy(values.data(), tables);
+            }
+        }
+    }
+
+    void bm_util_ntt_inverse_small_prime(State &state, shared_ptr<BMEnv> bm_env, bool use_uint32)
+    {
+        size_t coeff_count = bm_env->parms().poly_modulus_degree();
+        int coeff_count_power = get_power_of_two(coeff_count);
+        NTTTables tables(coeff_count_power, get_prime(coeff_count << 1, small_modulus_bit_count_max));
+        vector<uint64_t> values(coeff_count);
+        vector<uint32_t> values32(coeff_count);
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            bm_env->randomize_array_mod(values.data(), coeff_count, tables.modulus());
+            copy(values.cbegin(), values.cend(), values32.begin());
+
+            state.ResumeTiming();
+            if (use_uint32)
+            {
+                inverse_ntt_negacyclic_harvey_lazy(values32.data(), tables);
+            }
+            else
+            {
+                inverse_ntt_negacyclic_harvey_lazy(values.data(), tables);
+            }
+        }
+    }
 } // namespace sealbench
@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/seal.h"
+#include "seal/util/polycore.h"
+#include "seal/util/rlwe.h"
+#include "bench.h"
+
+using namespace benchmark;
+using namespace sealbench;
+using namespace seal;
+using namespace seal::util;
+using namespace std;
+
+/**
+This file defines benchmarks for sampling uniformly random polynomials, as done for the masks in public keys and
+key switching keys, with different PRNG types. The throughput is reported in bytes of sampled polynomial per second.
+*/
+
+namespace sealbench
+{
+    void bm_util_sample_poly_uniform(State &state, shared_ptr<BMEnv> bm_env, prng_type type)
+    {
+        auto &parms = bm_env->context().key_context_data()->parms();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_modulus_size = parms.coeff_modulus().size();
+        auto poly = allocate_poly(coeff_count, coeff_modulus_size, seal::MemoryManager::GetPool());
+        auto prng = UniformRandomGeneratorInfo(type, UniformRandomGeneratorFactory::DefaultFactory()->create()->seed())
+                        .make_prng();
+        for (auto _ : state)
+        {
+            sample_poly_uniform(prng, parms, poly.get());
+            DoNotOptimize(poly.get());
+        }
+        state.SetBytesProcessed(
+            static_cast<int64_t>(state.iterations() * coeff_count * coeff_modulus_size * sizeof(uint64_t)));
+    }
+} // namespace sealbench
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/seal.h"
+#include "bench.h"
+#include <memory>
+#include <vector>
+
+using namespace benchmark;
+using namespace sealbench;
+using namespace seal;
+using namespace std;
+
+/**
+This file defines benchmarks for saving and loading Galois keys with different compression modes. The throughput is
+reported in bytes of uncompressed data per second. Chunked compression modes use a ThreadPool of the given size.
+*/
+
+namespace sealbench
+{
+    void bm_serialization_save(
+        State &state, shared_ptr<BMEnv> bm_env, compr_mode_type compr_mode, size_t thread_count)
+    {
+        auto thread_pool = make_shared<ThreadPool>(thread_count);
+        const GaloisKeys &glk = bm_env->glk();
+        vector<seal_byte> buffer(static_cast<size_t>(glk.save_size(compr_mode)));
+        for (auto _ : state)
+        {
+            DoNotOptimize(glk.save(buffer.data(), buffer.size(), compr_mode, thread_pool.get()));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * glk.save_size(compr_mode_type::none));
+    }
+
+    void bm_serialization_load(
+        State &state, shared_ptr<BMEnv> bm_env, compr_mode_type compr_mode, size_t thread_count)
+    {
+        // Same parameters as the environment context, plus a ThreadPool of thread_count threads
+        SEALContext context(
+            bm_env->parms(), true, sec_level_type::none, 1, 0, mod_arith_type::barrett,
+            make_shared<ThreadPool>(thread_count));
+        const GaloisKeys &glk = bm_env->glk();
+        vector<seal_byte> buffer(static_cast<size_t>(glk.save_size(compr_mode)));
+        glk.save(buffer.data(), buffer.size(), compr_mode);
+        GaloisKeys loaded_glk;
+        for (auto _ : state)
+        {
+            loaded_glk.unsafe_load(context, buffer.data(), buffer.size());
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * glk.save_size(compr_mode_type::none));
+    }
+} // namespace sealbench
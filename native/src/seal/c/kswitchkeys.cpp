@@ -98,7 +98,7 @@ SEAL_C_FUNC KSwitchKeys_RawSize(void *thisptr, uint64_t *size)
     IfNullRet(keys, E_POINTER);
     IfNullRet(size, E_POINTER);
 
-    *size = keys->data().size();
+    *size = keys->index_count();
     return S_OK;
 }
 
@@ -108,8 +108,26 @@ SEAL_C_FUNC KSwitchKeys_GetKeyList(void *thisptr, uint64_t index, uint64_t *coun
     IfNullRet(keys, E_POINTER);
     IfNullRet(count, E_POINTER);
 
-    auto key = keys->data()[index];
-    return GetKeyFromVector(key, count, key_list);
+    if (!keys->contains(index))
+    {
+        *count = 0;
+        return S_OK;
+    }
+
+    try
+    {
+        // Indexed keys are read from their file if they are not resident
+        auto key = keys->acquire(index);
+        return GetKeyFromVector(*key, count, key_list);
+    }
+    catch (const logic_error &)
+    {
+        return COR_E_INVALIDOPERATION;
+    }
+    catch (const runtime_error &)
+    {
+        return COR_E_IO;
+    }
 }
 
 SEAL_C_FUNC KSwitchKeys_ClearDataAndReserve(void *thisptr, uint64_t size)
@@ -170,6 +188,84 @@ SEAL_C_FUNC KSwitchKeys_SetParmsId(void *thisptr, uint64_t *parms_id)
     return S_OK;
 }
 
+SEAL_C_FUNC KSwitchKeys_GetSpecialPrimeCount(void *thisptr, uint64_t *special_prime_count)
+{
+    KSwitchKeys *keys = FromVoid<KSwitchKeys>(thisptr);
+    IfNullRet(keys, E_POINTER);
+    IfNullRet(special_prime_count, E_POINTER);
+
+    *special_prime_count = static_cast<uint64_t>(keys->special_prime_count());
+    return S_OK;
+}
+
+SEAL_C_FUNC KSwitchKeys_SetSpecialPrimeCount(void *thisptr, uint64_t special_prime_count)
+{
+    KSwitchKeys *keys = FromVoid<KSwitchKeys>(thisptr);
+    IfNullRet(keys, E_POINTER);
+
+    try
+    {
+        keys->special_prime_count() = util::safe_cast<size_t>(special_prime_count);
+        return S_OK;
+    }
+    catch (const logic_error &)
+    {
+        return COR_E_INVALIDOPERATION;
+    }
+}
+
+SEAL_C_FUNC KSwitchKeys_GetDnum(void *thisptr, uint64_t *dnum)
+{
+    KSwitchKeys *keys = FromVoid<KSwitchKeys>(thisptr);
+    IfNullRet(keys, E_POINTER);
+    IfNullRet(dnum, E_POINTER);
+
+    *dnum = static_cast<uint64_t>(keys->dnum());
+    return S_OK;
+}
+
+SEAL_C_FUNC KSwitchKeys_SetDnum(void *thisptr, uint64_t dnum)
+{
+    KSwitchKeys *keys = FromVoid<KSwitchKeys>(thisptr);
+    IfNullRet(keys, E_POINTER);
+
+    try
+    {
+        keys->dnum() = util::safe_cast<size_t>(dnum);
+        return S_OK;
+    }
+    catch (const logic_error &)
+    {
+        return COR_E_INVALIDOPERATION;
+    }
+}
+
+SEAL_C_FUNC KSwitchKeys_GetDigitSize(void *thisptr, uint64_t *digit_size)
+{
+    KSwitchKeys *keys = FromVoid<KSwitchKeys>(thisptr);
+    IfNullRet(keys, E_POINTER);
+    IfNullRet(digit_size, E_POINTER);
+
+    *digit_size = static_cast<uint64_t>(keys->digit_size());
+    return S_OK;
+}
+
+SEAL_C_FUNC KSwitchKeys_SetDigitSize(void *thisptr, uint64_t digit_size)
+{
+    KSwitchKeys *keys = FromVoid<KSwitchKeys>(thisptr);
+    IfNullRet(keys, E_POINTER);
+
+    try
+    {
+        keys->digit_size() = util::safe_cast<size_t>(digit_size);
+        return S_OK;
+    }
+    catch (const logic_error &)
+    {
+        return COR_E_INVALIDOPERATION;
+    }
+}
+
 SEAL_C_FUNC KSwitchKeys_Pool(void *thisptr, void **pool)
 {
     KSwitchKeys *keys = FromVoid<KSwitchKeys>(thisptr);
@@ -35,6 +35,18 @@ SEAL_C_FUNC KSwitchKeys_GetParmsId(void *thisptr, uint64_t *parms_id);
 
 SEAL_C_FUNC KSwitchKeys_SetParmsId(void *thisptr, uint64_t *parms_id);
 
+SEAL_C_FUNC KSwitchKeys_GetSpecialPrimeCount(void *thisptr, uint64_t *special_prime_count);
+
+SEAL_C_FUNC KSwitchKeys_SetSpecialPrimeCount(void *thisptr, uint64_t special_prime_count);
+
+SEAL_C_FUNC KSwitchKeys_GetDnum(void *thisptr, uint64_t *dnum);
+
+SEAL_C_FUNC KSwitchKeys_SetDnum(void *thisptr, uint64_t dnum);
+
+SEAL_C_FUNC KSwitchKeys_GetDigitSize(void *thisptr, uint64_t *digit_size);
+
+SEAL_C_FUNC KSwitchKeys_SetDigitSize(void *thisptr, uint64_t digit_size);
+
 SEAL_C_FUNC KSwitchKeys_Pool(void *thisptr, void **pool);
 
 SEAL_C_FUNC KSwitchKeys_SaveSize(void *thisptr, uint8_t compr_mode, int64_t *result);
@@ -1,12 +1,17 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT license.
 
+// STD
+#include <algorithm>
+#include <vector>
+
 // SEALNet
 #include "seal/c/memorypoolhandle.h"
 #include "seal/c/utilities.h"
 
 // SEAL
 #include "seal/memorymanager.h"
+#include "seal/util/common.h"
 
 using namespace std;
 using namespace seal;
@@ -102,6 +107,72 @@ SEAL_C_FUNC MemoryPoolHandle_AllocByteCount(void *thisptr, uint64_t *count)
     return S_OK;
 }
 
+SEAL_C_FUNC MemoryPoolHandle_Stats(void *thisptr, uint64_t *count, uint64_t *stats)
+{
+    MemoryPoolHandle *pool = FromVoid<MemoryPoolHandle>(thisptr);
+    IfNullRet(pool, E_POINTER);
+    IfNullRet(count, E_POINTER);
+
+    vector<MemoryPoolStats> pool_stats = pool->stats();
+    if (nullptr == stats)
+    {
+        // We only wanted the count.
+        *count = pool_stats.size();
+        return S_OK;
+    }
+
+    // The pool may have grown since the count was queried, so write at most *count entries
+    *count = min<uint64_t>(*count, pool_stats.size());
+    for (uint64_t i = 0; i < *count; i++)
+    {
+        const MemoryPoolStats &head_stats = pool_stats[i];
+        *stats++ = head_stats.item_byte_count;
+        *stats++ = head_stats.item_count;
+        *stats++ = head_stats.live_item_count;
+        *stats++ = head_stats.free_item_count;
+        *stats++ = head_stats.peak_byte_count;
+        *stats++ = head_stats.alloc_count;
+        *stats++ = head_stats.total_alloc_count;
+    }
+    return S_OK;
+}
+
+SEAL_C_FUNC MemoryPoolHandle_ReleaseUnused(void *thisptr, uint64_t *count)
+{
+    MemoryPoolHandle *pool = FromVoid<MemoryPoolHandle>(thisptr);
+    IfNullRet(pool, E_POINTER);
+    IfNullRet(count, E_POINTER);
+
+    *count = pool->release_unused();
+    return S_OK;
+}
+
+SEAL_C_FUNC MemoryPoolHandle_SetByteCountLimit(void *thisptr, uint64_t limit)
+{
+    MemoryPoolHandle *pool = FromVoid<MemoryPoolHandle>(thisptr);
+    IfNullRet(pool, E_POINTER);
+
+    try
+    {
+        pool->set_byte_count_limit(util::safe_cast<size_t>(limit));
+        return S_OK;
+    }
+    catch (const logic_error &)
+    {
+        return COR_E_INVALIDOPERATION;
+    }
+}
+
+SEAL_C_FUNC MemoryPoolHandle_ByteCountLimit(void *thisptr, uint64_t *limit)
+{
+    MemoryPoolHandle *pool = FromVoid<MemoryPoolHandle>(thisptr);
+    IfNullRet(pool, E_POINTER);
+    IfNullRet(limit, E_POINTER);
+
+    *limit = pool->byte_count_limit();
+    return S_OK;
+}
+
 SEAL_C_FUNC MemoryPoolHandle_UseCount(void *thisptr, long *count)
 {
     MemoryPoolHandle *pool = FromVoid<MemoryPoolHandle>(thisptr);
@@ -31,6 +31,16 @@ SEAL_C_FUNC MemoryPoolHandle_PoolCount(void *thisptr, uint64_t *count);
 
 SEAL_C_FUNC MemoryPoolHandle_AllocByteCount(void *thisptr, uint64_t *count);
 
+// Writes seven values per allocation size to stats: item byte count, item count, live item count, free item count,
+// peak byte count, allocation count, and total allocation count
+SEAL_C_FUNC MemoryPoolHandle_Stats(void *thisptr, uint64_t *count, uint64_t *stats);
+
+SEAL_C_FUNC MemoryPoolHandle_ReleaseUnused(void *thisptr, uint64_t *count);
+
+SEAL_C_FUNC MemoryPoolHandle_SetByteCountLimit(void *thisptr, uint64_t limit);
+
+SEAL_C_FUNC MemoryPoolHandle_ByteCountLimit(void *thisptr, uint64_t *limit);
+
 SEAL_C_FUNC MemoryPoolHandle_UseCount(void *thisptr, long *count);
 
 SEAL_C_FUNC MemoryPoolHandle_IsInitialized(void *thisptr, bool *result);
@@ -139,6 +139,36 @@ SEAL_C_FUNC SEALContext_UsingKeyswitching(void *thisptr, bool *using_keyswitchin
     return S_OK;
 }
 
+SEAL_C_FUNC SEALContext_SpecialPrimeCount(void *thisptr, uint64_t *special_prime_count)
+{
+    SEALContext *context = FromVoid<SEALContext>(thisptr);
+    IfNullRet(context, E_POINTER);
+    IfNullRet(special_prime_count, E_POINTER);
+
+    *special_prime_count = static_cast<uint64_t>(context->special_prime_count());
+    return S_OK;
+}
+
+SEAL_C_FUNC SEALContext_Dnum(void *thisptr, uint64_t *dnum)
+{
+    SEALContext *context = FromVoid<SEALContext>(thisptr);
+    IfNullRet(context, E_POINTER);
+    IfNullRet(dnum, E_POINTER);
+
+    *dnum = static_cast<uint64_t>(context->dnum());
+    return S_OK;
+}
+
+SEAL_C_FUNC SEALContext_DigitSize(void *thisptr, uint64_t *digit_size)
+{
+    SEALContext *context = FromVoid<SEALContext>(thisptr);
+    IfNullRet(context, E_POINTER);
+    IfNullRet(digit_size, E_POINTER);
+
+    *digit_size = static_cast<uint64_t>(context->digit_size());
+    return S_OK;
+}
+
 SEAL_C_FUNC SEALContext_ParameterErrorName(void *thisptr, char *outstr, uint64_t *length)
 {
     SEALContext *context = FromVoid<SEALContext>(thisptr);
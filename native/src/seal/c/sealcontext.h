@@ -35,6 +35,12 @@ SEAL_C_FUNC SEALContext_GetContextData(void *thisptr, uint64_t *parms_id, void *
 
 SEAL_C_FUNC SEALContext_UsingKeyswitching(void *thisptr, bool *using_keyswitching);
 
+SEAL_C_FUNC SEALContext_SpecialPrimeCount(void *thisptr, uint64_t *special_prime_count);
+
+SEAL_C_FUNC SEALContext_Dnum(void *thisptr, uint64_t *dnum);
+
+SEAL_C_FUNC SEALContext_DigitSize(void *thisptr, uint64_t *digit_size);
+
 SEAL_C_FUNC SEALContext_ParameterErrorName(void *thisptr, char *outstr, uint64_t *length);
 
 SEAL_C_FUNC SEALContext_ParameterErrorMessage(void *thisptr, char *outstr, uint64_t *length);
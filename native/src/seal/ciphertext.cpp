@@ -13,6 +13,44 @@ using namespace seal::util;
 
 namespace seal
 {
+    Ciphertext::Ciphertext(
+        const SEALContext &context, parms_id_type parms_id, size_t size, ct_coeff_type *buffer,
+        size_t buffer_coeff_count, MemoryPoolHandle pool)
+        : data_(std::move(pool))
+    {
+        // Verify parameters
+        if (!context.parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+        auto context_data_ptr = context.get_context_data(parms_id);
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("parms_id is not valid for encryption parameters");
+        }
+        if ((size < SEAL_CIPHERTEXT_SIZE_MIN && size != 0) || size > SEAL_CIPHERTEXT_SIZE_MAX)
+        {
+            throw invalid_argument("invalid size");
+        }
+
+        auto &parms = context_data_ptr->parms();
+        size_t poly_modulus_degree = parms.poly_modulus_degree();
+        size_t coeff_modulus_size = parms.coeff_modulus().size();
+        size_t data_size = mul_safe(size, poly_modulus_degree, coeff_modulus_size);
+        if (data_size > buffer_coeff_count)
+        {
+            throw invalid_argument("ciphertext does not fit in buffer");
+        }
+
+        // Wrap the buffer without touching its contents
+        data_ = DynArray<ct_coeff_type>::Aliasing(buffer, buffer_coeff_count, data_size, data_.pool());
+        parms_id_ = parms_id;
+        is_ntt_form_ = parms.scheme() == scheme_type::ckks;
+        size_ = size;
+        poly_modulus_degree_ = poly_modulus_degree;
+        coeff_modulus_size_ = coeff_modulus_size;
+    }
+
     Ciphertext &Ciphertext::operator=(const Ciphertext &assign)
     {
         // Check for self-assignment
@@ -21,14 +59,14 @@ namespace seal
             return *this;
         }
 
-        // Copy over fields
+        // Resize first; this throws for a view whose buffer is too small, which must leave the metadata unchanged
+        resize_internal(assign.size_, assign.poly_modulus_degree_, assign.coeff_modulus_size_);
+
+        // Then copy over fields
         parms_id_ = assign.parms_id_;
         is_ntt_form_ = assign.is_ntt_form_;
         scale_ = assign.scale_;
 
-        // Then resize
-        resize_internal(assign.size_, assign.poly_modulus_degree_, assign.coeff_modulus_size_);
-
         // Size is guaranteed to be OK now so copy over
         copy(assign.data_.cbegin(), assign.data_.cend(), data_.begin());
 
@@ -352,6 +390,6 @@ namespace seal
         }
         stream.exceptions(old_except_mask);
 
-        swap(*this, new_data);
+        assign_loaded(new_data);
     }
 } // namespace seal
@@ -130,6 +130,41 @@ namespace seal
             reserve(context, parms_id, size_capacity);
         }
 
+        /**
+        Constructs a ciphertext of given size that views a buffer owned by the
+        caller, such as a network or shared memory buffer. The buffer holds the
+        coefficients in the same layout as data(), i.e., size polynomials for the
+        encryption parameters with given parms_id, and its contents are left
+        unchanged. The ciphertext is in the default NTT form of the scheme; use
+        is_ntt_form() and scale() to set the remaining metadata.
+
+        A view can be passed to all functions taking a ciphertext. They read and
+        write the coefficients directly in the buffer and never reallocate it, so
+        an operation whose result does not fit in buffer_coeff_count coefficients
+        throws std::logic_error. Copies of a view own their data, whereas moving a
+        view, or moving another ciphertext into it, transfers the reference to
+        the buffer. The buffer must outlive the view.
+
+        @param[in] context The SEALContext
+        @param[in] parms_id The parms_id corresponding to the encryption
+        parameters to be used
+        @param[in] size The number of polynomials in the ciphertext
+        @param[in] buffer The buffer holding the coefficients
+        @param[in] buffer_coeff_count The number of coefficients that fit in the
+        buffer
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if parms_id is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if size is invalid or the ciphertext does
+        not fit in the buffer
+        @throws std::invalid_argument if buffer is null
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        explicit Ciphertext(
+            const SEALContext &context, parms_id_type parms_id, std::size_t size, ct_coeff_type *buffer,
+            std::size_t buffer_coeff_count, MemoryPoolHandle pool = MemoryManager::GetPool());
+
         /**
         Creates a new ciphertext by copying a given one.
 
@@ -470,18 +505,21 @@ namespace seal
 
         @param[out] stream The stream to save the ciphertext to
         @param[in] compr_mode The desired compression mode
+        @param[in] thread_pool The ThreadPool across which the chunked compression
+        modes compress the data, or nullptr
         @throws std::invalid_argument if the compression mode is not supported
         @throws std::logic_error if the data to be saved is invalid, or if
         compression failed
         @throws std::runtime_error if I/O operations failed
         */
         inline std::streamoff save(
-            std::ostream &stream, compr_mode_type compr_mode = Serialization::compr_mode_default) const
+            std::ostream &stream, compr_mode_type compr_mode = Serialization::compr_mode_default,
+            ThreadPool *thread_pool = nullptr) const
         {
             using namespace std::placeholders;
             return Serialization::Save(
                 std::bind(&Ciphertext::save_members, this, _1), save_size(compr_mode_type::none), stream, compr_mode,
-                false);
+                false, thread_pool);
         }
 
         /**
@@ -500,7 +538,9 @@ namespace seal
         inline std::streamoff unsafe_load(const SEALContext &context, std::istream &stream)
         {
             using namespace std::placeholders;
-            return Serialization::Load(std::bind(&Ciphertext::load_members, this, context, _1, _2), stream, false);
+            return Serialization::Load(
+                std::bind(&Ciphertext::load_members, this, context, _1, _2), stream, false,
+                context.thread_pool().get());
         }
 
         /**
@@ -522,7 +562,7 @@ namespace seal
             {
                 throw std::logic_error("ciphertext data is invalid");
             }
-            std::swap(*this, new_data);
+            assign_loaded(new_data);
             return in_size;
         }
 
@@ -533,6 +573,8 @@ namespace seal
         @param[out] out The memory location to write the ciphertext to
         @param[in] size The number of bytes available in the given memory location
         @param[in] compr_mode The desired compression mode
+        @param[in] thread_pool The ThreadPool across which the chunked compression
+        modes compress the data, or nullptr
         @throws std::invalid_argument if out is null or if size is too small to
         contain a SEALHeader, or if the compression mode is not supported
         @throws std::logic_error if the data to be saved is invalid, or if
@@ -540,12 +582,13 @@ namespace seal
         @throws std::runtime_error if I/O operations failed
         */
         inline std::streamoff save(
-            seal_byte *out, std::size_t size, compr_mode_type compr_mode = Serialization::compr_mode_default) const
+            seal_byte *out, std::size_t size, compr_mode_type compr_mode = Serialization::compr_mode_default,
+            ThreadPool *thread_pool = nullptr) const
         {
             using namespace std::placeholders;
             return Serialization::Save(
                 std::bind(&Ciphertext::save_members, this, _1), save_size(compr_mode_type::none), out, size, compr_mode,
-                false);
+                false, thread_pool);
         }
 
         /**
@@ -567,7 +610,9 @@ namespace seal
         inline std::streamoff unsafe_load(const SEALContext &context, const seal_byte *in, std::size_t size)
         {
             using namespace std::placeholders;
-            return Serialization::Load(std::bind(&Ciphertext::load_members, this, context, _1, _2), in, size, false);
+            return Serialization::Load(
+                std::bind(&Ciphertext::load_members, this, context, _1, _2), in, size, false,
+                context.thread_pool().get());
         }
 
         /**
@@ -593,7 +638,7 @@ namespace seal
             {
                 throw std::logic_error("ciphertext data is invalid");
             }
-            std::swap(*this, new_data);
+            assign_loaded(new_data);
             return in_size;
         }
 
@@ -652,6 +697,14 @@ namespace seal
             return scale_;
         }
 
+        /**
+        Returns whether the ciphertext views a buffer owned by the caller.
+        */
+        SEAL_NODISCARD inline bool is_view() const noexcept
+        {
+            return data_.is_alias();
+        }
+
         /**
         Returns the currently used MemoryPoolHandle.
         */
@@ -666,6 +719,19 @@ namespace seal
         struct CiphertextPrivateHelper;
 
     private:
+        // Replaces the current ciphertext with loaded data, which is copied into the buffer of a view
+        inline void assign_loaded(Ciphertext &loaded)
+        {
+            if (is_view())
+            {
+                *this = loaded;
+            }
+            else
+            {
+                std::swap(*this, loaded);
+            }
+        }
+
         void reserve_internal(
             std::size_t size_capacity, std::size_t poly_modulus_degree, std::size_t coeff_modulus_size);
 
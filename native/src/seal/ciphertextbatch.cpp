@@ -0,0 +1,305 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/ciphertextbatch.h"
+#include "seal/util/common.h"
+#include <algorithm>
+
+using namespace std;
+using namespace seal::util;
+
+namespace seal
+{
+    bool CiphertextBatch::accepts(const Ciphertext &encrypted) const noexcept
+    {
+        if (!count_)
+        {
+            return true;
+        }
+        return encrypted.parms_id() == parms_id_ && encrypted.is_ntt_form() == is_ntt_form_ &&
+               encrypted.size() == ciphertext_size_ && encrypted.poly_modulus_degree() == poly_modulus_degree_ &&
+               encrypted.coeff_modulus_size() == coeff_modulus_size_ && encrypted.scale() == scale_;
+    }
+
+    void CiphertextBatch::push_back(const Ciphertext &encrypted)
+    {
+        if (!encrypted.size() || !is_buffer_valid(encrypted))
+        {
+            throw invalid_argument("encrypted is empty");
+        }
+        if (!accepts(encrypted))
+        {
+            throw invalid_argument("encrypted does not match the metadata of the batch");
+        }
+
+        if (!count_)
+        {
+            parms_id_ = encrypted.parms_id();
+            is_ntt_form_ = encrypted.is_ntt_form();
+            ciphertext_size_ = encrypted.size();
+            poly_modulus_degree_ = encrypted.poly_modulus_degree();
+            coeff_modulus_size_ = encrypted.coeff_modulus_size();
+            scale_ = encrypted.scale();
+        }
+
+        // Grow geometrically so that appending many ciphertexts copies each only a constant number of times
+        size_t coeff_count = ciphertext_coeff_count();
+        size_t new_size = add_safe(data_.size(), coeff_count);
+        if (new_size > data_.capacity())
+        {
+            data_.reserve(max(new_size, mul_safe(data_.capacity(), size_t(2))));
+        }
+        data_.resize(new_size, false);
+        copy_n(encrypted.data(), coeff_count, data_.begin() + mul_safe(count_, coeff_count));
+        count_++;
+    }
+
+    void CiphertextBatch::get(const SEALContext &context, size_t index, Ciphertext &destination) const
+    {
+        check_index(context, index);
+
+        size_t coeff_count = ciphertext_coeff_count();
+        destination.resize(context, parms_id_, ciphertext_size_);
+        copy_n(data_.cbegin() + index * coeff_count, coeff_count, destination.data());
+        destination.is_ntt_form() = is_ntt_form_;
+        destination.scale() = scale_;
+    }
+
+    Ciphertext CiphertextBatch::view(const SEALContext &context, size_t index)
+    {
+        check_index(context, index);
+
+        size_t coeff_count = ciphertext_coeff_count();
+        Ciphertext result(
+            context, parms_id_, ciphertext_size_, data_.begin() + index * coeff_count, coeff_count, data_.pool());
+        result.is_ntt_form() = is_ntt_form_;
+        result.scale() = scale_;
+        return result;
+    }
+
+    void CiphertextBatch::clear() noexcept
+    {
+        parms_id_ = parms_id_zero;
+        is_ntt_form_ = false;
+        ciphertext_size_ = 0;
+        poly_modulus_degree_ = 0;
+        coeff_modulus_size_ = 0;
+        scale_ = 1.0;
+        count_ = 0;
+        data_.resize(0, false);
+    }
+
+    size_t CiphertextBatch::ciphertext_coeff_count() const
+    {
+        return mul_safe(ciphertext_size_, poly_modulus_degree_, coeff_modulus_size_);
+    }
+
+    void CiphertextBatch::check_index(const SEALContext &context, size_t index) const
+    {
+        if (index >= count_)
+        {
+            throw out_of_range("index must be less than size()");
+        }
+        if (!is_metadata_valid_for(*this, context))
+        {
+            throw invalid_argument("CiphertextBatch is not valid for encryption parameters");
+        }
+    }
+
+    streamoff CiphertextBatch::save_size(compr_mode_type compr_mode) const
+    {
+        size_t members_size = Serialization::ComprSizeEstimate(
+            add_safe(
+                sizeof(parms_id_),
+                sizeof(seal_byte), // is_ntt_form_
+                sizeof(uint64_t),  // ciphertext_size_
+                sizeof(uint64_t),  // poly_modulus_degree_
+                sizeof(uint64_t),  // coeff_modulus_size_
+                sizeof(scale_),
+                sizeof(uint64_t), // count_
+                safe_cast<size_t>(data_.save_size(compr_mode_type::none))),
+            compr_mode);
+
+        return safe_cast<streamoff>(add_safe(sizeof(Serialization::SEALHeader), members_size));
+    }
+
+    void CiphertextBatch::save_members(ostream &stream) const
+    {
+        auto old_except_mask = stream.exceptions();
+        try
+        {
+            // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+            stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+            stream.write(reinterpret_cast<const char *>(&parms_id_), sizeof(parms_id_type));
+            seal_byte is_ntt_form_byte = static_cast<seal_byte>(is_ntt_form_);
+            stream.write(reinterpret_cast<const char *>(&is_ntt_form_byte), sizeof(seal_byte));
+            uint64_t ciphertext_size64 = safe_cast<uint64_t>(ciphertext_size_);
+            stream.write(reinterpret_cast<const char *>(&ciphertext_size64), sizeof(uint64_t));
+            uint64_t poly_modulus_degree64 = safe_cast<uint64_t>(poly_modulus_degree_);
+            stream.write(reinterpret_cast<const char *>(&poly_modulus_degree64), sizeof(uint64_t));
+            uint64_t coeff_modulus_size64 = safe_cast<uint64_t>(coeff_modulus_size_);
+            stream.write(reinterpret_cast<const char *>(&coeff_modulus_size64), sizeof(uint64_t));
+            stream.write(reinterpret_cast<const char *>(&scale_), sizeof(double));
+            uint64_t count64 = safe_cast<uint64_t>(count_);
+            stream.write(reinterpret_cast<const char *>(&count64), sizeof(uint64_t));
+
+            // Save the DynArray
+            data_.save(stream, compr_mode_type::none);
+        }
+        catch (const ios_base::failure &)
+        {
+            stream.exceptions(old_except_mask);
+            throw runtime_error("I/O error");
+        }
+        catch (...)
+        {
+            stream.exceptions(old_except_mask);
+            throw;
+        }
+        stream.exceptions(old_except_mask);
+    }
+
+    void CiphertextBatch::load_members(
+        const SEALContext &context, istream &stream, SEAL_MAYBE_UNUSED SEALVersion version)
+    {
+        // Verify parameters
+        if (!context.parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+
+        CiphertextBatch new_data(data_.pool());
+
+        auto old_except_mask = stream.exceptions();
+        try
+        {
+            // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+            stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+            parms_id_type parms_id{};
+            stream.read(reinterpret_cast<char *>(&parms_id), sizeof(parms_id_type));
+            seal_byte is_ntt_form_byte;
+            stream.read(reinterpret_cast<char *>(&is_ntt_form_byte), sizeof(seal_byte));
+            uint64_t ciphertext_size64 = 0;
+            stream.read(reinterpret_cast<char *>(&ciphertext_size64), sizeof(uint64_t));
+            uint64_t poly_modulus_degree64 = 0;
+            stream.read(reinterpret_cast<char *>(&poly_modulus_degree64), sizeof(uint64_t));
+            uint64_t coeff_modulus_size64 = 0;
+            stream.read(reinterpret_cast<char *>(&coeff_modulus_size64), sizeof(uint64_t));
+            double scale = 0;
+            stream.read(reinterpret_cast<char *>(&scale), sizeof(double));
+            uint64_t count64 = 0;
+            stream.read(reinterpret_cast<char *>(&count64), sizeof(uint64_t));
+
+            // Set values already at this point for the metadata validity check
+            new_data.parms_id_ = parms_id;
+            new_data.is_ntt_form_ = (is_ntt_form_byte == seal_byte{}) ? false : true;
+            new_data.ciphertext_size_ = safe_cast<size_t>(ciphertext_size64);
+            new_data.poly_modulus_degree_ = safe_cast<size_t>(poly_modulus_degree64);
+            new_data.coeff_modulus_size_ = safe_cast<size_t>(coeff_modulus_size64);
+            new_data.scale_ = scale;
+            new_data.count_ = safe_cast<size_t>(count64);
+            if (!is_metadata_valid_for(new_data, context))
+            {
+                throw logic_error("CiphertextBatch data is invalid");
+            }
+
+            // Load the data, with the expected size as a bound on the allocation
+            auto total_uint64_count =
+                new_data.count_ ? mul_safe(new_data.count_, new_data.ciphertext_coeff_count()) : size_t(0);
+            new_data.data_.load(stream, total_uint64_count);
+            if (!is_buffer_valid(new_data))
+            {
+                throw logic_error("CiphertextBatch data is invalid");
+            }
+        }
+        catch (const ios_base::failure &)
+        {
+            stream.exceptions(old_except_mask);
+            throw runtime_error("I/O error");
+        }
+        catch (...)
+        {
+            stream.exceptions(old_except_mask);
+            throw;
+        }
+        stream.exceptions(old_except_mask);
+
+        swap(*this, new_data);
+    }
+
+    CiphertextBatchWriter::CiphertextBatchWriter(
+        ostream &stream, size_t batch_size, compr_mode_type compr_mode, MemoryPoolHandle pool,
+        shared_ptr<ThreadPool> thread_pool)
+        : stream_(stream), batch_size_(batch_size), compr_mode_(compr_mode), thread_pool_(move(thread_pool)),
+          batch_(move(pool))
+    {
+        if (!batch_size)
+        {
+            throw invalid_argument("batch_size must be positive");
+        }
+        if (!Serialization::IsSupportedComprMode(compr_mode))
+        {
+            throw invalid_argument("unsupported compression mode");
+        }
+    }
+
+    void CiphertextBatchWriter::write(const Ciphertext &encrypted)
+    {
+        if (batch_.size() == batch_size_ || !batch_.accepts(encrypted))
+        {
+            flush();
+        }
+        batch_.push_back(encrypted);
+    }
+
+    void CiphertextBatchWriter::flush()
+    {
+        if (batch_.empty())
+        {
+            return;
+        }
+        bytes_written_ += batch_.save(stream_, compr_mode_, thread_pool_.get());
+        batch_.clear();
+    }
+
+    CiphertextBatchReader::CiphertextBatchReader(const SEALContext &context, istream &stream, MemoryPoolHandle pool)
+        : context_(context), stream_(stream), batch_(move(pool))
+    {
+        // Verify parameters
+        if (!context_.parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+    }
+
+    bool CiphertextBatchReader::read(Ciphertext &destination)
+    {
+        while (next_index_ == batch_.size())
+        {
+            if (at_end())
+            {
+                return false;
+            }
+            bytes_read_ += batch_.load(context_, stream_);
+            next_index_ = 0;
+        }
+        batch_.get(context_, next_index_++, destination);
+        return true;
+    }
+
+    bool CiphertextBatchReader::at_end()
+    {
+        // Peek without throwing on std::ios_base::eofbit, which is cleared again at the end of the stream
+        auto old_except_mask = stream_.exceptions();
+        stream_.exceptions(ios_base::goodbit);
+        bool result = stream_.peek() == char_traits<char>::eof();
+        if (result)
+        {
+            stream_.clear(stream_.rdstate() & ~ios_base::eofbit);
+        }
+        stream_.exceptions(old_except_mask);
+        return result;
+    }
+} // namespace seal
@@ -0,0 +1,540 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/ciphertext.h"
+#include "seal/context.h"
+#include "seal/dynarray.h"
+#include "seal/memorymanager.h"
+#include "seal/serialization.h"
+#include "seal/threadpool.h"
+#include "seal/valcheck.h"
+#include "seal/version.h"
+#include "seal/util/defines.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+
+namespace seal
+{
+    /**
+    Class to store many ciphertexts with identical metadata, i.e., the same
+    parms_id, size, NTT form, and scale, in one contiguous buffer. Saving a
+    CiphertextBatch writes the shared metadata and one SEALHeader only once and
+    compresses all ciphertexts in one compression stream, which removes the
+    per-object overhead of saving every ciphertext separately. With the chunked
+    compression modes the batch is compressed in parallel across the ThreadPool
+    passed to save, and decompressed in parallel across the ThreadPool of the
+    SEALContext passed to load.
+
+    @par Streaming
+    CiphertextBatchWriter and CiphertextBatchReader write and read an unbounded
+    sequence of ciphertexts as consecutive CiphertextBatch objects, holding only
+    one batch in memory at a time.
+
+    @par Thread Safety
+    In general, reading from a CiphertextBatch is thread-safe as long as no other
+    thread is concurrently mutating it.
+    */
+    class CiphertextBatch
+    {
+    public:
+        using ct_coeff_type = Ciphertext::ct_coeff_type;
+
+        /**
+        Constructs an empty CiphertextBatch allocating no memory.
+
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        CiphertextBatch(MemoryPoolHandle pool = MemoryManager::GetPool()) : data_(std::move(pool))
+        {}
+
+        /**
+        Creates a new CiphertextBatch by copying a given one.
+
+        @param[in] copy The CiphertextBatch to copy from
+        */
+        CiphertextBatch(const CiphertextBatch &copy) = default;
+
+        /**
+        Creates a new CiphertextBatch by moving a given one.
+
+        @param[in] source The CiphertextBatch to move from
+        */
+        CiphertextBatch(CiphertextBatch &&source) = default;
+
+        /**
+        Copies a given CiphertextBatch to the current one.
+
+        @param[in] assign The CiphertextBatch to copy from
+        */
+        CiphertextBatch &operator=(const CiphertextBatch &assign) = default;
+
+        /**
+        Moves a given CiphertextBatch to the current one.
+
+        @param[in] assign The CiphertextBatch to move from
+        */
+        CiphertextBatch &operator=(CiphertextBatch &&assign) = default;
+
+        /**
+        Returns whether a given ciphertext can be appended to the batch, i.e.,
+        whether the batch is empty or the ciphertext has the same metadata as the
+        ciphertexts already in the batch.
+
+        @param[in] encrypted The ciphertext to check
+        */
+        SEAL_NODISCARD bool accepts(const Ciphertext &encrypted) const noexcept;
+
+        /**
+        Appends a copy of a given ciphertext to the batch. The first ciphertext
+        appended to an empty batch determines the metadata of the batch.
+
+        @param[in] encrypted The ciphertext to append
+        @throws std::invalid_argument if encrypted is empty
+        @throws std::invalid_argument if the batch does not accept encrypted
+        */
+        void push_back(const Ciphertext &encrypted);
+
+        /**
+        Copies the ciphertext with the given index to the destination parameter.
+
+        @param[in] context The SEALContext
+        @param[in] index The index of the ciphertext
+        @param[out] destination The ciphertext to overwrite with the copy
+        @throws std::out_of_range if index is not less than size()
+        @throws std::invalid_argument if the batch is not valid for the
+        encryption parameters
+        */
+        void get(const SEALContext &context, std::size_t index, Ciphertext &destination) const;
+
+        /**
+        Returns a ciphertext that views the ciphertext with the given index in
+        the buffer of the batch, so it can be read and modified in place without
+        copying. The view is invalidated when the batch is reallocated.
+
+        @param[in] context The SEALContext
+        @param[in] index The index of the ciphertext
+        @throws std::out_of_range if index is not less than size()
+        @throws std::invalid_argument if the batch is not valid for the
+        encryption parameters
+        */
+        SEAL_NODISCARD Ciphertext view(const SEALContext &context, std::size_t index);
+
+        /**
+        Removes all ciphertexts from the batch and resets its metadata. The
+        allocated memory is kept for reuse.
+        */
+        void clear() noexcept;
+
+        /**
+        Returns the number of ciphertexts in the batch.
+        */
+        SEAL_NODISCARD inline std::size_t size() const noexcept
+        {
+            return count_;
+        }
+
+        /**
+        Returns whether the batch holds no ciphertexts.
+        */
+        SEAL_NODISCARD inline bool empty() const noexcept
+        {
+            return count_ == 0;
+        }
+
+        /**
+        Returns a reference to the backing DynArray object holding the
+        coefficients of all ciphertexts one after another.
+        */
+        SEAL_NODISCARD inline const auto &dyn_array() const noexcept
+        {
+            return data_;
+        }
+
+        /**
+        Returns a reference to parms_id shared by all ciphertexts.
+        */
+        SEAL_NODISCARD inline const parms_id_type &parms_id() const noexcept
+        {
+            return parms_id_;
+        }
+
+        /**
+        Returns the number of polynomials in each ciphertext.
+        */
+        SEAL_NODISCARD inline std::size_t ciphertext_size() const noexcept
+        {
+            return ciphertext_size_;
+        }
+
+        /**
+        Returns the degree of the polynomial modulus.
+        */
+        SEAL_NODISCARD inline std::size_t poly_modulus_degree() const noexcept
+        {
+            return poly_modulus_degree_;
+        }
+
+        /**
+        Returns the number of primes in the coefficient modulus.
+        */
+        SEAL_NODISCARD inline std::size_t coeff_modulus_size() const noexcept
+        {
+            return coeff_modulus_size_;
+        }
+
+        /**
+        Returns whether the ciphertexts are in NTT form.
+        */
+        SEAL_NODISCARD inline bool is_ntt_form() const noexcept
+        {
+            return is_ntt_form_;
+        }
+
+        /**
+        Returns the scale shared by all ciphertexts.
+        */
+        SEAL_NODISCARD inline double scale() const noexcept
+        {
+            return scale_;
+        }
+
+        /**
+        Returns the currently used MemoryPoolHandle.
+        */
+        SEAL_NODISCARD inline MemoryPoolHandle pool() const noexcept
+        {
+            return data_.pool();
+        }
+
+        /**
+        Returns an upper bound on the size of the CiphertextBatch, as if it was
+        written to an output stream.
+
+        @param[in] compr_mode The compression mode
+        @throws std::invalid_argument if the compression mode is not supported
+        @throws std::logic_error if the size does not fit in the return type
+        */
+        SEAL_NODISCARD std::streamoff save_size(
+            compr_mode_type compr_mode = Serialization::compr_mode_default) const;
+
+        /**
+        Saves the CiphertextBatch to an output stream. The output is in binary
+        format and not human-readable. The output stream must have the "binary"
+        flag set.
+
+        @param[out] stream The stream to save the CiphertextBatch to
+        @param[in] compr_mode The desired compression mode
+        @param[in] thread_pool The ThreadPool across which the chunked compression
+        modes compress the data, or nullptr
+        @throws std::invalid_argument if the compression mode is not supported
+        @throws std::logic_error if the data to be saved is invalid, or if
+        compression failed
+        @throws std::runtime_error if I/O operations failed
+        */
+        inline std::streamoff save(
+            std::ostream &stream, compr_mode_type compr_mode = Serialization::compr_mode_default,
+            ThreadPool *thread_pool = nullptr) const
+        {
+            using namespace std::placeholders;
+            return Serialization::Save(
+                std::bind(&CiphertextBatch::save_members, this, _1), save_size(compr_mode_type::none), stream,
+                compr_mode, false, thread_pool);
+        }
+
+        /**
+        Loads a CiphertextBatch from an input stream overwriting the current
+        CiphertextBatch. No checking of the validity of the ciphertext data
+        against encryption parameters is performed. This function should not be
+        used unless the CiphertextBatch comes from a fully trusted source.
+
+        @param[in] context The SEALContext
+        @param[in] stream The stream to load the CiphertextBatch from
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::logic_error if the data cannot be loaded by this version of
+        Microsoft SEAL, if the loaded data is invalid, or if decompression failed
+        @throws std::runtime_error if I/O operations failed
+        */
+        inline std::streamoff unsafe_load(const SEALContext &context, std::istream &stream)
+        {
+            using namespace std::placeholders;
+            return Serialization::Load(
+                std::bind(&CiphertextBatch::load_members, this, context, _1, _2), stream, false,
+                context.thread_pool().get());
+        }
+
+        /**
+        Loads a CiphertextBatch from an input stream overwriting the current
+        CiphertextBatch. The loaded CiphertextBatch is verified to be valid for
+        the given SEALContext.
+
+        @param[in] context The SEALContext
+        @param[in] stream The stream to load the CiphertextBatch from
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::logic_error if the data cannot be loaded by this version of
+        Microsoft SEAL, if the loaded data is invalid, or if decompression failed
+        @throws std::runtime_error if I/O operations failed
+        */
+        inline std::streamoff load(const SEALContext &context, std::istream &stream)
+        {
+            CiphertextBatch new_data(pool());
+            auto in_size = new_data.unsafe_load(context, stream);
+            if (!is_valid_for(new_data, context))
+            {
+                throw std::logic_error("CiphertextBatch data is invalid");
+            }
+            std::swap(*this, new_data);
+            return in_size;
+        }
+
+        /**
+        Saves the CiphertextBatch to a given memory location. The output is in
+        binary format and not human-readable.
+
+        @param[out] out The memory location to write the CiphertextBatch to
+        @param[in] size The number of bytes available in the given memory location
+        @param[in] compr_mode The desired compression mode
+        @param[in] thread_pool The ThreadPool across which the chunked compression
+        modes compress the data, or nullptr
+        @throws std::invalid_argument if out is null or if size is too small to
+        contain a SEALHeader, or if the compression mode is not supported
+        @throws std::logic_error if the data to be saved is invalid, or if
+        compression failed
+        @throws std::runtime_error if I/O operations failed
+        */
+        inline std::streamoff save(
+            seal_byte *out, std::size_t size, compr_mode_type compr_mode = Serialization::compr_mode_default,
+            ThreadPool *thread_pool = nullptr) const
+        {
+            using namespace std::placeholders;
+            return Serialization::Save(
+                std::bind(&CiphertextBatch::save_members, this, _1), save_size(compr_mode_type::none), out, size,
+                compr_mode, false, thread_pool);
+        }
+
+        /**
+        Loads a CiphertextBatch from a given memory location overwriting the
+        current CiphertextBatch. No checking of the validity of the ciphertext
+        data against encryption parameters is performed. This function should
+        not be used unless the CiphertextBatch comes from a fully trusted source.
+
+        @param[in] context The SEALContext
+        @param[in] in The memory location to load the CiphertextBatch from
+        @param[in] size The number of bytes available in the given memory location
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if in is null or if size is too small to
+        contain a SEALHeader
+        @throws std::logic_error if the data cannot be loaded by this version of
+        Microsoft SEAL, if the loaded data is invalid, or if decompression failed
+        @throws std::runtime_error if I/O operations failed
+        */
+        inline std::streamoff unsafe_load(const SEALContext &context, const seal_byte *in, std::size_t size)
+        {
+            using namespace std::placeholders;
+            return Serialization::Load(
+                std::bind(&CiphertextBatch::load_members, this, context, _1, _2), in, size, false,
+                context.thread_pool().get());
+        }
+
+        /**
+        Loads a CiphertextBatch from a given memory location overwriting the
+        current CiphertextBatch. The loaded CiphertextBatch is verified to be
+        valid for the given SEALContext.
+
+        @param[in] context The SEALContext
+        @param[in] in The memory location to load the CiphertextBatch from
+        @param[in] size The number of bytes available in the given memory location
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if in is null or if size is too small to
+        contain a SEALHeader
+        @throws std::logic_error if the data cannot be loaded by this version of
+        Microsoft SEAL, if the loaded data is invalid, or if decompression failed
+        @throws std::runtime_error if I/O operations failed
+        */
+        inline std::streamoff load(const SEALContext &context, const seal_byte *in, std::size_t size)
+        {
+            CiphertextBatch new_data(pool());
+            auto in_size = new_data.unsafe_load(context, in, size);
+            if (!is_valid_for(new_data, context))
+            {
+                throw std::logic_error("CiphertextBatch data is invalid");
+            }
+            std::swap(*this, new_data);
+            return in_size;
+        }
+
+    private:
+        void save_members(std::ostream &stream) const;
+
+        void load_members(const SEALContext &context, std::istream &stream, SEALVersion version);
+
+        // Returns the number of coefficients in each ciphertext
+        SEAL_NODISCARD std::size_t ciphertext_coeff_count() const;
+
+        // Throws if index is out of range or the metadata is invalid for the context
+        void check_index(const SEALContext &context, std::size_t index) const;
+
+        parms_id_type parms_id_ = parms_id_zero;
+
+        bool is_ntt_form_ = false;
+
+        std::size_t ciphertext_size_ = 0;
+
+        std::size_t poly_modulus_degree_ = 0;
+
+        std::size_t coeff_modulus_size_ = 0;
+
+        double scale_ = 1.0;
+
+        std::size_t count_ = 0;
+
+        DynArray<ct_coeff_type> data_;
+    };
+
+    /**
+    Writes a stream of ciphertexts as consecutive CiphertextBatch objects of at
+    most a given number of ciphertexts each. Ciphertexts are buffered until the
+    current batch is full or a ciphertext with different metadata arrives, so
+    memory use is bounded by one batch. Call flush() after the last ciphertext
+    to write the final, possibly partial, batch; the destructor does not write
+    anything.
+
+    @par Thread Safety
+    A CiphertextBatchWriter must not be used concurrently from several threads.
+    */
+    class CiphertextBatchWriter
+    {
+    public:
+        /**
+        Creates a CiphertextBatchWriter writing to a given output stream, which
+        must have the "binary" flag set and must outlive the writer.
+
+        @param[out] stream The stream to write the batches to
+        @param[in] batch_size The maximum number of ciphertexts in a batch
+        @param[in] compr_mode The compression mode of every batch
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @param[in] thread_pool The ThreadPool across which the chunked compression
+        modes compress every batch, or nullptr
+        @throws std::invalid_argument if batch_size is zero
+        @throws std::invalid_argument if the compression mode is not supported
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        CiphertextBatchWriter(
+            std::ostream &stream, std::size_t batch_size = 1024,
+            compr_mode_type compr_mode = Serialization::compr_mode_default,
+            MemoryPoolHandle pool = MemoryManager::GetPool(), std::shared_ptr<ThreadPool> thread_pool = nullptr);
+
+        /**
+        Appends a ciphertext to the stream, first writing the current batch if it
+        is full or does not accept the ciphertext.
+
+        @param[in] encrypted The ciphertext to write
+        @throws std::invalid_argument if encrypted is empty
+        @throws std::logic_error if compression failed
+        @throws std::runtime_error if I/O operations failed
+        */
+        void write(const Ciphertext &encrypted);
+
+        /**
+        Writes the current batch to the stream if it holds any ciphertexts.
+
+        @throws std::logic_error if compression failed
+        @throws std::runtime_error if I/O operations failed
+        */
+        void flush();
+
+        /**
+        Returns the total number of bytes written to the stream.
+        */
+        SEAL_NODISCARD inline std::streamoff bytes_written() const noexcept
+        {
+            return bytes_written_;
+        }
+
+    private:
+        CiphertextBatchWriter(const CiphertextBatchWriter &copy) = delete;
+
+        CiphertextBatchWriter &operator=(const CiphertextBatchWriter &assign) = delete;
+
+        std::ostream &stream_;
+
+        std::size_t batch_size_;
+
+        compr_mode_type compr_mode_;
+
+        std::shared_ptr<ThreadPool> thread_pool_;
+
+        CiphertextBatch batch_;
+
+        std::streamoff bytes_written_ = 0;
+    };
+
+    /**
+    Reads a stream of ciphertexts written by CiphertextBatchWriter, loading one
+    CiphertextBatch at a time. Every batch is verified to be valid for the given
+    SEALContext.
+
+    @par Thread Safety
+    A CiphertextBatchReader must not be used concurrently from several threads.
+    */
+    class CiphertextBatchReader
+    {
+    public:
+        /**
+        Creates a CiphertextBatchReader reading from a given input stream, which
+        must outlive the reader.
+
+        @param[in] context The SEALContext
+        @param[in] stream The stream to read the batches from
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        CiphertextBatchReader(
+            const SEALContext &context, std::istream &stream, MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Reads the next ciphertext from the stream, loading the next batch when the
+        current one is exhausted. Returns false if the end of the stream has been
+        reached, in which case destination is left unchanged.
+
+        @param[out] destination The ciphertext to overwrite with the next one
+        @throws std::logic_error if the data cannot be loaded by this version of
+        Microsoft SEAL, if the loaded data is invalid, or if decompression failed
+        @throws std::runtime_error if I/O operations failed
+        */
+        bool read(Ciphertext &destination);
+
+        /**
+        Returns the total number of bytes read from the stream.
+        */
+        SEAL_NODISCARD inline std::streamoff bytes_read() const noexcept
+        {
+            return bytes_read_;
+        }
+
+    private:
+        CiphertextBatchReader(const CiphertextBatchReader &copy) = delete;
+
+        CiphertextBatchReader &operator=(const CiphertextBatchReader &assign) = delete;
+
+        // Returns whether the stream has no more data
+        SEAL_NODISCARD bool at_end();
+
+        SEALContext context_;
+
+        std::istream &stream_;
+
+        CiphertextBatch batch_;
+
+        std::size_t next_index_ = 0;
+
+        std::streamoff bytes_read_ = 0;
+    };
+} // namespace seal
@@ -0,0 +1,183 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/compactciphertext.h"
+#include "seal/util/bitpack.h"
+#include "seal/util/common.h"
+#include <algorithm>
+
+using namespace std;
+using namespace seal::util;
+
+namespace seal
+{
+    void CompactCiphertext::resize(
+        const SEALContext &context, parms_id_type parms_id, int c0_bit_count, int c1_bit_count)
+    {
+        // Verify parameters
+        if (!context.parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+        auto context_data_ptr = context.get_context_data(parms_id);
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("parms_id is not valid for encryption parameters");
+        }
+        auto &parms = context_data_ptr->parms();
+        if (parms.scheme() != scheme_type::bfv)
+        {
+            throw invalid_argument("unsupported scheme");
+        }
+        if (c0_bit_count < 1 || c0_bit_count > 64 || c1_bit_count < 1 || c1_bit_count > 64)
+        {
+            throw invalid_argument("bit counts must be in the range [1, 64]");
+        }
+
+        size_t poly_modulus_degree = parms.poly_modulus_degree();
+        data_.resize(add_safe(
+            get_packed_uint64_count(poly_modulus_degree, c0_bit_count),
+            get_packed_uint64_count(poly_modulus_degree, c1_bit_count)));
+        parms_id_ = parms_id;
+        poly_modulus_degree_ = poly_modulus_degree;
+        bit_counts_[0] = c0_bit_count;
+        bit_counts_[1] = c1_bit_count;
+    }
+
+    size_t CompactCiphertext::poly_offset(size_t poly_index) const
+    {
+        if (poly_index > 1)
+        {
+            throw out_of_range("poly_index must be 0 or 1");
+        }
+        return poly_index ? get_packed_uint64_count(poly_modulus_degree_, bit_counts_[0]) : 0;
+    }
+
+    void CompactCiphertext::set_poly(size_t poly_index, const uint64_t *values)
+    {
+        uint64_t *packed = data_.begin() + poly_offset(poly_index);
+        int bit_count = bit_counts_[poly_index];
+
+        // Blocks of bitpack_block_uint64_count values take exactly bit_count words each
+        for (size_t i = 0; i < poly_modulus_degree_; i += bitpack_block_uint64_count)
+        {
+            size_t count = min(bitpack_block_uint64_count, poly_modulus_degree_ - i);
+            pack_uint_block(values + i, count, bit_count, packed);
+            packed += static_cast<size_t>(bit_count);
+        }
+    }
+
+    void CompactCiphertext::get_poly(size_t poly_index, uint64_t *destination) const
+    {
+        const uint64_t *packed = data_.cbegin() + poly_offset(poly_index);
+        int bit_count = bit_counts_[poly_index];
+        for (size_t i = 0; i < poly_modulus_degree_; i += bitpack_block_uint64_count)
+        {
+            size_t count = min(bitpack_block_uint64_count, poly_modulus_degree_ - i);
+            unpack_uint_block(packed, count, bit_count, destination + i);
+            packed += static_cast<size_t>(bit_count);
+        }
+    }
+
+    streamoff CompactCiphertext::save_size(compr_mode_type compr_mode) const
+    {
+        size_t members_size = Serialization::ComprSizeEstimate(
+            add_safe(
+                sizeof(parms_id_),
+                sizeof(uint64_t), // poly_modulus_degree_
+                sizeof(uint8_t),  // bit_counts_[0]
+                sizeof(uint8_t),  // bit_counts_[1]
+                safe_cast<size_t>(data_.save_size(compr_mode_type::none))),
+            compr_mode);
+
+        return safe_cast<streamoff>(add_safe(sizeof(Serialization::SEALHeader), members_size));
+    }
+
+    void CompactCiphertext::save_members(ostream &stream) const
+    {
+        auto old_except_mask = stream.exceptions();
+        try
+        {
+            // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+            stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+            stream.write(reinterpret_cast<const char *>(&parms_id_), sizeof(parms_id_type));
+            uint64_t poly_modulus_degree64 = safe_cast<uint64_t>(poly_modulus_degree_);
+            stream.write(reinterpret_cast<const char *>(&poly_modulus_degree64), sizeof(uint64_t));
+            for (int bit_count : bit_counts_)
+            {
+                uint8_t bit_count8 = safe_cast<uint8_t>(bit_count);
+                stream.write(reinterpret_cast<const char *>(&bit_count8), sizeof(uint8_t));
+            }
+
+            // Save the DynArray
+            data_.save(stream, compr_mode_type::none);
+        }
+        catch (const ios_base::failure &)
+        {
+            stream.exceptions(old_except_mask);
+            throw runtime_error("I/O error");
+        }
+        catch (...)
+        {
+            stream.exceptions(old_except_mask);
+            throw;
+        }
+        stream.exceptions(old_except_mask);
+    }
+
+    void CompactCiphertext::load_members(
+        const SEALContext &context, istream &stream, SEAL_MAYBE_UNUSED SEALVersion version)
+    {
+        // Verify parameters
+        if (!context.parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+
+        CompactCiphertext new_data(data_.pool());
+
+        auto old_except_mask = stream.exceptions();
+        try
+        {
+            // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+            stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+            parms_id_type parms_id{};
+            stream.read(reinterpret_cast<char *>(&parms_id), sizeof(parms_id_type));
+            uint64_t poly_modulus_degree64 = 0;
+            stream.read(reinterpret_cast<char *>(&poly_modulus_degree64), sizeof(uint64_t));
+            uint8_t bit_counts8[2]{ 0, 0 };
+            stream.read(reinterpret_cast<char *>(bit_counts8), sizeof(bit_counts8));
+
+            // Set values already at this point for the metadata validity check
+            new_data.parms_id_ = parms_id;
+            new_data.poly_modulus_degree_ = safe_cast<size_t>(poly_modulus_degree64);
+            new_data.bit_counts_[0] = static_cast<int>(bit_counts8[0]);
+            new_data.bit_counts_[1] = static_cast<int>(bit_counts8[1]);
+            if (!is_metadata_valid_for(new_data, context))
+            {
+                throw logic_error("CompactCiphertext data is invalid");
+            }
+
+            // Load the data, with the expected size as a bound on the allocation
+            auto total_uint64_count = add_safe(
+                get_packed_uint64_count(new_data.poly_modulus_degree_, new_data.bit_counts_[0]),
+                get_packed_uint64_count(new_data.poly_modulus_degree_, new_data.bit_counts_[1]));
+            new_data.data_.load(stream, total_uint64_count);
+        }
+        catch (const ios_base::failure &)
+        {
+            stream.exceptions(old_except_mask);
+            throw runtime_error("I/O error");
+        }
+        catch (...)
+        {
+            stream.exceptions(old_except_mask);
+            throw;
+        }
+        stream.exceptions(old_except_mask);
+
+        swap(*this, new_data);
+    }
+} // namespace seal
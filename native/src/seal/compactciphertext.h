@@ -0,0 +1,342 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/context.h"
+#include "seal/dynarray.h"
+#include "seal/memorymanager.h"
+#include "seal/serialization.h"
+#include "seal/valcheck.h"
+#include "seal/version.h"
+#include "seal/util/defines.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+
+namespace seal
+{
+    /**
+    Class to store a BFV ciphertext in a compact form that can only be decrypted.
+    Evaluator::compact creates a CompactCiphertext from a ciphertext of size 2 by
+    switching it to the lowest level of the modulus switching chain and then from
+    the coefficient modulus q of that level to the power-of-two moduli 2^b0 and
+    2^b1 for its two polynomials, i.e., by keeping only the b0 and b1 most
+    significant bits of every coefficient modulo q. Decryptor::decrypt accepts a
+    CompactCiphertext directly.
+
+    @par Bit Counts
+    Decryption computes c0 + c1 * s, so dropping bits from c1 adds an error that
+    is multiplied by the secret key, whereas the error from dropping bits of c0
+    is not; hence b0 is typically much smaller than b1. The default bit counts
+    chosen by Evaluator::compact guarantee correct decryption for ciphertexts that
+    have more than one bit of invariant noise budget at the lowest level.
+
+    @par Memory Layout
+    The coefficients of each polynomial are packed to the bit count of the
+    polynomial in blocks of 64 coefficients, which take as many 64-bit words as
+    the bit count. The packed words of the first polynomial are followed by the
+    packed words of the second.
+
+    @par Thread Safety
+    In general, reading from a CompactCiphertext is thread-safe as long as no other
+    thread is concurrently mutating it.
+
+    @see Evaluator::compact for creating a CompactCiphertext.
+    @see Decryptor::decrypt for decrypting a CompactCiphertext.
+    */
+    class CompactCiphertext
+    {
+    public:
+        /**
+        Constructs an empty CompactCiphertext allocating no memory.
+
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        CompactCiphertext(MemoryPoolHandle pool = MemoryManager::GetPool()) : data_(std::move(pool))
+        {}
+
+        /**
+        Creates a new CompactCiphertext by copying a given one.
+
+        @param[in] copy The CompactCiphertext to copy from
+        */
+        CompactCiphertext(const CompactCiphertext &copy) = default;
+
+        /**
+        Creates a new CompactCiphertext by moving a given one.
+
+        @param[in] source The CompactCiphertext to move from
+        */
+        CompactCiphertext(CompactCiphertext &&source) = default;
+
+        /**
+        Copies a given CompactCiphertext to the current one.
+
+        @param[in] assign The CompactCiphertext to copy from
+        */
+        CompactCiphertext &operator=(const CompactCiphertext &assign) = default;
+
+        /**
+        Moves a given CompactCiphertext to the current one.
+
+        @param[in] assign The CompactCiphertext to move from
+        */
+        CompactCiphertext &operator=(CompactCiphertext &&assign) = default;
+
+        /**
+        Resizes the CompactCiphertext to hold two polynomials for the encryption
+        parameters with given parms_id, packed to the given bit counts. The
+        coefficients are left uninitialized.
+
+        @param[in] context The SEALContext
+        @param[in] parms_id The parms_id corresponding to the encryption
+        parameters to be used
+        @param[in] c0_bit_count The number of bits kept of each coefficient of c0
+        @param[in] c1_bit_count The number of bits kept of each coefficient of c1
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if parms_id is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if the scheme is not BFV
+        @throws std::invalid_argument if c0_bit_count or c1_bit_count is not in
+        the range [1, 64]
+        */
+        void resize(const SEALContext &context, parms_id_type parms_id, int c0_bit_count, int c1_bit_count);
+
+        /**
+        Sets the coefficients of the polynomial with the given index, each of
+        which must be less than 2 to the power of bit_count(poly_index).
+
+        @param[in] poly_index The index of the polynomial, 0 or 1
+        @param[in] values The poly_modulus_degree() coefficients to pack
+        @throws std::out_of_range if poly_index is not 0 or 1
+        */
+        void set_poly(std::size_t poly_index, const std::uint64_t *values);
+
+        /**
+        Returns the coefficients of the polynomial with the given index.
+
+        @param[in] poly_index The index of the polynomial, 0 or 1
+        @param[out] destination The poly_modulus_degree() words to unpack to
+        @throws std::out_of_range if poly_index is not 0 or 1
+        */
+        void get_poly(std::size_t poly_index, std::uint64_t *destination) const;
+
+        /**
+        Returns a reference to the backing DynArray object holding the packed
+        coefficients.
+        */
+        SEAL_NODISCARD inline const auto &dyn_array() const noexcept
+        {
+            return data_;
+        }
+
+        /**
+        Returns the number of bits kept of each coefficient of the polynomial with
+        the given index.
+
+        @param[in] poly_index The index of the polynomial, 0 or 1
+        @throws std::out_of_range if poly_index is not 0 or 1
+        */
+        SEAL_NODISCARD inline int bit_count(std::size_t poly_index) const
+        {
+            if (poly_index > 1)
+            {
+                throw std::out_of_range("poly_index must be 0 or 1");
+            }
+            return bit_counts_[poly_index];
+        }
+
+        /**
+        Returns the degree of the polynomial modulus of the encryption parameters.
+        */
+        SEAL_NODISCARD inline std::size_t poly_modulus_degree() const noexcept
+        {
+            return poly_modulus_degree_;
+        }
+
+        /**
+        Returns a reference to parms_id, the parms_id of the encryption parameters
+        at the level that the CompactCiphertext was switched to before truncation.
+        */
+        SEAL_NODISCARD inline const parms_id_type &parms_id() const noexcept
+        {
+            return parms_id_;
+        }
+
+        /**
+        Returns the currently used MemoryPoolHandle.
+        */
+        SEAL_NODISCARD inline MemoryPoolHandle pool() const noexcept
+        {
+            return data_.pool();
+        }
+
+        /**
+        Returns an upper bound on the size of the CompactCiphertext, as if it was
+        written to an output stream.
+
+        @param[in] compr_mode The compression mode
+        @throws std::invalid_argument if the compression mode is not supported
+        @throws std::logic_error if the size does not fit in the return type
+        */
+        SEAL_NODISCARD std::streamoff save_size(compr_mode_type compr_mode = compr_mode_type::none) const;
+
+        /**
+        Saves the CompactCiphertext to an output stream. The output is in binary
+        format and not human-readable. The output stream must have the "binary"
+        flag set. The coefficients are already packed, so compression is off by
+        default.
+
+        @param[out] stream The stream to save the CompactCiphertext to
+        @param[in] compr_mode The desired compression mode
+        @throws std::invalid_argument if the compression mode is not supported
+        @throws std::logic_error if the data to be saved is invalid, or if
+        compression failed
+        @throws std::runtime_error if I/O operations failed
+        */
+        inline std::streamoff save(std::ostream &stream, compr_mode_type compr_mode = compr_mode_type::none) const
+        {
+            using namespace std::placeholders;
+            return Serialization::Save(
+                std::bind(&CompactCiphertext::save_members, this, _1), save_size(compr_mode_type::none), stream,
+                compr_mode, false);
+        }
+
+        /**
+        Loads a CompactCiphertext from an input stream overwriting the current
+        CompactCiphertext. No checking of the validity of the CompactCiphertext
+        data against encryption parameters is performed. This function should not
+        be used unless the CompactCiphertext comes from a fully trusted source.
+
+        @param[in] context The SEALContext
+        @param[in] stream The stream to load the CompactCiphertext from
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::logic_error if the data cannot be loaded by this version of
+        Microsoft SEAL, if the loaded data is invalid, or if decompression failed
+        @throws std::runtime_error if I/O operations failed
+        */
+        inline std::streamoff unsafe_load(const SEALContext &context, std::istream &stream)
+        {
+            using namespace std::placeholders;
+            return Serialization::Load(
+                std::bind(&CompactCiphertext::load_members, this, context, _1, _2), stream, false);
+        }
+
+        /**
+        Loads a CompactCiphertext from an input stream overwriting the current
+        CompactCiphertext. The loaded CompactCiphertext is verified to be valid
+        for the given SEALContext.
+
+        @param[in] context The SEALContext
+        @param[in] stream The stream to load the CompactCiphertext from
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::logic_error if the data cannot be loaded by this version of
+        Microsoft SEAL, if the loaded data is invalid, or if decompression failed
+        @throws std::runtime_error if I/O operations failed
+        */
+        inline std::streamoff load(const SEALContext &context, std::istream &stream)
+        {
+            CompactCiphertext new_data(pool());
+            auto in_size = new_data.unsafe_load(context, stream);
+            if (!is_valid_for(new_data, context))
+            {
+                throw std::logic_error("CompactCiphertext data is invalid");
+            }
+            std::swap(*this, new_data);
+            return in_size;
+        }
+
+        /**
+        Saves the CompactCiphertext to a given memory location. The output is in
+        binary format and not human-readable.
+
+        @param[out] out The memory location to write the CompactCiphertext to
+        @param[in] size The number of bytes available in the given memory location
+        @param[in] compr_mode The desired compression mode
+        @throws std::invalid_argument if out is null or if size is too small to
+        contain a SEALHeader, or if the compression mode is not supported
+        @throws std::logic_error if the data to be saved is invalid, or if
+        compression failed
+        @throws std::runtime_error if I/O operations failed
+        */
+        inline std::streamoff save(
+            seal_byte *out, std::size_t size, compr_mode_type compr_mode = compr_mode_type::none) const
+        {
+            using namespace std::placeholders;
+            return Serialization::Save(
+                std::bind(&CompactCiphertext::save_members, this, _1), save_size(compr_mode_type::none), out, size,
+                compr_mode, false);
+        }
+
+        /**
+        Loads a CompactCiphertext from a given memory location overwriting the
+        current CompactCiphertext. No checking of the validity of the
+        CompactCiphertext data against encryption parameters is performed. This
+        function should not be used unless the CompactCiphertext comes from a
+        fully trusted source.
+
+        @param[in] context The SEALContext
+        @param[in] in The memory location to load the CompactCiphertext from
+        @param[in] size The number of bytes available in the given memory location
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if in is null or if size is too small to
+        contain a SEALHeader
+        @throws std::logic_error if the data cannot be loaded by this version of
+        Microsoft SEAL, if the loaded data is invalid, or if decompression failed
+        @throws std::runtime_error if I/O operations failed
+        */
+        inline std::streamoff unsafe_load(const SEALContext &context, const seal_byte *in, std::size_t size)
+        {
+            using namespace std::placeholders;
+            return Serialization::Load(
+                std::bind(&CompactCiphertext::load_members, this, context, _1, _2), in, size, false);
+        }
+
+        /**
+        Loads a CompactCiphertext from a given memory location overwriting the
+        current CompactCiphertext. The loaded CompactCiphertext is verified to be
+        valid for the given SEALContext.
+
+        @param[in] context The SEALContext
+        @param[in] in The memory location to load the CompactCiphertext from
+        @param[in] size The number of bytes available in the given memory location
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if in is null or if size is too small to
+        contain a SEALHeader
+        @throws std::logic_error if the data cannot be loaded by this version of
+        Microsoft SEAL, if the loaded data is invalid, or if decompression failed
+        @throws std::runtime_error if I/O operations failed
+        */
+        inline std::streamoff load(const SEALContext &context, const seal_byte *in, std::size_t size)
+        {
+            CompactCiphertext new_data(pool());
+            auto in_size = new_data.unsafe_load(context, in, size);
+            if (!is_valid_for(new_data, context))
+            {
+                throw std::logic_error("CompactCiphertext data is invalid");
+            }
+            std::swap(*this, new_data);
+            return in_size;
+        }
+
+    private:
+        void save_members(std::ostream &stream) const;
+
+        void load_members(const SEALContext &context, std::istream &stream, SEALVersion version);
+
+        // Returns the offset of the packed words of the polynomial with the given index
+        SEAL_NODISCARD std::size_t poly_offset(std::size_t poly_index) const;
+
+        parms_id_type parms_id_ = parms_id_zero;
+
+        std::size_t poly_modulus_degree_ = 0;
+
+        int bit_counts_[2]{ 0, 0 };
+
+        DynArray<std::uint64_t> data_;
+    };
+} // namespace seal
@@ -419,12 +419,12 @@ namespace seal
         return context_data;
     }
 
-    parms_id_type SEALContext::create_next_context_data(const parms_id_type &prev_parms_id)
+    parms_id_type SEALContext::create_next_context_data(const parms_id_type &prev_parms_id, size_t drop_count)
     {
-        // Create the next set of parameters by removing last modulus
+        // Create the next set of parameters by removing the last drop_count moduli
         auto next_parms = context_data_map_.at(prev_parms_id)->parms_;
         auto next_coeff_modulus = next_parms.coeff_modulus();
-        next_coeff_modulus.pop_back();
+        next_coeff_modulus.resize(next_coeff_modulus.size() - drop_count);
         next_parms.set_coeff_modulus(next_coeff_modulus);
         auto next_parms_id = next_parms.parms_id();
 
@@ -452,13 +452,24 @@ namespace seal
     }
 
     SEALContext::SEALContext(
-        EncryptionParameters parms, bool expand_mod_chain, sec_level_type sec_level, MemoryPoolHandle pool)
-        : pool_(move(pool)), sec_level_(sec_level)
+        EncryptionParameters parms, bool expand_mod_chain, sec_level_type sec_level, size_t special_prime_count,
+        size_t dnum, mod_arith_type mod_arith, shared_ptr<ThreadPool> thread_pool, MemoryPoolHandle pool)
+        : pool_(move(pool)), sec_level_(sec_level), mod_arith_(mod_arith), special_prime_count_(special_prime_count),
+          thread_pool_(move(thread_pool))
     {
         if (!pool_)
         {
             throw invalid_argument("pool is uninitialized");
         }
+        if (!special_prime_count_)
+        {
+            throw invalid_argument("special_prime_count must be positive");
+        }
+        if (parms.coeff_modulus().size() > special_prime_count_ &&
+            dnum > parms.coeff_modulus().size() - special_prime_count_)
+        {
+            throw invalid_argument("dnum is too large");
+        }
 
         // Set random generator
         if (!parms.random_generator())
@@ -473,17 +484,18 @@ namespace seal
         context_data_map_.emplace(make_pair(parms.parms_id(), make_shared<const ContextData>(validate(parms))));
         key_parms_id_ = parms.parms_id();
 
-        // Then create first_parms_id_ if the parameters are valid and there is
-        // more than one modulus in coeff_modulus. This is equivalent to expanding
-        // the chain by one step. Otherwise, we set first_parms_id_ to equal
-        // key_parms_id_.
-        if (!context_data_map_.at(key_parms_id_)->qualifiers_.parameters_set() || parms.coeff_modulus().size() == 1)
+        // Then create first_parms_id_ if the parameters are valid and there are
+        // more moduli in coeff_modulus than special primes. This is equivalent to
+        // expanding the chain by dropping the special primes. Otherwise, we set
+        // first_parms_id_ to equal key_parms_id_.
+        if (!context_data_map_.at(key_parms_id_)->qualifiers_.parameters_set() ||
+            parms.coeff_modulus().size() <= special_prime_count_)
         {
             first_parms_id_ = key_parms_id_;
         }
         else
         {
-            auto next_parms_id = create_next_context_data(key_parms_id_);
+            auto next_parms_id = create_next_context_data(key_parms_id_, special_prime_count_);
             first_parms_id_ = (next_parms_id == parms_id_zero) ? key_parms_id_ : next_parms_id;
         }
 
@@ -510,6 +522,27 @@ namespace seal
             }
         }
 
+        // Create the hybrid keyswitching pre-computations for each data level; the digit size is fixed by the first
+        // data level, and lower levels use the same digits truncated to their primes
+        if (using_keyswitching_)
+        {
+            auto &key_modulus = parms.coeff_modulus();
+            size_t decomp_modulus_size = key_modulus.size() - special_prime_count_;
+            digit_size_ = dnum ? (decomp_modulus_size + dnum - 1) / dnum : special_prime_count_;
+            dnum_ = (decomp_modulus_size + digit_size_ - 1) / digit_size_;
+            vector<Modulus> special_primes(
+                key_modulus.cbegin() + static_cast<ptrdiff_t>(decomp_modulus_size), key_modulus.cend());
+
+            auto context_data_ptr = context_data_map_.at(first_parms_id_);
+            while (context_data_ptr)
+            {
+                // We need to remove constness first to modify this
+                const_pointer_cast<ContextData>(context_data_ptr)->kswitch_tool_ = allocate<KSwitchTool>(
+                    pool_, context_data_ptr->parms().coeff_modulus(), special_primes, digit_size_, pool_);
+                context_data_ptr = context_data_ptr->next_context_data_;
+            }
+        }
+
         // Set the chain_index for each context_data
         size_t parms_count = context_data_map_.size();
         auto context_data_ptr = context_data_map_.at(key_parms_id_);
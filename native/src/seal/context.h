@@ -6,12 +6,14 @@
 #include "seal/encryptionparams.h"
 #include "seal/memorymanager.h"
 #include "seal/modulus.h"
+#include "seal/threadpool.h"
 #include "seal/util/galois.h"
 #include "seal/util/ntt.h"
 #include "seal/util/pointer.h"
 #include "seal/util/rns.h"
 #include <memory>
 #include <unordered_map>
+#include <utility>
 
 namespace seal
 {
@@ -343,6 +345,15 @@ namespace seal
                 return galois_tool_.get();
             }
 
+            /**
+            Returns a constant pointer to the KSwitchTool, or nullptr if the context
+            does not support keyswitching or these are the key level parameters.
+            */
+            SEAL_NODISCARD inline const util::KSwitchTool *kswitch_tool() const noexcept
+            {
+                return kswitch_tool_.get();
+            }
+
             /**
             Return a pointer to BFV "Delta", i.e. coefficient modulus divided by
             plaintext modulus.
@@ -457,6 +468,8 @@ namespace seal
 
             util::Pointer<util::GaloisTool> galois_tool_;
 
+            util::Pointer<util::KSwitchTool> kswitch_tool_;
+
             util::Pointer<std::uint64_t> total_coeff_modulus_;
 
             int total_coeff_modulus_bit_count_ = 0;
@@ -489,11 +502,28 @@ namespace seal
         should be created
         @param[in] sec_level Determines whether a specific security level should be
         enforced according to HomomorphicEncryption.org security standard
+        @param[in] special_prime_count The number of primes at the end of the
+        coefficient modulus that form the special modulus P used only by keyswitching
+        @param[in] dnum The number of digits the remaining primes are grouped into
+        for keyswitching, or 0 to use digits of special_prime_count primes each;
+        fewer digits mean smaller keys and faster keyswitching, but more noise
+        unless P is at least as large as the product of the primes in each digit
+        @param[in] mod_arith Determines the modular multiplication used by Evaluator
+        for the dyadic products of NTT-form data
+        @param[in] thread_pool The ThreadPool across which Evaluator, Encryptor,
+        Decryptor, and KeyGenerator split their independent per-limb work, or
+        nullptr to run all operations on the calling thread
+        @throws std::invalid_argument if special_prime_count is zero
+        @throws std::invalid_argument if dnum exceeds the number of primes that
+        are not special
         */
         SEALContext(
             const EncryptionParameters &parms, bool expand_mod_chain = true,
-            sec_level_type sec_level = sec_level_type::tc128)
-            : SEALContext(parms, expand_mod_chain, sec_level, MemoryManager::GetPool())
+            sec_level_type sec_level = sec_level_type::tc128, std::size_t special_prime_count = 1, std::size_t dnum = 0,
+            mod_arith_type mod_arith = mod_arith_type::barrett, std::shared_ptr<ThreadPool> thread_pool = nullptr)
+            : SEALContext(
+                  parms, expand_mod_chain, sec_level, special_prime_count, dnum, mod_arith, std::move(thread_pool),
+                  MemoryManager::GetPool())
         {}
 
         /**
@@ -625,13 +655,60 @@ namespace seal
         support for keyswitching is required by Evaluator::relinearize,
         Evaluator::apply_galois, and all rotation and conjugation operations. For
         keyswitching to be available, the coefficient modulus parameter must consist
-        of at least two prime number factors.
+        of more prime number factors than the special modulus.
         */
         SEAL_NODISCARD inline bool using_keyswitching() const noexcept
         {
             return using_keyswitching_;
         }
 
+        /**
+        Returns the modular multiplication Evaluator uses for the dyadic products
+        of NTT-form data. The NTT tables use mod_arith_type::barrett regardless.
+        */
+        SEAL_NODISCARD inline mod_arith_type mod_arith() const noexcept
+        {
+            return mod_arith_;
+        }
+
+        /**
+        Returns the number of primes in the special modulus, i.e., the number of
+        primes dropped from the key level to the first data level.
+        */
+        SEAL_NODISCARD inline std::size_t special_prime_count() const noexcept
+        {
+            return special_prime_count_;
+        }
+
+        /**
+        Returns the number of digits keyswitching decomposes a ciphertext at the
+        first data level into, which is also the number of keys per KSwitchKeys
+        entry. Returns 0 if keyswitching is not supported.
+        */
+        SEAL_NODISCARD inline std::size_t dnum() const noexcept
+        {
+            return dnum_;
+        }
+
+        /**
+        Returns the number of primes in each keyswitching digit; the last digit
+        may hold fewer. Returns 0 if keyswitching is not supported.
+        */
+        SEAL_NODISCARD inline std::size_t digit_size() const noexcept
+        {
+            return digit_size_;
+        }
+
+        /**
+        Returns the ThreadPool given at construction, or nullptr if none was given.
+        Loops that allocate temporaries run serially regardless of this setting when
+        the MemoryPoolHandle passed to the operation is not thread-safe.
+        */
+        SEAL_NODISCARD inline const std::shared_ptr<ThreadPool> &thread_pool() const noexcept
+        {
+            return thread_pool_;
+        }
+
     private:
         /**
         Creates an instance of SEALContext, and performs several pre-computations
@@ -642,20 +719,31 @@ namespace seal
         should be created
         @param[in] sec_level Determines whether a specific security level should be
         enforced according to HomomorphicEncryption.org security standard
+        @param[in] special_prime_count The number of primes in the special modulus
+        @param[in] dnum The number of keyswitching digits, or 0 for the default
+        @param[in] mod_arith Determines the modular multiplication used by Evaluator
+        for the dyadic products of NTT-form data
+        @param[in] thread_pool The ThreadPool to split per-limb work across, or nullptr
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if pool is uninitialized
+        @throws std::invalid_argument if special_prime_count is zero
+        @throws std::invalid_argument if dnum exceeds the number of primes that
+        are not special
         */
-        SEALContext(EncryptionParameters parms, bool expand_mod_chain, sec_level_type sec_level, MemoryPoolHandle pool);
+        SEALContext(
+            EncryptionParameters parms, bool expand_mod_chain, sec_level_type sec_level,
+            std::size_t special_prime_count, std::size_t dnum, mod_arith_type mod_arith,
+            std::shared_ptr<ThreadPool> thread_pool, MemoryPoolHandle pool);
 
         ContextData validate(EncryptionParameters parms);
 
         /**
-        Create the next context_data by dropping the last element from coeff_modulus.
-        If the new encryption parameters are not valid, returns parms_id_zero.
-        Otherwise, returns the parms_id of the next parameter and appends the next
-        context_data to the chain.
+        Create the next context_data by dropping the last drop_count elements from
+        coeff_modulus. If the new encryption parameters are not valid, returns
+        parms_id_zero. Otherwise, returns the parms_id of the next parameter and
+        appends the next context_data to the chain.
         */
-        parms_id_type create_next_context_data(const parms_id_type &prev_parms);
+        parms_id_type create_next_context_data(const parms_id_type &prev_parms, std::size_t drop_count = 1);
 
         MemoryPoolHandle pool_;
 
@@ -672,6 +760,28 @@ namespace seal
         */
         sec_level_type sec_level_;
 
+        /**
+        Which modular multiplication do the dyadic products of NTT-form data use?
+        */
+        mod_arith_type mod_arith_;
+
+        /**
+        How many primes form the special modulus?
+        */
+        std::size_t special_prime_count_;
+
+        /**
+        How many keyswitching digits are there at the first data level?
+        */
+        std::size_t dnum_ = 0;
+
+        /**
+        How many primes does each keyswitching digit hold?
+        */
+        std::size_t digit_size_ = 0;
+
+        std::shared_ptr<ThreadPool> thread_pool_{ nullptr };
+
         /**
         Is keyswitching supported by the encryption parameters?
         */
@@ -4,6 +4,7 @@
 #include "seal/decryptor.h"
 #include "seal/valcheck.h"
 #include "seal/util/common.h"
+#include "seal/util/parallel.h"
 #include "seal/util/polyarithsmallmod.h"
 #include "seal/util/polycore.h"
 #include "seal/util/scalingvariant.h"
@@ -107,6 +108,55 @@ namespace seal
         }
     }
 
+    void Decryptor::decrypt(const CompactCiphertext &encrypted, Plaintext &destination)
+    {
+        // Verify that encrypted is valid.
+        if (!is_valid_for(encrypted, context_))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+
+        auto &context_data = *context_.get_context_data(encrypted.parms_id());
+        size_t coeff_count = context_data.parms().poly_modulus_degree();
+        size_t coeff_modulus_size = context_data.parms().coeff_modulus().size();
+        size_t wide_uint64_count = coeff_modulus_size + 1;
+        const uint64_t *modulus = context_data.total_coeff_modulus();
+
+        Ciphertext expanded(pool_);
+        expanded.resize(context_, encrypted.parms_id(), 2);
+
+        auto compressed(allocate_uint(coeff_count, pool_));
+        auto product(allocate_uint(wide_uint64_count, pool_));
+        auto half(allocate_zero_uint(wide_uint64_count, pool_));
+        for (size_t poly_index = 0; poly_index < 2; poly_index++)
+        {
+            int bit_count = encrypted.bit_count(poly_index);
+            half[0] = uint64_t(1) << (bit_count - 1);
+            encrypted.get_poly(poly_index, compressed.get());
+
+            // Compute round(v * q / 2^bit_count) for every truncated coefficient v
+            uint64_t *values = expanded.data(poly_index);
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                multiply_uint(modulus, coeff_modulus_size, compressed[i], wide_uint64_count, product.get());
+                add_uint(product.get(), half.get(), wide_uint64_count, product.get());
+                right_shift_uint(product.get(), bit_count, wide_uint64_count, product.get());
+
+                // The result is at most q, which is congruent to zero
+                if (is_greater_than_or_equal_uint(product.get(), modulus, coeff_modulus_size))
+                {
+                    set_zero_uint(coeff_modulus_size, product.get());
+                }
+                set_uint(product.get(), coeff_modulus_size, values + i * coeff_modulus_size);
+            }
+
+            // Return to the RNS representation
+            context_data.rns_tool()->base_q()->decompose_array(values, coeff_count, pool_);
+        }
+
+        bfv_decrypt(expanded, destination, pool_);
+    }
+
     void Decryptor::bfv_decrypt(const Ciphertext &encrypted, Plaintext &destination, MemoryPoolHandle pool)
     {
         if (encrypted.is_ntt_form())
@@ -264,6 +314,9 @@ namespace seal
         // Make sure we have enough secret key powers computed
         compute_secret_key_array(encrypted_size - 1);
 
+        // The RNS components are independent and no iteration allocates, so they can always run on the ThreadPool
+        ThreadPool *thread_pool = context_.thread_pool().get();
+
         if (encrypted_size == 2)
         {
             ConstRNSIter secret_key_array(secret_key_array_.get(), coeff_count);
@@ -271,29 +324,27 @@ namespace seal
             ConstRNSIter c1(encrypted.data(1), coeff_count);
             if (is_ntt_form)
             {
-                SEAL_ITERATE(
-                    iter(c0, c1, secret_key_array, coeff_modulus, destination), coeff_modulus_size, [&](auto I) {
-                        // put < c_1 * s > mod q in destination
-                        dyadic_product_coeffmod(get<1>(I), get<2>(I), coeff_count, get<3>(I), get<4>(I));
-                        // add c_0 to the result; note that destination should be in the same (NTT) form as encrypted
-                        add_poly_coeffmod(get<4>(I), get<0>(I), coeff_count, get<3>(I), get<4>(I));
-                    });
+                parallel_for_each(thread_pool, coeff_modulus_size, [&](size_t i) {
+                    // put < c_1 * s > mod q in destination
+                    dyadic_product_coeffmod(c1[i], secret_key_array[i], coeff_count, coeff_modulus[i], destination[i]);
+                    // add c_0 to the result; note that destination should be in the same (NTT) form as encrypted
+                    add_poly_coeffmod(destination[i], c0[i], coeff_count, coeff_modulus[i], destination[i]);
+                });
             }
             else
             {
-                SEAL_ITERATE(
-                    iter(c0, c1, secret_key_array, coeff_modulus, ntt_tables, destination), coeff_modulus_size,
-                    [&](auto I) {
-                        set_uint(get<1>(I), coeff_count, get<5>(I));
-                        // Transform c_1 to NTT form
-                        ntt_negacyclic_harvey_lazy(get<5>(I), get<4>(I));
-                        // put < c_1 * s > mod q in destination
-                        dyadic_product_coeffmod(get<5>(I), get<2>(I), coeff_count, get<3>(I), get<5>(I));
-                        // Transform back
-                        inverse_ntt_negacyclic_harvey(get<5>(I), get<4>(I));
-                        // add c_0 to the result; note that destination should be in the same (NTT) form as encrypted
-                        add_poly_coeffmod(get<5>(I), get<0>(I), coeff_count, get<3>(I), get<5>(I));
-                    });
+                parallel_for_each(thread_pool, coeff_modulus_size, [&](size_t i) {
+                    set_uint(c1[i], coeff_count, destination[i]);
+                    // Transform c_1 to NTT form
+                    ntt_negacyclic_harvey_lazy(destination[i], ntt_tables[i]);
+                    // put < c_1 * s > mod q in destination
+                    dyadic_product_coeffmod(
+                        destination[i], secret_key_array[i], coeff_count, coeff_modulus[i], destination[i]);
+                    // Transform back
+                    inverse_ntt_negacyclic_harvey(destination[i], ntt_tables[i]);
+                    // add c_0 to the result; note that destination should be in the same (NTT) form as encrypted
+                    add_poly_coeffmod(destination[i], c0[i], coeff_count, coeff_modulus[i], destination[i]);
+                });
             }
         }
         else
@@ -307,24 +358,24 @@ namespace seal
             // Transform c_1, c_2, ... to NTT form unless they already are
             if (!is_ntt_form)
             {
-                ntt_negacyclic_harvey_lazy(encrypted_copy, encrypted_size - 1, ntt_tables);
+                ntt_negacyclic_harvey_lazy(encrypted_copy, encrypted_size - 1, ntt_tables, thread_pool);
             }
 
-            // Compute dyadic product with secret power array
+            // Compute dyadic product with secret power array and aggregate all polynomials together to complete the
+            // dot product, one RNS component at a time
             auto secret_key_array = PolyIter(secret_key_array_.get(), coeff_count, key_coeff_modulus_size);
-            SEAL_ITERATE(iter(encrypted_copy, secret_key_array), encrypted_size - 1, [&](auto I) {
-                dyadic_product_coeffmod(get<0>(I), get<1>(I), coeff_modulus_size, coeff_modulus, get<0>(I));
-            });
-            // Aggregate all polynomials together to complete the dot product
-            set_zero_poly(coeff_count, coeff_modulus_size, destination);
-            SEAL_ITERATE(encrypted_copy, encrypted_size - 1, [&](auto I) {
-                add_poly_coeffmod(destination, I, coeff_modulus_size, coeff_modulus, destination);
+            parallel_for_each(thread_pool, coeff_modulus_size, [&](size_t i) {
+                set_zero_uint(coeff_count, destination[i]);
+                SEAL_ITERATE(iter(encrypted_copy, secret_key_array), encrypted_size - 1, [&](auto I) {
+                    dyadic_product_coeffmod(get<0>(I)[i], get<1>(I)[i], coeff_count, coeff_modulus[i], get<0>(I)[i]);
+                    add_poly_coeffmod(destination[i], get<0>(I)[i], coeff_count, coeff_modulus[i], destination[i]);
+                });
             });
 
             if (!is_ntt_form)
             {
                 // If the input was not in NTT form, need to transform back
-                inverse_ntt_negacyclic_harvey(destination, coeff_modulus_size, ntt_tables);
+                inverse_ntt_negacyclic_harvey(destination, coeff_modulus_size, ntt_tables, thread_pool);
             }
 
             // Finally add c_0 to the result; note that destination should be in the same (NTT) form as encrypted
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "seal/ciphertext.h"
+#include "seal/compactciphertext.h"
 #include "seal/context.h"
 #include "seal/encryptionparams.h"
 #include "seal/memorymanager.h"
@@ -37,6 +38,11 @@ namespace seal
     to use. It is important for a developer to understand how this works to avoid
     unnecessary performance bottlenecks.
 
+    @par Parallel Decryption
+    If the SEALContext was constructed with a ThreadPool, the dot product of the
+    ciphertext with the powers of the secret key, including its NTTs, is split
+    across the pool one RNS component at a time. This applies to decrypt and to
+    invariant_noise_budget.
 
     @par NTT form
     When using the BFV scheme (scheme_type::bfv), all plaintext and ciphertexts
@@ -73,6 +79,19 @@ namespace seal
         */
         void decrypt(const Ciphertext &encrypted, Plaintext &destination);
 
+        /*
+        Decrypts a CompactCiphertext and stores the result in the destination
+        parameter. The coefficients are first scaled back to the coefficient
+        modulus of the level the CompactCiphertext was created at.
+
+        @param[in] encrypted The compact ciphertext to decrypt
+        @param[out] destination The plaintext to overwrite with the decrypted
+        ciphertext
+        @throws std::invalid_argument if encrypted is not valid for the encryption
+        parameters
+        */
+        void decrypt(const CompactCiphertext &encrypted, Plaintext &destination);
+
         /*
         Computes the invariant noise budget (in bits) of a ciphertext. The
         invariant noise budget measures the amount of room there is for the noise
@@ -6,6 +6,7 @@
 #include "seal/memorymanager.h"
 #include "seal/serialization.h"
 #include "seal/version.h"
+#include "seal/util/bitpack.h"
 #include "seal/util/common.h"
 #include "seal/util/defines.h"
 #include "seal/util/pointer.h"
@@ -205,6 +206,32 @@ namespace seal
             : DynArray(values, values.size(), std::move(pool))
         {}
 #endif
+        /**
+        Creates a new DynArray of given size over a buffer owned by the caller.
+        No memory is allocated and the contents of the buffer are left unchanged.
+        The DynArray reads and writes its elements directly in the buffer and
+        never reallocates it: resizing it beyond the given capacity throws, and
+        reserve and shrink_to_fit do not change the capacity. Copies of the
+        DynArray allocate their own memory from the memory pool, whereas moving
+        it transfers the reference to the buffer. The buffer must outlive the
+        DynArray and any DynArray it is moved to.
+
+        @param[in] buffer The buffer to wrap
+        @param[in] capacity The number of elements that fit in the buffer
+        @param[in] size The size of the array
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if buffer is null and capacity is positive
+        @throws std::invalid_argument if capacity is less than size
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        SEAL_NODISCARD static DynArray<T> Aliasing(
+            T *buffer, std::size_t capacity, std::size_t size, MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            DynArray<T> result(util::Pointer<T>::Aliasing(buffer), capacity, size, false, std::move(pool));
+            result.aliasing_ = true;
+            return result;
+        }
+
         /**
         Creates a new DynArray by copying a given one.
 
@@ -225,8 +252,10 @@ namespace seal
         */
         DynArray(DynArray<T> &&source) noexcept
             : pool_(std::move(source.pool_)), capacity_(source.capacity_), size_(source.size_),
-              data_(std::move(source.data_))
-        {}
+              data_(std::move(source.data_)), aliasing_(source.aliasing_)
+        {
+            source.aliasing_ = false;
+        }
 
         /**
         Destroys the DynArray.
@@ -396,15 +425,25 @@ namespace seal
             return pool_;
         }
 
+        /**
+        Returns whether the DynArray wraps a buffer owned by the caller.
+        */
+        SEAL_NODISCARD inline bool is_alias() const noexcept
+        {
+            return aliasing_;
+        }
+
         /**
         Releases any allocated memory to the memory pool and sets the size
-        and capacity of the array to zero.
+        and capacity of the array to zero. An aliasing DynArray stops referring
+        to its buffer.
         */
         inline void release() noexcept
         {
             capacity_ = 0;
             size_ = 0;
             data_.release();
+            aliasing_ = false;
         }
 
         /**
@@ -421,10 +460,21 @@ namespace seal
         the current size, the size is automatically set to equal the new capacity.
 
         @param[in] capacity The capacity of the array
+        @throws std::logic_error if the DynArray is aliasing and capacity exceeds
+        the size of its buffer
         */
         inline void reserve(std::size_t capacity)
         {
             std::size_t copy_size = std::min<>(capacity, size_);
+            if (aliasing_)
+            {
+                if (capacity > capacity_)
+                {
+                    throw std::logic_error("capacity exceeds the aliased buffer");
+                }
+                size_ = copy_size;
+                return;
+            }
 
             // Create new allocation and copy over value
             auto new_data(util::allocate<T>(capacity, pool_));
@@ -453,6 +503,8 @@ namespace seal
 
         @param[in] size The size of the array
         @param[in] fill_zero If true, fills expanded space with zeros
+        @throws std::logic_error if the DynArray is aliasing and size exceeds the
+        size of its buffer
         */
         inline void resize(std::size_t size, bool fill_zero = true)
         {
@@ -473,6 +525,10 @@ namespace seal
 
             // At this point we know for sure that size_ <= capacity_ < size so need
             // to reallocate to bigger
+            if (aliasing_)
+            {
+                throw std::logic_error("size exceeds the aliased buffer");
+            }
             auto new_data(util::allocate<T>(size, pool_));
             std::copy(cbegin(), cend(), new_data.get());
             if (fill_zero)
@@ -536,6 +592,8 @@ namespace seal
             size_ = assign.size_;
             data_ = std::move(assign.data_);
             pool_ = std::move(assign.pool_);
+            aliasing_ = assign.aliasing_;
+            assign.aliasing_ = false;
 
             return *this;
         }
@@ -659,7 +717,11 @@ namespace seal
 
                 std::uint64_t size64 = size_;
                 stream.write(reinterpret_cast<const char *>(&size64), sizeof(std::uint64_t));
-                if (size_)
+                if (size_ && std::is_same<T, std::uint64_t>::value && Serialization::IsPackedStream(stream))
+                {
+                    util::save_packed_uint(reinterpret_cast<const std::uint64_t *>(cbegin()), size_, stream, pool_);
+                }
+                else if (size_)
                 {
                     stream.write(
                         reinterpret_cast<const char *>(cbegin()),
@@ -702,7 +764,11 @@ namespace seal
                 resize(util::safe_cast<std::size_t>(size64));
 
                 // Read data
-                if (size_)
+                if (size_ && std::is_same<T, std::uint64_t>::value && Serialization::IsPackedStream(stream))
+                {
+                    util::load_packed_uint(stream, size_, reinterpret_cast<std::uint64_t *>(begin()), pool_);
+                }
+                else if (size_)
                 {
                     stream.read(
                         reinterpret_cast<char *>(begin()),
@@ -729,5 +795,8 @@ namespace seal
         std::size_t size_ = 0;
 
         util::Pointer<T> data_;
+
+        // Whether data_ refers to a buffer owned by the caller that must not be reallocated
+        bool aliasing_ = false;
     };
 } // namespace seal
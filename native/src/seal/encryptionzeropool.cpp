@@ -0,0 +1,144 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/encryptionzeropool.h"
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+namespace seal
+{
+    EncryptionZeroPool::EncryptionZeroPool(
+        const SEALContext &context, const PublicKey &public_key, parms_id_type parms_id, size_t depth,
+        size_t thread_count)
+        : context_(context), public_key_(public_key), parms_id_(parms_id), depth_(depth),
+          encryptor_(context, public_key)
+    {
+        // Verify parameters
+        if (!context_.get_context_data(parms_id_))
+        {
+            throw invalid_argument("parms_id is not valid for encryption parameters");
+        }
+        if (!depth_)
+        {
+            throw invalid_argument("depth must be positive");
+        }
+        if (!thread_count)
+        {
+            throw invalid_argument("thread_count must be positive");
+        }
+
+        workers_.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; i++)
+        {
+            workers_.emplace_back(&EncryptionZeroPool::worker_loop, this);
+        }
+    }
+
+    EncryptionZeroPool::~EncryptionZeroPool()
+    {
+        {
+            lock_guard<mutex> lock(mutex_);
+            stop_ = true;
+        }
+        refill_.notify_all();
+        for (auto &worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    void EncryptionZeroPool::take(Ciphertext &destination)
+    {
+        Ciphertext zero;
+        bool found = false;
+        {
+            lock_guard<mutex> lock(mutex_);
+            if (!zeros_.empty())
+            {
+                zero = move(zeros_.front());
+                zeros_.pop_front();
+                found = true;
+            }
+            else
+            {
+                miss_count_++;
+            }
+        }
+        refill_.notify_one();
+
+        if (found)
+        {
+            // Copy rather than move so that destination keeps its memory pool
+            destination = zero;
+        }
+        else
+        {
+            encryptor_.encrypt_zero(parms_id_, destination);
+        }
+    }
+
+    void EncryptionZeroPool::wait_until_filled()
+    {
+        unique_lock<mutex> lock(mutex_);
+        filled_.wait(lock, [this] { return zeros_.size() >= depth_ || error_; });
+        if (error_)
+        {
+            rethrow_exception(error_);
+        }
+    }
+
+    size_t EncryptionZeroPool::size() const
+    {
+        lock_guard<mutex> lock(mutex_);
+        return zeros_.size();
+    }
+
+    size_t EncryptionZeroPool::miss_count() const
+    {
+        lock_guard<mutex> lock(mutex_);
+        return miss_count_;
+    }
+
+    void EncryptionZeroPool::worker_loop()
+    {
+        unique_lock<mutex> lock(mutex_);
+        while (true)
+        {
+            refill_.wait(lock, [this] { return stop_ || zeros_.size() + pending_count_ < depth_; });
+            if (stop_)
+            {
+                return;
+            }
+
+            // Encrypt without holding the lock
+            pending_count_++;
+            lock.unlock();
+            Ciphertext zero;
+            exception_ptr error;
+            try
+            {
+                encryptor_.encrypt_zero(parms_id_, zero);
+            }
+            catch (...)
+            {
+                error = current_exception();
+            }
+            lock.lock();
+            pending_count_--;
+
+            if (error)
+            {
+                error_ = error;
+                filled_.notify_all();
+                return;
+            }
+            zeros_.push_back(move(zero));
+            if (zeros_.size() >= depth_)
+            {
+                filled_.notify_all();
+            }
+        }
+    }
+} // namespace seal
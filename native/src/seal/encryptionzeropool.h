@@ -0,0 +1,165 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/ciphertext.h"
+#include "seal/context.h"
+#include "seal/encryptor.h"
+#include "seal/publickey.h"
+#include "seal/util/defines.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace seal
+{
+    /**
+    Keeps a supply of fresh public-key encryptions of zero that are computed ahead of time on background threads.
+    Almost all of the cost of public-key encryption is in computing an encryption of zero, which does not depend on
+    the message. When an EncryptionZeroPool is attached to an Encryptor with Encryptor::set_zero_pool, public-key
+    encryptions at the level of the pool take a precomputed encryption of zero and only add the plaintext to it, so
+    that the latency of encryption no longer includes sampling and NTTs.
+
+    @par Refilling
+    The background threads keep the pool filled up to its depth. Each encryption of zero is handed out exactly once.
+    If the pool is empty when an encryption of zero is requested, it is computed on the calling thread instead.
+
+    @par Thread Safety
+    All member functions are thread-safe. The background threads are stopped and joined when the EncryptionZeroPool
+    is destroyed.
+    */
+    class EncryptionZeroPool
+    {
+    public:
+        /**
+        Creates an EncryptionZeroPool for the highest (data) level in the modulus switching chain and starts
+        thread_count background threads that fill it up to depth encryptions of zero.
+
+        @param[in] context The SEALContext
+        @param[in] public_key The public key
+        @param[in] depth The number of encryptions of zero to keep in the pool
+        @param[in] thread_count The number of background threads
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if public_key is not valid
+        @throws std::invalid_argument if depth or thread_count is zero
+        */
+        EncryptionZeroPool(
+            const SEALContext &context, const PublicKey &public_key, std::size_t depth, std::size_t thread_count = 1)
+            : EncryptionZeroPool(context, public_key, context.first_parms_id(), depth, thread_count)
+        {}
+
+        /**
+        Creates an EncryptionZeroPool for the level given by parms_id and starts thread_count background threads
+        that fill it up to depth encryptions of zero.
+
+        @param[in] context The SEALContext
+        @param[in] public_key The public key
+        @param[in] parms_id The parms_id of the encryptions of zero
+        @param[in] depth The number of encryptions of zero to keep in the pool
+        @param[in] thread_count The number of background threads
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::invalid_argument if public_key is not valid
+        @throws std::invalid_argument if parms_id is not valid for the encryption parameters
+        @throws std::invalid_argument if depth or thread_count is zero
+        */
+        EncryptionZeroPool(
+            const SEALContext &context, const PublicKey &public_key, parms_id_type parms_id, std::size_t depth,
+            std::size_t thread_count = 1);
+
+        /**
+        Stops and joins the background threads.
+        */
+        ~EncryptionZeroPool();
+
+        EncryptionZeroPool(const EncryptionZeroPool &copy) = delete;
+
+        EncryptionZeroPool &operator=(const EncryptionZeroPool &assign) = delete;
+
+        /**
+        Overwrites destination with a fresh encryption of zero from the pool, or with one computed on the calling
+        thread if the pool is empty.
+
+        @param[out] destination The ciphertext to overwrite with an encryption of zero
+        */
+        void take(Ciphertext &destination);
+
+        /**
+        Blocks until the pool holds depth() encryptions of zero.
+
+        @throws std::exception if a background thread failed, in which case its exception is rethrown
+        */
+        void wait_until_filled();
+
+        /**
+        Returns the number of encryptions of zero currently in the pool.
+        */
+        SEAL_NODISCARD std::size_t size() const;
+
+        /**
+        Returns the number of calls to take that found the pool empty.
+        */
+        SEAL_NODISCARD std::size_t miss_count() const;
+
+        /**
+        Returns the number of encryptions of zero the pool is filled up to.
+        */
+        SEAL_NODISCARD inline std::size_t depth() const noexcept
+        {
+            return depth_;
+        }
+
+        /**
+        Returns the parms_id of the encryptions of zero.
+        */
+        SEAL_NODISCARD inline const parms_id_type &parms_id() const noexcept
+        {
+            return parms_id_;
+        }
+
+        /**
+        Returns the public key used for encryption.
+        */
+        SEAL_NODISCARD inline const PublicKey &public_key() const noexcept
+        {
+            return public_key_;
+        }
+
+    private:
+        void worker_loop();
+
+        const SEALContext context_;
+
+        const PublicKey public_key_;
+
+        const parms_id_type parms_id_;
+
+        const std::size_t depth_;
+
+        // Encrypts without a zero pool; its const member functions are thread-safe
+        const Encryptor encryptor_;
+
+        mutable std::mutex mutex_{};
+
+        std::condition_variable refill_{};
+
+        std::condition_variable filled_{};
+
+        std::deque<Ciphertext> zeros_{};
+
+        // Encryptions of zero being computed by the background threads
+        std::size_t pending_count_ = 0;
+
+        std::size_t miss_count_ = 0;
+
+        std::exception_ptr error_{};
+
+        bool stop_ = false;
+
+        std::vector<std::thread> workers_{};
+    };
+} // namespace seal
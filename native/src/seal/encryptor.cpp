@@ -2,10 +2,12 @@
 // Licensed under the MIT license.
 
 #include "seal/encryptor.h"
+#include "seal/encryptionzeropool.h"
 #include "seal/modulus.h"
 #include "seal/randomtostd.h"
 #include "seal/util/common.h"
 #include "seal/util/iterator.h"
+#include "seal/util/parallel.h"
 #include "seal/util/polyarithsmallmod.h"
 #include "seal/util/rlwe.h"
 #include "seal/util/scalingvariant.h"
@@ -85,6 +87,29 @@ namespace seal
         }
     }
 
+    void Encryptor::set_zero_pool(shared_ptr<EncryptionZeroPool> zero_pool)
+    {
+        if (!zero_pool)
+        {
+            zero_pool_.reset();
+            return;
+        }
+        if (!is_metadata_valid_for(public_key_, context_))
+        {
+            throw logic_error("public key is not set");
+        }
+
+        // The pool must encrypt under this public key
+        auto &pool_key = zero_pool->public_key().data();
+        auto &key = public_key_.data();
+        if (pool_key.parms_id() != key.parms_id() || pool_key.dyn_array().size() != key.dyn_array().size() ||
+            !equal(key.dyn_array().cbegin(), key.dyn_array().cend(), pool_key.dyn_array().cbegin()))
+        {
+            throw invalid_argument("zero_pool does not match the public key");
+        }
+        zero_pool_ = move(zero_pool);
+    }
+
     void Encryptor::encrypt_zero_internal(
         parms_id_type parms_id, bool is_asymmetric, bool save_seed, Ciphertext &destination,
         MemoryPoolHandle pool) const
@@ -103,8 +128,6 @@ namespace seal
 
         auto &context_data = *context_.get_context_data(parms_id);
         auto &parms = context_data.parms();
-        size_t coeff_modulus_size = parms.coeff_modulus().size();
-        size_t coeff_count = parms.poly_modulus_degree();
         bool is_ntt_form = false;
 
         if (parms.scheme() == scheme_type::ckks)
@@ -116,25 +139,62 @@ namespace seal
             throw invalid_argument("unsupported scheme");
         }
 
+        // A precomputed encryption of zero replaces the whole computation
+        if (is_asymmetric && zero_pool_ && zero_pool_->parms_id() == parms_id)
+        {
+            zero_pool_->take(destination);
+            return;
+        }
+
         // Resize destination and save results
         destination.resize(context_, parms_id, 2);
 
         // If asymmetric key encryption
         if (is_asymmetric)
         {
-            auto prev_context_data_ptr = context_data.prev_context_data();
-            if (prev_context_data_ptr)
-            {
-                // Requires modulus switching
-                auto &prev_context_data = *prev_context_data_ptr;
-                auto &prev_parms_id = prev_context_data.parms_id();
-                auto rns_tool = prev_context_data.rns_tool();
+            encrypt_zero_asymmetric_internal(parms_id, parms.random_generator()->create(), &destination, 1, pool);
+        }
+        else
+        {
+            // Does not require modulus switching
+            util::encrypt_zero_symmetric(secret_key_, context_, parms_id, is_ntt_form, save_seed, destination);
+        }
+    }
 
-                // Zero encryption without modulus switching
-                Ciphertext temp(pool);
-                util::encrypt_zero_asymmetric(public_key_, context_, prev_parms_id, is_ntt_form, temp);
+    void Encryptor::encrypt_zero_asymmetric_internal(
+        parms_id_type parms_id, shared_ptr<UniformRandomGenerator> prng, Ciphertext *destinations, size_t count,
+        MemoryPoolHandle pool) const
+    {
+        auto &context_data = *context_.get_context_data(parms_id);
+        auto &parms = context_data.parms();
+        size_t coeff_modulus_size = parms.coeff_modulus().size();
+        size_t coeff_count = parms.poly_modulus_degree();
+        bool is_ntt_form = parms.scheme() == scheme_type::ckks;
+
+        auto prev_context_data_ptr = context_data.prev_context_data();
+        if (prev_context_data_ptr)
+        {
+            // Requires modulus switching
+            auto &prev_context_data = *prev_context_data_ptr;
+            auto &prev_parms_id = prev_context_data.parms_id();
+            auto rns_tool = prev_context_data.rns_tool();
+
+            // Zero encryptions without modulus switching
+            vector<Ciphertext> temps;
+            temps.reserve(count);
+            for (size_t k = 0; k < count; k++)
+            {
+                temps.emplace_back(pool);
+            }
+            util::encrypt_zero_asymmetric_many(
+                public_key_, context_, prev_parms_id, is_ntt_form, move(prng), temps.data(), count);
 
-                // Modulus switching
+            // Modulus switching
+            for (size_t k = 0; k < count; k++)
+            {
+                Ciphertext &temp = temps[k];
+                Ciphertext &destination = destinations[k];
+                destination.resize(context_, parms_id, temp.size());
                 SEAL_ITERATE(iter(temp, destination), temp.size(), [&](auto I) {
                     if (is_ntt_form)
                     {
@@ -152,16 +212,12 @@ namespace seal
                 destination.scale() = temp.scale();
                 destination.parms_id() = parms_id;
             }
-            else
-            {
-                // Does not require modulus switching
-                util::encrypt_zero_asymmetric(public_key_, context_, parms_id, is_ntt_form, destination);
-            }
         }
         else
         {
             // Does not require modulus switching
-            util::encrypt_zero_symmetric(secret_key_, context_, parms_id, is_ntt_form, save_seed, destination);
+            util::encrypt_zero_asymmetric_many(
+                public_key_, context_, parms_id, is_ntt_form, move(prng), destinations, count);
         }
     }
 
@@ -185,6 +241,79 @@ namespace seal
             }
         }
 
+        encrypt_zero_internal(verify_plain(plain), is_asymmetric, save_seed, destination, pool);
+        add_plain_internal(plain, destination);
+    }
+
+    void Encryptor::encrypt_many(
+        const vector<Plaintext> &plains, vector<Ciphertext> &destinations, MemoryPoolHandle pool) const
+    {
+        // Minimal verification that the public key is set
+        if (!is_metadata_valid_for(public_key_, context_))
+        {
+            throw logic_error("public key is not set");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // Verify all plaintexts before any of them is encrypted
+        vector<parms_id_type> parms_ids;
+        parms_ids.reserve(plains.size());
+        for (const auto &plain : plains)
+        {
+            parms_ids.push_back(verify_plain(plain));
+        }
+
+        // Split the plaintexts into groups of consecutive ones at the same level. A group is small enough for its
+        // ternary polynomials to take about 8 MB, and for there to be a group for each thread.
+        constexpr size_t group_size_bound = 32;
+        constexpr size_t group_uint64_count_bound = size_t(1) << 20;
+        ThreadPool *thread_pool = get_thread_pool(context_, pool);
+        auto &key_parms = context_.key_context_data()->parms();
+        size_t poly_uint64_count = mul_safe(key_parms.poly_modulus_degree(), key_parms.coeff_modulus().size());
+        size_t thread_count = thread_pool ? thread_pool->thread_count() : size_t(1);
+        size_t group_size_max = min(
+            { group_size_bound, group_uint64_count_bound / poly_uint64_count,
+              divide_round_up(plains.size(), thread_count) });
+        group_size_max = max(group_size_max, size_t(1));
+
+        vector<pair<size_t, size_t>> groups;
+        for (size_t begin = 0; begin < plains.size();)
+        {
+            size_t end = begin + 1;
+            while (end < plains.size() && end - begin < group_size_max && parms_ids[end] == parms_ids[begin])
+            {
+                end++;
+            }
+            groups.emplace_back(begin, end);
+            begin = end;
+        }
+
+        // Allocate the destinations here, since their pools need not be thread-safe even if pool is
+        destinations.resize(plains.size());
+        for (size_t k = 0; k < plains.size(); k++)
+        {
+            destinations[k].resize(context_, parms_ids[k], public_key_.data().size());
+        }
+
+        // Each group draws all of its randomness from one PRNG
+        parallel_for_each(thread_pool, groups.size(), [&](size_t index) {
+            size_t begin = groups[index].first;
+            size_t end = groups[index].second;
+            auto prng = context_.get_context_data(parms_ids[begin])->parms().random_generator()->create();
+            encrypt_zero_asymmetric_internal(
+                parms_ids[begin], move(prng), destinations.data() + begin, end - begin, pool);
+            for (size_t k = begin; k < end; k++)
+            {
+                add_plain_internal(plains[k], destinations[k]);
+            }
+        });
+    }
+
+    parms_id_type Encryptor::verify_plain(const Plaintext &plain) const
+    {
         // Verify that plain is valid.
         if (!is_metadata_valid_for(plain, context_) || !is_buffer_valid(plain))
         {
@@ -198,12 +327,7 @@ namespace seal
             {
                 throw invalid_argument("plain cannot be in NTT form");
             }
-
-            encrypt_zero_internal(context_.first_parms_id(), is_asymmetric, save_seed, destination, pool);
-
-            // Multiply plain by scalar coeff_div_plaintext and reposition if in upper-half.
-            // Result gets added into the c_0 term of ciphertext (c_0,c_1).
-            multiply_add_plain_with_scaling_variant(plain, *context_.first_context_data(), *iter(destination));
+            return context_.first_parms_id();
         }
         else if (scheme == scheme_type::ckks)
         {
@@ -217,8 +341,25 @@ namespace seal
             {
                 throw invalid_argument("plain is not valid for encryption parameters");
             }
-            encrypt_zero_internal(plain.parms_id(), is_asymmetric, save_seed, destination, pool);
+            return plain.parms_id();
+        }
+        else
+        {
+            throw invalid_argument("unsupported scheme");
+        }
+    }
 
+    void Encryptor::add_plain_internal(const Plaintext &plain, Ciphertext &destination) const
+    {
+        auto scheme = context_.key_context_data()->parms().scheme();
+        if (scheme == scheme_type::bfv)
+        {
+            // Multiply plain by scalar coeff_div_plaintext and reposition if in upper-half.
+            // Result gets added into the c_0 term of ciphertext (c_0,c_1).
+            multiply_add_plain_with_scaling_variant(plain, *context_.first_context_data(), *iter(destination));
+        }
+        else
+        {
             auto &parms = context_.get_context_data(plain.parms_id())->parms();
             auto &coeff_modulus = parms.coeff_modulus();
             size_t coeff_modulus_size = coeff_modulus.size();
@@ -231,9 +372,5 @@ namespace seal
 
             destination.scale() = plain.scale();
         }
-        else
-        {
-            throw invalid_argument("unsupported scheme");
-        }
     }
 } // namespace seal
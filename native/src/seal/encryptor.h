@@ -13,10 +13,13 @@
 #include "seal/serializable.h"
 #include "seal/util/defines.h"
 #include "seal/util/ntt.h"
+#include <memory>
 #include <vector>
 
 namespace seal
 {
+    class EncryptionZeroPool;
+
     /**
     Encrypts Plaintext objects into Ciphertext objects. Constructing an Encryptor
     requires a SEALContext with valid encryption parameters, the public key and/or
@@ -82,7 +85,7 @@ namespace seal
         Encryptor(const SEALContext &context, const PublicKey &public_key, const SecretKey &secret_key);
 
         /**
-        Give a new instance of public key.
+        Give a new instance of public key. Detaches any EncryptionZeroPool set with set_zero_pool.
 
         @param[in] public_key The public key
         @throws std::invalid_argument if public_key is not valid
@@ -94,6 +97,28 @@ namespace seal
                 throw std::invalid_argument("public key is not valid for encryption parameters");
             }
             public_key_ = public_key;
+            zero_pool_.reset();
+        }
+
+        /**
+        Attaches an EncryptionZeroPool holding precomputed encryptions of zero under the public key. Public-key
+        encryptions at the level of the pool then take an encryption of zero from the pool instead of computing one,
+        so that only the plaintext remains to be added. Encryptions at other levels and encrypt_many are not
+        affected. Passing nullptr detaches the current EncryptionZeroPool.
+
+        @param[in] zero_pool The EncryptionZeroPool, or nullptr
+        @throws std::logic_error if a public key is not set
+        @throws std::invalid_argument if zero_pool was created with different encryption parameters or a different
+        public key
+        */
+        void set_zero_pool(std::shared_ptr<EncryptionZeroPool> zero_pool);
+
+        /**
+        Returns the EncryptionZeroPool set with set_zero_pool, or nullptr if there is none.
+        */
+        SEAL_NODISCARD inline const std::shared_ptr<EncryptionZeroPool> &zero_pool() const noexcept
+        {
+            return zero_pool_;
         }
 
         /**
@@ -163,6 +188,31 @@ namespace seal
             return destination;
         }
 
+        /**
+        Encrypts many plaintexts with the public key and stores the results in
+        destinations, which is resized to the number of plaintexts. The result
+        is the same as calling encrypt for each plaintext, but consecutive
+        plaintexts at the same level are encrypted in groups that share one
+        PRNG and scratch buffers and whose NTTs are done one RNS component at a
+        time. If the SEALContext has a ThreadPool and pool is thread-safe, the
+        groups are encrypted in parallel. Dynamic memory allocations in the
+        process are allocated from the memory pool pointed to by the given
+        MemoryPoolHandle.
+
+        @param[in] plains The plaintexts to encrypt
+        @param[out] destinations The ciphertexts to overwrite with the encrypted
+        plaintexts
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if a public key is not set
+        @throws std::invalid_argument if any of plains is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if any of plains is not in default NTT form
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void encrypt_many(
+            const std::vector<Plaintext> &plains, std::vector<Ciphertext> &destinations,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
         /**
         Encrypts a zero plaintext with the public key and stores the result in
         destination.
@@ -419,14 +469,24 @@ namespace seal
             parms_id_type parms_id, bool is_asymmetric, bool save_seed, Ciphertext &destination,
             MemoryPoolHandle pool = MemoryManager::GetPool()) const;
 
+        void encrypt_zero_asymmetric_internal(
+            parms_id_type parms_id, std::shared_ptr<UniformRandomGenerator> prng, Ciphertext *destinations,
+            std::size_t count, MemoryPoolHandle pool) const;
+
         void encrypt_internal(
             const Plaintext &plain, bool is_asymmetric, bool save_seed, Ciphertext &destination,
             MemoryPoolHandle pool = MemoryManager::GetPool()) const;
 
+        parms_id_type verify_plain(const Plaintext &plain) const;
+
+        void add_plain_internal(const Plaintext &plain, Ciphertext &destination) const;
+
         SEALContext context_;
 
         PublicKey public_key_;
 
         SecretKey secret_key_;
+
+        std::shared_ptr<EncryptionZeroPool> zero_pool_{};
     };
 } // namespace seal
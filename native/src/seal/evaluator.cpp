@@ -5,6 +5,7 @@
 #include "seal/util/common.h"
 #include "seal/util/galois.h"
 #include "seal/util/numth.h"
+#include "seal/util/parallel.h"
 #include "seal/util/polyarithsmallmod.h"
 #include "seal/util/polycore.h"
 #include "seal/util/scalingvariant.h"
@@ -45,8 +46,173 @@ namespace seal
 
             return !(scale <= 0 || (static_cast<int>(log2(scale)) >= scale_bit_count_bound));
         }
+
+        /**
+        Behaves like SEAL_ITERATE(iter, count, kernel), but distributes the iterations across thread_pool unless it is
+        nullptr.
+        */
+        template <typename IterT, typename KernelT>
+        inline void parallel_iterate(ThreadPool *thread_pool, IterT iter, size_t count, KernelT &&kernel)
+        {
+            parallel_for_each(thread_pool, count, [&](size_t i) { kernel(iter[i]); });
+        }
+
+        /**
+        Returns true if the dyadic products of NTT-form data modulo modulus use Montgomery reduction. Moduli of at most
+        small_modulus_bit_count_max bits keep the single-word Barrett reduction of dyadic_product_coeffmod, which needs
+        no operand in Montgomery form.
+        */
+        SEAL_NODISCARD inline bool use_montgomery(const SEALContext &context, const Modulus &modulus) noexcept
+        {
+            return context.mod_arith() == mod_arith_type::montgomery &&
+                   modulus.bit_count() > small_modulus_bit_count_max;
+        }
+
+        /**
+        Writes operand to result in the form dyadic_product_prepared expects for its second operand: in Montgomery form
+        for the RNS components where use_montgomery holds, and unchanged otherwise. Converting an operand once lets all
+        products that share it use the Montgomery kernel, which is cheaper than Barrett reduction of 128-bit products.
+        */
+        void prepare_dyadic_operand(
+            const SEALContext &context, ConstRNSIter operand, size_t coeff_modulus_size, ConstModulusIter modulus,
+            RNSIter result)
+        {
+            size_t coeff_count = result.poly_modulus_degree();
+            SEAL_ITERATE(iter(operand, modulus, result), coeff_modulus_size, [&](auto I) {
+                if (use_montgomery(context, get<1>(I)))
+                {
+                    to_montgomery_coeffmod(get<0>(I), coeff_count, get<1>(I), get<2>(I));
+                }
+                else
+                {
+                    set_uint(get<0>(I), coeff_count, get<2>(I));
+                }
+            });
+        }
+
+        /**
+        Computes the dyadic product of operand1 and prepared_operand2, which must be prepared for modulus as by
+        prepare_dyadic_operand. The result is in normal form and fully reduced.
+        */
+        inline void dyadic_product_prepared(
+            const SEALContext &context, ConstCoeffIter operand1, ConstCoeffIter prepared_operand2, size_t coeff_count,
+            const Modulus &modulus, CoeffIter result)
+        {
+            if (use_montgomery(context, modulus))
+            {
+                dyadic_product_montgomery_coeffmod(operand1, prepared_operand2, coeff_count, modulus, result);
+            }
+            else
+            {
+                dyadic_product_coeffmod(operand1, prepared_operand2, coeff_count, modulus, result);
+            }
+        }
+
+        inline void dyadic_product_prepared(
+            const SEALContext &context, ConstRNSIter operand1, ConstRNSIter prepared_operand2,
+            size_t coeff_modulus_size, ConstModulusIter modulus, RNSIter result)
+        {
+            size_t coeff_count = result.poly_modulus_degree();
+            SEAL_ITERATE(iter(operand1, prepared_operand2, modulus, result), coeff_modulus_size, [&](auto I) {
+                dyadic_product_prepared(context, get<0>(I), get<1>(I), coeff_count, get<2>(I), get<3>(I));
+            });
+        }
+
+        /**
+        Writes the keyswitching digit with the given index of target, extended to the primes of context_data followed
+        by the special primes, to destination in RNS-NTT form with lazy outputs in [0, 4q). The argument t_target holds
+        target in coefficient representation; if target is in NTT form, it is used directly for the primes of the
+        digit. The NTTs are distributed across thread_pool unless it is nullptr.
+        */
+        void get_kswitch_digit(
+            const SEALContext &context, const SEALContext::ContextData &context_data, ConstRNSIter target,
+            ConstRNSIter t_target, bool is_ntt_form, size_t digit_index, RNSIter destination, ThreadPool *thread_pool,
+            MemoryPoolHandle pool)
+        {
+            auto kswitch_tool = context_data.kswitch_tool();
+            auto &key_context_data = *context.key_context_data();
+            size_t key_modulus_size = key_context_data.parms().coeff_modulus().size();
+            auto key_ntt_tables = iter(key_context_data.small_ntt_tables());
+            size_t coeff_count = context_data.parms().poly_modulus_degree();
+            size_t decomp_modulus_size = context_data.parms().coeff_modulus().size();
+            size_t rns_modulus_size = decomp_modulus_size + context.special_prime_count();
+            size_t digit_begin = digit_index * kswitch_tool->digit_size();
+            size_t digit_end = min(digit_begin + kswitch_tool->digit_size(), decomp_modulus_size);
+
+            kswitch_tool->extend_digit(digit_index, t_target, destination, pool);
+            parallel_for_each(thread_pool, rns_modulus_size, [&](size_t index) {
+                if (is_ntt_form && index >= digit_begin && index < digit_end)
+                {
+                    // RNS-NTT form exists in input
+                    set_uint(target[index], coeff_count, destination[index]);
+                    return;
+                }
+
+                // NTT conversion lazy outputs in [0, 4q)
+                size_t key_index =
+                    (index < decomp_modulus_size ? index : key_modulus_size - rns_modulus_size + index);
+                ntt_negacyclic_harvey_lazy(destination[index], key_ntt_tables[key_index]);
+            });
+        }
+
+        // Returns the byte count of the temporaries of key switching and of multiplication of ciphertexts of size two
+        // at the first data level, whichever is larger
+        SEAL_NODISCARD size_t workspace_byte_count(const SEALContext &context)
+        {
+            auto &context_data = *context.first_context_data();
+            auto &parms = context_data.parms();
+            size_t coeff_count = parms.poly_modulus_degree();
+            size_t base_q_size = parms.coeff_modulus().size();
+            size_t rns_modulus_size = base_q_size + context.special_prime_count();
+
+            // Key switching: the target and the conversion from the special primes in base q, two lazy accumulators of
+            // 128-bit coefficients and the product in the extended basis, and a digit and its extension
+            size_t word_count = mul_safe(coeff_count, add_safe(mul_safe(base_q_size, size_t(2)), rns_modulus_size * 8));
+
+            if (parms.scheme() == scheme_type::bfv)
+            {
+                // BEHZ multiplication: both inputs and the product of size three in bases q and Bsk, and the
+                // conversion temporaries
+                auto rns_tool = context_data.rns_tool();
+                size_t base_Bsk_size = rns_tool->base_Bsk()->size();
+                size_t base_Bsk_m_tilde_size = rns_tool->base_Bsk_m_tilde()->size();
+                size_t behz_word_count = mul_safe(
+                    coeff_count, add_safe(base_q_size * 8, base_Bsk_size * 9, base_Bsk_m_tilde_size));
+                word_count = max(word_count, behz_word_count);
+            }
+            return mul_safe(word_count, sizeof(uint64_t));
+        }
+
+        // Stores results in destinations, resized to the number of results. Ciphertexts already in destinations are
+        // assigned to rather than replaced, so that views keep writing to the buffers of the caller.
+        void assign_results(vector<Ciphertext> &results, vector<Ciphertext> &destinations)
+        {
+            size_t assign_count = min(results.size(), destinations.size());
+            destinations.resize(results.size());
+            for (size_t i = 0; i < results.size(); i++)
+            {
+                if (i < assign_count)
+                {
+                    destinations[i] = results[i];
+                }
+                else
+                {
+                    destinations[i] = move(results[i]);
+                }
+            }
+        }
     } // namespace
 
+    EvaluatorWorkspace::EvaluatorWorkspace(const SEALContext &context, bool clear_on_destruction)
+    {
+        // Verify parameters
+        if (!context.parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+        pool_ = MemoryPoolHandle::Arena(workspace_byte_count(context), clear_on_destruction);
+    }
+
     Evaluator::Evaluator(const SEALContext &context) : context_(context)
     {
         // Verify parameters
@@ -325,20 +491,22 @@ namespace seal
         // Resize encrypted1 to destination size
         encrypted1.resize(context_, context_data.parms_id(), dest_size);
 
+        // The steps below are distributed across the ThreadPool of the context, if any, one polynomial or one RNS
+        // component at a time
+        ThreadPool *thread_pool = get_thread_pool(context_, pool);
+
         // This lambda function takes as input an IterTuple with three components:
         //
         // 1. (Const)RNSIter to read an input polynomial from
         // 2. RNSIter for the output in base q
         // 3. RNSIter for the output in base Bsk
         //
-        // It performs steps (1)-(3) of the BEHZ multiplication (see above) on the given input polynomial (given as an
-        // RNSIter or ConstRNSIter) and writes the results in base q and base Bsk to the given output
-        // iterators.
-        auto behz_extend_base_convert_to_ntt = [&](auto I) {
-            // Make copy of input polynomial (in base q) and convert to NTT form
-            // Lazy reduction
+        // It performs steps (1)-(2) of the BEHZ multiplication (see above) on the given input polynomial (given as an
+        // RNSIter or ConstRNSIter) and writes the results in base q and base Bsk to the given output iterators. Step
+        // (3) is then performed on all outputs at once.
+        auto behz_extend_base_convert = [&](auto I) {
+            // Make copy of input polynomial (in base q)
             set_poly(get<0>(I), coeff_count, base_q_size, get<1>(I));
-            ntt_negacyclic_harvey_lazy(get<1>(I), base_q_size, base_q_ntt_tables);
 
             // Allocate temporary space for a polynomial in the Bsk U {m_tilde} base
             SEAL_ALLOCATE_GET_RNS_ITER(temp, coeff_count, base_Bsk_m_tilde_size, pool);
@@ -348,34 +516,47 @@ namespace seal
 
             // (2) Reduce q-overflows in with Montgomery reduction, switching base to Bsk
             rns_tool->sm_mrq(temp, get<2>(I), pool);
-
-            // Transform to NTT form in base Bsk
-            // Lazy reduction
-            ntt_negacyclic_harvey_lazy(get<2>(I), base_Bsk_size, base_Bsk_ntt_tables);
         };
 
-        // Allocate space for a base q output of behz_extend_base_convert_to_ntt for encrypted1
+        // Allocate space for the base q and base Bsk outputs of behz_extend_base_convert for encrypted1
         SEAL_ALLOCATE_GET_POLY_ITER(encrypted1_q, encrypted1_size, coeff_count, base_q_size, pool);
-
-        // Allocate space for a base Bsk output of behz_extend_base_convert_to_ntt for encrypted1
         SEAL_ALLOCATE_GET_POLY_ITER(encrypted1_Bsk, encrypted1_size, coeff_count, base_Bsk_size, pool);
 
-        // Perform BEHZ steps (1)-(3) for encrypted1
-        SEAL_ITERATE(iter(encrypted1, encrypted1_q, encrypted1_Bsk), encrypted1_size, behz_extend_base_convert_to_ntt);
-
         // Repeat for encrypted2
         SEAL_ALLOCATE_GET_POLY_ITER(encrypted2_q, encrypted2_size, coeff_count, base_q_size, pool);
         SEAL_ALLOCATE_GET_POLY_ITER(encrypted2_Bsk, encrypted2_size, coeff_count, base_Bsk_size, pool);
 
-        SEAL_ITERATE(iter(encrypted2, encrypted2_q, encrypted2_Bsk), encrypted2_size, behz_extend_base_convert_to_ntt);
+        // Perform BEHZ steps (1)-(2) for encrypted1 and encrypted2
+        parallel_for_each(thread_pool, encrypted1_size + encrypted2_size, [&](size_t index) {
+            if (index < encrypted1_size)
+            {
+                behz_extend_base_convert(iter(encrypted1, encrypted1_q, encrypted1_Bsk)[index]);
+            }
+            else
+            {
+                behz_extend_base_convert(iter(encrypted2, encrypted2_q, encrypted2_Bsk)[index - encrypted1_size]);
+            }
+        });
+
+        // Perform BEHZ step (3): transform to NTT form in base q and base Bsk
+        // Lazy reduction
+        ntt_negacyclic_harvey_lazy(encrypted1_q, encrypted1_size, base_q_ntt_tables, thread_pool);
+        ntt_negacyclic_harvey_lazy(encrypted1_Bsk, encrypted1_size, base_Bsk_ntt_tables, thread_pool);
+        ntt_negacyclic_harvey_lazy(encrypted2_q, encrypted2_size, base_q_ntt_tables, thread_pool);
+        ntt_negacyclic_harvey_lazy(encrypted2_Bsk, encrypted2_size, base_Bsk_ntt_tables, thread_pool);
 
         // Allocate temporary space for the output of step (4)
         // We allocate space separately for the base q and the base Bsk components
         SEAL_ALLOCATE_ZERO_GET_POLY_ITER(temp_dest_q, dest_size, coeff_count, base_q_size, pool);
         SEAL_ALLOCATE_ZERO_GET_POLY_ITER(temp_dest_Bsk, dest_size, coeff_count, base_Bsk_size, pool);
 
-        // Perform BEHZ step (4): dyadic multiplication on arbitrary size ciphertexts
-        SEAL_ITERATE(iter(size_t(0)), dest_size, [&](auto I) {
+        // Perform BEHZ step (4): dyadic multiplication on arbitrary size ciphertexts, one output polynomial and one
+        // RNS component of base q U Bsk at a time
+        size_t base_q_Bsk_size = base_q_size + base_Bsk_size;
+        parallel_for_each(thread_pool, dest_size * base_q_Bsk_size, [&](size_t index) {
+            size_t I = index / base_q_Bsk_size;
+            size_t component = index % base_q_Bsk_size;
+
             // We iterate over relevant components of encrypted1 and encrypted2 in increasing order for
             // encrypted1 and reversed (decreasing) order for encrypted2. The bounds for the indices of
             // the relevant terms are obtained as follows.
@@ -387,17 +568,18 @@ namespace seal
             // The total number of dyadic products is now easy to compute
             size_t steps = curr_encrypted1_last - curr_encrypted1_first + 1;
 
-            // This lambda function computes the ciphertext product for BFV multiplication. Since we use the BEHZ
-            // approach, the multiplication of individual polynomials is done using a dyadic product where the inputs
-            // are already in NTT form. The arguments of the lambda function are expected to be as follows:
+            // This lambda function computes the ciphertext product for BFV multiplication in a single RNS component.
+            // Since we use the BEHZ approach, the multiplication of individual polynomials is done using a dyadic
+            // product where the inputs are already in NTT form. The arguments of the lambda function are expected to
+            // be as follows:
             //
             // 1. a ConstPolyIter pointing to the beginning of the first input ciphertext (in NTT form)
             // 2. a ConstPolyIter pointing to the beginning of the second input ciphertext (in NTT form)
-            // 3. a ConstModulusIter pointing to an array of Modulus elements for the base
-            // 4. the size of the base
+            // 3. the index of the RNS component in the base
+            // 4. the Modulus of the RNS component
             // 5. a PolyIter pointing to the beginning of the output ciphertext
-            auto behz_ciphertext_product = [&](ConstPolyIter in1_iter, ConstPolyIter in2_iter,
-                                               ConstModulusIter base_iter, size_t base_size, PolyIter out_iter) {
+            auto behz_ciphertext_product = [&](ConstPolyIter in1_iter, ConstPolyIter in2_iter, size_t j,
+                                               const Modulus &modulus, PolyIter out_iter) {
                 // Create a shifted iterator for the first input
                 auto shifted_in1_iter = in1_iter + curr_encrypted1_first;
 
@@ -405,29 +587,34 @@ namespace seal
                 auto shifted_reversed_in2_iter = reverse_iter(in2_iter + curr_encrypted2_first);
 
                 // Create a shifted iterator for the output
-                auto shifted_out_iter = out_iter[I];
+                CoeffIter shifted_out_iter = out_iter[I][j];
 
+                SEAL_ALLOCATE_GET_COEFF_ITER(temp, coeff_count, pool);
                 SEAL_ITERATE(iter(shifted_in1_iter, shifted_reversed_in2_iter), steps, [&](auto J) {
-                    SEAL_ITERATE(iter(J, base_iter, shifted_out_iter), base_size, [&](auto K) {
-                        SEAL_ALLOCATE_GET_COEFF_ITER(temp, coeff_count, pool);
-                        dyadic_product_coeffmod(get<0, 0>(K), get<0, 1>(K), coeff_count, get<1>(K), temp);
-                        add_poly_coeffmod(temp, get<2>(K), coeff_count, get<1>(K), get<2>(K));
-                    });
+                    dyadic_product_coeffmod(get<0>(J)[j], get<1>(J)[j], coeff_count, modulus, temp);
+                    add_poly_coeffmod(temp, shifted_out_iter, coeff_count, modulus, shifted_out_iter);
                 });
             };
 
-            // Perform the BEHZ ciphertext product both for base q and base Bsk
-            behz_ciphertext_product(encrypted1_q, encrypted2_q, base_q, base_q_size, temp_dest_q);
-            behz_ciphertext_product(encrypted1_Bsk, encrypted2_Bsk, base_Bsk, base_Bsk_size, temp_dest_Bsk);
+            // Perform the BEHZ ciphertext product either for base q or base Bsk
+            if (component < base_q_size)
+            {
+                behz_ciphertext_product(encrypted1_q, encrypted2_q, component, base_q[component], temp_dest_q);
+            }
+            else
+            {
+                size_t j = component - base_q_size;
+                behz_ciphertext_product(encrypted1_Bsk, encrypted2_Bsk, j, base_Bsk[j], temp_dest_Bsk);
+            }
         });
 
         // Perform BEHZ step (5): transform data from NTT form
         // Lazy reduction here. The following multiply_poly_scalar_coeffmod will correct the value back to [0, p)
-        inverse_ntt_negacyclic_harvey_lazy(temp_dest_q, dest_size, base_q_ntt_tables);
-        inverse_ntt_negacyclic_harvey_lazy(temp_dest_Bsk, dest_size, base_Bsk_ntt_tables);
+        inverse_ntt_negacyclic_harvey_lazy(temp_dest_q, dest_size, base_q_ntt_tables, thread_pool);
+        inverse_ntt_negacyclic_harvey_lazy(temp_dest_Bsk, dest_size, base_Bsk_ntt_tables, thread_pool);
 
         // Perform BEHZ steps (6)-(8)
-        SEAL_ITERATE(iter(temp_dest_q, temp_dest_Bsk, encrypted1), dest_size, [&](auto I) {
+        parallel_iterate(thread_pool, iter(temp_dest_q, temp_dest_Bsk, encrypted1), dest_size, [&](auto I) {
             // Bring together the base q and base Bsk components into a single allocation
             SEAL_ALLOCATE_GET_RNS_ITER(temp_q_Bsk, coeff_count, base_q_size + base_Bsk_size, pool);
 
@@ -491,6 +678,9 @@ namespace seal
         PolyIter encrypted1_iter = iter(encrypted1);
         ConstPolyIter encrypted2_iter = iter(encrypted2);
 
+        // Dyadic products with Montgomery reduction take their operands from encrypted2 in Montgomery form
+        bool montgomery = context_.mod_arith() == mod_arith_type::montgomery;
+
         if (dest_size == 3)
         {
             // We want to keep six polynomials in the L1 cache: x[0], x[1], x[2], y[0], y[1], temp.
@@ -507,40 +697,59 @@ namespace seal
             }
 #endif
 
-            // Semantic misuse of RNSIter; each is really pointing to the data for each RNS factor in sequence
-            ConstRNSIter encrypted2_0_iter(*encrypted2_iter[0], tile_size);
-            ConstRNSIter encrypted2_1_iter(*encrypted2_iter[1], tile_size);
-            RNSIter encrypted1_0_iter(*encrypted1_iter[0], tile_size);
-            RNSIter encrypted1_1_iter(*encrypted1_iter[1], tile_size);
-            RNSIter encrypted1_2_iter(*encrypted1_iter[2], tile_size);
-
-            // Temporary buffer to store intermediate results
-            SEAL_ALLOCATE_GET_COEFF_ITER(temp, tile_size, pool);
-
-            // Computes the output tile_size coefficients at a time
+            // Computes the output tile_size coefficients at a time, one RNS component after another, or distributed
+            // across the ThreadPool of the context, if any
             // Given input tuples of polynomials x = (x[0], x[1], x[2]), y = (y[0], y[1]), computes
             // x = (x[0] * y[0], x[0] * y[1] + x[1] * y[0], x[1] * y[1])
             // with appropriate modular reduction
-            SEAL_ITERATE(coeff_modulus, coeff_modulus_size, [&](auto I) {
+            ThreadPool *thread_pool = get_thread_pool(context_, pool);
+            parallel_iterate(thread_pool, iter(coeff_modulus, seq_iter(0)), coeff_modulus_size, [&](auto I) {
+                const Modulus &modulus = get<0>(I);
+
+                // Semantic misuse of RNSIter; each is really pointing to the data for each RNS factor in sequence
+                size_t offset = get<1>(I) * coeff_count;
+                ConstRNSIter encrypted2_0_iter(*encrypted2_iter[0] + offset, tile_size);
+                ConstRNSIter encrypted2_1_iter(*encrypted2_iter[1] + offset, tile_size);
+                RNSIter encrypted1_0_iter(*encrypted1_iter[0] + offset, tile_size);
+                RNSIter encrypted1_1_iter(*encrypted1_iter[1] + offset, tile_size);
+                RNSIter encrypted1_2_iter(*encrypted1_iter[2] + offset, tile_size);
+
+                // Temporary buffer to store intermediate results
+                SEAL_ALLOCATE_GET_COEFF_ITER(temp, tile_size, pool);
+
+                // Temporary buffers for the tiles of y[0] and y[1] prepared for the dyadic products
+                bool prepare_y = use_montgomery(context_, modulus);
+                SEAL_ALLOCATE_GET_RNS_ITER(prepared_y, tile_size, prepare_y ? 2 : 0, pool);
+
                 SEAL_ITERATE(iter(size_t(0)), num_tiles, [&](SEAL_MAYBE_UNUSED auto J) {
+                    ConstCoeffIter y0 = encrypted2_0_iter[0];
+                    ConstCoeffIter y1 = encrypted2_1_iter[0];
+                    if (prepare_y)
+                    {
+                        to_montgomery_coeffmod(y0, tile_size, modulus, prepared_y[0]);
+                        to_montgomery_coeffmod(y1, tile_size, modulus, prepared_y[1]);
+                        y0 = prepared_y[0];
+                        y1 = prepared_y[1];
+                    }
+
                     // Compute third output polynomial, overwriting input
                     // x[2] = x[1] * y[1]
-                    dyadic_product_coeffmod(
-                        encrypted1_1_iter[0], encrypted2_1_iter[0], tile_size, I, encrypted1_2_iter[0]);
+                    dyadic_product_prepared(
+                        context_, encrypted1_1_iter[0], y1, tile_size, modulus, encrypted1_2_iter[0]);
 
                     // Compute second output polynomial, overwriting input
                     // temp = x[1] * y[0]
-                    dyadic_product_coeffmod(encrypted1_1_iter[0], encrypted2_0_iter[0], tile_size, I, temp);
+                    dyadic_product_prepared(context_, encrypted1_1_iter[0], y0, tile_size, modulus, temp);
                     // x[1] = x[0] * y[1]
-                    dyadic_product_coeffmod(
-                        encrypted1_0_iter[0], encrypted2_1_iter[0], tile_size, I, encrypted1_1_iter[0]);
+                    dyadic_product_prepared(
+                        context_, encrypted1_0_iter[0], y1, tile_size, modulus, encrypted1_1_iter[0]);
                     // x[1] += temp
-                    add_poly_coeffmod(encrypted1_1_iter[0], temp, tile_size, I, encrypted1_1_iter[0]);
+                    add_poly_coeffmod(encrypted1_1_iter[0], temp, tile_size, modulus, encrypted1_1_iter[0]);
 
                     // Compute first output polynomial, overwriting input
                     // x[0] = x[0] * y[0]
-                    dyadic_product_coeffmod(
-                        encrypted1_0_iter[0], encrypted2_0_iter[0], tile_size, I, encrypted1_0_iter[0]);
+                    dyadic_product_prepared(
+                        context_, encrypted1_0_iter[0], y0, tile_size, modulus, encrypted1_0_iter[0]);
 
                     // Manually increment iterators
                     encrypted1_0_iter++;
@@ -556,6 +765,17 @@ namespace seal
             // Allocate temporary space for the result
             SEAL_ALLOCATE_ZERO_GET_POLY_ITER(temp, dest_size, coeff_count, coeff_modulus_size, pool);
 
+            // Prepare encrypted2 once, before encrypted1 (possibly the same ciphertext) changes
+            SEAL_ALLOCATE_GET_POLY_ITER(
+                prepared_encrypted2, montgomery ? encrypted2_size : 0, coeff_count, coeff_modulus_size, pool);
+            if (montgomery)
+            {
+                SEAL_ITERATE(iter(encrypted2_iter, prepared_encrypted2), encrypted2_size, [&](auto I) {
+                    prepare_dyadic_operand(context_, get<0>(I), coeff_modulus_size, coeff_modulus, get<1>(I));
+                });
+                encrypted2_iter = prepared_encrypted2;
+            }
+
             SEAL_ITERATE(iter(size_t(0)), dest_size, [&](auto I) {
                 // We iterate over relevant components of encrypted1 and encrypted2 in increasing order for
                 // encrypted1 and reversed (decreasing) order for encrypted2. The bounds for the indices of
@@ -579,7 +799,7 @@ namespace seal
                     // temp_iter must be dereferenced once to produce an appropriate RNSIter
                     SEAL_ITERATE(iter(J, coeff_modulus, temp[I]), coeff_modulus_size, [&](auto K) {
                         SEAL_ALLOCATE_GET_COEFF_ITER(prod, coeff_count, pool);
-                        dyadic_product_coeffmod(get<0, 0>(K), get<0, 1>(K), coeff_count, get<1>(K), prod);
+                        dyadic_product_prepared(context_, get<0, 0>(K), get<0, 1>(K), coeff_count, get<1>(K), prod);
                         add_poly_coeffmod(prod, get<2>(K), coeff_count, get<1>(K), get<2>(K));
                     });
                 });
@@ -680,19 +900,22 @@ namespace seal
         // Resize encrypted to destination size
         encrypted.resize(context_, context_data.parms_id(), dest_size);
 
+        // The steps below are distributed across the ThreadPool of the context, if any, one polynomial or one RNS
+        // component at a time
+        ThreadPool *thread_pool = get_thread_pool(context_, pool);
+
         // This lambda function takes as input an IterTuple with three components:
         //
         // 1. (Const)RNSIter to read an input polynomial from
         // 2. RNSIter for the output in base q
         // 3. RNSIter for the output in base Bsk
         //
-        // It performs steps (1)-(3) of the BEHZ multiplication on the given input polynomial (given as an RNSIter
-        // or ConstRNSIter) and writes the results in base q and base Bsk to the given output iterators.
-        auto behz_extend_base_convert_to_ntt = [&](auto I) {
-            // Make copy of input polynomial (in base q) and convert to NTT form
-            // Lazy reduction
+        // It performs steps (1)-(2) of the BEHZ multiplication on the given input polynomial (given as an RNSIter
+        // or ConstRNSIter) and writes the results in base q and base Bsk to the given output iterators. Step (3) is
+        // then performed on all outputs at once.
+        auto behz_extend_base_convert = [&](auto I) {
+            // Make copy of input polynomial (in base q)
             set_poly(get<0>(I), coeff_count, base_q_size, get<1>(I));
-            ntt_negacyclic_harvey_lazy(get<1>(I), base_q_size, base_q_ntt_tables);
 
             // Allocate temporary space for a polynomial in the Bsk U {m_tilde} base
             SEAL_ALLOCATE_GET_RNS_ITER(temp, coeff_count, base_Bsk_m_tilde_size, pool);
@@ -702,20 +925,19 @@ namespace seal
 
             // (2) Reduce q-overflows in with Montgomery reduction, switching base to Bsk
             rns_tool->sm_mrq(temp, get<2>(I), pool);
-
-            // Transform to NTT form in base Bsk
-            // Lazy reduction
-            ntt_negacyclic_harvey_lazy(get<2>(I), base_Bsk_size, base_Bsk_ntt_tables);
         };
 
-        // Allocate space for a base q output of behz_extend_base_convert_to_ntt
+        // Allocate space for a base q output of behz_extend_base_convert
         SEAL_ALLOCATE_GET_POLY_ITER(encrypted_q, encrypted_size, coeff_count, base_q_size, pool);
 
-        // Allocate space for a base Bsk output of behz_extend_base_convert_to_ntt
+        // Allocate space for a base Bsk output of behz_extend_base_convert
         SEAL_ALLOCATE_GET_POLY_ITER(encrypted_Bsk, encrypted_size, coeff_count, base_Bsk_size, pool);
 
         // Perform BEHZ steps (1)-(3)
-        SEAL_ITERATE(iter(encrypted, encrypted_q, encrypted_Bsk), encrypted_size, behz_extend_base_convert_to_ntt);
+        parallel_iterate(
+            thread_pool, iter(encrypted, encrypted_q, encrypted_Bsk), encrypted_size, behz_extend_base_convert);
+        ntt_negacyclic_harvey_lazy(encrypted_q, encrypted_size, base_q_ntt_tables, thread_pool);
+        ntt_negacyclic_harvey_lazy(encrypted_Bsk, encrypted_size, base_Bsk_ntt_tables, thread_pool);
 
         // Allocate temporary space for the output of step (4)
         // We allocate space separately for the base q and the base Bsk components
@@ -724,37 +946,46 @@ namespace seal
 
         // Perform BEHZ step (4): dyadic Karatsuba-squaring on size-2 ciphertexts
 
-        // This lambda function computes the size-2 ciphertext square for BFV multiplication. Since we use the BEHZ
-        // approach, the multiplication of individual polynomials is done using a dyadic product where the inputs
-        // are already in NTT form. The arguments of the lambda function are expected to be as follows:
+        // This lambda function computes the size-2 ciphertext square for BFV multiplication in a single RNS component.
+        // Since we use the BEHZ approach, the multiplication of individual polynomials is done using a dyadic product
+        // where the inputs are already in NTT form. The arguments of the lambda function are expected to be as
+        // follows:
         //
         // 1. a ConstPolyIter pointing to the beginning of the input ciphertext (in NTT form)
-        // 3. a ConstModulusIter pointing to an array of Modulus elements for the base
-        // 4. the size of the base
-        // 5. a PolyIter pointing to the beginning of the output ciphertext
-        auto behz_ciphertext_square = [&](ConstPolyIter in_iter, ConstModulusIter base_iter, size_t base_size,
-                                          PolyIter out_iter) {
+        // 2. the index of the RNS component in the base
+        // 3. the Modulus of the RNS component
+        // 4. a PolyIter pointing to the beginning of the output ciphertext
+        auto behz_ciphertext_square = [&](ConstPolyIter in_iter, size_t j, const Modulus &modulus, PolyIter out_iter) {
             // Compute c0^2
-            dyadic_product_coeffmod(in_iter[0], in_iter[0], base_size, base_iter, out_iter[0]);
+            dyadic_product_coeffmod(in_iter[0][j], in_iter[0][j], coeff_count, modulus, out_iter[0][j]);
 
             // Compute 2*c0*c1
-            dyadic_product_coeffmod(in_iter[0], in_iter[1], base_size, base_iter, out_iter[1]);
-            add_poly_coeffmod(out_iter[1], out_iter[1], base_size, base_iter, out_iter[1]);
+            dyadic_product_coeffmod(in_iter[0][j], in_iter[1][j], coeff_count, modulus, out_iter[1][j]);
+            add_poly_coeffmod(out_iter[1][j], out_iter[1][j], coeff_count, modulus, out_iter[1][j]);
 
             // Compute c1^2
-            dyadic_product_coeffmod(in_iter[1], in_iter[1], base_size, base_iter, out_iter[2]);
+            dyadic_product_coeffmod(in_iter[1][j], in_iter[1][j], coeff_count, modulus, out_iter[2][j]);
         };
 
         // Perform the BEHZ ciphertext square both for base q and base Bsk
-        behz_ciphertext_square(encrypted_q, base_q, base_q_size, temp_dest_q);
-        behz_ciphertext_square(encrypted_Bsk, base_Bsk, base_Bsk_size, temp_dest_Bsk);
+        parallel_for_each(thread_pool, base_q_size + base_Bsk_size, [&](size_t component) {
+            if (component < base_q_size)
+            {
+                behz_ciphertext_square(encrypted_q, component, base_q[component], temp_dest_q);
+            }
+            else
+            {
+                size_t j = component - base_q_size;
+                behz_ciphertext_square(encrypted_Bsk, j, base_Bsk[j], temp_dest_Bsk);
+            }
+        });
 
         // Perform BEHZ step (5): transform data from NTT form
-        inverse_ntt_negacyclic_harvey(temp_dest_q, dest_size, base_q_ntt_tables);
-        inverse_ntt_negacyclic_harvey(temp_dest_Bsk, dest_size, base_Bsk_ntt_tables);
+        inverse_ntt_negacyclic_harvey(temp_dest_q, dest_size, base_q_ntt_tables, thread_pool);
+        inverse_ntt_negacyclic_harvey(temp_dest_Bsk, dest_size, base_Bsk_ntt_tables, thread_pool);
 
         // Perform BEHZ steps (6)-(8)
-        SEAL_ITERATE(iter(temp_dest_q, temp_dest_Bsk, encrypted), dest_size, [&](auto I) {
+        parallel_iterate(thread_pool, iter(temp_dest_q, temp_dest_Bsk, encrypted), dest_size, [&](auto I) {
             // Bring together the base q and base Bsk components into a single allocation
             SEAL_ALLOCATE_GET_RNS_ITER(temp_q_Bsk, coeff_count, base_q_size + base_Bsk_size, pool);
 
@@ -823,18 +1054,31 @@ namespace seal
         // Set up iterators for input ciphertext
         auto encrypted_iter = iter(encrypted);
 
+        // Dyadic products with Montgomery reduction take their second operands in Montgomery form
+        ConstPolyIter prepared_iter = encrypted_iter;
+        bool montgomery = context_.mod_arith() == mod_arith_type::montgomery;
+        SEAL_ALLOCATE_GET_POLY_ITER(
+            prepared_encrypted, montgomery ? encrypted_size : 0, coeff_count, coeff_modulus_size, pool);
+        if (montgomery)
+        {
+            SEAL_ITERATE(iter(encrypted_iter, prepared_encrypted), encrypted_size, [&](auto I) {
+                prepare_dyadic_operand(context_, get<0>(I), coeff_modulus_size, coeff_modulus, get<1>(I));
+            });
+            prepared_iter = prepared_encrypted;
+        }
+
         // Compute c1^2
-        dyadic_product_coeffmod(
-            encrypted_iter[1], encrypted_iter[1], coeff_modulus_size, coeff_modulus, encrypted_iter[2]);
+        dyadic_product_prepared(
+            context_, encrypted_iter[1], prepared_iter[1], coeff_modulus_size, coeff_modulus, encrypted_iter[2]);
 
         // Compute 2*c0*c1
-        dyadic_product_coeffmod(
-            encrypted_iter[0], encrypted_iter[1], coeff_modulus_size, coeff_modulus, encrypted_iter[1]);
+        dyadic_product_prepared(
+            context_, encrypted_iter[0], prepared_iter[1], coeff_modulus_size, coeff_modulus, encrypted_iter[1]);
         add_poly_coeffmod(encrypted_iter[1], encrypted_iter[1], coeff_modulus_size, coeff_modulus, encrypted_iter[1]);
 
         // Compute c0^2
-        dyadic_product_coeffmod(
-            encrypted_iter[0], encrypted_iter[0], coeff_modulus_size, coeff_modulus, encrypted_iter[0]);
+        dyadic_product_prepared(
+            context_, encrypted_iter[0], prepared_iter[0], coeff_modulus_size, coeff_modulus, encrypted_iter[0]);
 
         // Set the scale
         encrypted.scale() = new_scale;
@@ -1129,6 +1373,101 @@ namespace seal
         }
     }
 
+    void Evaluator::compact(const Ciphertext &encrypted, CompactCiphertext &destination, MemoryPoolHandle pool) const
+    {
+        // Truncating to b bits changes a coefficient by at most q/2^(b+1) plus rounding, which is below q/(32t) for c0
+        // and, with the factor n from the product with the ternary secret key, also for c1 * s. Together they stay well
+        // below q/(4t), so the result decrypts correctly as long as the invariant noise is less than q/(4t).
+        auto &context_data = *context_.last_context_data();
+        auto &parms = context_data.parms();
+        int plain_bit_count = parms.plain_modulus().bit_count();
+        int max_bit_count = min(context_data.total_coeff_modulus_bit_count(), bits_per_uint64);
+        int c0_bit_count = min(plain_bit_count + 4, max_bit_count);
+        int c1_bit_count = min(plain_bit_count + get_power_of_two(parms.poly_modulus_degree()) + 4, max_bit_count);
+        compact(encrypted, c0_bit_count, c1_bit_count, destination, move(pool));
+    }
+
+    void Evaluator::compact(
+        const Ciphertext &encrypted, int c0_bit_count, int c1_bit_count, CompactCiphertext &destination,
+        MemoryPoolHandle pool) const
+    {
+        // Verify parameters.
+        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (context_.key_context_data()->parms().scheme() != scheme_type::bfv)
+        {
+            throw invalid_argument("unsupported scheme");
+        }
+        if (encrypted.is_ntt_form())
+        {
+            throw invalid_argument("encrypted cannot be in NTT form");
+        }
+        if (encrypted.size() != 2)
+        {
+            throw invalid_argument("encrypted must have size 2");
+        }
+        if (c0_bit_count < 1 || c0_bit_count > bits_per_uint64 || c1_bit_count < 1 || c1_bit_count > bits_per_uint64)
+        {
+            throw invalid_argument("bit counts must be in the range [1, 64]");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // Switch to the lowest level first
+        Ciphertext encrypted_last(encrypted, pool);
+        mod_switch_to_inplace(encrypted_last, context_.last_parms_id(), pool);
+#ifdef SEAL_THROW_ON_TRANSPARENT_CIPHERTEXT
+        // Transparent ciphertext output is not allowed.
+        if (encrypted_last.is_transparent())
+        {
+            throw logic_error("result ciphertext is transparent");
+        }
+#endif
+
+        auto &context_data = *context_.get_context_data(encrypted_last.parms_id());
+        size_t coeff_count = context_data.parms().poly_modulus_degree();
+        size_t coeff_modulus_size = context_data.parms().coeff_modulus().size();
+        size_t wide_uint64_count = coeff_modulus_size + 1;
+        destination.resize(context_, encrypted_last.parms_id(), c0_bit_count, c1_bit_count);
+
+        // The total modulus q and floor(q/2) with one extra word to hold c * 2^bit_count
+        auto modulus(allocate_zero_uint(wide_uint64_count, pool));
+        set_uint(context_data.total_coeff_modulus(), coeff_modulus_size, modulus.get());
+        auto half_modulus(allocate_uint(wide_uint64_count, pool));
+        right_shift_uint(modulus.get(), 1, wide_uint64_count, half_modulus.get());
+
+        auto values(allocate_uint(mul_safe(coeff_count, coeff_modulus_size), pool));
+        auto compressed(allocate_uint(coeff_count, pool));
+        auto numerator(allocate_uint(wide_uint64_count, pool));
+        auto quotient(allocate_uint(wide_uint64_count, pool));
+        for (size_t poly_index = 0; poly_index < 2; poly_index++)
+        {
+            int bit_count = poly_index ? c1_bit_count : c0_bit_count;
+            uint64_t bit_mask =
+                (bit_count == bits_per_uint64) ? numeric_limits<uint64_t>::max() : (uint64_t(1) << bit_count) - 1;
+
+            // Compose the coefficients from their RNS representation
+            set_uint(encrypted_last.data(poly_index), coeff_count * coeff_modulus_size, values.get());
+            context_data.rns_tool()->base_q()->compose_array(values.get(), coeff_count, pool);
+
+            // Compute round(c * 2^bit_count / q) mod 2^bit_count for every coefficient c
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                set_uint(values.get() + i * coeff_modulus_size, coeff_modulus_size, numerator.get());
+                numerator[coeff_modulus_size] = 0;
+                left_shift_uint(numerator.get(), bit_count, wide_uint64_count, numerator.get());
+                add_uint(numerator.get(), half_modulus.get(), wide_uint64_count, numerator.get());
+                divide_uint_inplace(numerator.get(), modulus.get(), wide_uint64_count, quotient.get(), pool);
+                compressed[i] = quotient[0] & bit_mask;
+            }
+            destination.set_poly(poly_index, compressed.get());
+        }
+    }
+
     void Evaluator::mod_switch_to_inplace(Plaintext &plain, parms_id_type parms_id) const
     {
         // Verify parameters.
@@ -1527,7 +1866,7 @@ namespace seal
 
         if (encrypted.is_ntt_form())
         {
-            multiply_plain_ntt(encrypted, plain);
+            multiply_plain_ntt(encrypted, plain, move(pool));
         }
         else
         {
@@ -1619,11 +1958,31 @@ namespace seal
         }
 
         // Generic case: any plaintext polynomial
-        // Allocate temporary space for an entire RNS polynomial
-        auto temp(allocate_zero_poly(coeff_count, coeff_modulus_size, pool));
+        // The product is computed one RNS component at a time: the plaintext component is transformed lazily to
+        // [0, 4q), and each ciphertext component is transformed, multiplied and transformed back while both are
+        // still cache-resident. The dyadic product accepts lazy inputs, so only the inverse NTT reduces fully. The
+        // components are independent and are distributed across the ThreadPool of the context, if any.
+        // With Montgomery reduction, the plaintext component is converted to Montgomery form once after its NTT, which
+        // also reduces it fully.
+        ThreadPool *thread_pool = context_.thread_pool().get();
+        auto multiply_component = [&](CoeffIter temp_component, size_t j) {
+            const NTTTables &tables = ntt_tables[j];
+            ntt_negacyclic_harvey_lazy(temp_component, tables);
+            if (use_montgomery(context_, coeff_modulus[j]))
+            {
+                to_montgomery_coeffmod(temp_component, coeff_count, coeff_modulus[j], temp_component);
+            }
+            SEAL_ITERATE(iter(encrypted), encrypted_size, [&](auto I) {
+                ntt_negacyclic_harvey_lazy(I[j], tables);
+                dyadic_product_prepared(context_, I[j], temp_component, coeff_count, coeff_modulus[j], I[j]);
+                inverse_ntt_negacyclic_harvey(I[j], tables);
+            });
+        };
 
         if (!context_data.qualifiers().using_fast_plain_lift)
         {
+            // Allocate temporary space for an entire RNS polynomial; the lift needs all components at once
+            auto temp(allocate_zero_poly(coeff_count, coeff_modulus_size, pool));
             StrideIter<uint64_t *> temp_iter(temp.get(), coeff_modulus_size);
 
             SEAL_ITERATE(iter(plain.data(), temp_iter), plain_coeff_count, [&](auto I) {
@@ -1639,38 +1998,36 @@ namespace seal
             });
 
             context_data.rns_tool()->base_q()->decompose_array(temp_iter, coeff_count, pool);
+
+            RNSIter temp_rns_iter(temp.get(), coeff_count);
+            parallel_iterate(thread_pool, iter(temp_rns_iter, seq_iter(0)), coeff_modulus_size, [&](auto I) {
+                multiply_component(get<0>(I), get<1>(I));
+            });
         }
         else
         {
             // Note that in this case plain_upper_half_increment holds its value in RNS form modulo the coeff_modulus
-            // primes.
-            RNSIter temp_iter(temp.get(), coeff_count);
-            SEAL_ITERATE(iter(temp_iter, plain_upper_half_increment), coeff_modulus_size, [&](auto I) {
-                SEAL_ITERATE(iter(get<0>(I), plain.data()), plain_coeff_count, [&](auto J) {
-                    get<0>(J) =
-                        SEAL_COND_SELECT(get<1>(J) >= plain_upper_half_threshold, get<1>(J) + get<1>(I), get<1>(J));
+            // primes, so each component can be lifted on its own into a single reused buffer, or into one buffer per
+            // component if the components are processed concurrently.
+            SEAL_ALLOCATE_GET_RNS_ITER(temp, coeff_count, thread_pool ? coeff_modulus_size : 1, pool);
+            parallel_iterate(
+                thread_pool, iter(plain_upper_half_increment, seq_iter(0)), coeff_modulus_size, [&](auto I) {
+                    CoeffIter temp_component = temp[thread_pool ? get<1>(I) : 0];
+                    SEAL_ITERATE(iter(temp_component, plain.data()), plain_coeff_count, [&](auto J) {
+                        get<0>(J) = SEAL_COND_SELECT(
+                            get<1>(J) >= plain_upper_half_threshold, get<1>(J) + get<0>(I), get<1>(J));
+                    });
+                    set_zero_uint(coeff_count - plain_coeff_count, temp_component + plain_coeff_count);
+                    multiply_component(temp_component, get<1>(I));
                 });
-            });
         }
 
-        // Need to multiply each component in encrypted with temp; first step is to transform to NTT form
-        RNSIter temp_iter(temp.get(), coeff_count);
-        ntt_negacyclic_harvey(temp_iter, coeff_modulus_size, ntt_tables);
-
-        SEAL_ITERATE(iter(encrypted), encrypted_size, [&](auto I) {
-            SEAL_ITERATE(iter(I, temp_iter, coeff_modulus, ntt_tables), coeff_modulus_size, [&](auto J) {
-                // Lazy reduction
-                ntt_negacyclic_harvey_lazy(get<0>(J), get<3>(J));
-                dyadic_product_coeffmod(get<0>(J), get<1>(J), coeff_count, get<2>(J), get<0>(J));
-                inverse_ntt_negacyclic_harvey(get<0>(J), get<3>(J));
-            });
-        });
-
         // Set the scale
         encrypted.scale() = new_scale;
     }
 
-    void Evaluator::multiply_plain_ntt(Ciphertext &encrypted_ntt, const Plaintext &plain_ntt) const
+    void Evaluator::multiply_plain_ntt(
+        Ciphertext &encrypted_ntt, const Plaintext &plain_ntt, MemoryPoolHandle pool) const
     {
         // Verify parameters.
         if (!plain_ntt.is_ntt_form())
@@ -1703,8 +2060,17 @@ namespace seal
         }
 
         ConstRNSIter plain_ntt_iter(plain_ntt.data(), coeff_count);
+
+        // Dyadic products with Montgomery reduction take plain_ntt in Montgomery form
+        bool montgomery = context_.mod_arith() == mod_arith_type::montgomery;
+        SEAL_ALLOCATE_GET_RNS_ITER(prepared_plain_ntt, coeff_count, montgomery ? coeff_modulus_size : 0, pool);
+        if (montgomery)
+        {
+            prepare_dyadic_operand(context_, plain_ntt_iter, coeff_modulus_size, coeff_modulus, prepared_plain_ntt);
+            plain_ntt_iter = prepared_plain_ntt;
+        }
         SEAL_ITERATE(iter(encrypted_ntt), encrypted_ntt_size, [&](auto I) {
-            dyadic_product_coeffmod(I, plain_ntt_iter, coeff_modulus_size, coeff_modulus, I);
+            dyadic_product_prepared(context_, I, plain_ntt_iter, coeff_modulus_size, coeff_modulus, I);
         });
 
         // Set the scale
@@ -1839,7 +2205,7 @@ namespace seal
         }
 
         // Transform each polynomial to NTT domain
-        ntt_negacyclic_harvey(encrypted, encrypted_size, ntt_tables);
+        ntt_negacyclic_harvey(encrypted, encrypted_size, ntt_tables, context_.thread_pool().get());
 
         // Finally change the is_ntt_transformed flag
         encrypted.is_ntt_form() = true;
@@ -1886,7 +2252,7 @@ namespace seal
         }
 
         // Transform each polynomial from NTT domain
-        inverse_ntt_negacyclic_harvey(encrypted_ntt, encrypted_ntt_size, ntt_tables);
+        inverse_ntt_negacyclic_harvey(encrypted_ntt, encrypted_ntt_size, ntt_tables, context_.thread_pool().get());
 
         // Finally change the is_ntt_transformed flag
         encrypted_ntt.is_ntt_form() = false;
@@ -2060,62 +2426,83 @@ namespace seal
         }
     }
 
-    void Evaluator::switch_key_inplace(
-        Ciphertext &encrypted, ConstRNSIter target_iter, const KSwitchKeys &kswitch_keys, size_t kswitch_keys_index,
-        MemoryPoolHandle pool) const
+    void Evaluator::rotate_many_internal(
+        const Ciphertext &encrypted, const vector<int> &steps, const GaloisKeys &galois_keys,
+        vector<Ciphertext> &destinations, MemoryPoolHandle pool) const
     {
-        auto parms_id = encrypted.parms_id();
-        auto &context_data = *context_.get_context_data(parms_id);
-        auto &parms = context_data.parms();
-        auto &key_context_data = *context_.key_context_data();
-        auto &key_parms = key_context_data.parms();
-        auto scheme = parms.scheme();
-
-        // Verify parameters.
-        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
+        auto context_data_ptr = context_.get_context_data(encrypted.parms_id());
+        if (!context_data_ptr)
         {
             throw invalid_argument("encrypted is not valid for encryption parameters");
         }
-        if (!target_iter)
+        if (!context_data_ptr->qualifiers().using_batching)
         {
-            throw invalid_argument("target_iter");
+            throw logic_error("encryption parameters do not support batching");
         }
-        if (!context_.using_keyswitching())
+        if (galois_keys.parms_id() != context_.key_parms_id())
         {
-            throw logic_error("keyswitching is not supported by the context");
+            throw invalid_argument("galois_keys is not valid for encryption parameters");
         }
 
-        // Don't validate all of kswitch_keys but just check the parms_id.
-        if (kswitch_keys.parms_id() != context_.key_parms_id())
-        {
-            throw invalid_argument("parameter mismatch");
-        }
+        auto galois_tool = context_data_ptr->galois_tool();
 
-        if (kswitch_keys_index >= kswitch_keys.data().size())
+        // Steps with a Galois key present share one hoisted decomposition; the rest fall back to rotate_internal
+        vector<uint32_t> hoisted_elts;
+        vector<size_t> hoisted_indices;
+        for (size_t i = 0; i < steps.size(); i++)
         {
-            throw out_of_range("kswitch_keys_index");
+            if (steps[i] != 0 && galois_keys.has_key(galois_tool->get_elt_from_step(steps[i])))
+            {
+                hoisted_elts.push_back(galois_tool->get_elt_from_step(steps[i]));
+                hoisted_indices.push_back(i);
+            }
         }
-        if (!pool)
+
+        vector<Ciphertext> hoisted;
+        if (!hoisted_elts.empty())
         {
-            throw invalid_argument("pool is uninitialized");
+            apply_galois_many(encrypted, hoisted_elts, galois_keys, hoisted, pool);
         }
-        if (scheme == scheme_type::bfv && encrypted.is_ntt_form())
+
+        vector<Ciphertext> results(steps.size());
+        for (size_t i = 0; i < hoisted.size(); i++)
         {
-            throw invalid_argument("BFV encrypted cannot be in NTT form");
+            results[hoisted_indices[i]] = move(hoisted[i]);
         }
-        if (scheme == scheme_type::ckks && !encrypted.is_ntt_form())
+        for (size_t i = 0, j = 0; i < steps.size(); i++)
         {
-            throw invalid_argument("CKKS encrypted must be in NTT form");
+            if (j < hoisted_indices.size() && hoisted_indices[j] == i)
+            {
+                j++;
+                continue;
+            }
+            results[i] = encrypted;
+            rotate_internal(results[i], steps[i], galois_keys, pool);
         }
 
+        assign_results(results, destinations);
+    }
+
+    template <typename GetDigitT>
+    void Evaluator::switch_key_core(
+        Ciphertext &encrypted, const vector<PublicKey> &key_vector, GetDigitT &&get_digit, MemoryPoolHandle pool) const
+    {
+        auto &context_data = *context_.get_context_data(encrypted.parms_id());
+        auto &parms = context_data.parms();
+        auto &key_context_data = *context_.key_context_data();
+        auto &key_parms = key_context_data.parms();
+        auto scheme = parms.scheme();
+        auto kswitch_tool = context_data.kswitch_tool();
+
         // Extract encryption parameters.
         size_t coeff_count = parms.poly_modulus_degree();
         size_t decomp_modulus_size = parms.coeff_modulus().size();
         auto &key_modulus = key_parms.coeff_modulus();
         size_t key_modulus_size = key_modulus.size();
-        size_t rns_modulus_size = decomp_modulus_size + 1;
+        size_t special_modulus_size = context_.special_prime_count();
+        size_t rns_modulus_size = decomp_modulus_size + special_modulus_size;
+        size_t digit_count = kswitch_tool->digit_count();
         auto key_ntt_tables = iter(key_context_data.small_ntt_tables());
-        auto modswitch_factors = key_context_data.rns_tool()->inv_q_last_mod_q();
 
         // Size check
         if (!product_fits_in(coeff_count, rns_modulus_size, size_t(2)))
@@ -2123,8 +2510,10 @@ namespace seal
             throw logic_error("invalid parameters");
         }
 
-        // Prepare input
-        auto &key_vector = kswitch_keys.data()[kswitch_keys_index];
+        if (key_vector.size() < digit_count)
+        {
+            throw invalid_argument("kswitch_keys is not valid for encryption parameters");
+        }
         size_t key_component_count = key_vector[0].data().size();
 
         // Check only the used component in KSwitchKeys.
@@ -2136,69 +2525,45 @@ namespace seal
             }
         }
 
-        // Create a copy of target_iter
-        SEAL_ALLOCATE_GET_RNS_ITER(t_target, coeff_count, decomp_modulus_size, pool);
-        set_uint(target_iter, decomp_modulus_size * coeff_count, t_target);
-
-        // In CKKS t_target is in NTT form; switch back to normal form
-        if (scheme == scheme_type::ckks)
-        {
-            inverse_ntt_negacyclic_harvey(t_target, decomp_modulus_size, key_ntt_tables);
-        }
-
-        // Temporary result
-        auto t_poly_prod(allocate_zero_poly_array(key_component_count, coeff_count, rns_modulus_size, pool));
-
-        SEAL_ITERATE(iter(size_t(0)), rns_modulus_size, [&](auto I) {
-            size_t key_index = (I == decomp_modulus_size ? key_modulus_size - 1 : I);
+        // The per-limb loops below do not allocate, so they can use the ThreadPool regardless of pool
+        ThreadPool *thread_pool = context_.thread_pool().get();
 
-            // Product of two numbers is up to 60 + 60 = 120 bits, so we can sum up to 256 of them without reduction.
-            size_t lazy_reduction_summand_bound = size_t(SEAL_MULTIPLY_ACCUMULATE_USER_MOD_MAX);
-            size_t lazy_reduction_counter = lazy_reduction_summand_bound;
+        // The extended basis consists of the primes of encrypted followed by the special primes
+        auto get_key_index = [&](size_t index) {
+            return index < decomp_modulus_size ? index : key_modulus_size - rns_modulus_size + index;
+        };
 
-            // Allocate memory for a lazy accumulator (128-bit coefficients)
-            auto t_poly_lazy(allocate_zero_poly_array(key_component_count, coeff_count, 2, pool));
+        // Product of two numbers is up to 60 + 60 = 120 bits, so we can sum up to 256 of them without reduction.
+        size_t lazy_reduction_summand_bound = size_t(SEAL_MULTIPLY_ACCUMULATE_USER_MOD_MAX);
+        size_t lazy_reduction_counter = lazy_reduction_summand_bound;
 
+        // Allocate memory for a lazy accumulator (128-bit coefficients) for each modulus of the extended basis
+        auto t_poly_lazy(allocate_zero_poly_array(rns_modulus_size * key_component_count, coeff_count, 2, pool));
+        auto get_accumulator_iter = [&](size_t index) {
             // Semantic misuse of PolyIter; this is really pointing to the data for a single RNS factor
-            PolyIter accumulator_iter(t_poly_lazy.get(), 2, coeff_count);
+            return PolyIter(t_poly_lazy.get() + index * key_component_count * coeff_count * 2, 2, coeff_count);
+        };
 
-            // Multiply with keys and perform lazy reduction on product's coefficients
-            SEAL_ITERATE(iter(size_t(0)), decomp_modulus_size, [&](auto J) {
-                SEAL_ALLOCATE_GET_COEFF_ITER(t_ntt, coeff_count, pool);
-                ConstCoeffIter t_operand;
+        // Multiply with keys and perform lazy reduction on product's coefficients
+        SEAL_ALLOCATE_GET_RNS_ITER(t_digit, coeff_count, rns_modulus_size, pool);
+        SEAL_ITERATE(iter(size_t(0)), digit_count, [&](auto J) {
+            // Digit J extended to the whole basis in RNS-NTT form
+            ConstRNSIter digit_iter = get_digit(J, t_digit);
 
-                // RNS-NTT form exists in input
-                if ((scheme == scheme_type::ckks) && (I == J))
-                {
-                    t_operand = target_iter[J];
-                }
-                // Perform RNS-NTT conversion
-                else
-                {
-                    // No need to perform RNS conversion (modular reduction)
-                    if (key_modulus[J] <= key_modulus[key_index])
-                    {
-                        set_uint(t_target[J], coeff_count, t_ntt);
-                    }
-                    // Perform RNS conversion (modular reduction)
-                    else
-                    {
-                        modulo_poly_coeffs(t_target[J], coeff_count, key_modulus[key_index], t_ntt);
-                    }
-                    // NTT conversion lazy outputs in [0, 4q)
-                    ntt_negacyclic_harvey_lazy(t_ntt, key_ntt_tables[key_index]);
-                    t_operand = t_ntt;
-                }
+            parallel_for_each(thread_pool, rns_modulus_size, [&](size_t index) {
+                ConstCoeffIter digit = digit_iter[index];
+                size_t key_index = get_key_index(index);
+                PolyIter accumulator_iter = get_accumulator_iter(index);
 
                 // Multiply with keys and modular accumulate products in a lazy fashion
                 SEAL_ITERATE(iter(key_vector[J].data(), accumulator_iter), key_component_count, [&](auto K) {
                     if (!lazy_reduction_counter)
                     {
-                        SEAL_ITERATE(iter(t_operand, get<0>(K)[key_index], get<1>(K)), coeff_count, [&](auto L) {
+                        SEAL_ITERATE(iter(digit, get<0>(K)[key_index], get<1>(K)), coeff_count, [&](auto L) {
                             unsigned long long qword[2]{ 0, 0 };
                             multiply_uint64(get<0>(L), get<1>(L), qword);
 
-                            // Accumulate product of t_operand and t_key_acc to t_poly_lazy and reduce
+                            // Accumulate product of the digit and the key to t_poly_lazy and reduce
                             add_uint128(qword, get<2>(L).ptr(), qword);
                             get<2>(L)[0] = barrett_reduce_128(qword, key_modulus[key_index]);
                             get<2>(L)[1] = 0;
@@ -2207,7 +2572,7 @@ namespace seal
                     else
                     {
                         // Same as above but no reduction
-                        SEAL_ITERATE(iter(t_operand, get<0>(K)[key_index], get<1>(K)), coeff_count, [&](auto L) {
+                        SEAL_ITERATE(iter(digit, get<0>(K)[key_index], get<1>(K)), coeff_count, [&](auto L) {
                             unsigned long long qword[2]{ 0, 0 };
                             multiply_uint64(get<0>(L), get<1>(L), qword);
                             add_uint128(qword, get<2>(L).ptr(), qword);
@@ -2216,18 +2581,25 @@ namespace seal
                         });
                     }
                 });
-
-                if (!--lazy_reduction_counter)
-                {
-                    lazy_reduction_counter = lazy_reduction_summand_bound;
-                }
             });
 
+            if (!--lazy_reduction_counter)
+            {
+                lazy_reduction_counter = lazy_reduction_summand_bound;
+            }
+        });
+
+        // Temporary result
+        auto t_poly_prod(allocate_poly_array(key_component_count, coeff_count, rns_modulus_size, pool));
+
+        parallel_for_each(thread_pool, rns_modulus_size, [&](size_t index) {
+            size_t key_index = get_key_index(index);
+
             // PolyIter pointing to the destination t_poly_prod, shifted to the appropriate modulus
-            PolyIter t_poly_prod_iter(t_poly_prod.get() + (I * coeff_count), coeff_count, rns_modulus_size);
+            PolyIter t_poly_prod_iter(t_poly_prod.get() + (index * coeff_count), coeff_count, rns_modulus_size);
 
             // Final modular reduction
-            SEAL_ITERATE(iter(accumulator_iter, t_poly_prod_iter), key_component_count, [&](auto K) {
+            SEAL_ITERATE(iter(get_accumulator_iter(index), t_poly_prod_iter), key_component_count, [&](auto K) {
                 if (lazy_reduction_counter == lazy_reduction_summand_bound)
                 {
                     SEAL_ITERATE(iter(get<0>(K), *get<1>(K)), coeff_count, [&](auto L) {
@@ -2245,64 +2617,277 @@ namespace seal
         });
         // Accumulated products are now stored in t_poly_prod
 
-        // Perform modulus switching with scaling
+        // Perform modulus switching with scaling by the special modulus P
         PolyIter t_poly_prod_iter(t_poly_prod.get(), coeff_count, rns_modulus_size);
         SEAL_ITERATE(iter(encrypted, t_poly_prod_iter), key_component_count, [&](auto I) {
-            // Lazy reduction; this needs to be then reduced mod qi
-            CoeffIter t_last(get<1>(I)[decomp_modulus_size]);
-            inverse_ntt_negacyclic_harvey_lazy(t_last, key_ntt_tables[key_modulus_size - 1]);
-
-            // Add (p-1)/2 to change from flooring to rounding.
-            uint64_t qk = key_modulus[key_modulus_size - 1].value();
-            uint64_t qk_half = qk >> 1;
-            SEAL_ITERATE(t_last, coeff_count, [&](auto &J) {
-                J = barrett_reduce_64(J + qk_half, key_modulus[key_modulus_size - 1]);
-            });
+            RNSIter t_special = get<1>(I) + decomp_modulus_size;
+            auto special_ntt_tables = key_ntt_tables + (key_modulus_size - special_modulus_size);
+
+            // Add floor(P/2) to change from flooring to rounding.
+            SEAL_ITERATE(
+                iter(t_special, special_ntt_tables, kswitch_tool->half_p_mod_p()), special_modulus_size, [&](auto J) {
+                    // Lazy reduction; this needs to be then reduced mod p
+                    inverse_ntt_negacyclic_harvey_lazy(get<0>(J), get<1>(J));
+                    const Modulus &p = get<1>(J).modulus();
+                    uint64_t half_p = get<2>(J);
+                    SEAL_ITERATE(get<0>(J), coeff_count, [&](auto &K) { K = barrett_reduce_64(K + half_p, p); });
+                });
 
-            SEAL_ITERATE(iter(I, key_modulus, key_ntt_tables, modswitch_factors), decomp_modulus_size, [&](auto J) {
-                SEAL_ALLOCATE_GET_COEFF_ITER(t_ntt, coeff_count, pool);
+            // (ct mod P) mod qi
+            SEAL_ALLOCATE_GET_RNS_ITER(t_last, coeff_count, decomp_modulus_size, pool);
+            kswitch_tool->convert_p_to_q(t_special, t_last, pool);
 
-                // (ct mod 4qk) mod qi
-                uint64_t qi = get<1>(J).value();
-                if (qk > qi)
-                {
-                    // This cannot be spared. NTT only tolerates input that is less than 4*modulus (i.e. qk <=4*qi).
-                    modulo_poly_coeffs(t_last, coeff_count, get<1>(J), t_ntt);
-                }
-                else
-                {
-                    set_uint(t_last, coeff_count, t_ntt);
-                }
+            parallel_iterate(
+                thread_pool,
+                iter(I, key_modulus, key_ntt_tables, kswitch_tool->inv_p_mod_q(), kswitch_tool->half_p_mod_q(), t_last),
+                decomp_modulus_size, [&](auto J) {
+                    CoeffIter t_ntt = get<5>(J);
 
-                // Lazy substraction, results in [0, 2*qi), since fix is in [0, qi].
-                uint64_t fix = qi - barrett_reduce_64(qk_half, get<1>(J));
-                SEAL_ITERATE(t_ntt, coeff_count, [fix](auto &K) { K += fix; });
+                    // Lazy substraction, results in [0, 2*qi), since fix is in [0, qi].
+                    uint64_t qi = get<1>(J).value();
+                    uint64_t fix = qi - get<4>(J);
+                    SEAL_ITERATE(t_ntt, coeff_count, [fix](auto &K) { K += fix; });
 
-                uint64_t qi_lazy = qi << 1; // some multiples of qi
-                if (scheme == scheme_type::ckks)
-                {
-                    // This ntt_negacyclic_harvey_lazy results in [0, 4*qi).
-                    ntt_negacyclic_harvey_lazy(t_ntt, get<2>(J));
+                    uint64_t qi_lazy = qi << 1; // some multiples of qi
+                    if (scheme == scheme_type::ckks)
+                    {
+                        // This ntt_negacyclic_harvey_lazy results in [0, 4*qi).
+                        ntt_negacyclic_harvey_lazy(t_ntt, get<2>(J));
 #if SEAL_USER_MOD_BIT_COUNT_MAX > 60
-                    // Reduce from [0, 4qi) to [0, 2qi)
-                    SEAL_ITERATE(t_ntt, coeff_count, [&](auto &K) { K -= SEAL_COND_SELECT(K >= qi_lazy, qi_lazy, 0); });
+                        // Reduce from [0, 4qi) to [0, 2qi)
+                        SEAL_ITERATE(
+                            t_ntt, coeff_count, [&](auto &K) { K -= SEAL_COND_SELECT(K >= qi_lazy, qi_lazy, 0); });
 #else
-                    // Since SEAL uses at most 60bit moduli, 8*qi < 2^63.
-                    qi_lazy = qi << 2;
+                        // Since SEAL uses at most 60bit moduli, 8*qi < 2^63.
+                        qi_lazy = qi << 2;
 #endif
-                }
-                else if (scheme == scheme_type::bfv)
-                {
-                    inverse_ntt_negacyclic_harvey_lazy(get<0, 1>(J), get<2>(J));
-                }
+                    }
+                    else if (scheme == scheme_type::bfv)
+                    {
+                        inverse_ntt_negacyclic_harvey_lazy(get<0, 1>(J), get<2>(J));
+                    }
 
-                // ((ct mod qi) - (ct mod qk)) mod qi
-                SEAL_ITERATE(iter(get<0, 1>(J), t_ntt), coeff_count, [&](auto K) { get<0>(K) += qi_lazy - get<1>(K); });
+                    // ((ct mod qi) - (ct mod P)) mod qi
+                    SEAL_ITERATE(
+                        iter(get<0, 1>(J), t_ntt), coeff_count, [&](auto K) { get<0>(K) += qi_lazy - get<1>(K); });
 
-                // qk^(-1) * ((ct mod qi) - (ct mod qk)) mod qi
-                multiply_poly_scalar_coeffmod(get<0, 1>(J), coeff_count, get<3>(J), get<1>(J), get<0, 1>(J));
-                add_poly_coeffmod(get<0, 1>(J), get<0, 0>(J), coeff_count, get<1>(J), get<0, 0>(J));
-            });
+                    // P^(-1) * ((ct mod qi) - (ct mod P)) mod qi
+                    multiply_poly_scalar_coeffmod(get<0, 1>(J), coeff_count, get<3>(J), get<1>(J), get<0, 1>(J));
+                    add_poly_coeffmod(get<0, 1>(J), get<0, 0>(J), coeff_count, get<1>(J), get<0, 0>(J));
+                });
+        });
+    }
+
+    void Evaluator::switch_key_inplace(
+        Ciphertext &encrypted, ConstRNSIter target_iter, const KSwitchKeys &kswitch_keys, size_t kswitch_keys_index,
+        MemoryPoolHandle pool) const
+    {
+        auto parms_id = encrypted.parms_id();
+        auto &context_data = *context_.get_context_data(parms_id);
+        auto &parms = context_data.parms();
+        auto &key_context_data = *context_.key_context_data();
+        auto scheme = parms.scheme();
+
+        // Verify parameters.
+        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (!target_iter)
+        {
+            throw invalid_argument("target_iter");
+        }
+        if (!context_.using_keyswitching())
+        {
+            throw logic_error("keyswitching is not supported by the context");
+        }
+
+        // Don't validate all of kswitch_keys but just check the parms_id.
+        if (kswitch_keys.parms_id() != context_.key_parms_id())
+        {
+            throw invalid_argument("parameter mismatch");
+        }
+
+        if (!kswitch_keys.contains(kswitch_keys_index))
+        {
+            throw out_of_range("kswitch_keys_index");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+        if (scheme == scheme_type::bfv && encrypted.is_ntt_form())
+        {
+            throw invalid_argument("BFV encrypted cannot be in NTT form");
+        }
+        if (scheme == scheme_type::ckks && !encrypted.is_ntt_form())
+        {
+            throw invalid_argument("CKKS encrypted must be in NTT form");
+        }
+
+        // Extract encryption parameters.
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t decomp_modulus_size = parms.coeff_modulus().size();
+        auto key_ntt_tables = iter(key_context_data.small_ntt_tables());
+
+        // Create a copy of target_iter
+        SEAL_ALLOCATE_GET_RNS_ITER(t_target, coeff_count, decomp_modulus_size, pool);
+        set_uint(target_iter, decomp_modulus_size * coeff_count, t_target);
+
+        // In CKKS t_target is in NTT form; switch back to normal form
+        if (scheme == scheme_type::ckks)
+        {
+            parallel_iterate(
+                context_.thread_pool().get(), iter(t_target, key_ntt_tables), decomp_modulus_size,
+                [&](auto I) { inverse_ntt_negacyclic_harvey(get<0>(I), get<1>(I)); });
+        }
+
+        // Keeps the key resident while it is used if kswitch_keys are indexed
+        auto key_vector = kswitch_keys.acquire(kswitch_keys_index);
+        switch_key_core(
+            encrypted, *key_vector,
+            [&](size_t J, RNSIter t_digit) -> ConstRNSIter {
+                get_kswitch_digit(
+                    context_, context_data, target_iter, t_target, scheme == scheme_type::ckks, J, t_digit,
+                    context_.thread_pool().get(), pool);
+                return t_digit;
+            },
+            pool);
+    }
+
+    void Evaluator::apply_galois_many(
+        const Ciphertext &encrypted, const vector<uint32_t> &galois_elts, const GaloisKeys &galois_keys,
+        vector<Ciphertext> &destinations, MemoryPoolHandle pool) const
+    {
+        // Verify parameters.
+        if (!is_metadata_valid_for(encrypted, context_) || !is_buffer_valid(encrypted))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (!context_.using_keyswitching())
+        {
+            throw logic_error("keyswitching is not supported by the context");
+        }
+
+        // Don't validate all of galois_keys but just check the parms_id.
+        if (galois_keys.parms_id() != context_.key_parms_id())
+        {
+            throw invalid_argument("galois_keys is not valid for encryption parameters");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        auto &context_data = *context_.get_context_data(encrypted.parms_id());
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t decomp_modulus_size = coeff_modulus.size();
+        size_t rns_modulus_size = decomp_modulus_size + context_.special_prime_count();
+        auto scheme = parms.scheme();
+        auto &key_context_data = *context_.key_context_data();
+        auto key_ntt_tables = iter(key_context_data.small_ntt_tables());
+        // Use key_context_data where permutation tables exist since previous runs.
+        auto galois_tool = key_context_data.galois_tool();
+
+        // Size check
+        if (!product_fits_in(coeff_count, rns_modulus_size, decomp_modulus_size + 1))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        uint64_t m = mul_safe(static_cast<uint64_t>(coeff_count), uint64_t(2));
+        for (auto galois_elt : galois_elts)
+        {
+            // Check if Galois key is generated or not.
+            if (!galois_keys.has_key(galois_elt))
+            {
+                throw invalid_argument("Galois key not present");
+            }
+            if (!(galois_elt & 1) || unsigned_geq(galois_elt, m))
+            {
+                throw invalid_argument("Galois element is not valid");
+            }
+        }
+        if (encrypted.size() > 2)
+        {
+            throw invalid_argument("encrypted size must be 2");
+        }
+        if (scheme == scheme_type::bfv && encrypted.is_ntt_form())
+        {
+            throw invalid_argument("BFV encrypted cannot be in NTT form");
+        }
+        if (scheme == scheme_type::ckks && !encrypted.is_ntt_form())
+        {
+            throw invalid_argument("CKKS encrypted must be in NTT form");
+        }
+
+        // Hoisting: a Galois automorphism commutes with the keyswitching decomposition and acts on the NTT form as a
+        // mere permutation, so the decomposition of encrypted.data(1) and its NTTs are computed once for all elements.
+        // The decomposition digits of the permuted ciphertexts are then the permuted digits, which are bounded just
+        // like the digits computed by apply_galois_inplace.
+        SEAL_ALLOCATE_GET_RNS_ITER(t_target, coeff_count, decomp_modulus_size, pool);
+        set_poly(encrypted.data(1), coeff_count, decomp_modulus_size, t_target);
+
+        // In CKKS t_target is in NTT form; switch back to normal form
+        if (scheme == scheme_type::ckks)
+        {
+            parallel_iterate(
+                context_.thread_pool().get(), iter(t_target, key_ntt_tables), decomp_modulus_size,
+                [&](auto I) { inverse_ntt_negacyclic_harvey(get<0>(I), get<1>(I)); });
+        }
+
+        // All keyswitching digits extended to the basis with the special primes in RNS-NTT form
+        size_t digit_count = context_data.kswitch_tool()->digit_count();
+        auto t_decomp(allocate_poly_array(digit_count, coeff_count, rns_modulus_size, pool));
+        PolyIter decomp_iter(t_decomp.get(), coeff_count, rns_modulus_size);
+        SEAL_ITERATE(iter(decomp_iter, size_t(0)), digit_count, [&](auto I) {
+            get_kswitch_digit(
+                context_, context_data, iter(encrypted)[1], t_target, scheme == scheme_type::ckks, get<1>(I),
+                get<0>(I), context_.thread_pool().get(), pool);
         });
+
+        vector<Ciphertext> results(galois_elts.size(), encrypted);
+        for (size_t i = 0; i < galois_elts.size(); i++)
+        {
+            uint32_t galois_elt = galois_elts[i];
+            Ciphertext &result = results[i];
+
+            // Apply the automorphism to encrypted.data(0) and wipe result.data(1)
+            if (scheme == scheme_type::bfv)
+            {
+                galois_tool->apply_galois(
+                    iter(encrypted)[0], decomp_modulus_size, galois_elt, coeff_modulus, iter(result)[0]);
+            }
+            else if (scheme == scheme_type::ckks)
+            {
+                galois_tool->apply_galois_ntt(iter(encrypted)[0], decomp_modulus_size, galois_elt, iter(result)[0]);
+            }
+            else
+            {
+                throw logic_error("scheme not implemented");
+            }
+            set_zero_poly(coeff_count, decomp_modulus_size, result.data(1));
+
+            // Calculate (temp * galois_key[0], temp * galois_key[1]) + (ct[0], 0) with permuted hoisted digits
+            auto key_vector = galois_keys.acquire_key(galois_elt);
+            switch_key_core(
+                result, *key_vector,
+                [&](size_t J, RNSIter t_digit) -> ConstRNSIter {
+                    galois_tool->apply_galois_ntt(decomp_iter[J], rns_modulus_size, galois_elt, t_digit);
+                    return t_digit;
+                },
+                pool);
+#ifdef SEAL_THROW_ON_TRANSPARENT_CIPHERTEXT
+            // Transparent ciphertext output is not allowed.
+            if (result.is_transparent())
+            {
+                throw logic_error("result ciphertext is transparent");
+            }
+#endif
+        }
+
+        assign_results(results, destinations);
     }
 } // namespace seal
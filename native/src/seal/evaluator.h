@@ -4,6 +4,7 @@
 #pragma once
 
 #include "seal/ciphertext.h"
+#include "seal/compactciphertext.h"
 #include "seal/context.h"
 #include "seal/galoiskeys.h"
 #include "seal/memorymanager.h"
@@ -487,6 +488,52 @@ namespace seal
             mod_switch_to_inplace(destination, parms_id);
         }
 
+        /**
+        Converts a BFV ciphertext of size 2 to a CompactCiphertext that can only be decrypted. The ciphertext is first
+        switched to the lowest level of the modulus switching chain, after which every coefficient of c0 and c1 is
+        scaled from the coefficient modulus q to 2^c0_bit_count and 2^c1_bit_count, respectively. The bit counts are
+        chosen such that the result decrypts correctly whenever the ciphertext has more than one bit of invariant noise
+        budget at the lowest level. Dynamic memory allocations in the process are allocated from the memory pool
+        pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to compact
+        @param[out] destination The CompactCiphertext to overwrite with the result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if the scheme is not BFV
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted is in NTT form
+        @throws std::invalid_argument if encrypted does not have size 2
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void compact(
+            const Ciphertext &encrypted, CompactCiphertext &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
+        /**
+        Converts a BFV ciphertext of size 2 to a CompactCiphertext that can only be decrypted, keeping the given number
+        of most significant bits of every coefficient of c0 and c1 modulo the coefficient modulus of the lowest level
+        of the modulus switching chain. Since the error from truncating c1 is multiplied by the secret key during
+        decryption, c1_bit_count should exceed c0_bit_count by roughly log2(poly_modulus_degree). Dynamic memory
+        allocations in the process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to compact
+        @param[in] c0_bit_count The number of bits kept of each coefficient of c0
+        @param[in] c1_bit_count The number of bits kept of each coefficient of c1
+        @param[out] destination The CompactCiphertext to overwrite with the result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if the scheme is not BFV
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted is in NTT form
+        @throws std::invalid_argument if encrypted does not have size 2
+        @throws std::invalid_argument if c0_bit_count or c1_bit_count is not in the range [1, 64]
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void compact(
+            const Ciphertext &encrypted, int c0_bit_count, int c1_bit_count, CompactCiphertext &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
         /**
         Given a ciphertext encrypted modulo q_1...q_k, this function switches the modulus down to q_1...q_{k-1}, scales
         the message down accordingly, and stores the result in the destination parameter. Dynamic memory allocations in
@@ -927,6 +974,36 @@ namespace seal
             apply_galois_inplace(destination, galois_elt, galois_keys, std::move(pool));
         }
 
+        /**
+        Applies several Galois automorphisms to the same ciphertext and writes the results to the destinations
+        parameter, in the order of the given Galois elements. The RNS decomposition of the ciphertext and its NTTs,
+        which dominate the cost of key switching, are computed only once and shared by all automorphisms (hoisting);
+        each automorphism then only permutes the decomposition and computes the inner product with its Galois key.
+        The results decrypt to the same values as those of apply_galois, but are not bitwise identical to them. Dynamic
+        memory allocations in the process are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to apply the Galois automorphisms to
+        @param[in] galois_elts The Galois elements
+        @param[in] galois_keys The Galois keys
+        @param[out] destinations The vector of ciphertexts to overwrite with the results. It is resized to the number of
+        Galois elements; ciphertexts already in it, including views, are overwritten in place
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if galois_keys do not correspond to the top
+        level parameters in the current context
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if any of the Galois elements is not valid
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if keyswitching is not supported by the context
+        @throws std::logic_error if any result ciphertext is transparent
+        */
+        void apply_galois_many(
+            const Ciphertext &encrypted, const std::vector<std::uint32_t> &galois_elts, const GaloisKeys &galois_keys,
+            std::vector<Ciphertext> &destinations, MemoryPoolHandle pool = MemoryManager::GetPool()) const;
+
         /**
         Rotates plaintext matrix rows cyclically. When batching is used with the BFV scheme, this function rotates the
         encrypted plaintext matrix rows cyclically to the left (steps > 0) or to the right (steps < 0). Since the size
@@ -997,6 +1074,45 @@ namespace seal
             rotate_rows_inplace(destination, steps, galois_keys, std::move(pool));
         }
 
+        /**
+        Rotates plaintext matrix rows cyclically by several step counts at once. When batching is used with the BFV
+        scheme, this function computes the rotations of the encrypted plaintext matrix rows by each of the given steps
+        and writes them to the destinations parameter, in the order of the given steps. All rotations for which a
+        Galois key is present share one key switching decomposition (see apply_galois_many); the remaining ones are
+        computed as in rotate_rows. Dynamic memory allocations in the process are allocated from the memory pool
+        pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to rotate
+        @param[in] steps The numbers of steps to rotate (positive left, negative right)
+        @param[in] galois_keys The Galois keys
+        @param[out] destinations The vector of ciphertexts to overwrite with the rotated results. It is resized to the
+        number of steps; ciphertexts already in it, including views, are overwritten in place
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::bfv
+        @throws std::logic_error if the encryption parameters do not support batching
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if galois_keys do not correspond to the top
+        level parameters in the current context
+        @throws std::invalid_argument if encrypted is in NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if any of the steps has too big absolute value
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if keyswitching is not supported by the context
+        @throws std::logic_error if any result ciphertext is transparent
+        */
+        inline void rotate_rows_many(
+            const Ciphertext &encrypted, const std::vector<int> &steps, const GaloisKeys &galois_keys,
+            std::vector<Ciphertext> &destinations, MemoryPoolHandle pool = MemoryManager::GetPool()) const
+        {
+            if (context_.key_context_data()->parms().scheme() != scheme_type::bfv)
+            {
+                throw std::logic_error("unsupported scheme");
+            }
+            rotate_many_internal(encrypted, steps, galois_keys, destinations, std::move(pool));
+        }
+
         /**
         Rotates plaintext matrix columns cyclically. When batching is used with the BFV scheme, this function rotates
         the encrypted plaintext matrix columns cyclically. Since the size of the batched matrix is 2-by-(N/2), where N
@@ -1131,6 +1247,44 @@ namespace seal
             rotate_vector_inplace(destination, steps, galois_keys, std::move(pool));
         }
 
+        /**
+        Rotates plaintext vector cyclically by several step counts at once. When using the CKKS scheme, this function
+        computes the rotations of the encrypted plaintext vector by each of the given steps and writes them to the
+        destinations parameter, in the order of the given steps. All rotations for which a Galois key is present share
+        one key switching decomposition (see apply_galois_many); the remaining ones are computed as in rotate_vector.
+        Dynamic memory allocations in the process are allocated from the memory pool pointed to by the given
+        MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to rotate
+        @param[in] steps The numbers of steps to rotate (positive left, negative right)
+        @param[in] galois_keys The Galois keys
+        @param[out] destinations The vector of ciphertexts to overwrite with the rotated results. It is resized to the
+        number of steps; ciphertexts already in it, including views, are overwritten in place
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::ckks
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if galois_keys do not correspond to the top
+        level parameters in the current context
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if any of the steps has too big absolute value
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if keyswitching is not supported by the context
+        @throws std::logic_error if any result ciphertext is transparent
+        */
+        inline void rotate_vector_many(
+            const Ciphertext &encrypted, const std::vector<int> &steps, const GaloisKeys &galois_keys,
+            std::vector<Ciphertext> &destinations, MemoryPoolHandle pool = MemoryManager::GetPool()) const
+        {
+            if (context_.key_context_data()->parms().scheme() != scheme_type::ckks)
+            {
+                throw std::logic_error("unsupported scheme");
+            }
+            rotate_many_internal(encrypted, steps, galois_keys, destinations, std::move(pool));
+        }
+
         /**
         Complex conjugates plaintext slot values. When using the CKKS scheme, this function complex conjugates all
         values in the underlying plaintext. Dynamic memory allocations in the process are allocated from the memory pool
@@ -1228,6 +1382,10 @@ namespace seal
         void rotate_internal(
             Ciphertext &encrypted, int steps, const GaloisKeys &galois_keys, MemoryPoolHandle pool) const;
 
+        void rotate_many_internal(
+            const Ciphertext &encrypted, const std::vector<int> &steps, const GaloisKeys &galois_keys,
+            std::vector<Ciphertext> &destinations, MemoryPoolHandle pool) const;
+
         inline void conjugate_internal(
             Ciphertext &encrypted, const GaloisKeys &galois_keys, MemoryPoolHandle pool) const
         {
@@ -1255,10 +1413,75 @@ namespace seal
             Ciphertext &encrypted, util::ConstRNSIter target_iter, const KSwitchKeys &kswitch_keys,
             std::size_t key_index, MemoryPoolHandle pool = MemoryManager::GetPool()) const;
 
+        /**
+        Accumulates the products of the keyswitching digits with the key switching keys in key_vector and adds the
+        result, scaled down by the special modulus, to encrypted. The functor get_digit(J, buffer) must return digit J
+        extended to the primes of encrypted followed by the special primes, in RNS-NTT form; buffer is scratch space of
+        that size that may be used for it.
+        */
+        template <typename GetDigitT>
+        void switch_key_core(
+            Ciphertext &encrypted, const std::vector<PublicKey> &key_vector, GetDigitT &&get_digit,
+            MemoryPoolHandle pool) const;
+
         void multiply_plain_normal(Ciphertext &encrypted, const Plaintext &plain, MemoryPoolHandle pool) const;
 
-        void multiply_plain_ntt(Ciphertext &encrypted_ntt, const Plaintext &plain_ntt) const;
+        void multiply_plain_ntt(Ciphertext &encrypted_ntt, const Plaintext &plain_ntt, MemoryPoolHandle pool) const;
 
         SEALContext context_;
     };
+
+    /**
+    Scratch memory for the temporaries of Evaluator operations. Key switching and ciphertext multiplication allocate
+    many short-lived buffers per call; drawing them from a general memory pool costs a lookup and a lock for each
+    buffer. An EvaluatorWorkspace instead serves them from an arena created by MemoryPoolHandle::Arena, which allocates
+    by bumping an offset and reclaims the memory as the buffers are released at the end of the operation.
+
+    An EvaluatorWorkspace is passed to Evaluator functions in place of a MemoryPoolHandle, for example
+
+        EvaluatorWorkspace workspace(context);
+        evaluator.multiply_inplace(encrypted1, encrypted2, workspace);
+        evaluator.relinearize_inplace(encrypted1, relin_keys, workspace);
+
+    The workspace is sized when it is created for the largest temporaries of the given SEALContext and grows on demand,
+    so that after the first operation it serves all later operations from a single block of memory. Ciphertexts whose
+    data the operations allocate from the workspace keep that memory reserved until they are destroyed, so outputs
+    should preferably be allocated from another memory pool beforehand.
+
+    @par Thread Safety
+    An EvaluatorWorkspace must only be used by one thread at a time, and each thread should use its own. The Evaluator
+    does not parallelize the operations that allocate from a workspace across the ThreadPool of the SEALContext.
+    */
+    class EvaluatorWorkspace
+    {
+    public:
+        /**
+        Creates an EvaluatorWorkspace sized for the temporaries of key switching and multiplication of ciphertexts of
+        size two at the highest data level of the given SEALContext.
+
+        @param[in] context The SEALContext
+        @param[in] clear_on_destruction Indicates whether the memory of the workspace should be cleared when destroyed
+        @throws std::invalid_argument if the encryption parameters are not valid
+        */
+        explicit EvaluatorWorkspace(const SEALContext &context, bool clear_on_destruction = false);
+
+        /**
+        Returns a MemoryPoolHandle pointing to the arena of the workspace.
+        */
+        SEAL_NODISCARD inline const MemoryPoolHandle &pool() const noexcept
+        {
+            return pool_;
+        }
+
+        /**
+        Returns a MemoryPoolHandle pointing to the arena of the workspace.
+        */
+        inline operator MemoryPoolHandle() const noexcept
+        {
+            return pool_;
+        }
+
+    private:
+        MemoryPoolHandle pool_;
+    };
 } // namespace seal
@@ -58,8 +58,7 @@ namespace seal
         */
         SEAL_NODISCARD inline bool has_key(std::uint32_t galois_elt) const
         {
-            std::size_t index = get_index(galois_elt);
-            return data().size() > index && !data()[index].empty();
+            return contains(get_index(galois_elt));
         }
 
         /**
@@ -68,10 +67,27 @@ namespace seal
 
         @param[in] galois_elt The Galois element
         @throws std::invalid_argument if the key corresponding to galois_elt does not exist
+        @throws std::logic_error if the keys were loaded with load_indexed; use
+        acquire_key instead
         */
         SEAL_NODISCARD inline const auto &key(std::uint32_t galois_elt) const
         {
             return KSwitchKeys::data(get_index(galois_elt));
         }
+
+        /**
+        Returns a Galois key that stays valid while the returned pointer is held.
+        The returned Galois key corresponds to the given Galois element and is
+        read from the file first if the keys were loaded with load_indexed.
+
+        @param[in] galois_elt The Galois element
+        @throws std::invalid_argument if the key corresponding to galois_elt does not exist
+        @throws std::logic_error if the key read from the file is invalid
+        @throws std::runtime_error if I/O operations failed
+        */
+        SEAL_NODISCARD inline std::shared_ptr<const std::vector<PublicKey>> acquire_key(std::uint32_t galois_elt) const
+        {
+            return acquire(get_index(galois_elt));
+        }
     };
 } // namespace seal
@@ -6,6 +6,7 @@
 #include "seal/util/common.h"
 #include "seal/util/galois.h"
 #include "seal/util/ntt.h"
+#include "seal/util/parallel.h"
 #include "seal/util/polyarithsmallmod.h"
 #include "seal/util/polycore.h"
 #include "seal/util/rlwe.h"
@@ -153,8 +154,11 @@ namespace seal
         ConstPolyIter secret_key(secret_key_array_.get(), coeff_count, coeff_modulus_size);
         generate_kswitch_keys(secret_key + 1, count, static_cast<KSwitchKeys &>(relin_keys), save_seed);
 
-        // Set the parms_id
+        // Set the parms_id and the keyswitching configuration
         relin_keys.parms_id() = context_data.parms_id();
+        relin_keys.special_prime_count_ = context_.special_prime_count();
+        relin_keys.dnum_ = context_.dnum();
+        relin_keys.digit_size_ = context_.digit_size();
 
         return relin_keys;
     }
@@ -187,35 +191,45 @@ namespace seal
         // The max number of keys is equal to number of coefficients
         galois_keys.data().resize(coeff_count);
 
+        // Verify coprime conditions and skip repeated elements before generating any key
+        vector<uint32_t> new_galois_elts;
+        vector<vector<PublicKey> *> destinations;
+        vector<bool> has_key(coeff_count, false);
         for (auto galois_elt : galois_elts)
         {
-            // Verify coprime conditions.
             if (!(galois_elt & 1) || (galois_elt >= coeff_count << 1))
             {
                 throw invalid_argument("Galois element is not valid");
             }
 
-            // Do we already have the key?
-            if (galois_keys.has_key(galois_elt))
+            // This is the location in the galois_keys vector
+            size_t index = GaloisKeys::get_index(galois_elt);
+            if (has_key[index])
             {
                 continue;
             }
+            has_key[index] = true;
+            new_galois_elts.push_back(galois_elt);
+            destinations.push_back(&galois_keys.data()[index]);
+        }
 
-            // Rotate secret key for each coeff_modulus
-            SEAL_ALLOCATE_GET_RNS_ITER(rotated_secret_key, coeff_count, coeff_modulus_size, pool_);
-            RNSIter secret_key(secret_key_.data().data(), coeff_count);
-            galois_tool->apply_galois_ntt(secret_key, coeff_modulus_size, galois_elt, rotated_secret_key);
-
-            // Initialize Galois key
-            // This is the location in the galois_keys vector
-            size_t index = GaloisKeys::get_index(galois_elt);
+        // Rotate secret key for each coeff_modulus
+        auto rotated_secret_keys(
+            allocate_poly_array(new_galois_elts.size(), coeff_count, coeff_modulus_size, pool_));
+        PolyIter rotated_secret_key(rotated_secret_keys.get(), coeff_count, coeff_modulus_size);
+        RNSIter secret_key(secret_key_.data().data(), coeff_count);
+        SEAL_ITERATE(iter(new_galois_elts, rotated_secret_key), new_galois_elts.size(), [&](auto I) {
+            galois_tool->apply_galois_ntt(secret_key, coeff_modulus_size, get<0>(I), get<1>(I));
+        });
 
-            // Create Galois keys.
-            generate_one_kswitch_key(rotated_secret_key, galois_keys.data()[index], save_seed);
-        }
+        // Create Galois keys.
+        generate_kswitch_keys(rotated_secret_key, destinations, save_seed);
 
-        // Set the parms_id
+        // Set the parms_id and the keyswitching configuration
         galois_keys.parms_id_ = context_data.parms_id();
+        galois_keys.special_prime_count_ = context_.special_prime_count();
+        galois_keys.dnum_ = context_.dnum();
+        galois_keys.digit_size_ = context_.digit_size();
 
         return galois_keys;
     }
@@ -298,41 +312,6 @@ namespace seal
         secret_key_array_.acquire(secret_key_array);
     }
 
-    void KeyGenerator::generate_one_kswitch_key(ConstRNSIter new_key, vector<PublicKey> &destination, bool save_seed)
-    {
-        if (!context_.using_keyswitching())
-        {
-            throw logic_error("keyswitching is not supported by the context");
-        }
-
-        size_t coeff_count = context_.key_context_data()->parms().poly_modulus_degree();
-        size_t decomp_mod_count = context_.first_context_data()->parms().coeff_modulus().size();
-        auto &key_context_data = *context_.key_context_data();
-        auto &key_parms = key_context_data.parms();
-        auto &key_modulus = key_parms.coeff_modulus();
-
-        // Size check
-        if (!product_fits_in(coeff_count, decomp_mod_count))
-        {
-            throw logic_error("invalid parameters");
-        }
-
-        // KSwitchKeys data allocated from pool given by MemoryManager::GetPool.
-        destination.resize(decomp_mod_count);
-
-        SEAL_ITERATE(iter(new_key, key_modulus, destination, size_t(0)), decomp_mod_count, [&](auto I) {
-            SEAL_ALLOCATE_GET_COEFF_ITER(temp, coeff_count, pool_);
-            encrypt_zero_symmetric(
-                secret_key_, context_, key_context_data.parms_id(), true, save_seed, get<2>(I).data());
-            uint64_t factor = barrett_reduce_64(key_modulus.back().value(), get<1>(I));
-            multiply_poly_scalar_coeffmod(get<0>(I), coeff_count, factor, get<1>(I), temp);
-
-            // We use the SeqIter at get<3>(I) to find the i-th RNS factor of the first destination polynomial.
-            CoeffIter destination_iter = (*iter(get<2>(I).data()))[get<3>(I)];
-            add_poly_coeffmod(destination_iter, temp, coeff_count, get<1>(I), destination_iter);
-        });
-    }
-
     void KeyGenerator::generate_kswitch_keys(
         ConstPolyIter new_keys, size_t num_keys, KSwitchKeys &destination, bool save_seed)
     {
@@ -357,8 +336,84 @@ namespace seal
         }
 #endif
         destination.data().resize(num_keys);
-        SEAL_ITERATE(iter(new_keys, destination.data()), num_keys, [&](auto I) {
-            this->generate_one_kswitch_key(get<0>(I), get<1>(I), save_seed);
+        vector<vector<PublicKey> *> destinations;
+        destinations.reserve(num_keys);
+        for (auto &key : destination.data())
+        {
+            destinations.push_back(&key);
+        }
+        generate_kswitch_keys(new_keys, destinations, save_seed);
+    }
+
+    void KeyGenerator::generate_kswitch_keys(
+        ConstPolyIter new_keys, const vector<vector<PublicKey> *> &destinations, bool save_seed)
+    {
+        if (!context_.using_keyswitching())
+        {
+            throw logic_error("keyswitching is not supported by the context");
+        }
+
+        size_t coeff_count = context_.key_context_data()->parms().poly_modulus_degree();
+        auto &first_context_data = *context_.first_context_data();
+        size_t decomp_mod_count = first_context_data.parms().coeff_modulus().size();
+        auto kswitch_tool = first_context_data.kswitch_tool();
+        size_t digit_size = kswitch_tool->digit_size();
+        size_t digit_count = kswitch_tool->digit_count();
+        auto &key_context_data = *context_.key_context_data();
+        auto &key_parms = key_context_data.parms();
+        auto &key_modulus = key_parms.coeff_modulus();
+        size_t num_keys = destinations.size();
+
+        // Size check
+        if (!product_fits_in(coeff_count, decomp_mod_count) || !product_fits_in(num_keys, digit_count))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        // The special modulus P modulo each decomposition modulus
+        auto special_modulus = kswitch_tool->base_p();
+        vector<uint64_t> factors(decomp_mod_count);
+        SEAL_ITERATE(iter(factors, key_modulus), decomp_mod_count, [&](auto I) {
+            get<0>(I) = modulo_uint(special_modulus->base_prod(), special_modulus->size(), get<1>(I));
+        });
+
+        // KSwitchKeys data allocated from pool given by MemoryManager::GetPool.
+        for (auto destination : destinations)
+        {
+            destination->resize(digit_count);
+        }
+
+        // Sample the seeds of all components in order, so that the result does not depend on how the components are
+        // scheduled across threads.
+        size_t component_count = num_keys * digit_count;
+        vector<prng_seed_type> seeds(component_count);
+        key_parms.random_generator()->create()->generate(
+            mul_safe(component_count, prng_seed_byte_count), reinterpret_cast<seal_byte *>(seeds.data()));
+
+        // The components allocate from the pools of the destinations, which were created on this thread
+        ThreadPool *thread_pool = get_thread_pool(context_, MemoryManager::GetPool());
+
+        // The key for digit J encrypts P * new_key modulo the primes of digit J and zero modulo all other primes
+        parallel_for_each(thread_pool, component_count, [&](size_t component_index) {
+            size_t key_index = component_index / digit_count;
+            size_t digit_index = component_index % digit_count;
+            auto new_key = new_keys[key_index];
+            PublicKey &destination = (*destinations[key_index])[digit_index];
+
+            encrypt_zero_symmetric(
+                secret_key_, context_, key_context_data.parms_id(), true, save_seed,
+                key_parms.random_generator()->create(seeds[component_index]), destination.data());
+
+            size_t digit_begin = digit_index * digit_size;
+            size_t digit_end = min(digit_begin + digit_size, decomp_mod_count);
+            SEAL_ALLOCATE_GET_COEFF_ITER(temp, coeff_count, pool_);
+            SEAL_ITERATE(iter(size_t(digit_begin)), digit_end - digit_begin, [&](auto J) {
+                multiply_poly_scalar_coeffmod(new_key[J], coeff_count, factors[J], key_modulus[J], temp);
+
+                // We use J to find the J-th RNS factor of the first destination polynomial.
+                CoeffIter destination_iter = (*iter(destination.data()))[J];
+                add_poly_coeffmod(destination_iter, temp, coeff_count, key_modulus[J], destination_iter);
+            });
         });
     }
 } // namespace seal
@@ -21,6 +21,13 @@ namespace seal
     also at any time be used to generate relinearization keys and Galois keys.
     Constructing a KeyGenerator requires only a SEALContext.
 
+    @par Parallel Key Generation
+    If the SEALContext was constructed with a ThreadPool, relinearization keys
+    and Galois keys are generated in parallel across all keys and decomposition
+    components. Every component uses its own PRNG, and the seeds of these PRNGs
+    are sampled in a fixed order, so with a fixed seed for the random generator
+    factory the keys are the same for any number of threads.
+
     @see EncryptionParameters for more details on encryption parameters.
     @see SecretKey for more details on secret key.
     @see PublicKey for more details on public key.
@@ -327,10 +334,14 @@ namespace seal
             util::ConstPolyIter new_keys, std::size_t num_keys, KSwitchKeys &destination, bool save_seed = false);
 
         /**
-        Generates one key switching key for a new key.
+        Generates new key switching keys for an array of new keys and stores the key for new_keys[i] in
+        destinations[i]. The decomposition components of all keys are generated in parallel across the ThreadPool
+        of the context, if any. Each component draws its randomness from its own PRNG, whose seed is sampled in
+        order from one PRNG, so the keys do not depend on the number of threads.
         */
-        void generate_one_kswitch_key(
-            util::ConstRNSIter new_key, std::vector<PublicKey> &destination, bool save_seed = false);
+        void generate_kswitch_keys(
+            util::ConstPolyIter new_keys, const std::vector<std::vector<PublicKey> *> &destinations,
+            bool save_seed = false);
 
         /**
         Generates and returns the specified number of relinearization keys.
@@ -2,13 +2,245 @@
 // Licensed under the MIT license.
 
 #include "seal/kswitchkeys.h"
+#include "seal/util/common.h"
+#include "seal/util/mappedfile.h"
+#include "seal/util/streambuf.h"
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <numeric>
 #include <stdexcept>
+#include <unordered_map>
 
 using namespace std;
 using namespace seal::util;
 
 namespace seal
 {
+    namespace
+    {
+        // A file written by KSwitchKeys::save_mapped consists of a MappedKeysHeader, the keys_dim1 sizes of the second
+        // dimension of keys_ as 64-bit integers, a MappedKeyEntry for every key, and the coefficients of every key at
+        // the offset recorded in its entry. The offsets are multiples of mapped_alignment so that the coefficients
+        // can be used in place.
+        constexpr uint64_t mapped_magic = 0x324D534B4C414553; // "SEALKSM2"
+
+        constexpr size_t mapped_alignment = 64;
+
+        struct MappedKeysHeader
+        {
+            uint64_t magic;
+
+            parms_id_type parms_id;
+
+            uint64_t special_prime_count;
+
+            uint64_t dnum;
+
+            uint64_t digit_size;
+
+            uint64_t keys_dim1;
+
+            uint64_t key_count;
+        };
+
+        struct MappedKeyEntry
+        {
+            parms_id_type parms_id;
+
+            uint64_t size;
+
+            uint64_t poly_modulus_degree;
+
+            uint64_t coeff_modulus_size;
+
+            uint64_t is_ntt_form;
+
+            double scale;
+
+            uint64_t data_offset;
+        };
+
+        static_assert(sizeof(MappedKeysHeader) == 80, "unexpected MappedKeysHeader layout");
+        static_assert(sizeof(MappedKeyEntry) == 80, "unexpected MappedKeyEntry layout");
+
+        SEAL_NODISCARD inline size_t align_mapped_offset(size_t offset)
+        {
+            return add_safe(offset, mapped_alignment - 1) & ~(mapped_alignment - 1);
+        }
+
+        SEAL_NODISCARD inline size_t get_mapped_coeff_count(const MappedKeyEntry &entry)
+        {
+            return mul_safe(
+                static_cast<size_t>(entry.size), static_cast<size_t>(entry.poly_modulus_degree),
+                static_cast<size_t>(entry.coeff_modulus_size));
+        }
+
+        // Reads the tables of a file of file_size bytes written by KSwitchKeys::save_mapped and checks that every
+        // entry describes a key for the given SEALContext whose coefficients lie within the file. Returns the entries
+        // of every index of keys_ and stores the header in header.
+        vector<vector<MappedKeyEntry>> load_mapped_tables(
+            const SEALContext &context, istream &stream, size_t file_size, MappedKeysHeader &header)
+        {
+            vector<vector<MappedKeyEntry>> entries;
+
+            auto old_except_mask = stream.exceptions();
+            try
+            {
+                // Throw exceptions on ios_base::badbit and ios_base::failbit
+                stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+                MappedKeysHeader new_header;
+                if (file_size < sizeof(MappedKeysHeader))
+                {
+                    throw logic_error("KSwitchKeys data is invalid");
+                }
+                stream.read(reinterpret_cast<char *>(&new_header), sizeof(MappedKeysHeader));
+                if (new_header.magic != mapped_magic)
+                {
+                    throw logic_error("file was not written by KSwitchKeys::save_mapped");
+                }
+
+                // The tables must fit in the file before any memory is reserved for them
+                size_t keys_dim1 = safe_cast<size_t>(new_header.keys_dim1);
+                size_t key_count = safe_cast<size_t>(new_header.key_count);
+                if (add_safe(
+                        sizeof(MappedKeysHeader), mul_safe(keys_dim1, sizeof(uint64_t)),
+                        mul_safe(key_count, sizeof(MappedKeyEntry))) > file_size)
+                {
+                    throw logic_error("KSwitchKeys data is invalid");
+                }
+                vector<uint64_t> keys_dim2(keys_dim1);
+                stream.read(
+                    reinterpret_cast<char *>(keys_dim2.data()), static_cast<streamsize>(keys_dim1 * sizeof(uint64_t)));
+
+                entries.resize(keys_dim1);
+                size_t entry_index = 0;
+                for (size_t index = 0; index < keys_dim1; index++)
+                {
+                    if (keys_dim2[index] > key_count - entry_index ||
+                        (keys_dim2[index] && keys_dim2[index] != context.dnum()))
+                    {
+                        throw logic_error("KSwitchKeys data is invalid");
+                    }
+                    entries[index].resize(static_cast<size_t>(keys_dim2[index]));
+                    entry_index += entries[index].size();
+                    stream.read(
+                        reinterpret_cast<char *>(entries[index].data()),
+                        static_cast<streamsize>(entries[index].size() * sizeof(MappedKeyEntry)));
+
+                    for (auto &entry : entries[index])
+                    {
+                        auto context_data = context.get_context_data(entry.parms_id);
+                        if (!context_data || entry.size < SEAL_CIPHERTEXT_SIZE_MIN ||
+                            entry.size > SEAL_CIPHERTEXT_SIZE_MAX || entry.data_offset % mapped_alignment ||
+                            entry.data_offset > file_size)
+                        {
+                            throw logic_error("KSwitchKeys data is invalid");
+                        }
+                        auto &parms = context_data->parms();
+                        size_t buffer_coeff_count =
+                            (file_size - static_cast<size_t>(entry.data_offset)) / sizeof(Ciphertext::ct_coeff_type);
+                        if (entry.poly_modulus_degree != parms.poly_modulus_degree() ||
+                            entry.coeff_modulus_size != parms.coeff_modulus().size() ||
+                            get_mapped_coeff_count(entry) > buffer_coeff_count)
+                        {
+                            throw logic_error("KSwitchKeys data is invalid");
+                        }
+                    }
+                }
+                if (entry_index != key_count)
+                {
+                    throw logic_error("KSwitchKeys data is invalid");
+                }
+                header = new_header;
+            }
+            catch (const ios_base::failure &)
+            {
+                stream.exceptions(old_except_mask);
+                throw runtime_error("I/O error");
+            }
+            catch (...)
+            {
+                stream.exceptions(old_except_mask);
+                throw;
+            }
+            stream.exceptions(old_except_mask);
+
+            return entries;
+        }
+    } // namespace
+
+    // The keys of a file written by save_mapped, read on first use and cached in least recently used order
+    class KSwitchKeys::KeyIndex
+    {
+    public:
+        KeyIndex(
+            const SEALContext &context, const string &path, size_t max_resident_byte_count, MemoryPoolHandle pool);
+
+        SEAL_NODISCARD inline const MappedKeysHeader &header() const noexcept
+        {
+            return header_;
+        }
+
+        SEAL_NODISCARD inline size_t key_count() const noexcept
+        {
+            return key_count_;
+        }
+
+        SEAL_NODISCARD inline size_t index_count() const noexcept
+        {
+            return entries_.size();
+        }
+
+        SEAL_NODISCARD inline bool contains(size_t index) const noexcept
+        {
+            return index < entries_.size() && !entries_[index].empty();
+        }
+
+        SEAL_NODISCARD shared_ptr<const vector<PublicKey>> acquire(size_t index);
+
+        SEAL_NODISCARD size_t resident_byte_count() const;
+
+    private:
+        struct ResidentKey
+        {
+            shared_ptr<const vector<PublicKey>> key_vector;
+
+            size_t byte_count;
+
+            list<size_t>::iterator lru_position;
+        };
+
+        SEAL_NODISCARD shared_ptr<const vector<PublicKey>> read_key(size_t index, size_t &byte_count) const;
+
+        SEALContext context_;
+
+        // The file whose table was read, kept open so that keys are read from it even if the path is replaced
+        mutable ifstream stream_;
+
+        mutable mutex stream_mutex_;
+
+        size_t max_resident_byte_count_;
+
+        MemoryPoolHandle pool_;
+
+        MappedKeysHeader header_{};
+
+        vector<vector<MappedKeyEntry>> entries_;
+
+        size_t key_count_ = 0;
+
+        mutable mutex mutex_;
+
+        // Indices of the resident keys, most recently used first
+        list<size_t> lru_;
+
+        unordered_map<size_t, ResidentKey> resident_keys_;
+
+        size_t resident_byte_count_ = 0;
+    };
+
     KSwitchKeys &KSwitchKeys::operator=(const KSwitchKeys &assign)
     {
         // Check for self-assignment
@@ -19,6 +251,11 @@ namespace seal
 
         // Copy over fields
         parms_id_ = assign.parms_id_;
+        special_prime_count_ = assign.special_prime_count_;
+        dnum_ = assign.dnum_;
+        digit_size_ = assign.digit_size_;
+        mapping_.reset();
+        index_ = assign.index_;
 
         // Then copy over keys
         keys_.clear();
@@ -52,6 +289,14 @@ namespace seal
             // Save the parms_id
             stream.write(reinterpret_cast<const char *>(&parms_id_), sizeof(parms_id_type));
 
+            // Save the keyswitching configuration
+            uint64_t special_prime_count = static_cast<uint64_t>(special_prime_count_);
+            uint64_t dnum = static_cast<uint64_t>(dnum_);
+            uint64_t digit_size = static_cast<uint64_t>(digit_size_);
+            stream.write(reinterpret_cast<const char *>(&special_prime_count), sizeof(uint64_t));
+            stream.write(reinterpret_cast<const char *>(&dnum), sizeof(uint64_t));
+            stream.write(reinterpret_cast<const char *>(&digit_size), sizeof(uint64_t));
+
             // Save the size of keys_
             stream.write(reinterpret_cast<const char *>(&keys_dim1), sizeof(uint64_t));
 
@@ -83,7 +328,7 @@ namespace seal
         stream.exceptions(old_except_mask);
     }
 
-    void KSwitchKeys::load_members(const SEALContext &context, istream &stream, SEAL_MAYBE_UNUSED SEALVersion version)
+    void KSwitchKeys::load_members(const SEALContext &context, istream &stream, SEALVersion version)
     {
         // Verify parameters
         if (!context.parameters_set())
@@ -93,6 +338,9 @@ namespace seal
 
         // Create new keys
         vector<vector<PublicKey>> new_keys;
+        uint64_t special_prime_count = 0;
+        uint64_t dnum = 0;
+        uint64_t digit_size = 0;
 
         auto old_except_mask = stream.exceptions();
         try
@@ -103,6 +351,22 @@ namespace seal
             // Read the parms_id
             stream.read(reinterpret_cast<char *>(&parms_id_), sizeof(parms_id_type));
 
+            // Read the keyswitching configuration, which is present from version 3.8 on
+            if (version.major > 3 || (version.major == 3 && version.minor >= 8))
+            {
+                stream.read(reinterpret_cast<char *>(&special_prime_count), sizeof(uint64_t));
+                stream.read(reinterpret_cast<char *>(&dnum), sizeof(uint64_t));
+                stream.read(reinterpret_cast<char *>(&digit_size), sizeof(uint64_t));
+            }
+            else
+            {
+                // Older versions always used a single special prime and one prime per digit
+                size_t decomp_modulus_size = context.key_context_data()->parms().coeff_modulus().size() - 1;
+                special_prime_count = 1;
+                dnum = static_cast<uint64_t>(decomp_modulus_size);
+                digit_size = decomp_modulus_size ? 1 : 0;
+            }
+
             // Read in the size of keys_
             uint64_t keys_dim1 = 0;
             stream.read(reinterpret_cast<char *>(&keys_dim1), sizeof(uint64_t));
@@ -141,5 +405,340 @@ namespace seal
         stream.exceptions(old_except_mask);
 
         swap(keys_, new_keys);
+        special_prime_count_ = safe_cast<size_t>(special_prime_count);
+        dnum_ = safe_cast<size_t>(dnum);
+        digit_size_ = safe_cast<size_t>(digit_size);
+        mapping_.reset();
+        index_.reset();
+    }
+
+    streamoff KSwitchKeys::save_mapped(ostream &stream) const
+    {
+        if (index_)
+        {
+            throw logic_error("indexed KSwitchKeys cannot be saved");
+        }
+
+        MappedKeysHeader header{};
+        header.magic = mapped_magic;
+        header.parms_id = parms_id_;
+        header.special_prime_count = static_cast<uint64_t>(special_prime_count_);
+        header.dnum = static_cast<uint64_t>(dnum_);
+        header.digit_size = static_cast<uint64_t>(digit_size_);
+        header.keys_dim1 = static_cast<uint64_t>(keys_.size());
+
+        vector<uint64_t> keys_dim2;
+        keys_dim2.reserve(keys_.size());
+        for (auto &key_dim1 : keys_)
+        {
+            keys_dim2.push_back(static_cast<uint64_t>(key_dim1.size()));
+            header.key_count += keys_dim2.back();
+        }
+
+        // Lay out the coefficients after the tables
+        size_t offset = add_safe(
+            sizeof(MappedKeysHeader), mul_safe(keys_.size(), sizeof(uint64_t)),
+            mul_safe(safe_cast<size_t>(header.key_count), sizeof(MappedKeyEntry)));
+        vector<MappedKeyEntry> entries;
+        entries.reserve(safe_cast<size_t>(header.key_count));
+        for (auto &key_dim1 : keys_)
+        {
+            for (auto &key : key_dim1)
+            {
+                if (!is_buffer_valid(key))
+                {
+                    throw logic_error("KSwitchKeys data is invalid");
+                }
+                const Ciphertext &key_data = key.data();
+                MappedKeyEntry entry{};
+                entry.parms_id = key_data.parms_id();
+                entry.size = static_cast<uint64_t>(key_data.size());
+                entry.poly_modulus_degree = static_cast<uint64_t>(key_data.poly_modulus_degree());
+                entry.coeff_modulus_size = static_cast<uint64_t>(key_data.coeff_modulus_size());
+                entry.is_ntt_form = key_data.is_ntt_form() ? 1 : 0;
+                entry.scale = key_data.scale();
+                offset = align_mapped_offset(offset);
+                entry.data_offset = static_cast<uint64_t>(offset);
+                offset = add_safe(offset, mul_safe(key_data.dyn_array().size(), sizeof(Ciphertext::ct_coeff_type)));
+                entries.push_back(entry);
+            }
+        }
+
+        auto old_except_mask = stream.exceptions();
+        try
+        {
+            // Throw exceptions on ios_base::badbit and ios_base::failbit
+            stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+            stream.write(reinterpret_cast<const char *>(&header), sizeof(MappedKeysHeader));
+            stream.write(
+                reinterpret_cast<const char *>(keys_dim2.data()),
+                safe_cast<streamsize>(mul_safe(keys_dim2.size(), sizeof(uint64_t))));
+            stream.write(
+                reinterpret_cast<const char *>(entries.data()),
+                safe_cast<streamsize>(mul_safe(entries.size(), sizeof(MappedKeyEntry))));
+
+            // Write the coefficients, padding each key to its aligned offset
+            const char padding[mapped_alignment]{};
+            size_t written = sizeof(MappedKeysHeader) + keys_dim2.size() * sizeof(uint64_t) +
+                             entries.size() * sizeof(MappedKeyEntry);
+            size_t entry_index = 0;
+            for (auto &key_dim1 : keys_)
+            {
+                for (auto &key : key_dim1)
+                {
+                    size_t data_offset = static_cast<size_t>(entries[entry_index++].data_offset);
+                    stream.write(padding, static_cast<streamsize>(data_offset - written));
+                    size_t data_byte_count = key.data().dyn_array().size() * sizeof(Ciphertext::ct_coeff_type);
+                    stream.write(
+                        reinterpret_cast<const char *>(key.data().data()), safe_cast<streamsize>(data_byte_count));
+                    written = data_offset + data_byte_count;
+                }
+            }
+        }
+        catch (const ios_base::failure &)
+        {
+            stream.exceptions(old_except_mask);
+            throw runtime_error("I/O error");
+        }
+        catch (...)
+        {
+            stream.exceptions(old_except_mask);
+            throw;
+        }
+        stream.exceptions(old_except_mask);
+
+        return safe_cast<streamoff>(offset);
+    }
+
+    void KSwitchKeys::load_mapped(const SEALContext &context, const string &path)
+    {
+        // Verify parameters
+        if (!context.parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+
+        auto mapping = make_shared<MappedFile>(path, pool_);
+        if (mapping->size() < sizeof(MappedKeysHeader))
+        {
+            throw logic_error("KSwitchKeys data is invalid");
+        }
+        ArrayGetBuffer agbuf(reinterpret_cast<const char *>(mapping->data()), safe_cast<streamsize>(mapping->size()));
+        istream stream(&agbuf);
+        MappedKeysHeader header;
+        auto entries = load_mapped_tables(context, stream, mapping->size(), header);
+
+        KSwitchKeys new_keys;
+        new_keys.pool_ = pool_;
+        new_keys.parms_id_ = header.parms_id;
+        new_keys.special_prime_count_ = safe_cast<size_t>(header.special_prime_count);
+        new_keys.dnum_ = safe_cast<size_t>(header.dnum);
+        new_keys.digit_size_ = safe_cast<size_t>(header.digit_size);
+        new_keys.keys_.resize(entries.size());
+        for (size_t index = 0; index < entries.size(); index++)
+        {
+            new_keys.keys_[index].reserve(entries[index].size());
+            for (auto &entry : entries[index])
+            {
+                PublicKey key(pool_);
+                key.data() = Ciphertext(
+                    context, entry.parms_id, static_cast<size_t>(entry.size),
+                    reinterpret_cast<Ciphertext::ct_coeff_type *>(
+                        mapping->data() + static_cast<size_t>(entry.data_offset)),
+                    get_mapped_coeff_count(entry), pool_);
+                key.data().is_ntt_form() = entry.is_ntt_form != 0;
+                key.data().scale() = entry.scale;
+                new_keys.keys_[index].emplace_back(move(key));
+            }
+        }
+        if (!is_metadata_valid_for(new_keys, context) || !is_buffer_valid(new_keys))
+        {
+            throw logic_error("KSwitchKeys data is invalid");
+        }
+
+        new_keys.mapping_ = move(mapping);
+        swap(*this, new_keys);
+    }
+
+    void KSwitchKeys::load_indexed(const SEALContext &context, const string &path, size_t max_resident_byte_count)
+    {
+        auto index = make_shared<KeyIndex>(context, path, max_resident_byte_count, pool_);
+        auto &header = index->header();
+
+        KSwitchKeys new_keys;
+        new_keys.pool_ = pool_;
+        new_keys.parms_id_ = header.parms_id;
+        new_keys.special_prime_count_ = safe_cast<size_t>(header.special_prime_count);
+        new_keys.dnum_ = safe_cast<size_t>(header.dnum);
+        new_keys.digit_size_ = safe_cast<size_t>(header.digit_size);
+        if (!is_metadata_valid_for(new_keys, context))
+        {
+            throw logic_error("KSwitchKeys data is invalid");
+        }
+        new_keys.index_ = move(index);
+        swap(*this, new_keys);
+    }
+
+    size_t KSwitchKeys::size() const
+    {
+        if (index_)
+        {
+            return index_->key_count();
+        }
+        return accumulate(keys_.cbegin(), keys_.cend(), size_t(0), [](size_t res, auto &next_key) {
+            return res + (next_key.empty() ? 0 : 1);
+        });
+    }
+
+    bool KSwitchKeys::contains(size_t index) const
+    {
+        if (index_)
+        {
+            return index_->contains(index);
+        }
+        return index < keys_.size() && !keys_[index].empty();
+    }
+
+    size_t KSwitchKeys::index_count() const
+    {
+        return index_ ? index_->index_count() : keys_.size();
+    }
+
+    shared_ptr<const vector<PublicKey>> KSwitchKeys::acquire(size_t index) const
+    {
+        if (!contains(index))
+        {
+            throw invalid_argument("keyswitching key does not exist");
+        }
+        if (index_)
+        {
+            return index_->acquire(index);
+        }
+
+        // The keys are owned by this KSwitchKeys, so the returned pointer does not share ownership
+        return shared_ptr<const vector<PublicKey>>(shared_ptr<const vector<PublicKey>>(), &keys_[index]);
+    }
+
+    size_t KSwitchKeys::resident_byte_count() const
+    {
+        return index_ ? index_->resident_byte_count() : 0;
+    }
+
+    KSwitchKeys::KeyIndex::KeyIndex(
+        const SEALContext &context, const string &path, size_t max_resident_byte_count, MemoryPoolHandle pool)
+        : context_(context), stream_(path, ios_base::binary | ios_base::ate),
+          max_resident_byte_count_(max_resident_byte_count), pool_(move(pool))
+    {
+        // Verify parameters
+        if (!context_.parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+
+        if (!stream_)
+        {
+            throw runtime_error("I/O error");
+        }
+        size_t file_size = safe_cast<size_t>(static_cast<streamoff>(stream_.tellg()));
+        stream_.seekg(0);
+        entries_ = load_mapped_tables(context_, stream_, file_size, header_);
+        for (auto &key_entries : entries_)
+        {
+            key_count_ += key_entries.empty() ? 0 : 1;
+        }
+    }
+
+    shared_ptr<const vector<PublicKey>> KSwitchKeys::KeyIndex::acquire(size_t index)
+    {
+        {
+            lock_guard<mutex> lock(mutex_);
+            auto resident_key = resident_keys_.find(index);
+            if (resident_key != resident_keys_.end())
+            {
+                // Mark as most recently used
+                lru_.splice(lru_.begin(), lru_, resident_key->second.lru_position);
+                return resident_key->second.key_vector;
+            }
+        }
+
+        // Read the key without holding the lock so that other keys can be acquired in the meantime
+        size_t byte_count = 0;
+        auto key_vector = read_key(index, byte_count);
+
+        lock_guard<mutex> lock(mutex_);
+        auto resident_key = resident_keys_.find(index);
+        if (resident_key != resident_keys_.end())
+        {
+            // Another thread read the same key first
+            lru_.splice(lru_.begin(), lru_, resident_key->second.lru_position);
+            return resident_key->second.key_vector;
+        }
+        lru_.push_front(index);
+        resident_keys_[index] = ResidentKey{ key_vector, byte_count, lru_.begin() };
+        resident_byte_count_ += byte_count;
+
+        // Evict the least recently used keys, but never the one just read. Keys still held by callers stay alive
+        // until they are released.
+        while (max_resident_byte_count_ && resident_byte_count_ > max_resident_byte_count_ && lru_.size() > 1)
+        {
+            auto evicted_key = resident_keys_.find(lru_.back());
+            resident_byte_count_ -= evicted_key->second.byte_count;
+            resident_keys_.erase(evicted_key);
+            lru_.pop_back();
+        }
+        return key_vector;
+    }
+
+    size_t KSwitchKeys::KeyIndex::resident_byte_count() const
+    {
+        lock_guard<mutex> lock(mutex_);
+        return resident_byte_count_;
+    }
+
+    shared_ptr<const vector<PublicKey>> KSwitchKeys::KeyIndex::read_key(size_t index, size_t &byte_count) const
+    {
+        auto key_vector = make_shared<vector<PublicKey>>();
+        key_vector->reserve(entries_[index].size());
+        byte_count = 0;
+
+        for (auto &entry : entries_[index])
+        {
+            PublicKey key(pool_);
+            Ciphertext &key_data = key.data();
+            key_data.resize(context_, entry.parms_id, static_cast<size_t>(entry.size));
+            key_data.is_ntt_form() = entry.is_ntt_form != 0;
+            key_data.scale() = entry.scale;
+
+            size_t data_byte_count = mul_safe(get_mapped_coeff_count(entry), sizeof(Ciphertext::ct_coeff_type));
+            {
+                lock_guard<mutex> lock(stream_mutex_);
+
+                // Clear the state left by a failed read so that the key can be read again later
+                stream_.clear();
+                try
+                {
+                    // Throw exceptions on ios_base::badbit and ios_base::failbit
+                    stream_.exceptions(ios_base::badbit | ios_base::failbit);
+                    stream_.seekg(safe_cast<streamoff>(entry.data_offset));
+                    stream_.read(reinterpret_cast<char *>(key_data.data()), safe_cast<streamsize>(data_byte_count));
+                }
+                catch (const ios_base::failure &)
+                {
+                    stream_.exceptions(ios_base::goodbit);
+                    throw runtime_error("I/O error");
+                }
+                stream_.exceptions(ios_base::goodbit);
+            }
+            byte_count = add_safe(byte_count, data_byte_count);
+
+            // The coefficients are read anyway, so validate them fully
+            if (!is_valid_for(key, context_))
+            {
+                throw logic_error("KSwitchKeys data is invalid");
+            }
+            key_vector->emplace_back(move(key));
+        }
+        return key_vector;
     }
 } // namespace seal
@@ -9,10 +9,17 @@
 #include "seal/valcheck.h"
 #include "seal/version.h"
 #include <iostream>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace seal
 {
+    namespace util
+    {
+        class MappedFile;
+    }
+
     /**
     Class to store keyswitching keys. It should never be necessary for normal
     users to create an instance of KSwitchKeys. This class is used strictly as
@@ -50,7 +57,10 @@ namespace seal
 
         @param[in] copy The KSwitchKeys to copy from
         */
-        KSwitchKeys(const KSwitchKeys &copy) = default;
+        KSwitchKeys(const KSwitchKeys &copy)
+            : pool_(copy.pool_), parms_id_(copy.parms_id_), special_prime_count_(copy.special_prime_count_),
+              dnum_(copy.dnum_), digit_size_(copy.digit_size_), keys_(copy.keys_), index_(copy.index_)
+        {}
 
         /**
         Creates a new KSwitchKeys instance by moving a given instance.
@@ -77,15 +87,38 @@ namespace seal
         Returns the current number of keyswitching keys. Only keys that are
         non-empty are counted.
         */
-        SEAL_NODISCARD inline std::size_t size() const noexcept
-        {
-            return std::accumulate(keys_.cbegin(), keys_.cend(), std::size_t(0), [](std::size_t res, auto &next_key) {
-                return res + (next_key.empty() ? 0 : 1);
-            });
-        }
+        SEAL_NODISCARD std::size_t size() const;
+
+        /**
+        Returns whether a keyswitching key exists at a given index. For keys
+        loaded with load_indexed, this does not read the key.
+
+        @param[in] index The index of the keyswitching key
+        */
+        SEAL_NODISCARD bool contains(std::size_t index) const;
+
+        /**
+        Returns one more than the largest index at which a keyswitching key can
+        exist. This is data().size() unless the keys were loaded with load_indexed.
+        */
+        SEAL_NODISCARD std::size_t index_count() const;
+
+        /**
+        Returns a keyswitching key at a given index. For keys loaded with
+        load_indexed, the key is read from the file unless it is resident, and
+        the returned pointer keeps it alive even if it is evicted. Otherwise the
+        returned pointer refers to the key in data() without owning it.
+
+        @param[in] index The index of the keyswitching key
+        @throws std::invalid_argument if the key at the given index does not exist
+        @throws std::logic_error if the key read from the file is invalid
+        @throws std::runtime_error if I/O operations failed
+        */
+        SEAL_NODISCARD std::shared_ptr<const std::vector<PublicKey>> acquire(std::size_t index) const;
 
         /**
-        Returns a reference to the KSwitchKeys data.
+        Returns a reference to the KSwitchKeys data. The data is empty for keys
+        loaded with load_indexed; use contains and acquire to access those.
         */
         SEAL_NODISCARD inline auto &data() noexcept
         {
@@ -93,7 +126,8 @@ namespace seal
         }
 
         /**
-        Returns a const reference to the KSwitchKeys data.
+        Returns a const reference to the KSwitchKeys data. The data is empty for
+        keys loaded with load_indexed; use contains and acquire to access those.
         */
         SEAL_NODISCARD inline auto &data() const noexcept
         {
@@ -105,9 +139,15 @@ namespace seal
 
         @param[in] index The index of the keyswitching key
         @throws std::invalid_argument if the key at the given index does not exist
+        @throws std::logic_error if the keys were loaded with load_indexed; use
+        acquire instead
         */
         SEAL_NODISCARD inline auto &data(std::size_t index)
         {
+            if (index_)
+            {
+                throw std::logic_error("keyswitching keys are indexed; use acquire");
+            }
             if (index >= keys_.size() || keys_[index].empty())
             {
                 throw std::invalid_argument("keyswitching key does not exist");
@@ -120,9 +160,15 @@ namespace seal
 
         @param[in] index The index of the keyswitching key
         @throws std::invalid_argument if the key at the given index does not exist
+        @throws std::logic_error if the keys were loaded with load_indexed; use
+        acquire instead
         */
         SEAL_NODISCARD inline const auto &data(std::size_t index) const
         {
+            if (index_)
+            {
+                throw std::logic_error("keyswitching keys are indexed; use acquire");
+            }
             if (index >= keys_.size() || keys_[index].empty())
             {
                 throw std::invalid_argument("keyswitching key does not exist");
@@ -150,6 +196,72 @@ namespace seal
             return parms_id_;
         }
 
+        /**
+        Returns the number of special primes of the SEALContext the keys were
+        generated for.
+
+        @see SEALContext::special_prime_count() for more information.
+        */
+        SEAL_NODISCARD inline std::size_t special_prime_count() const noexcept
+        {
+            return special_prime_count_;
+        }
+
+        /**
+        Returns a reference to special_prime_count. KeyGenerator sets the
+        keyswitching configuration; keys assembled by hand must set
+        special_prime_count, dnum, and digit_size to the values of the
+        SEALContext they are used with.
+
+        @see SEALContext::special_prime_count() for more information.
+        */
+        SEAL_NODISCARD inline std::size_t &special_prime_count() noexcept
+        {
+            return special_prime_count_;
+        }
+
+        /**
+        Returns the number of keyswitching digits of the SEALContext the keys
+        were generated for.
+
+        @see SEALContext::dnum() for more information.
+        */
+        SEAL_NODISCARD inline std::size_t dnum() const noexcept
+        {
+            return dnum_;
+        }
+
+        /**
+        Returns a reference to dnum.
+
+        @see SEALContext::dnum() for more information.
+        */
+        SEAL_NODISCARD inline std::size_t &dnum() noexcept
+        {
+            return dnum_;
+        }
+
+        /**
+        Returns the number of primes in each keyswitching digit of the SEALContext
+        the keys were generated for.
+
+        @see SEALContext::digit_size() for more information.
+        */
+        SEAL_NODISCARD inline std::size_t digit_size() const noexcept
+        {
+            return digit_size_;
+        }
+
+        /**
+        Returns a reference to digit_size.
+
+        @see SEALContext::digit_size() for more information.
+        */
+        SEAL_NODISCARD inline std::size_t &digit_size() noexcept
+        {
+            return digit_size_;
+        }
+
         /**
         Returns an upper bound on the size of the KSwitchKeys, as if it was written
         to an output stream.
@@ -174,6 +286,9 @@ namespace seal
             std::size_t members_size = Serialization::ComprSizeEstimate(
                 util::add_safe(
                     sizeof(parms_id_),
+                    sizeof(std::uint64_t), // special_prime_count
+                    sizeof(std::uint64_t), // dnum
+                    sizeof(std::uint64_t), // digit_size
                     sizeof(std::uint64_t), // keys_dim1
                     total_key_size),
                 compr_mode);
@@ -188,18 +303,27 @@ namespace seal
 
         @param[out] stream The stream to save the KSwitchKeys to
         @param[in] compr_mode The desired compression mode
+        @param[in] thread_pool The ThreadPool across which the chunked compression
+        modes compress the data, or nullptr
         @throws std::invalid_argument if the compression mode is not supported
-        @throws std::logic_error if the data to be saved is invalid, or if
-        compression failed
+        @throws std::logic_error if the keys were loaded with load_indexed, if
+        the data to be saved is invalid, or if compression failed
         @throws std::runtime_error if I/O operations failed
         */
         inline std::streamoff save(
-            std::ostream &stream, compr_mode_type compr_mode = Serialization::compr_mode_default) const
+            std::ostream &stream, compr_mode_type compr_mode = Serialization::compr_mode_default,
+            ThreadPool *thread_pool = nullptr) const
         {
+            // Check before anything is written so that the output is left untouched
+            if (index_)
+            {
+                throw std::logic_error("indexed KSwitchKeys cannot be saved");
+            }
+
             using namespace std::placeholders;
             return Serialization::Save(
                 std::bind(&KSwitchKeys::save_members, this, _1), save_size(compr_mode_type::none), stream, compr_mode,
-                false);
+                false, thread_pool);
         }
 
         /**
@@ -218,7 +342,9 @@ namespace seal
         inline std::streamoff unsafe_load(const SEALContext &context, std::istream &stream)
         {
             using namespace std::placeholders;
-            return Serialization::Load(std::bind(&KSwitchKeys::load_members, this, context, _1, _2), stream, false);
+            return Serialization::Load(
+                std::bind(&KSwitchKeys::load_members, this, context, _1, _2), stream, false,
+                context.thread_pool().get());
         }
 
         /**
@@ -252,19 +378,28 @@ namespace seal
         @param[out] out The memory location to write the KSwitchKeys to
         @param[in] size The number of bytes available in the given memory location
         @param[in] compr_mode The desired compression mode
+        @param[in] thread_pool The ThreadPool across which the chunked compression
+        modes compress the data, or nullptr
         @throws std::invalid_argument if out is null or if size is too small to
         contain a SEALHeader, or if the compression mode is not supported
-        @throws std::logic_error if the data to be saved is invalid, or if
-        compression failed
+        @throws std::logic_error if the keys were loaded with load_indexed, if
+        the data to be saved is invalid, or if compression failed
         @throws std::runtime_error if I/O operations failed
         */
         inline std::streamoff save(
-            seal_byte *out, std::size_t size, compr_mode_type compr_mode = Serialization::compr_mode_default) const
+            seal_byte *out, std::size_t size, compr_mode_type compr_mode = Serialization::compr_mode_default,
+            ThreadPool *thread_pool = nullptr) const
         {
+            // Check before anything is written so that the output is left untouched
+            if (index_)
+            {
+                throw std::logic_error("indexed KSwitchKeys cannot be saved");
+            }
+
             using namespace std::placeholders;
             return Serialization::Save(
                 std::bind(&KSwitchKeys::save_members, this, _1), save_size(compr_mode_type::none), out, size,
-                compr_mode, false);
+                compr_mode, false, thread_pool);
         }
 
         /**
@@ -286,7 +421,9 @@ namespace seal
         inline std::streamoff unsafe_load(const SEALContext &context, const seal_byte *in, std::size_t size)
         {
             using namespace std::placeholders;
-            return Serialization::Load(std::bind(&KSwitchKeys::load_members, this, context, _1, _2), in, size, false);
+            return Serialization::Load(
+                std::bind(&KSwitchKeys::load_members, this, context, _1, _2), in, size, false,
+                context.thread_pool().get());
         }
 
         /**
@@ -317,6 +454,93 @@ namespace seal
             return in_size;
         }
 
+        /**
+        Saves the KSwitchKeys instance to an output stream in an uncompressed
+        format that can be loaded with load_mapped. The output starts with a
+        table of the keys and their metadata, followed by the coefficients of
+        each key aligned to a 64-byte boundary, and must be the only contents of
+        the file it is written to. The output is in the byte order of the host
+        and not portable across platforms with a different byte order.
+
+        @param[out] stream The stream to save the KSwitchKeys to
+        @throws std::logic_error if the data to be saved is invalid
+        @throws std::runtime_error if I/O operations failed
+        */
+        std::streamoff save_mapped(std::ostream &stream) const;
+
+        /**
+        Loads a KSwitchKeys from a file written with save_mapped, overwriting the
+        current KSwitchKeys. Instead of reading the file, it is mapped into memory
+        and every key views its coefficients directly in the mapping, so loading
+        takes time proportional to the number of keys rather than to their size.
+        Pages are read on first use and are shared through the page cache by all
+        processes that map the same file; modifying a key copies only the pages
+        it touches and never writes to the file. The mapping is released when the
+        last key referencing it is destroyed, while copies of the KSwitchKeys own
+        their data. If memory mapping is not supported on the platform, the file
+        is read into memory allocated from the current MemoryPoolHandle instead.
+
+        The metadata of the loaded KSwitchKeys is verified to be valid for the
+        given SEALContext, but to avoid touching every page the coefficients are
+        not checked to be reduced; use is_valid_for for a full check.
+
+        @param[in] context The SEALContext
+        @param[in] path The path of the file to load the KSwitchKeys from
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::logic_error if the file was not written by save_mapped or if
+        the loaded data is invalid
+        @throws std::runtime_error if I/O operations failed
+        */
+        void load_mapped(const SEALContext &context, const std::string &path);
+
+        /**
+        Loads the table of keys of a file written with save_mapped, overwriting
+        the current KSwitchKeys, and reads each key from the file only when it is
+        first acquired, for instance when Evaluator uses it. Resident keys are
+        kept in least recently used order, and once they take more than
+        max_resident_byte_count bytes the least recently used ones are evicted
+        and read again on their next use. Keys that are still in use are freed
+        only when released, and the most recently read key is never evicted. A
+        max_resident_byte_count of zero keeps all keys that were read.
+
+        Keys are fully validated as they are read. Since they are not resident,
+        data() is empty for indexed keys; use contains and acquire instead. All
+        copies of indexed keys share the resident keys, acquiring keys is safe
+        from multiple threads, and indexed keys cannot be saved.
+
+        @param[in] context The SEALContext
+        @param[in] path The path of the file to load the KSwitchKeys from
+        @param[in] max_resident_byte_count The bound on the size of the resident keys in bytes, or zero
+        @throws std::invalid_argument if the encryption parameters are not valid
+        @throws std::logic_error if the file was not written by save_mapped or if
+        its table of keys is invalid
+        @throws std::runtime_error if I/O operations failed
+        */
+        void load_indexed(
+            const SEALContext &context, const std::string &path, std::size_t max_resident_byte_count = 0);
+
+        /**
+        Returns whether the keys were loaded with load_indexed.
+        */
+        SEAL_NODISCARD inline bool is_indexed() const noexcept
+        {
+            return index_ != nullptr;
+        }
+
+        /**
+        Returns the number of bytes taken by the keys that an indexed KSwitchKeys
+        currently holds in memory, or zero if the keys are not indexed.
+        */
+        SEAL_NODISCARD std::size_t resident_byte_count() const;
+
+        /**
+        Returns whether the keys view a file loaded with load_mapped.
+        */
+        SEAL_NODISCARD inline bool is_mapped() const noexcept
+        {
+            return mapping_ != nullptr;
+        }
+
         /**
         Returns the currently used MemoryPoolHandle.
         */
@@ -334,9 +558,24 @@ namespace seal
 
         parms_id_type parms_id_ = parms_id_zero;
 
+        // The keyswitching configuration of the SEALContext the keys were generated for
+        std::size_t special_prime_count_ = 0;
+
+        std::size_t dnum_ = 0;
+
+        std::size_t digit_size_ = 0;
+
         /**
         The vector of keyswitching keys.
         */
         std::vector<std::vector<PublicKey>> keys_{};
+
+        // Keeps a file loaded with load_mapped alive while the keys view it
+        std::shared_ptr<util::MappedFile> mapping_{};
+
+        class KeyIndex;
+
+        // Reads the keys of a file loaded with load_indexed on demand
+        std::shared_ptr<KeyIndex> index_{};
     };
 } // namespace seal
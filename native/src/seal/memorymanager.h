@@ -10,6 +10,7 @@
 #include <stdexcept>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 /*
 For .NET Framework wrapper support (C++/CLI) we need to
@@ -152,14 +153,52 @@ namespace seal
 #endif
         /**
         Returns a MemoryPoolHandle pointing to a new thread-safe memory pool.
+        The allocation policy determines how the memory pool obtains large
+        allocations from the system, e.g., backed by huge pages or placed on a
+        specific NUMA node. Creating one memory pool per NUMA node and using it
+        for the key material and operations of the threads running on that node
+        keeps their memory local.
 
         @param[in] clear_on_destruction Indicates whether the memory pool data
         should be cleared when destroyed. This can be important when memory pools
         are used to store private data.
+        @param[in] alloc_policy The allocation policy of the memory pool
+        @throws std::invalid_argument if alloc_policy is not valid
         */
-        SEAL_NODISCARD inline static MemoryPoolHandle New(bool clear_on_destruction = false)
+        SEAL_NODISCARD inline static MemoryPoolHandle New(
+            bool clear_on_destruction = false, const MemoryPoolAllocPolicy &alloc_policy = MemoryPoolAllocPolicy())
         {
-            return MemoryPoolHandle(std::make_shared<util::MemoryPoolMT>(clear_on_destruction));
+            return MemoryPoolHandle(std::make_shared<util::MemoryPoolMT>(clear_on_destruction, alloc_policy));
+        }
+
+        /**
+        Returns a MemoryPoolHandle pointing to a new single-threaded arena memory
+        pool for short-lived temporaries. The arena serves allocations of all
+        sizes from a stack of bump allocations in constant time and without
+        locking, and reclaims their memory when they are released in reverse
+        order of allocation. Memory released out of order stays reserved until
+        every allocation made after it has been released. The arena grows when
+        it runs out of memory and returns to a single block of the combined
+        size once no allocation is in use.
+
+        An arena must only be used by one thread at a time. This includes the
+        destruction of objects, such as Ciphertext instances, whose data was
+        allocated from it.
+
+        @param[in] byte_count The initial size of the arena in bytes
+        @param[in] clear_on_destruction Indicates whether the memory pool data
+        should be cleared when destroyed. This can be important when memory pools
+        are used to store private data.
+        @param[in] alloc_policy The allocation policy of the memory pool
+        @throws std::invalid_argument if byte_count is too large or alloc_policy
+        is not valid
+        */
+        SEAL_NODISCARD inline static MemoryPoolHandle Arena(
+            std::size_t byte_count = 0, bool clear_on_destruction = false,
+            const MemoryPoolAllocPolicy &alloc_policy = MemoryPoolAllocPolicy())
+        {
+            return MemoryPoolHandle(
+                std::make_shared<util::MemoryPoolArena>(byte_count, clear_on_destruction, alloc_policy));
         }
 
         /**
@@ -200,6 +239,74 @@ namespace seal
             return !pool_ ? std::size_t(0) : pool_->alloc_byte_count();
         }
 
+        /**
+        Returns statistics of the memory pool pointed to by the current
+        MemoryPoolHandle. The returned vector contains one entry for each
+        different allocation size in decreasing order of size. The statistics
+        are a snapshot and can be out of date as soon as they are returned if
+        the memory pool is used concurrently.
+        */
+        SEAL_NODISCARD inline std::vector<MemoryPoolStats> stats() const
+        {
+            return !pool_ ? std::vector<MemoryPoolStats>{} : pool_->stats();
+        }
+
+        /**
+        Returns unused memory to the system. The memory pool allocates memory
+        in batches of items of the same size, and reuses items after they are
+        released instead of returning them to the system. This function frees
+        every batch none of whose items is currently in use and returns the
+        number of bytes freed. This is useful for reducing the memory footprint
+        of long-running applications after a burst of large allocations.
+        */
+        inline std::size_t release_unused()
+        {
+            return !pool_ ? std::size_t(0) : pool_->release_unused();
+        }
+
+        /**
+        Sets a soft limit on the size of allocated memory. When an allocation
+        from the memory pool makes alloc_byte_count() exceed the limit, the
+        memory pool calls release_unused(). Memory in use is never released, so
+        alloc_byte_count() can remain above the limit. A limit of zero means no
+        limit, which is the default.
+
+        @param[in] limit The limit in bytes, or zero for no limit
+        @throws std::logic_error if the MemoryPoolHandle is uninitialized
+        */
+        inline void set_byte_count_limit(std::size_t limit)
+        {
+            if (!pool_)
+            {
+                throw std::logic_error("pool not initialized");
+            }
+            pool_->set_byte_count_limit(limit);
+        }
+
+        /**
+        Returns the limit on the size of allocated memory set with
+        set_byte_count_limit, or zero if there is no limit.
+        */
+        SEAL_NODISCARD inline std::size_t byte_count_limit() const noexcept
+        {
+            return !pool_ ? std::size_t(0) : pool_->byte_count_limit();
+        }
+
+        /**
+        Returns the allocation policy of the memory pool pointed to by the
+        current MemoryPoolHandle.
+
+        @throws std::logic_error if the MemoryPoolHandle is uninitialized
+        */
+        SEAL_NODISCARD inline const MemoryPoolAllocPolicy &alloc_policy() const
+        {
+            if (!pool_)
+            {
+                throw std::logic_error("pool not initialized");
+            }
+            return pool_->alloc_policy();
+        }
+
         /**
         Returns the number of MemoryPoolHandle objects sharing this memory pool.
         */
@@ -387,6 +494,47 @@ namespace seal
     private:
         MemoryPoolHandle pool_;
     };
+
+    /**
+    A memory manager profile that always returns a MemoryPoolHandle pointing to
+    a thread-safe memory pool with a given allocation policy. The profile creates
+    the memory pool once, so that its memory is reused. This profile can be used
+    to back large key material and temporaries with huge pages, or to place them
+    on a specific NUMA node, without passing a MemoryPoolHandle to every call.
+    */
+    class MMProfAllocPolicy : public MMProf
+    {
+    public:
+        /**
+        Creates a new MMProfAllocPolicy.
+
+        @param[in] alloc_policy The allocation policy of the memory pool
+        @param[in] clear_on_destruction Indicates whether the memory pool data
+        should be cleared when destroyed
+        @throws std::invalid_argument if alloc_policy is not valid
+        */
+        MMProfAllocPolicy(const MemoryPoolAllocPolicy &alloc_policy, bool clear_on_destruction = false)
+            : pool_(MemoryPoolHandle::New(clear_on_destruction, alloc_policy))
+        {}
+
+        /**
+        Destroys the MMProfAllocPolicy.
+        */
+        virtual ~MMProfAllocPolicy() noexcept override
+        {}
+
+        /**
+        Returns a MemoryPoolHandle pointing to the memory pool of this profile.
+        The mm_prof_opt_t input parameter has no effect.
+        */
+        SEAL_NODISCARD inline virtual MemoryPoolHandle get_pool(mm_prof_opt_t) override
+        {
+            return pool_;
+        }
+
+    private:
+        MemoryPoolHandle pool_;
+    };
 #ifndef _M_CEE
     /**
     A memory manager profile that always returns a MemoryPoolHandle pointing to
@@ -72,6 +72,7 @@ namespace seal
             uint64_count_ = 1;
             value_ = 0;
             const_ratio_ = { { 0, 0, 0 } };
+            montgomery_inv_ = 0;
             is_prime_ = false;
         }
         else if ((value >> SEAL_MOD_BIT_COUNT_MAX != 0) || (value == 1))
@@ -97,6 +98,19 @@ namespace seal
             // We store also the remainder
             const_ratio_[2] = numerator[0];
 
+            // Compute -value^(-1) mod 2^64 for Montgomery reduction by Newton iteration; each step doubles the
+            // number of correct low bits, starting from the 3 bits that value^(-1) = value mod 8 provides.
+            montgomery_inv_ = 0;
+            if (value_ & 1)
+            {
+                uint64_t inv = value_;
+                for (int i = 0; i < 5; i++)
+                {
+                    inv *= 2 - value_ * inv;
+                }
+                montgomery_inv_ = 0 - inv;
+            }
+
             uint64_count_ = 1;
 
             // Set the primality flag
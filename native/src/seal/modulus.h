@@ -127,6 +127,15 @@ namespace seal
             return const_ratio_;
         }
 
+        /**
+        Returns -value^(-1) mod 2^64, the constant used by Montgomery reduction with respect to 2^64, if the value of
+        the current Modulus is odd. Otherwise returns zero.
+        */
+        SEAL_NODISCARD inline std::uint64_t montgomery_inv() const noexcept
+        {
+            return montgomery_inv_;
+        }
+
         /**
         Returns whether the value of the current Modulus is zero.
         */
@@ -372,6 +381,8 @@ namespace seal
 
         std::array<std::uint64_t, 3> const_ratio_{ { 0, 0, 0 } };
 
+        std::uint64_t montgomery_inv_ = 0;
+
         std::size_t uint64_count_ = 0;
 
         int bit_count_ = 0;
@@ -410,6 +421,28 @@ namespace seal
         tc256 = 256
     };
 
+    /**
+    Selects the modular multiplication Evaluator uses for the dyadic products of
+    NTT-form data. The value mod_arith_type::barrett uses Barrett reduction and is
+    the default. The value mod_arith_type::montgomery converts one operand of each
+    product to Montgomery form and uses Montgomery reduction, but only for primes of
+    more than 30 bits; smaller primes keep the faster single-word Barrett reduction.
+    The NTT always uses Shoup's precomputed quotients. Both produce identical results;
+    the choice only affects performance.
+    */
+    enum class mod_arith_type : std::uint8_t
+    {
+        /**
+        Shoup and Barrett reduction.
+        */
+        barrett = 0,
+
+        /**
+        Montgomery reduction with respect to 2^64.
+        */
+        montgomery = 1
+    };
+
     /**
     This class contains static methods for creating a coefficient modulus easily.
     Note that while these functions take a sec_level_type argument, all security
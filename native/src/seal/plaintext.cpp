@@ -298,6 +298,6 @@ namespace seal
         }
         stream.exceptions(old_except_mask);
 
-        swap(*this, new_data);
+        assign_loaded(new_data);
     }
 } // namespace seal
@@ -98,6 +98,34 @@ namespace seal
             std::size_t capacity, std::size_t coeff_count, MemoryPoolHandle pool = MemoryManager::GetPool())
             : coeff_count_(coeff_count), data_(capacity, coeff_count_, std::move(pool))
         {}
+
+        /**
+        Constructs a plaintext with given coefficient count that views a buffer
+        owned by the caller. The contents of the buffer are left unchanged. A view
+        can be passed to all functions taking a plaintext. They read and write the
+        coefficients directly in the buffer and never reallocate it, so a result
+        that does not fit in buffer_coeff_count coefficients throws
+        std::logic_error. Copies of a view own their data, whereas moving a view,
+        or moving another plaintext into it, transfers the reference to the
+        buffer. The buffer must outlive the view.
+
+        @param[in] coeff_count The number of coefficients in the plaintext
+        polynomial
+        @param[in] buffer The buffer holding the coefficients
+        @param[in] buffer_coeff_count The number of coefficients that fit in the
+        buffer
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if buffer_coeff_count is less than
+        coeff_count
+        @throws std::invalid_argument if buffer is null
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        explicit Plaintext(
+            std::size_t coeff_count, pt_coeff_type *buffer, std::size_t buffer_coeff_count,
+            MemoryPoolHandle pool = MemoryManager::GetPool())
+            : coeff_count_(coeff_count),
+              data_(DynArray<pt_coeff_type>::Aliasing(buffer, buffer_coeff_count, coeff_count, std::move(pool)))
+        {}
 #ifdef SEAL_USE_MSGSL
         /**
         Constructs a plaintext representing a polynomial with given coefficient
@@ -603,18 +631,21 @@ namespace seal
 
         @param[out] stream The stream to save the plaintext to
         @param[in] compr_mode The desired compression mode
+        @param[in] thread_pool The ThreadPool across which the chunked compression
+        modes compress the data, or nullptr
         @throws std::invalid_argument if the compression mode is not supported
         @throws std::logic_error if the data to be saved is invalid, or if
         compression failed
         @throws std::runtime_error if I/O operations failed
         */
         inline std::streamoff save(
-            std::ostream &stream, compr_mode_type compr_mode = Serialization::compr_mode_default) const
+            std::ostream &stream, compr_mode_type compr_mode = Serialization::compr_mode_default,
+            ThreadPool *thread_pool = nullptr) const
         {
             using namespace std::placeholders;
             return Serialization::Save(
                 std::bind(&Plaintext::save_members, this, _1), save_size(compr_mode_type::none), stream, compr_mode,
-                false);
+                false, thread_pool);
         }
 
         /**
@@ -633,7 +664,8 @@ namespace seal
         inline std::streamoff unsafe_load(const SEALContext &context, std::istream &stream)
         {
             using namespace std::placeholders;
-            return Serialization::Load(std::bind(&Plaintext::load_members, this, context, _1, _2), stream, false);
+            return Serialization::Load(
+                std::bind(&Plaintext::load_members, this, context, _1, _2), stream, false, context.thread_pool().get());
         }
 
         /**
@@ -655,7 +687,7 @@ namespace seal
             {
                 throw std::logic_error("Plaintext data is invalid");
             }
-            std::swap(*this, new_data);
+            assign_loaded(new_data);
             return in_size;
         }
 
@@ -666,6 +698,8 @@ namespace seal
         @param[out] out The memory location to write the plaintext to
         @param[in] size The number of bytes available in the given memory location
         @param[in] compr_mode The desired compression mode
+        @param[in] thread_pool The ThreadPool across which the chunked compression
+        modes compress the data, or nullptr
         @throws std::invalid_argument if out is null or if size is too small to
         contain a SEALHeader, or if the compression mode is not supported
         @throws std::logic_error if the data to be saved is invalid, or if
@@ -673,12 +707,13 @@ namespace seal
         @throws std::runtime_error if I/O operations failed
         */
         inline std::streamoff save(
-            seal_byte *out, std::size_t size, compr_mode_type compr_mode = Serialization::compr_mode_default) const
+            seal_byte *out, std::size_t size, compr_mode_type compr_mode = Serialization::compr_mode_default,
+            ThreadPool *thread_pool = nullptr) const
         {
             using namespace std::placeholders;
             return Serialization::Save(
                 std::bind(&Plaintext::save_members, this, _1), save_size(compr_mode_type::none), out, size, compr_mode,
-                false);
+                false, thread_pool);
         }
 
         /**
@@ -700,7 +735,9 @@ namespace seal
         inline std::streamoff unsafe_load(const SEALContext &context, const seal_byte *in, std::size_t size)
         {
             using namespace std::placeholders;
-            return Serialization::Load(std::bind(&Plaintext::load_members, this, context, _1, _2), in, size, false);
+            return Serialization::Load(
+                std::bind(&Plaintext::load_members, this, context, _1, _2), in, size, false,
+                context.thread_pool().get());
         }
 
         /**
@@ -725,7 +762,7 @@ namespace seal
             {
                 throw std::logic_error("Plaintext data is invalid");
             }
-            std::swap(*this, new_data);
+            assign_loaded(new_data);
             return in_size;
         }
 
@@ -778,6 +815,14 @@ namespace seal
             return scale_;
         }
 
+        /**
+        Returns whether the plaintext views a buffer owned by the caller.
+        */
+        SEAL_NODISCARD inline bool is_view() const noexcept
+        {
+            return data_.is_alias();
+        }
+
         /**
         Returns the currently used MemoryPoolHandle.
         */
@@ -792,6 +837,19 @@ namespace seal
         struct PlaintextPrivateHelper;
 
     private:
+        // Replaces the current plaintext with loaded data, which is copied into the buffer of a view
+        inline void assign_loaded(Plaintext &loaded)
+        {
+            if (is_view())
+            {
+                *this = loaded;
+            }
+            else
+            {
+                std::swap(*this, loaded);
+            }
+        }
+
         void save_members(std::ostream &stream) const;
 
         void load_members(const SEALContext &context, std::istream &stream, SEALVersion version);
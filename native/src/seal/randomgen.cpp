@@ -2,8 +2,10 @@
 // Licensed under the MIT license.
 
 #include "seal/randomgen.h"
+#include "seal/util/aes.h"
 #include "seal/util/blake2.h"
 #include "seal/util/common.h"
+#include "seal/util/cpufeatures.h"
 #include "seal/util/fips202.h"
 #include <algorithm>
 #include <iostream>
@@ -167,6 +169,9 @@ namespace seal
         case prng_type::shake256:
             return make_shared<Shake256PRNG>(seed_);
 
+        case prng_type::aes256ctr:
+            return make_shared<Aes256CtrPRNG>(seed_);
+
         case prng_type::unknown:
             return nullptr;
         }
@@ -222,4 +227,28 @@ namespace seal
         seal_memzero(seed_ext.data(), seed_ext.size() * bytes_per_uint64);
         counter_++;
     }
+
+    Aes256CtrPRNG::Aes256CtrPRNG(prng_seed_type seed)
+        : UniformRandomGenerator(seed),
+          round_keys_(aes256_round_key_byte_count, MemoryManager::GetPool(mm_prof_opt::mm_force_new, true))
+    {
+        static_assert(aes256_key_byte_count == 4 * bytes_per_uint64, "unexpected key size");
+        aes256_expand_key(
+            reinterpret_cast<const uint8_t *>(seed_.cbegin()), reinterpret_cast<uint8_t *>(round_keys_.begin()));
+        counter_[0] = seed_[4];
+        counter_[1] = seed_[5];
+    }
+
+    bool Aes256CtrPRNG::IsHardwareAccelerated() noexcept
+    {
+        return cpu_has_aes_ni();
+    }
+
+    void Aes256CtrPRNG::refill_buffer()
+    {
+        // Fill the randomness buffer with the next blocks of keystream
+        aes256_ctr(
+            reinterpret_cast<const uint8_t *>(round_keys_.cbegin()), counter_.data(),
+            buffer_size_ / aes_block_byte_count, reinterpret_cast<uint8_t *>(buffer_begin_));
+    }
 } // namespace seal
@@ -32,7 +32,9 @@ namespace seal
 
         blake2xb = 1,
 
-        shake256 = 2
+        shake256 = 2,
+
+        aes256ctr = 3
     };
 
     /**
@@ -142,6 +144,9 @@ namespace seal
             case prng_type::shake256:
                 /* fall through */
 
+            case prng_type::aes256ctr:
+                /* fall through */
+
             case prng_type::unknown:
                 return true;
             }
@@ -636,4 +641,84 @@ namespace seal
 
     private:
     };
+
+    /**
+    Provides an implementation of UniformRandomGenerator for using AES-256 in
+    counter mode for generating randomness with given seed. The first four words
+    of the seed form the key and the next two words the initial value of the
+    128-bit counter; the remaining words are not used. The keystream is computed
+    with AES-NI on CPUs that support it, and with a much slower constant-time
+    portable implementation otherwise.
+    */
+    class Aes256CtrPRNG : public UniformRandomGenerator
+    {
+    public:
+        /**
+        Creates a new Aes256CtrPRNG instance initialized with the given seed.
+
+        @param[in] seed The seed for the random number generator
+        */
+        Aes256CtrPRNG(prng_seed_type seed);
+
+        /**
+        Destroys the random number generator.
+        */
+        ~Aes256CtrPRNG() = default;
+
+        /**
+        Returns whether the keystream is computed with AES-NI on this machine.
+        */
+        SEAL_NODISCARD static bool IsHardwareAccelerated() noexcept;
+
+    protected:
+        SEAL_NODISCARD prng_type type() const noexcept override
+        {
+            return prng_type::aes256ctr;
+        }
+
+        void refill_buffer() override;
+
+    private:
+        DynArray<seal_byte> round_keys_;
+
+        std::array<std::uint64_t, 2> counter_{};
+    };
+
+    class Aes256CtrPRNGFactory : public UniformRandomGeneratorFactory
+    {
+    public:
+        /**
+        Creates a new Aes256CtrPRNGFactory. The seed will be sampled randomly for
+        each Aes256CtrPRNG instance created by the factory instance, which is
+        desirable in most normal use-cases.
+        */
+        Aes256CtrPRNGFactory() : UniformRandomGeneratorFactory()
+        {}
+
+        /**
+        Creates a new Aes256CtrPRNGFactory and sets the default seed to the given
+        value. For debugging purposes it may sometimes be convenient to have the
+        same randomness be used deterministically and repeatedly. Such randomness
+        sampling is naturally insecure and must be strictly restricted to debugging
+        situations. Thus, most users should never use this constructor.
+
+        @param[in] default_seed The default value for a seed to be used by all
+        created instances of Aes256CtrPRNG
+        */
+        Aes256CtrPRNGFactory(prng_seed_type default_seed) : UniformRandomGeneratorFactory(default_seed)
+        {}
+
+        /**
+        Destroys the random number generator factory.
+        */
+        ~Aes256CtrPRNGFactory() = default;
+
+    protected:
+        SEAL_NODISCARD auto create_impl(prng_seed_type seed) -> std::shared_ptr<UniformRandomGenerator> override
+        {
+            return std::make_shared<Aes256CtrPRNG>(seed);
+        }
+
+    private:
+    };
 } // namespace seal
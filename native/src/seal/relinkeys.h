@@ -73,8 +73,7 @@ namespace seal
         */
         SEAL_NODISCARD inline bool has_key(std::size_t key_power) const
         {
-            std::size_t index = get_index(key_power);
-            return data().size() > index && !data()[index].empty();
+            return contains(get_index(key_power));
         }
 
         /**
@@ -83,6 +82,8 @@ namespace seal
 
         @param[in] key_power The power of the secret key
         @throws std::invalid_argument if the key corresponding to key_power does not exist
+        @throws std::logic_error if the keys were loaded with load_indexed; use
+        acquire instead
         */
         SEAL_NODISCARD inline auto &key(std::size_t key_power) const
         {
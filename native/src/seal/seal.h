@@ -5,11 +5,14 @@
 
 #include "seal/batchencoder.h"
 #include "seal/ciphertext.h"
+#include "seal/ciphertextbatch.h"
 #include "seal/ckks.h"
+#include "seal/compactciphertext.h"
 #include "seal/context.h"
 #include "seal/decryptor.h"
 #include "seal/dynarray.h"
 #include "seal/encryptionparams.h"
+#include "seal/encryptionzeropool.h"
 #include "seal/encryptor.h"
 #include "seal/evaluator.h"
 #include "seal/galoiskeys.h"
@@ -24,5 +27,6 @@
 #include "seal/secretkey.h"
 #include "seal/serializable.h"
 #include "seal/serialization.h"
+#include "seal/threadpool.h"
 #include "seal/valcheck.h"
 #include "seal/version.h"
@@ -4,11 +4,17 @@
 #include "seal/dynarray.h"
 #include "seal/memorymanager.h"
 #include "seal/serialization.h"
+#include "seal/threadpool.h"
 #include "seal/util/common.h"
+#include "seal/util/parallel.h"
+#include "seal/util/pointer.h"
 #include "seal/util/streambuf.h"
 #include "seal/util/ztools.h"
+#include <algorithm>
 #include <stdexcept>
+#include <string>
 #include <typeinfo>
+#include <vector>
 
 using namespace std;
 using namespace seal::util;
@@ -27,6 +33,10 @@ namespace seal
     // symbol is created.
     constexpr uint8_t Serialization::seal_header_size;
 
+    // Required for C++14 compliance: static constexpr member variables are not necessarily inlined so need to ensure
+    // symbol is created.
+    constexpr size_t Serialization::compr_chunk_size;
+
     namespace
     {
         [[noreturn]] void expressive_rethrow_on_ios_base_failure(const ostream &stream)
@@ -80,6 +90,226 @@ namespace seal
             // Generic message
             throw runtime_error("I/O error");
         }
+
+        // Index of the stream word marking streams that save_members and load_members use in packed form
+        int packed_stream_index()
+        {
+            static const int index = ios_base::xalloc();
+            return index;
+        }
+
+        // Marks a stream as packed or not for the lifetime of the scope
+        class PackedStreamScope
+        {
+        public:
+            PackedStreamScope(ios_base &stream, bool packed)
+                : stream_(stream), old_packed_(stream.iword(packed_stream_index()))
+            {
+                stream_.iword(packed_stream_index()) = packed ? 1 : 0;
+            }
+
+            ~PackedStreamScope()
+            {
+                stream_.iword(packed_stream_index()) = old_packed_;
+            }
+
+            PackedStreamScope(const PackedStreamScope &copy) = delete;
+
+            PackedStreamScope &operator=(const PackedStreamScope &assign) = delete;
+
+        private:
+            ios_base &stream_;
+
+            long old_packed_;
+        };
+
+        // Packing never widens a word but adds one byte per block of up to 64 words. Serialized 64-bit words are
+        // preceded by at least 24 bytes of SEALHeader and size, or in_size itself is small, hence the bound.
+        SEAL_NODISCARD size_t packed_size_bound(size_t in_size)
+        {
+            return add_safe(in_size, in_size / 32, size_t(1));
+        }
+#if defined(SEAL_USE_ZLIB) || defined(SEAL_USE_ZSTD)
+        // An entry of the frame index of chunked data
+        struct ChunkFrame
+        {
+            uint64_t size;
+
+            uint64_t compr_size;
+        };
+
+        // Bounds the frame index and the compressed frames of in_size bytes, given a bound for a single frame
+        template <typename FrameSizeBoundT>
+        SEAL_NODISCARD size_t chunked_size_bound(size_t in_size, FrameSizeBoundT &&frame_size_bound)
+        {
+            size_t frame_count = divide_round_up(in_size, Serialization::compr_chunk_size);
+            size_t last_frame_size = in_size % Serialization::compr_chunk_size;
+            return add_safe(
+                sizeof(uint64_t), mul_safe(frame_count, sizeof(ChunkFrame)),
+                mul_safe(in_size / Serialization::compr_chunk_size, frame_size_bound(Serialization::compr_chunk_size)),
+                last_frame_size ? frame_size_bound(last_frame_size) : size_t(0));
+        }
+
+        // Compresses a frame in place
+        void deflate_frame(DynArray<seal_byte> &frame, compr_mode_type compr_mode, MemoryPoolHandle pool)
+        {
+            switch (compr_mode)
+            {
+#ifdef SEAL_USE_ZLIB
+            case compr_mode_type::zlib_chunked:
+                if (auto ret = ztools::zlib_deflate_array_inplace(frame, move(pool)))
+                {
+                    throw logic_error("ZLIB compression failed with error code " + to_string(ret));
+                }
+                break;
+#endif
+#ifdef SEAL_USE_ZSTD
+            case compr_mode_type::zstd_chunked:
+                if (auto ret = ztools::zstd_deflate_array_inplace(frame, move(pool)))
+                {
+                    throw logic_error("Zstandard compression failed with error code " + to_string(ret));
+                }
+                break;
+#endif
+            default:
+                throw invalid_argument("unsupported compression mode");
+            }
+        }
+
+        // Decompresses a frame and returns whether it decompressed to exactly out_size bytes
+        SEAL_NODISCARD bool inflate_frame(
+            const seal_byte *in, size_t in_size, seal_byte *out, size_t out_size, compr_mode_type compr_mode,
+            MemoryPoolHandle pool)
+        {
+            ArrayGetBuffer agbuf(reinterpret_cast<const char *>(in), safe_cast<streamsize>(in_size));
+            istream in_stream(&agbuf);
+            ArrayPutBuffer apbuf(reinterpret_cast<char *>(out), safe_cast<streamsize>(out_size));
+            ostream out_stream(&apbuf);
+            switch (compr_mode)
+            {
+#ifdef SEAL_USE_ZLIB
+            case compr_mode_type::zlib_chunked:
+                return !ztools::zlib_inflate_stream(
+                           in_stream, safe_cast<streamoff>(in_size), out_stream, move(pool)) &&
+                       apbuf.at_end();
+#endif
+#ifdef SEAL_USE_ZSTD
+            case compr_mode_type::zstd_chunked:
+                return !ztools::zstd_inflate_stream(
+                           in_stream, safe_cast<streamoff>(in_size), out_stream, move(pool)) &&
+                       apbuf.at_end();
+#endif
+            default:
+                throw invalid_argument("unsupported compression mode");
+            }
+        }
+
+        // Compresses in_size bytes in frames across thread_pool and writes the completed header, the frame index, and
+        // the compressed frames to stream
+        void save_chunked(
+            const seal_byte *in, size_t in_size, Serialization::SEALHeader &header, ostream &stream,
+            ThreadPool *thread_pool, bool clear_buffers)
+        {
+            size_t frame_count = divide_round_up(in_size, Serialization::compr_chunk_size);
+            auto safe_pool(MemoryManager::GetPool(mm_prof_opt::mm_force_new, clear_buffers));
+            vector<DynArray<seal_byte>> frames(frame_count, DynArray<seal_byte>(safe_pool));
+            parallel_for_each(thread_pool, frame_count, [&](size_t i) {
+                size_t offset = i * Serialization::compr_chunk_size;
+                size_t size = min(in_size - offset, Serialization::compr_chunk_size);
+                frames[i].resize(size, false);
+                copy_n(in + offset, size, frames[i].begin());
+                deflate_frame(frames[i], header.compr_mode, safe_pool);
+            });
+
+            vector<ChunkFrame> frame_index(frame_count);
+            size_t out_size = add_safe(
+                sizeof(Serialization::SEALHeader), sizeof(uint64_t), mul_safe(frame_count, sizeof(ChunkFrame)));
+            for (size_t i = 0; i < frame_count; i++)
+            {
+                frame_index[i].size = static_cast<uint64_t>(min(
+                    in_size - i * Serialization::compr_chunk_size, Serialization::compr_chunk_size));
+                frame_index[i].compr_size = static_cast<uint64_t>(frames[i].size());
+                out_size = add_safe(out_size, frames[i].size());
+            }
+            header.size = static_cast<uint64_t>(out_size);
+
+            uint64_t frame_count64 = static_cast<uint64_t>(frame_count);
+            Serialization::SaveHeader(header, stream);
+            stream.write(reinterpret_cast<const char *>(&frame_count64), sizeof(uint64_t));
+            stream.write(
+                reinterpret_cast<const char *>(frame_index.data()),
+                safe_cast<streamsize>(mul_safe(frame_count, sizeof(ChunkFrame))));
+            for (auto &frame : frames)
+            {
+                stream.write(reinterpret_cast<const char *>(frame.cbegin()), safe_cast<streamsize>(frame.size()));
+            }
+        }
+
+        // Reads the frame index and the compressed frames of in_size bytes from stream and decompresses the frames
+        // across thread_pool into a buffer, on which load_members is then called
+        void load_chunked(
+            const function<void(istream &, SEALVersion)> &load_members, SEALVersion version, istream &stream,
+            uint64_t in_size, compr_mode_type compr_mode, ThreadPool *thread_pool, bool clear_buffers)
+        {
+            uint64_t frame_count = 0;
+            if (in_size < sizeof(uint64_t))
+            {
+                throw logic_error("invalid frame index");
+            }
+            stream.read(reinterpret_cast<char *>(&frame_count), sizeof(uint64_t));
+            in_size -= sizeof(uint64_t);
+            if (frame_count > in_size / sizeof(ChunkFrame))
+            {
+                throw logic_error("invalid frame index");
+            }
+            vector<ChunkFrame> frame_index(safe_cast<size_t>(frame_count));
+            stream.read(
+                reinterpret_cast<char *>(frame_index.data()),
+                safe_cast<streamsize>(mul_safe(frame_index.size(), sizeof(ChunkFrame))));
+            in_size -= frame_count * sizeof(ChunkFrame);
+
+            // Every frame is non-empty and at most compr_chunk_size bytes, and the frames fill the data exactly
+            vector<size_t> in_offsets(frame_index.size());
+            vector<size_t> out_offsets(frame_index.size());
+            uint64_t compr_size = 0;
+            size_t size = 0;
+            for (size_t i = 0; i < frame_index.size(); i++)
+            {
+                if (!frame_index[i].size || frame_index[i].size > Serialization::compr_chunk_size ||
+                    !frame_index[i].compr_size || frame_index[i].compr_size > in_size - compr_size)
+                {
+                    throw logic_error("invalid frame index");
+                }
+                in_offsets[i] = safe_cast<size_t>(compr_size);
+                out_offsets[i] = size;
+                compr_size += frame_index[i].compr_size;
+                size = add_safe(size, static_cast<size_t>(frame_index[i].size));
+            }
+            if (compr_size != in_size)
+            {
+                throw logic_error("invalid frame index");
+            }
+
+            auto safe_pool(MemoryManager::GetPool(mm_prof_opt::mm_force_new, clear_buffers));
+            auto in(allocate<seal_byte>(safe_cast<size_t>(compr_size), safe_pool));
+            stream.read(reinterpret_cast<char *>(in.get()), safe_cast<streamsize>(compr_size));
+
+            SafeByteBuffer safe_buffer(safe_cast<streamsize>(size), clear_buffers);
+            parallel_for_each(thread_pool, frame_index.size(), [&](size_t i) {
+                if (!inflate_frame(
+                        in.get() + in_offsets[i], static_cast<size_t>(frame_index[i].compr_size),
+                        safe_buffer.data() + out_offsets[i], static_cast<size_t>(frame_index[i].size), compr_mode,
+                        safe_pool))
+                {
+                    throw logic_error("stream decompression failed");
+                }
+            });
+
+            iostream temp_stream(&safe_buffer);
+            temp_stream.exceptions(ios_base::badbit | ios_base::failbit);
+            load_members(temp_stream, version);
+        }
+#endif
     } // namespace
 
     size_t Serialization::ComprSizeEstimate(size_t in_size, compr_mode_type compr_mode)
@@ -103,11 +333,29 @@ namespace seal
             // No compression
             return in_size;
 
+        case compr_mode_type::packed:
+            return packed_size_bound(in_size);
+#ifdef SEAL_USE_ZSTD
+        case compr_mode_type::packed_zstd:
+            return ztools::zstd_deflate_size_bound(packed_size_bound(in_size));
+
+        case compr_mode_type::zstd_chunked:
+            return chunked_size_bound(in_size, ztools::zstd_deflate_size_bound<size_t>);
+#endif
+#ifdef SEAL_USE_ZLIB
+        case compr_mode_type::zlib_chunked:
+            return chunked_size_bound(in_size, ztools::zlib_deflate_size_bound<size_t>);
+#endif
         default:
             throw invalid_argument("unsupported compression mode");
         }
     }
 
+    bool Serialization::IsPackedStream(ios_base &stream)
+    {
+        return stream.iword(packed_stream_index()) != 0;
+    }
+
     streamoff Serialization::SaveHeader(const SEALHeader &header, ostream &stream)
     {
         auto old_except_mask = stream.exceptions();
@@ -223,7 +471,7 @@ namespace seal
 
     streamoff Serialization::Save(
         function<void(ostream &)> save_members, streamoff raw_size, ostream &stream, compr_mode_type compr_mode,
-        SEAL_MAYBE_UNUSED bool clear_buffers)
+        SEAL_MAYBE_UNUSED bool clear_buffers, SEAL_MAYBE_UNUSED ThreadPool *thread_pool)
     {
         if (!save_members)
         {
@@ -238,6 +486,12 @@ namespace seal
             throw invalid_argument("unsupported compression mode");
         }
 
+        // Objects nested in packed data are packed as well
+        if (compr_mode == compr_mode_type::none && IsPackedStream(stream))
+        {
+            compr_mode = compr_mode_type::packed;
+        }
+
         streamoff out_size = 0;
 
         auto old_except_mask = stream.exceptions();
@@ -263,6 +517,23 @@ namespace seal
                 // Write rest of the data
                 save_members(stream);
                 break;
+
+            case compr_mode_type::packed:
+            {
+                // The size is known only after packing, so write the header again once the data is written
+                header.compr_mode = compr_mode;
+                SaveHeader(header, stream);
+                {
+                    PackedStreamScope packed_scope(stream, true);
+                    save_members(stream);
+                }
+                auto stream_end_pos = stream.tellp();
+                header.size = safe_cast<uint64_t>(stream_end_pos - stream_start_pos);
+                stream.seekp(stream_start_pos);
+                SaveHeader(header, stream);
+                stream.seekp(stream_end_pos);
+                break;
+            }
 #ifdef SEAL_USE_ZLIB
             case compr_mode_type::zlib:
             {
@@ -284,6 +555,7 @@ namespace seal
 
                 // After compression, write_header_deflate_buffer will write the final size to the given header and
                 // write the header to stream, before writing the compressed output.
+                header.compr_mode = compr_mode;
                 ztools::zlib_write_header_deflate_buffer(
                     safe_buffer_array, reinterpret_cast<void *>(&header), stream, safe_pool);
                 break;
@@ -291,6 +563,8 @@ namespace seal
 #endif
 #ifdef SEAL_USE_ZSTD
             case compr_mode_type::zstd:
+                /* fall through */
+            case compr_mode_type::packed_zstd:
             {
                 // First save_members to a temporary byte stream; set the size of the temporary stream to be right from
                 // the start to avoid extra reallocs.
@@ -299,7 +573,10 @@ namespace seal
                     clear_buffers);
                 iostream temp_stream(&safe_buffer);
                 temp_stream.exceptions(ios_base::badbit | ios_base::failbit);
-                save_members(temp_stream);
+                {
+                    PackedStreamScope packed_scope(temp_stream, compr_mode == compr_mode_type::packed_zstd);
+                    save_members(temp_stream);
+                }
 
                 auto safe_pool(MemoryManager::GetPool(mm_prof_opt::mm_force_new, clear_buffers));
 
@@ -310,10 +587,34 @@ namespace seal
 
                 // After compression, write_header_deflate_buffer will write the final size to the given header and
                 // write the header to stream, before writing the compressed output.
+                header.compr_mode = compr_mode;
                 ztools::zstd_write_header_deflate_buffer(
                     safe_buffer_array, reinterpret_cast<void *>(&header), stream, safe_pool);
                 break;
             }
+#endif
+#if defined(SEAL_USE_ZLIB) || defined(SEAL_USE_ZSTD)
+#ifdef SEAL_USE_ZLIB
+            case compr_mode_type::zlib_chunked:
+                /* fall through */
+#endif
+#ifdef SEAL_USE_ZSTD
+            case compr_mode_type::zstd_chunked:
+                /* fall through */
+#endif
+            {
+                // First save_members to a temporary byte stream as above, then compress it in independent frames
+                SafeByteBuffer safe_buffer(raw_size - static_cast<streamoff>(sizeof(SEALHeader)), clear_buffers);
+                iostream temp_stream(&safe_buffer);
+                temp_stream.exceptions(ios_base::badbit | ios_base::failbit);
+                save_members(temp_stream);
+
+                header.compr_mode = compr_mode;
+                save_chunked(
+                    safe_buffer.data(), static_cast<size_t>(temp_stream.tellp()), header, stream,
+                    thread_pool, clear_buffers);
+                break;
+            }
 #endif
             default:
                 throw invalid_argument("unsupported compression mode");
@@ -339,7 +640,8 @@ namespace seal
     }
 
     streamoff Serialization::Load(
-        function<void(istream &, SEALVersion)> load_members, istream &stream, SEAL_MAYBE_UNUSED bool clear_buffers)
+        function<void(istream &, SEALVersion)> load_members, istream &stream, SEAL_MAYBE_UNUSED bool clear_buffers,
+        SEAL_MAYBE_UNUSED ThreadPool *thread_pool)
     {
         if (!load_members)
         {
@@ -376,13 +678,18 @@ namespace seal
             switch (header.compr_mode)
             {
             case compr_mode_type::none:
+                /* fall through */
+            case compr_mode_type::packed:
+            {
                 // Read rest of the data
+                PackedStreamScope packed_scope(stream, header.compr_mode == compr_mode_type::packed);
                 load_members(stream, version);
                 if (header.size != safe_cast<uint64_t>(stream.tellg() - stream_start_pos))
                 {
                     throw logic_error("invalid data size");
                 }
                 break;
+            }
 #ifdef SEAL_USE_ZLIB
             case compr_mode_type::zlib:
             {
@@ -408,6 +715,8 @@ namespace seal
 #endif
 #ifdef SEAL_USE_ZSTD
             case compr_mode_type::zstd:
+                /* fall through */
+            case compr_mode_type::packed_zstd:
             {
                 auto compr_size = header.size - safe_cast<uint64_t>(stream.tellg() - stream_start_pos);
 
@@ -425,9 +734,31 @@ namespace seal
                 {
                     throw logic_error("stream decompression failed");
                 }
+                PackedStreamScope packed_scope(temp_stream, header.compr_mode == compr_mode_type::packed_zstd);
                 load_members(temp_stream, version);
                 break;
             }
+#endif
+#if defined(SEAL_USE_ZLIB) || defined(SEAL_USE_ZSTD)
+#ifdef SEAL_USE_ZLIB
+            case compr_mode_type::zlib_chunked:
+                /* fall through */
+#endif
+#ifdef SEAL_USE_ZSTD
+            case compr_mode_type::zstd_chunked:
+                /* fall through */
+#endif
+            {
+                auto header_size = safe_cast<uint64_t>(stream.tellg() - stream_start_pos);
+                if (header.size < header_size)
+                {
+                    throw logic_error("invalid data size");
+                }
+                load_chunked(
+                    load_members, version, stream, header.size - header_size, header.compr_mode,
+                    thread_pool, clear_buffers);
+                break;
+            }
 #endif
             default:
                 throw invalid_argument("unsupported compression mode");
@@ -452,7 +783,7 @@ namespace seal
 
     streamoff Serialization::Save(
         function<void(ostream &)> save_members, streamoff raw_size, seal_byte *out, size_t size,
-        compr_mode_type compr_mode, bool clear_buffers)
+        compr_mode_type compr_mode, bool clear_buffers, ThreadPool *thread_pool)
     {
         if (!out)
         {
@@ -468,11 +799,12 @@ namespace seal
         }
         ArrayPutBuffer apbuf(reinterpret_cast<char *>(out), static_cast<streamsize>(size));
         ostream stream(&apbuf);
-        return Save(save_members, raw_size, stream, compr_mode, clear_buffers);
+        return Save(save_members, raw_size, stream, compr_mode, clear_buffers, thread_pool);
     }
 
     streamoff Serialization::Load(
-        function<void(istream &, SEALVersion)> load_members, const seal_byte *in, size_t size, bool clear_buffers)
+        function<void(istream &, SEALVersion)> load_members, const seal_byte *in, size_t size, bool clear_buffers,
+        ThreadPool *thread_pool)
     {
         if (!in)
         {
@@ -488,6 +820,6 @@ namespace seal
         }
         ArrayGetBuffer agbuf(reinterpret_cast<const char *>(in), static_cast<streamsize>(size));
         istream stream(&agbuf);
-        return Load(load_members, stream, clear_buffers);
+        return Load(load_members, stream, clear_buffers, thread_pool);
     }
 } // namespace seal
@@ -12,6 +12,8 @@
 
 namespace seal
 {
+    class ThreadPool;
+
     /**
     A type to describe the compression algorithm applied to serialized data.
     Ciphertext and key data consist of a large number of 64-bit words storing
@@ -31,6 +33,24 @@ namespace seal
 #ifdef SEAL_USE_ZSTD
         // Use Zstandard compression
         zstd = 2,
+#endif
+        // Pack every 64-bit word of ciphertext and key data to the bit width of
+        // the largest word among up to 64 neighbouring words, which for residues
+        // is the bit count of the corresponding coefficient modulus
+        packed = 3,
+#ifdef SEAL_USE_ZSTD
+        // Pack as with compr_mode_type::packed and use Zstandard compression
+        packed_zstd = 4,
+#endif
+#ifdef SEAL_USE_ZLIB
+        // Split the data into frames of Serialization::compr_chunk_size bytes
+        // and compress them independently, and in parallel, with ZLIB
+        zlib_chunked = 5,
+#endif
+#ifdef SEAL_USE_ZSTD
+        // Split the data into frames of Serialization::compr_chunk_size bytes
+        // and compress them independently, and in parallel, with Zstandard
+        zstd_chunked = 6,
 #endif
     };
 
@@ -62,6 +82,13 @@ namespace seal
         */
         static constexpr std::uint8_t seal_header_size = 0x10;
 
+        /**
+        The number of bytes of uncompressed data in each frame written with
+        compr_mode_type::zlib_chunked or compr_mode_type::zstd_chunked. Only the
+        last frame may be smaller.
+        */
+        static constexpr std::size_t compr_chunk_size = 0x100000;
+
         /**
         Struct to contain metadata for serialization comprising the following fields:
 
@@ -72,6 +99,12 @@ namespace seal
         5. a compr_mode_type indicating whether data after the header is compressed (1 byte)
         6. reserved for future use and data alignment (2 bytes)
         7. the size in bytes of the entire serialized object, including the header (8 bytes)
+
+        With compr_mode_type::zlib_chunked and compr_mode_type::zstd_chunked the
+        header is extended by a frame index, which consists of the number of
+        frames (8 bytes) followed by the uncompressed and the compressed size of
+        each frame (8 bytes each). The compressed frames follow the frame index
+        in order, so each frame can be located and decompressed independently.
         */
         struct SEALHeader
         {
@@ -106,10 +139,18 @@ namespace seal
 #ifdef SEAL_USE_ZLIB
             case static_cast<std::uint8_t>(compr_mode_type::zlib):
                 /* fall through */
+            case static_cast<std::uint8_t>(compr_mode_type::zlib_chunked):
+                /* fall through */
 #endif
 #ifdef SEAL_USE_ZSTD
             case static_cast<std::uint8_t>(compr_mode_type::zstd):
+                /* fall through */
+            case static_cast<std::uint8_t>(compr_mode_type::packed_zstd):
+                /* fall through */
+            case static_cast<std::uint8_t>(compr_mode_type::zstd_chunked):
+                /* fall through */
 #endif
+            case static_cast<std::uint8_t>(compr_mode_type::packed):
                 return true;
             }
             return false;
@@ -136,6 +177,16 @@ namespace seal
         */
         SEAL_NODISCARD static std::size_t ComprSizeEstimate(std::size_t in_size, compr_mode_type compr_mode);
 
+        /**
+        Returns true if data is written to or read from the given stream with
+        compr_mode_type::packed or compr_mode_type::packed_zstd, in which case
+        a DynArray of 64-bit words is serialized in packed form. Save and Load
+        mark the stream while save_members and load_members run.
+
+        @param[in] stream The stream passed to save_members or load_members
+        */
+        SEAL_NODISCARD static bool IsPackedStream(std::ios_base &stream);
+
         /**
         Returns true if the SEALHeader has a version number compatible with this version of Microsoft SEAL.
 
@@ -249,6 +300,15 @@ namespace seal
         mode plus the size of SEALHeader. Otherwise the behavior of Save is
         unspecified.
 
+        With compr_mode_type::packed the header is written after save_members
+        has run, so stream must support tellp and seekp. Nested objects that
+        save_members writes with compr_mode_type::none are packed as well.
+
+        With compr_mode_type::zlib_chunked and compr_mode_type::zstd_chunked the
+        output of save_members is compressed in frames of compr_chunk_size bytes
+        across thread_pool, or on the calling thread if thread_pool is nullptr.
+        The output does not depend on thread_pool.
+
         @param[in] save_members A function taking an std::ostream reference as an
         argument, possibly writing some number of bytes into it
         @param[in] raw_size The exact uncompressed output size of save_members
@@ -256,6 +316,8 @@ namespace seal
         @param[out] stream The stream to write to
         @param[in] compr_mode The desired compression mode
         @param[in] clear_buffers Whether internal buffers should be cleared
+        @param[in] thread_pool The ThreadPool across which the chunked compression
+        modes compress the frames, or nullptr
         @throws std::invalid_argument if save_members is invalid
         @throws std::invalid_argument if raw_size is smaller than SEALHeader size
         @throws std::logic_error if the data to be saved is invalid, if compression
@@ -264,7 +326,7 @@ namespace seal
         */
         static std::streamoff Save(
             std::function<void(std::ostream &)> save_members, std::streamoff raw_size, std::ostream &stream,
-            compr_mode_type compr_mode, bool clear_buffers);
+            compr_mode_type compr_mode, bool clear_buffers, ThreadPool *thread_pool = nullptr);
 
         /**
         Deserializes data from stream that was serialized by Save. Once stream has
@@ -278,13 +340,16 @@ namespace seal
         from the std::istream, possibly depending on the SEALVersion object
         @param[in] stream The stream to read from
         @param[in] clear_buffers Whether internal buffers should be cleared
+        @param[in] thread_pool The ThreadPool across which the chunked compression
+        modes decompress the frames, or nullptr
         @throws std::invalid_argument if load_members is invalid
         @throws std::logic_error if the data cannot be loaded by this version of
         Microsoft SEAL, if the loaded data is invalid, or if decompression failed
         @throws std::runtime_error if I/O operations failed
         */
         static std::streamoff Load(
-            std::function<void(std::istream &, SEALVersion)> load_members, std::istream &stream, bool clear_buffers);
+            std::function<void(std::istream &, SEALVersion)> load_members, std::istream &stream, bool clear_buffers,
+            ThreadPool *thread_pool = nullptr);
 
         /**
         Evaluates save_members and compresses the output according to the given
@@ -307,6 +372,8 @@ namespace seal
         @param[in] size The number of bytes available in the given memory location
         @param[in] compr_mode The desired compression mode
         @param[in] clear_buffers Whether internal buffers should be cleared
+        @param[in] thread_pool The ThreadPool across which the chunked compression
+        modes compress the frames, or nullptr
         @throws std::invalid_argument if save_members is invalid, if raw_size or
         size is smaller than SEALHeader size, or if out is null
         @throws std::logic_error if the data to be saved is invalid, if compression
@@ -315,7 +382,7 @@ namespace seal
         */
         static std::streamoff Save(
             std::function<void(std::ostream &)> save_members, std::streamoff raw_size, seal_byte *out, std::size_t size,
-            compr_mode_type compr_mode, bool clear_buffers);
+            compr_mode_type compr_mode, bool clear_buffers, ThreadPool *thread_pool = nullptr);
 
         /**
         Deserializes data from a memory location that was serialized by Save.
@@ -330,6 +397,8 @@ namespace seal
         @param[in] in The memory location to read from
         @param[in] size The number of bytes available in the given memory location
         @param[in] clear_buffers Whether internal buffers should be cleared
+        @param[in] thread_pool The ThreadPool across which the chunked compression
+        modes decompress the frames, or nullptr
         @throws std::invalid_argument if load_members is invalid, if in is null,
         or if size is too small to contain a SEALHeader
         @throws std::logic_error if the data cannot be loaded by this version of
@@ -338,7 +407,7 @@ namespace seal
         */
         static std::streamoff Load(
             std::function<void(std::istream &, SEALVersion)> load_members, const seal_byte *in, std::size_t size,
-            bool clear_buffers);
+            bool clear_buffers, ThreadPool *thread_pool = nullptr);
 
     private:
         Serialization() = delete;
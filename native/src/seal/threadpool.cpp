@@ -0,0 +1,159 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/threadpool.h"
+#include <utility>
+
+using namespace std;
+
+namespace seal
+{
+    namespace
+    {
+        // Set while the current thread executes a loop body of any ThreadPool
+        thread_local bool in_parallel_for = false;
+
+        class ParallelForScope
+        {
+        public:
+            ParallelForScope() noexcept
+            {
+                in_parallel_for = true;
+            }
+
+            ~ParallelForScope() noexcept
+            {
+                in_parallel_for = false;
+            }
+        };
+    } // namespace
+
+    ThreadPool::ThreadPool(size_t thread_count)
+    {
+        if (thread_count > 1)
+        {
+            workers_.reserve(thread_count - 1);
+            for (size_t i = 1; i < thread_count; i++)
+            {
+                workers_.emplace_back(&ThreadPool::worker_loop, this);
+            }
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            lock_guard<mutex> lock(state_mutex_);
+            stop_ = true;
+        }
+        loop_ready_.notify_all();
+        for (auto &worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::parallel_for(size_t count, const function<void(size_t)> &kernel)
+    {
+        auto run_serially = [&]() {
+            for (size_t i = 0; i < count; i++)
+            {
+                kernel(i);
+            }
+        };
+        if (count <= 1 || workers_.empty() || in_parallel_for)
+        {
+            run_serially();
+            return;
+        }
+
+        unique_lock<mutex> loop_lock(loop_mutex_, try_to_lock);
+        if (!loop_lock.owns_lock())
+        {
+            // Another thread is using the workers
+            run_serially();
+            return;
+        }
+
+        {
+            lock_guard<mutex> lock(state_mutex_);
+            kernel_ = &kernel;
+            count_ = count;
+            next_index_.store(0, memory_order_relaxed);
+            error_ = nullptr;
+            busy_workers_ = workers_.size();
+            generation_++;
+        }
+        loop_ready_.notify_all();
+
+        {
+            ParallelForScope scope;
+            run_claimed_indices();
+        }
+
+        exception_ptr error;
+        {
+            unique_lock<mutex> lock(state_mutex_);
+            loop_done_.wait(lock, [this] { return busy_workers_ == 0; });
+            kernel_ = nullptr;
+            error = move(error_);
+            error_ = nullptr;
+        }
+        if (error)
+        {
+            rethrow_exception(error);
+        }
+    }
+
+    void ThreadPool::worker_loop()
+    {
+        ParallelForScope scope;
+        uint64_t seen_generation = 0;
+        while (true)
+        {
+            {
+                unique_lock<mutex> lock(state_mutex_);
+                loop_ready_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+                if (stop_)
+                {
+                    return;
+                }
+                seen_generation = generation_;
+            }
+
+            run_claimed_indices();
+
+            {
+                lock_guard<mutex> lock(state_mutex_);
+                if (!--busy_workers_)
+                {
+                    loop_done_.notify_one();
+                }
+            }
+        }
+    }
+
+    void ThreadPool::run_claimed_indices()
+    {
+        size_t count = count_;
+        for (size_t i = next_index_.fetch_add(1, memory_order_relaxed); i < count;
+             i = next_index_.fetch_add(1, memory_order_relaxed))
+        {
+            try
+            {
+                (*kernel_)(i);
+            }
+            catch (...)
+            {
+                lock_guard<mutex> lock(state_mutex_);
+                if (!error_)
+                {
+                    error_ = current_exception();
+                }
+
+                // Let all threads stop claiming indices
+                next_index_.store(count, memory_order_relaxed);
+            }
+        }
+    }
+} // namespace seal
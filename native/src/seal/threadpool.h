@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/util/defines.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace seal
+{
+    /**
+    A fixed set of worker threads used to parallelize independent loops over RNS components (limbs) inside a single
+    homomorphic operation. A ThreadPool is opt-in: it is passed to the SEALContext constructor, and the Evaluator,
+    Encryptor, Decryptor, and KeyGenerator instances created from that SEALContext then split their per-limb work
+    across the pool.
+
+    @par Scheduling
+    A call to parallel_for publishes a loop to the workers and lets the calling thread participate. Every thread
+    repeatedly claims the next unprocessed index from a shared atomic counter, so threads that finish early take
+    over the remaining work of slower ones and no static partitioning of the loop is needed.
+
+    @par Thread Safety
+    The ThreadPool runs one loop at a time. If parallel_for is called while another loop is running, either
+    concurrently from a different thread or from within a loop body, the call runs serially on the calling thread
+    instead of waiting. This makes nested parallel regions and sharing one pool among several application threads
+    safe, at the cost of parallelism for the callers that lose the race.
+    */
+    class ThreadPool
+    {
+    public:
+        /**
+        Creates a ThreadPool that uses thread_count threads in total, including the thread calling parallel_for.
+        A thread_count of zero or one creates no worker threads, in which case all loops run serially.
+
+        @param[in] thread_count The total number of threads that execute a loop
+        */
+        explicit ThreadPool(std::size_t thread_count = std::thread::hardware_concurrency());
+
+        /**
+        Stops and joins all worker threads.
+        */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &copy) = delete;
+
+        ThreadPool &operator=(const ThreadPool &assign) = delete;
+
+        /**
+        Returns the total number of threads that execute a loop, including the calling thread.
+        */
+        SEAL_NODISCARD inline std::size_t thread_count() const noexcept
+        {
+            return workers_.size() + 1;
+        }
+
+        /**
+        Calls kernel(i) for every i in [0, count), distributing the calls across the worker threads and the calling
+        thread, and returns when all calls have completed. If any call throws, the remaining indices are skipped and
+        the first exception is rethrown on the calling thread.
+
+        @param[in] count The number of loop iterations
+        @param[in] kernel The loop body
+        */
+        void parallel_for(std::size_t count, const std::function<void(std::size_t)> &kernel);
+
+    private:
+        void worker_loop();
+
+        void run_claimed_indices();
+
+        std::vector<std::thread> workers_{};
+
+        // Held by the thread whose loop is currently published to the workers
+        std::mutex loop_mutex_{};
+
+        std::mutex state_mutex_{};
+
+        std::condition_variable loop_ready_{};
+
+        std::condition_variable loop_done_{};
+
+        const std::function<void(std::size_t)> *kernel_ = nullptr;
+
+        std::size_t count_ = 0;
+
+        std::atomic<std::size_t> next_index_{ 0 };
+
+        std::size_t busy_workers_ = 0;
+
+        std::uint64_t generation_ = 0;
+
+        std::exception_ptr error_{};
+
+        bool stop_ = false;
+    };
+} // namespace seal
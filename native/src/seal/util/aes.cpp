@@ -0,0 +1,258 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/util/aes.h"
+#include "seal/util/cpufeatures.h"
+#include <algorithm>
+#include <cstring>
+#ifdef SEAL_USE_AES_NI
+#include <immintrin.h>
+#endif
+
+// The library is not compiled with AES-NI enabled; only the kernel below is, and it is entered only after a run-time
+// CPU check.
+#ifdef SEAL_USE_AES_NI
+#if SEAL_COMPILER == SEAL_COMPILER_MSVC
+#define SEAL_TARGET_AES_NI
+#else
+#define SEAL_TARGET_AES_NI __attribute__((target("aes")))
+#endif
+#endif
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            // The operations below act on eight bytes packed into a 64-bit word, each byte an element of GF(2^8)
+            constexpr uint64_t bytes_lsb = 0x0101010101010101ULL;
+
+            inline uint64_t xtime_bytes(uint64_t x) noexcept
+            {
+                return ((x & (0x7F * bytes_lsb)) << 1) ^ (((x >> 7) & bytes_lsb) * 0x1B);
+            }
+
+            inline uint64_t multiply_bytes(uint64_t a, uint64_t b) noexcept
+            {
+                uint64_t result = 0;
+                for (int i = 0; i < 8; i++)
+                {
+                    result ^= a & (((b >> i) & bytes_lsb) * 0xFF);
+                    a = xtime_bytes(a);
+                }
+                return result;
+            }
+
+            // Computes x^254, which is the inverse of x for non-zero x and zero otherwise
+            inline uint64_t invert_bytes(uint64_t x) noexcept
+            {
+                uint64_t x2 = multiply_bytes(x, x);
+                uint64_t x3 = multiply_bytes(x2, x);
+                uint64_t x6 = multiply_bytes(x3, x3);
+                uint64_t x12 = multiply_bytes(x6, x6);
+                uint64_t x15 = multiply_bytes(x12, x3);
+                uint64_t x30 = multiply_bytes(x15, x15);
+                uint64_t x60 = multiply_bytes(x30, x30);
+                uint64_t x120 = multiply_bytes(x60, x60);
+                uint64_t x240 = multiply_bytes(x120, x120);
+                uint64_t x252 = multiply_bytes(x240, x12);
+                return multiply_bytes(x252, x2);
+            }
+
+            template <int k>
+            inline uint64_t rotate_bytes(uint64_t x) noexcept
+            {
+                return ((x << k) & (((0xFF << k) & 0xFF) * bytes_lsb)) |
+                       ((x >> (8 - k)) & (((1 << k) - 1) * bytes_lsb));
+            }
+
+            inline uint64_t sub_bytes(uint64_t x) noexcept
+            {
+                uint64_t y = invert_bytes(x);
+                return y ^ rotate_bytes<1>(y) ^ rotate_bytes<2>(y) ^ rotate_bytes<3>(y) ^ rotate_bytes<4>(y) ^
+                       (0x63 * bytes_lsb);
+            }
+
+            inline uint8_t xtime(uint8_t x) noexcept
+            {
+                return static_cast<uint8_t>((x << 1) ^ (0x1B & (0U - (x >> 7))));
+            }
+
+            inline void write_counter_block(const uint64_t *counter, uint8_t *block) noexcept
+            {
+                for (size_t i = 0; i < 8; i++)
+                {
+                    block[i] = static_cast<uint8_t>(counter[0] >> (8 * i));
+                    block[i + 8] = static_cast<uint8_t>(counter[1] >> (8 * i));
+                }
+            }
+
+            inline void increment_counter(uint64_t *counter) noexcept
+            {
+                counter[0]++;
+                counter[1] += static_cast<uint64_t>(counter[0] == 0);
+            }
+
+            void encrypt_block(const uint8_t *round_keys, uint8_t *state) noexcept
+            {
+                for (size_t i = 0; i < aes_block_byte_count; i++)
+                {
+                    state[i] ^= round_keys[i];
+                }
+
+                uint8_t temp[aes_block_byte_count];
+                for (size_t round = 1; round <= aes256_round_count; round++)
+                {
+                    // SubBytes
+                    uint64_t words[2];
+                    memcpy(words, state, aes_block_byte_count);
+                    words[0] = sub_bytes(words[0]);
+                    words[1] = sub_bytes(words[1]);
+                    memcpy(state, words, aes_block_byte_count);
+
+                    // ShiftRows; the state is stored column by column
+                    for (size_t c = 0; c < 4; c++)
+                    {
+                        for (size_t r = 0; r < 4; r++)
+                        {
+                            temp[r + 4 * c] = state[r + 4 * ((c + r) & 3)];
+                        }
+                    }
+
+                    // MixColumns, except in the last round
+                    if (round < aes256_round_count)
+                    {
+                        for (size_t c = 0; c < 4; c++)
+                        {
+                            const uint8_t *a = temp + 4 * c;
+                            uint8_t t = a[0] ^ a[1] ^ a[2] ^ a[3];
+                            for (size_t r = 0; r < 4; r++)
+                            {
+                                state[r + 4 * c] = a[r] ^ t ^ xtime(a[r] ^ a[(r + 1) & 3]);
+                            }
+                        }
+                    }
+                    else
+                    {
+                        copy_n(temp, aes_block_byte_count, state);
+                    }
+
+                    // AddRoundKey
+                    const uint8_t *round_key = round_keys + round * aes_block_byte_count;
+                    for (size_t i = 0; i < aes_block_byte_count; i++)
+                    {
+                        state[i] ^= round_key[i];
+                    }
+                }
+            }
+        } // namespace
+
+        void aes256_expand_key(const uint8_t *key, uint8_t *round_keys) noexcept
+        {
+            constexpr size_t key_word_count = aes256_key_byte_count / 4;
+            constexpr size_t round_key_word_count = aes256_round_key_byte_count / 4;
+
+            copy_n(key, aes256_key_byte_count, round_keys);
+            uint8_t rcon = 1;
+            for (size_t i = key_word_count; i < round_key_word_count; i++)
+            {
+                uint8_t temp[4];
+                copy_n(round_keys + 4 * (i - 1), 4, temp);
+                if (i % key_word_count == 0 || i % key_word_count == 4)
+                {
+                    if (i % key_word_count == 0)
+                    {
+                        // RotWord
+                        rotate(temp, temp + 1, temp + 4);
+                    }
+
+                    // SubWord
+                    uint64_t word = 0;
+                    memcpy(&word, temp, 4);
+                    word = sub_bytes(word);
+                    memcpy(temp, &word, 4);
+
+                    if (i % key_word_count == 0)
+                    {
+                        temp[0] ^= rcon;
+                        rcon = xtime(rcon);
+                    }
+                }
+                for (size_t j = 0; j < 4; j++)
+                {
+                    round_keys[4 * i + j] = round_keys[4 * (i - key_word_count) + j] ^ temp[j];
+                }
+            }
+        }
+
+        void aes256_ctr(
+            const uint8_t *round_keys, uint64_t *counter, size_t block_count, uint8_t *destination) noexcept
+        {
+#ifdef SEAL_USE_AES_NI
+            if (cpu_has_aes_ni())
+            {
+                aes256_ctr_aes_ni(round_keys, counter, block_count, destination);
+                return;
+            }
+#endif
+            aes256_ctr_portable(round_keys, counter, block_count, destination);
+        }
+
+        void aes256_ctr_portable(
+            const uint8_t *round_keys, uint64_t *counter, size_t block_count, uint8_t *destination) noexcept
+        {
+            for (size_t i = 0; i < block_count; i++, destination += aes_block_byte_count)
+            {
+                write_counter_block(counter, destination);
+                encrypt_block(round_keys, destination);
+                increment_counter(counter);
+            }
+        }
+
+#ifdef SEAL_USE_AES_NI
+        SEAL_TARGET_AES_NI void aes256_ctr_aes_ni(
+            const uint8_t *round_keys, uint64_t *counter, size_t block_count, uint8_t *destination) noexcept
+        {
+            // Eight independent blocks hide the latency of the AES instructions
+            constexpr size_t lane_count = 8;
+
+            __m128i keys[aes256_round_count + 1];
+            for (size_t round = 0; round <= aes256_round_count; round++)
+            {
+                keys[round] =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(round_keys + round * aes_block_byte_count));
+            }
+
+            __m128i blocks[lane_count];
+            while (block_count)
+            {
+                size_t lanes = min(block_count, lane_count);
+                for (size_t j = 0; j < lanes; j++)
+                {
+                    blocks[j] = _mm_xor_si128(
+                        _mm_set_epi64x(static_cast<long long>(counter[1]), static_cast<long long>(counter[0])),
+                        keys[0]);
+                    increment_counter(counter);
+                }
+                for (size_t round = 1; round < aes256_round_count; round++)
+                {
+                    for (size_t j = 0; j < lanes; j++)
+                    {
+                        blocks[j] = _mm_aesenc_si128(blocks[j], keys[round]);
+                    }
+                }
+                for (size_t j = 0; j < lanes; j++)
+                {
+                    blocks[j] = _mm_aesenclast_si128(blocks[j], keys[aes256_round_count]);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(destination), blocks[j]);
+                    destination += aes_block_byte_count;
+                }
+                block_count -= lanes;
+            }
+        }
+#endif
+    } // namespace util
+} // namespace seal
@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/util/defines.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace seal
+{
+    namespace util
+    {
+        constexpr std::size_t aes_block_byte_count = 16;
+
+        constexpr std::size_t aes256_key_byte_count = 32;
+
+        constexpr std::size_t aes256_round_count = 14;
+
+        constexpr std::size_t aes256_round_key_byte_count = (aes256_round_count + 1) * aes_block_byte_count;
+
+        /**
+        Expands a 256-bit AES key into the round keys for encryption as specified in FIPS-197. The round keys are laid
+        out as the consecutive 16-byte blocks that are added to the state in each round.
+
+        @param[in] key The 32-byte key
+        @param[out] round_keys A buffer of aes256_round_key_byte_count bytes to hold the round keys
+        */
+        void aes256_expand_key(const std::uint8_t *key, std::uint8_t *round_keys) noexcept;
+
+        /**
+        Writes the AES-256 encryptions of block_count consecutive counter blocks to destination and advances the
+        counter past them. The counter block is the 16-byte little-endian encoding of the 128-bit integer with low word
+        counter[0] and high word counter[1]. Uses AES-NI if cpu_has_aes_ni() returns true, and
+        aes256_ctr_portable otherwise.
+
+        @param[in] round_keys The round keys computed by aes256_expand_key
+        @param[in,out] counter The 128-bit counter
+        @param[in] block_count The number of 16-byte blocks to write
+        @param[out] destination A buffer of block_count * aes_block_byte_count bytes
+        */
+        void aes256_ctr(
+            const std::uint8_t *round_keys, std::uint64_t *counter, std::size_t block_count,
+            std::uint8_t *destination) noexcept;
+
+        /**
+        Portable counterpart of aes256_ctr. The S-box is evaluated arithmetically rather than with table lookups, so
+        the running time and memory access pattern do not depend on the key, at the cost of being much slower than
+        AES-NI.
+        */
+        void aes256_ctr_portable(
+            const std::uint8_t *round_keys, std::uint64_t *counter, std::size_t block_count,
+            std::uint8_t *destination) noexcept;
+
+#ifdef SEAL_USE_AES_NI
+        /**
+        AES-NI counterpart of aes256_ctr_portable encrypting eight counter blocks at a time. Must only be called if
+        cpu_has_aes_ni() returns true.
+        */
+        void aes256_ctr_aes_ni(
+            const std::uint8_t *round_keys, std::uint64_t *counter, std::size_t block_count,
+            std::uint8_t *destination) noexcept;
+#endif
+    } // namespace util
+} // namespace seal
@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/util/bitpack.h"
+#include "seal/util/common.h"
+#include "seal/util/uintcore.h"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        void pack_uint_block(const uint64_t *values, size_t count, int bit_width, uint64_t *destination)
+        {
+            if (bit_width == bits_per_uint64)
+            {
+                copy_n(values, count, destination);
+                return;
+            }
+
+            // Accumulate the values in a word and emit it whenever it is full
+            uint64_t acc = 0;
+            int acc_bit_count = 0;
+            for (size_t i = 0; i < count; i++)
+            {
+                uint64_t value = values[i];
+                acc |= value << acc_bit_count;
+                acc_bit_count += bit_width;
+                if (acc_bit_count >= bits_per_uint64)
+                {
+                    *destination++ = acc;
+                    acc_bit_count -= bits_per_uint64;
+                    acc = acc_bit_count ? value >> (bit_width - acc_bit_count) : 0;
+                }
+            }
+            if (acc_bit_count)
+            {
+                *destination = acc;
+            }
+        }
+
+        void unpack_uint_block(const uint64_t *packed, size_t count, int bit_width, uint64_t *destination)
+        {
+            if (bit_width == bits_per_uint64)
+            {
+                copy_n(packed, count, destination);
+                return;
+            }
+            if (!bit_width)
+            {
+                fill_n(destination, count, uint64_t(0));
+                return;
+            }
+
+            // Hold the bits not yet consumed and read the next word only when they run out
+            uint64_t mask = (uint64_t(1) << bit_width) - 1;
+            uint64_t acc = 0;
+            int acc_bit_count = 0;
+            for (size_t i = 0; i < count; i++)
+            {
+                if (acc_bit_count >= bit_width)
+                {
+                    destination[i] = acc & mask;
+                    acc >>= bit_width;
+                    acc_bit_count -= bit_width;
+                }
+                else
+                {
+                    uint64_t next = *packed++;
+                    destination[i] = (acc | (next << acc_bit_count)) & mask;
+                    acc = next >> (bit_width - acc_bit_count);
+                    acc_bit_count += bits_per_uint64 - bit_width;
+                }
+            }
+        }
+
+        void save_packed_uint(const uint64_t *values, size_t count, ostream &stream, MemoryPoolHandle pool)
+        {
+            size_t block_count = (count + bitpack_block_uint64_count - 1) / bitpack_block_uint64_count;
+            auto bit_widths(allocate<uint8_t>(block_count, pool));
+            size_t packed_uint64_count = 0;
+            for (size_t block = 0; block < block_count; block++)
+            {
+                size_t offset = block * bitpack_block_uint64_count;
+                size_t block_size = min(bitpack_block_uint64_count, count - offset);
+                uint64_t block_or = 0;
+                for (size_t i = 0; i < block_size; i++)
+                {
+                    block_or |= values[offset + i];
+                }
+                int bit_width = get_significant_bit_count(block_or);
+                bit_widths[block] = static_cast<uint8_t>(bit_width);
+                packed_uint64_count += get_packed_uint64_count(block_size, bit_width);
+            }
+
+            auto packed(allocate_uint(packed_uint64_count, pool));
+            uint64_t *packed_ptr = packed.get();
+            for (size_t block = 0; block < block_count; block++)
+            {
+                size_t offset = block * bitpack_block_uint64_count;
+                size_t block_size = min(bitpack_block_uint64_count, count - offset);
+                pack_uint_block(values + offset, block_size, bit_widths[block], packed_ptr);
+                packed_ptr += get_packed_uint64_count(block_size, bit_widths[block]);
+            }
+
+            stream.write(reinterpret_cast<const char *>(bit_widths.get()), safe_cast<streamsize>(block_count));
+            stream.write(
+                reinterpret_cast<const char *>(packed.get()),
+                safe_cast<streamsize>(mul_safe(packed_uint64_count, sizeof(uint64_t))));
+        }
+
+        void load_packed_uint(istream &stream, size_t count, uint64_t *destination, MemoryPoolHandle pool)
+        {
+            size_t block_count = (count + bitpack_block_uint64_count - 1) / bitpack_block_uint64_count;
+            auto bit_widths(allocate<uint8_t>(block_count, pool));
+            stream.read(reinterpret_cast<char *>(bit_widths.get()), safe_cast<streamsize>(block_count));
+            size_t packed_uint64_count = 0;
+            for (size_t block = 0; block < block_count; block++)
+            {
+                if (bit_widths[block] > bits_per_uint64)
+                {
+                    throw logic_error("invalid bit width");
+                }
+                size_t block_size = min(bitpack_block_uint64_count, count - block * bitpack_block_uint64_count);
+                packed_uint64_count += get_packed_uint64_count(block_size, bit_widths[block]);
+            }
+
+            auto packed(allocate_uint(packed_uint64_count, pool));
+            stream.read(
+                reinterpret_cast<char *>(packed.get()),
+                safe_cast<streamsize>(mul_safe(packed_uint64_count, sizeof(uint64_t))));
+            const uint64_t *packed_ptr = packed.get();
+            for (size_t block = 0; block < block_count; block++)
+            {
+                size_t offset = block * bitpack_block_uint64_count;
+                size_t block_size = min(bitpack_block_uint64_count, count - offset);
+                unpack_uint_block(packed_ptr, block_size, bit_widths[block], destination + offset);
+                packed_ptr += get_packed_uint64_count(block_size, bit_widths[block]);
+            }
+        }
+    } // namespace util
+} // namespace seal
@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/memorymanager.h"
+#include "seal/util/defines.h"
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+namespace seal
+{
+    namespace util
+    {
+        // Words are packed in blocks of this many words that share one bit width
+        constexpr std::size_t bitpack_block_uint64_count = 64;
+
+        // Returns the number of words holding count values packed to bit_width bits each
+        SEAL_NODISCARD inline std::size_t get_packed_uint64_count(std::size_t count, int bit_width) noexcept
+        {
+            return (count * static_cast<std::size_t>(bit_width) + 63) / 64;
+        }
+
+        // Packs at most bitpack_block_uint64_count values, each less than 2^bit_width, into
+        // get_packed_uint64_count(count, bit_width) words starting from the least significant bits
+        void pack_uint_block(const std::uint64_t *values, std::size_t count, int bit_width, std::uint64_t *destination);
+
+        // Reverses pack_uint_block
+        void unpack_uint_block(
+            const std::uint64_t *packed, std::size_t count, int bit_width, std::uint64_t *destination);
+
+        // Writes count words to a stream packed block by block to the bit width of the largest word in each block.
+        // The output is the bit width of every block (one byte each) followed by the packed blocks. For residues
+        // modulo a prime, the bit width of a block is the bit count of the prime with overwhelming probability.
+        void save_packed_uint(
+            const std::uint64_t *values, std::size_t count, std::ostream &stream, MemoryPoolHandle pool);
+
+        // Reads count words written by save_packed_uint
+        void load_packed_uint(
+            std::istream &stream, std::size_t count, std::uint64_t *destination, MemoryPoolHandle pool);
+    } // namespace util
+} // namespace seal
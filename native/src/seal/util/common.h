@@ -376,6 +376,15 @@ namespace seal
             return (t + (t >> 4)) & 0x0F;
         }
 
+        template <typename T, typename = std::enable_if_t<is_uint64_v<T>>>
+        SEAL_NODISCARD inline constexpr int hamming_weight(T value)
+        {
+            value -= (value >> 1) & T(0x5555555555555555);
+            value = (value & T(0x3333333333333333)) + ((value >> 2) & T(0x3333333333333333));
+            value = (value + (value >> 4)) & T(0x0F0F0F0F0F0F0F0F);
+            return static_cast<int>((value * T(0x0101010101010101)) >> 56);
+        }
+
         template <typename T, typename = std::enable_if_t<is_uint32_v<T> || is_uint64_v<T>>>
         SEAL_NODISCARD inline constexpr T reverse_bits(T operand) noexcept
         {
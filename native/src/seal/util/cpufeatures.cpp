@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/util/cpufeatures.h"
+#if (defined(SEAL_USE_AVX2) || defined(SEAL_USE_AES_NI)) && (SEAL_COMPILER == SEAL_COMPILER_MSVC)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            bool detect_avx2() noexcept
+            {
+#ifdef SEAL_USE_AVX2
+#if SEAL_COMPILER == SEAL_COMPILER_MSVC
+                int regs[4];
+                __cpuid(regs, 0);
+                if (regs[0] < 7)
+                {
+                    return false;
+                }
+
+                // AVX and OSXSAVE must both be set, and the OS must save YMM state on context switches
+                __cpuid(regs, 1);
+                const int avx_osxsave = (1 << 27) | (1 << 28);
+                if ((regs[2] & avx_osxsave) != avx_osxsave || (_xgetbv(0) & 0x6) != 0x6)
+                {
+                    return false;
+                }
+
+                __cpuidex(regs, 7, 0);
+                return (regs[1] & (1 << 5)) != 0;
+#else
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2") != 0;
+#endif
+#else
+                return false;
+#endif
+            }
+
+            bool detect_aes_ni() noexcept
+            {
+#ifdef SEAL_USE_AES_NI
+#if SEAL_COMPILER == SEAL_COMPILER_MSVC
+                int regs[4];
+                __cpuid(regs, 1);
+                return (regs[2] & (1 << 25)) != 0;
+#else
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("aes") != 0;
+#endif
+#else
+                return false;
+#endif
+            }
+        } // namespace
+
+        bool cpu_has_avx2() noexcept
+        {
+            static const bool has_avx2 = detect_avx2();
+            return has_avx2;
+        }
+
+        bool cpu_has_aes_ni() noexcept
+        {
+            static const bool has_aes_ni = detect_aes_ni();
+            return has_aes_ni;
+        }
+    } // namespace util
+} // namespace seal
@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/util/defines.h"
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        Returns true if the library was compiled with AVX2 kernels (SEAL_USE_AVX2) and the executing CPU and operating
+        system support AVX2. The result is computed on first use and cached.
+        */
+        SEAL_NODISCARD bool cpu_has_avx2() noexcept;
+
+        /**
+        Returns true if the library was compiled with AES-NI kernels (SEAL_USE_AES_NI) and the executing CPU supports
+        the AES-NI instructions. The result is computed on first use and cached.
+        */
+        SEAL_NODISCARD bool cpu_has_aes_ni() noexcept;
+    } // namespace util
+} // namespace seal
@@ -355,6 +355,254 @@ namespace seal
                 }
             }
 
+            /**
+            Performs in place a fast multiplication with the DWT matrix, producing exactly the same result as
+            transform_to_rev. Pairs of consecutive layers are merged into radix-4 butterflies so that each pass over
+            values applies two layers while four values are held in registers, halving the memory traffic.
+
+            @param[values] inputs in normal order, outputs in bit-reversed order
+            @param[log_n] log 2 of the DWT size
+            @param[roots] powers of a root in bit-reversed order
+            @param[scalar] an optional scalar that is multiplied to all output values
+            */
+            void transform_to_rev_radix4(
+                ValueType *values, int log_n, const RootType *roots, const ScalarType *scalar = nullptr) const
+            {
+                // constant transform size
+                std::size_t n = std::size_t(1) << log_n;
+                // registers to hold temporary values
+                RootType r0;
+                RootType r1;
+                RootType r2;
+                ValueType u;
+                ValueType v;
+                ValueType a0;
+                ValueType a1;
+                ValueType a2;
+                ValueType a3;
+                // variables for indexing; the layer with m groups uses roots[m], ..., roots[2m - 1]
+                std::size_t gap = n >> 1;
+                std::size_t m = 1;
+
+                // Merge layers m and 2m while both precede the last layer
+                for (; (m << 3) <= n; m <<= 2)
+                {
+                    std::size_t quarter = gap >> 1;
+                    for (std::size_t i = 0; i < m; i++)
+                    {
+                        r0 = roots[m + i];
+                        r1 = roots[(m + i) << 1];
+                        r2 = roots[((m + i) << 1) + 1];
+                        ValueType *x0 = values + (gap << 1) * i;
+                        ValueType *x1 = x0 + quarter;
+                        ValueType *x2 = x0 + gap;
+                        ValueType *x3 = x2 + quarter;
+                        for (std::size_t j = 0; j < quarter; j++)
+                        {
+                            u = arithmetic_.guard(x0[j]);
+                            v = arithmetic_.mul_root(x2[j], r0);
+                            a0 = arithmetic_.add(u, v);
+                            a2 = arithmetic_.sub(u, v);
+                            u = arithmetic_.guard(x1[j]);
+                            v = arithmetic_.mul_root(x3[j], r0);
+                            a1 = arithmetic_.add(u, v);
+                            a3 = arithmetic_.sub(u, v);
+
+                            u = arithmetic_.guard(a0);
+                            v = arithmetic_.mul_root(a1, r1);
+                            x0[j] = arithmetic_.add(u, v);
+                            x1[j] = arithmetic_.sub(u, v);
+                            u = arithmetic_.guard(a2);
+                            v = arithmetic_.mul_root(a3, r2);
+                            x2[j] = arithmetic_.add(u, v);
+                            x3[j] = arithmetic_.sub(u, v);
+                        }
+                    }
+                    gap >>= 2;
+                }
+
+                // A single radix-2 layer remains if the number of layers before the last one is odd
+                if ((m << 1) < n)
+                {
+                    for (std::size_t i = 0; i < m; i++)
+                    {
+                        r0 = roots[m + i];
+                        ValueType *x = values + (gap << 1) * i;
+                        ValueType *y = x + gap;
+                        for (std::size_t j = 0; j < gap; j++)
+                        {
+                            u = arithmetic_.guard(x[j]);
+                            v = arithmetic_.mul_root(y[j], r0);
+                            x[j] = arithmetic_.add(u, v);
+                            y[j] = arithmetic_.sub(u, v);
+                        }
+                    }
+                    m <<= 1;
+                }
+
+                if (scalar != nullptr)
+                {
+                    RootType scaled_r;
+                    for (std::size_t i = 0; i < m; i++)
+                    {
+                        scaled_r = arithmetic_.mul_root_scalar(roots[m + i], *scalar);
+                        u = arithmetic_.mul_scalar(arithmetic_.guard(values[0]), *scalar);
+                        v = arithmetic_.mul_root(values[1], scaled_r);
+                        values[0] = arithmetic_.add(u, v);
+                        values[1] = arithmetic_.sub(u, v);
+                        values += 2;
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = 0; i < m; i++)
+                    {
+                        r0 = roots[m + i];
+                        u = arithmetic_.guard(values[0]);
+                        v = arithmetic_.mul_root(values[1], r0);
+                        values[0] = arithmetic_.add(u, v);
+                        values[1] = arithmetic_.sub(u, v);
+                        values += 2;
+                    }
+                }
+            }
+
+            /**
+            Performs in place a fast multiplication with the DWT matrix, producing exactly the same result as
+            transform_from_rev. Pairs of consecutive layers are merged into radix-4 butterflies so that each pass over
+            values applies two layers while four values are held in registers, halving the memory traffic.
+
+            @param[values] inputs in bit-reversed order, outputs in normal order
+            @param[log_n] log 2 of the DWT size
+            @param[roots] powers of a root in scrambled order
+            @param[scalar] an optional scalar that is multiplied to all output values
+            */
+            void transform_from_rev_radix4(
+                ValueType *values, int log_n, const RootType *roots, const ScalarType *scalar = nullptr) const
+            {
+                // constant transform size
+                std::size_t n = std::size_t(1) << log_n;
+                // registers to hold temporary values
+                RootType r0;
+                RootType r1;
+                RootType r2;
+                ValueType u;
+                ValueType v;
+                ValueType a0;
+                ValueType a1;
+                ValueType a2;
+                ValueType a3;
+                // variables for indexing; the layer with m groups uses roots[n - 2m + 1], ..., roots[n - m]
+                std::size_t gap = 1;
+                std::size_t m = n >> 1;
+
+                // Merge layers m and m / 2 while both precede the last layer
+                for (; m > 2; m >>= 2)
+                {
+                    const RootType *roots_first = roots + (n - (m << 1) + 1);
+                    const RootType *roots_second = roots + (n - m + 1);
+                    if (gap == 1)
+                    {
+                        ValueType *x = values;
+                        for (std::size_t i = 0; i < (m >> 1); i++)
+                        {
+                            r0 = roots_first[i << 1];
+                            r1 = roots_first[(i << 1) + 1];
+                            r2 = roots_second[i];
+                            u = x[0];
+                            v = x[1];
+                            a0 = arithmetic_.guard(arithmetic_.add(u, v));
+                            a1 = arithmetic_.mul_root(arithmetic_.sub(u, v), r0);
+                            u = x[2];
+                            v = x[3];
+                            a2 = arithmetic_.guard(arithmetic_.add(u, v));
+                            a3 = arithmetic_.mul_root(arithmetic_.sub(u, v), r1);
+
+                            x[0] = arithmetic_.guard(arithmetic_.add(a0, a2));
+                            x[2] = arithmetic_.mul_root(arithmetic_.sub(a0, a2), r2);
+                            x[1] = arithmetic_.guard(arithmetic_.add(a1, a3));
+                            x[3] = arithmetic_.mul_root(arithmetic_.sub(a1, a3), r2);
+                            x += 4;
+                        }
+                        gap <<= 2;
+                        continue;
+                    }
+                    for (std::size_t i = 0; i < (m >> 1); i++)
+                    {
+                        r0 = roots_first[i << 1];
+                        r1 = roots_first[(i << 1) + 1];
+                        r2 = roots_second[i];
+                        ValueType *x0 = values + (gap << 2) * i;
+                        ValueType *x1 = x0 + gap;
+                        ValueType *x2 = x1 + gap;
+                        ValueType *x3 = x2 + gap;
+                        for (std::size_t j = 0; j < gap; j++)
+                        {
+                            u = x0[j];
+                            v = x1[j];
+                            a0 = arithmetic_.guard(arithmetic_.add(u, v));
+                            a1 = arithmetic_.mul_root(arithmetic_.sub(u, v), r0);
+                            u = x2[j];
+                            v = x3[j];
+                            a2 = arithmetic_.guard(arithmetic_.add(u, v));
+                            a3 = arithmetic_.mul_root(arithmetic_.sub(u, v), r1);
+
+                            x0[j] = arithmetic_.guard(arithmetic_.add(a0, a2));
+                            x2[j] = arithmetic_.mul_root(arithmetic_.sub(a0, a2), r2);
+                            x1[j] = arithmetic_.guard(arithmetic_.add(a1, a3));
+                            x3[j] = arithmetic_.mul_root(arithmetic_.sub(a1, a3), r2);
+                        }
+                    }
+                    gap <<= 2;
+                }
+
+                // A single radix-2 layer remains if the number of layers before the last one is odd
+                if (m > 1)
+                {
+                    const RootType *roots_layer = roots + (n - (m << 1) + 1);
+                    for (std::size_t i = 0; i < m; i++)
+                    {
+                        r0 = roots_layer[i];
+                        ValueType *x = values + (gap << 1) * i;
+                        ValueType *y = x + gap;
+                        for (std::size_t j = 0; j < gap; j++)
+                        {
+                            u = x[j];
+                            v = y[j];
+                            x[j] = arithmetic_.guard(arithmetic_.add(u, v));
+                            y[j] = arithmetic_.mul_root(arithmetic_.sub(u, v), r0);
+                        }
+                    }
+                    gap <<= 1;
+                }
+
+                // The last layer uses roots[n - 1]
+                r0 = roots[n - 1];
+                ValueType *x = values;
+                ValueType *y = x + gap;
+                if (scalar != nullptr)
+                {
+                    RootType scaled_r = arithmetic_.mul_root_scalar(r0, *scalar);
+                    for (std::size_t j = 0; j < gap; j++)
+                    {
+                        u = arithmetic_.guard(x[j]);
+                        v = y[j];
+                        x[j] = arithmetic_.mul_scalar(arithmetic_.guard(arithmetic_.add(u, v)), *scalar);
+                        y[j] = arithmetic_.mul_root(arithmetic_.sub(u, v), scaled_r);
+                    }
+                }
+                else
+                {
+                    for (std::size_t j = 0; j < gap; j++)
+                    {
+                        u = x[j];
+                        v = y[j];
+                        x[j] = arithmetic_.guard(arithmetic_.add(u, v));
+                        y[j] = arithmetic_.mul_root(arithmetic_.sub(u, v), r0);
+                    }
+                }
+            }
+
         private:
             Arithmetic<ValueType, RootType, ScalarType> arithmetic_;
         };
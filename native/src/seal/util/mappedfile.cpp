@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/util/common.h"
+#include "seal/util/mappedfile.h"
+#include <fstream>
+#include <ios>
+#include <stdexcept>
+#ifdef SEAL_USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        MappedFile::MappedFile(const string &path, MemoryPoolHandle pool)
+        {
+            if (!pool)
+            {
+                throw invalid_argument("pool is uninitialized");
+            }
+#ifdef SEAL_USE_MMAP
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd == -1)
+            {
+                throw runtime_error("I/O error");
+            }
+            struct stat file_stat;
+            if (fstat(fd, &file_stat) == -1)
+            {
+                close(fd);
+                throw runtime_error("I/O error");
+            }
+            size_ = safe_cast<size_t>(file_stat.st_size);
+            if (size_)
+            {
+                void *map = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                if (map == MAP_FAILED)
+                {
+                    close(fd);
+                    throw runtime_error("I/O error");
+                }
+                data_ = reinterpret_cast<seal_byte *>(map);
+                is_mapped_ = true;
+            }
+
+            // The mapping remains valid after the file is closed
+            close(fd);
+#else
+            ifstream stream(path, ios_base::binary | ios_base::ate);
+            if (!stream)
+            {
+                throw runtime_error("I/O error");
+            }
+            size_ = safe_cast<size_t>(static_cast<streamoff>(stream.tellg()));
+            if (size_)
+            {
+                buffer_ = allocate<seal_byte>(size_, pool);
+                data_ = buffer_.get();
+                stream.seekg(0);
+                if (!stream.read(reinterpret_cast<char *>(data_), safe_cast<streamsize>(size_)))
+                {
+                    throw runtime_error("I/O error");
+                }
+            }
+#endif
+        }
+
+        MappedFile::~MappedFile() noexcept
+        {
+#ifdef SEAL_USE_MMAP
+            if (is_mapped_)
+            {
+                munmap(data_, size_);
+            }
+#endif
+        }
+    } // namespace util
+} // namespace seal
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/memorymanager.h"
+#include "seal/util/defines.h"
+#include "seal/util/pointer.h"
+#include <cstddef>
+#include <string>
+
+namespace seal
+{
+    namespace util
+    {
+        // Maps an entire file into memory. The mapping is private and writable: pages that are never written are
+        // shared with every other process mapping the same file through the page cache, and a write only copies the
+        // affected page, leaving the file unchanged. Pages are read from the file when first touched. Without mmap
+        // support the file is instead read into a buffer allocated from the given pool.
+        class MappedFile
+        {
+        public:
+            MappedFile(const std::string &path, MemoryPoolHandle pool = MemoryManager::GetPool());
+
+            ~MappedFile() noexcept;
+
+            MappedFile(const MappedFile &copy) = delete;
+
+            MappedFile &operator=(const MappedFile &assign) = delete;
+
+            SEAL_NODISCARD inline seal_byte *data() noexcept
+            {
+                return data_;
+            }
+
+            SEAL_NODISCARD inline const seal_byte *data() const noexcept
+            {
+                return data_;
+            }
+
+            SEAL_NODISCARD inline std::size_t size() const noexcept
+            {
+                return size_;
+            }
+
+            // Returns true if the file is mapped rather than copied into a buffer
+            SEAL_NODISCARD inline bool is_mapped() const noexcept
+            {
+                return is_mapped_;
+            }
+
+        private:
+            seal_byte *data_ = nullptr;
+
+            std::size_t size_ = 0;
+
+            bool is_mapped_ = false;
+
+            Pointer<seal_byte> buffer_;
+        };
+    } // namespace util
+} // namespace seal
@@ -4,9 +4,21 @@
 #include "seal/util/common.h"
 #include "seal/util/mempool.h"
 #include "seal/util/uintarith.h"
+#include <algorithm>
 #include <cmath>
+#include <functional>
+#include <iterator>
+#include <mutex>
 #include <numeric>
 #include <stdexcept>
+#include <thread>
+#include <utility>
+#ifdef SEAL_USE_HUGE_PAGES
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -26,9 +38,321 @@ namespace seal
         // ensure symbol is created.
         constexpr size_t MemoryPool::first_alloc_count;
 
-        MemoryPoolHeadMT::MemoryPoolHeadMT(size_t item_byte_count, bool clear_on_destruction)
+        namespace
+        {
+            // Assigns thread cache indices to threads when they first use any MemoryPoolHeadMT and takes them back
+            // when the threads exit. The smallest free index is reused, so the indices of the live threads stay
+            // dense and threads collide on a cache only when more of them are alive than there are caches.
+            class ThreadCacheIndexRegistry
+            {
+            public:
+                SEAL_NODISCARD size_t acquire()
+                {
+                    lock_guard<mutex> lock(mutex_);
+                    if (free_indices_.empty())
+                    {
+                        // Make room for the index to be released so that release never allocates
+                        free_indices_.reserve(next_index_ + 1);
+                        return next_index_++;
+                    }
+                    pop_heap(free_indices_.begin(), free_indices_.end(), greater<size_t>());
+                    size_t index = free_indices_.back();
+                    free_indices_.pop_back();
+                    return index;
+                }
+
+                void release(size_t index) noexcept
+                {
+                    lock_guard<mutex> lock(mutex_);
+                    free_indices_.push_back(index);
+                    push_heap(free_indices_.begin(), free_indices_.end(), greater<size_t>());
+                }
+
+            private:
+                mutex mutex_;
+
+                size_t next_index_ = 0;
+
+                // Min-heap of the indices of exited threads
+                vector<size_t> free_indices_;
+            };
+
+            // Never destroyed, so that threads exiting during static destruction can still release their indices
+            ThreadCacheIndexRegistry &thread_cache_index_registry()
+            {
+                static ThreadCacheIndexRegistry *registry = new ThreadCacheIndexRegistry();
+                return *registry;
+            }
+
+            class ThreadCacheIndex
+            {
+            public:
+                ThreadCacheIndex() : index_(thread_cache_index_registry().acquire())
+                {}
+
+                ~ThreadCacheIndex() noexcept
+                {
+                    thread_cache_index_registry().release(index_);
+                }
+
+                SEAL_NODISCARD size_t index() const noexcept
+                {
+                    return index_;
+                }
+
+            private:
+                const size_t index_;
+            };
+
+            thread_local const ThreadCacheIndex thread_cache_index;
+
+            inline void acquire_spin_lock(atomic<bool> &lock) noexcept
+            {
+                bool expected = false;
+                while (!lock.compare_exchange_weak(expected, true, memory_order_acquire))
+                {
+                    expected = false;
+                }
+            }
+
+            inline void delete_items(MemoryPoolItem *first_item) noexcept
+            {
+                while (first_item)
+                {
+                    MemoryPoolItem *next_item = first_item->next();
+                    delete first_item;
+                    first_item = next_item;
+                }
+            }
+
+            using allocation = MemoryPoolHead::allocation;
+
+#ifdef SEAL_USE_HUGE_PAGES
+            constexpr size_t huge_page_byte_count = size_t(1) << 21;
+
+            // Returns whether an allocation is mapped directly from the operating system
+            SEAL_NODISCARD inline bool is_mapped(size_t byte_count, const MemoryPoolAllocPolicy &alloc_policy) noexcept
+            {
+                return (alloc_policy.huge_pages || alloc_policy.numa_node >= 0) &&
+                       byte_count >= alloc_policy.large_alloc_byte_count;
+            }
+
+            SEAL_NODISCARD inline size_t round_up_to_huge_pages(size_t byte_count)
+            {
+                size_t page_count = add_safe(byte_count, huge_page_byte_count - 1) / huge_page_byte_count;
+                return mul_safe(page_count, huge_page_byte_count);
+            }
+#endif
+            // Allocates memory for the items of an allocation according to the allocation policy
+            SEAL_NODISCARD seal_byte *allocate_memory(size_t byte_count, const MemoryPoolAllocPolicy &alloc_policy)
+            {
+#ifdef SEAL_USE_HUGE_PAGES
+                if (is_mapped(byte_count, alloc_policy))
+                {
+                    // Map one extra huge page so that the memory can be aligned to a huge page boundary, which the
+                    // kernel requires to back it with huge pages, and unmap the unaligned ends
+                    size_t mapped_byte_count = round_up_to_huge_pages(byte_count);
+                    size_t map_byte_count = add_safe(mapped_byte_count, huge_page_byte_count);
+                    void *map =
+                        mmap(nullptr, map_byte_count, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                    if (map == MAP_FAILED)
+                    {
+                        throw bad_alloc();
+                    }
+                    uintptr_t map_begin = reinterpret_cast<uintptr_t>(map);
+                    uintptr_t begin = (map_begin + huge_page_byte_count - 1) & ~uintptr_t(huge_page_byte_count - 1);
+                    uintptr_t end = begin + mapped_byte_count;
+                    if (begin != map_begin)
+                    {
+                        munmap(map, begin - map_begin);
+                    }
+                    if (end != map_begin + map_byte_count)
+                    {
+                        munmap(reinterpret_cast<void *>(end), map_begin + map_byte_count - end);
+                    }
+
+                    // Both are requests that leave the memory usable if the kernel cannot honor them, so failures are
+                    // ignored. They take effect when the pages are first touched.
+                    void *ptr = reinterpret_cast<void *>(begin);
+                    if (alloc_policy.huge_pages)
+                    {
+                        madvise(ptr, mapped_byte_count, MADV_HUGEPAGE);
+                    }
+                    if (alloc_policy.numa_node >= 0)
+                    {
+                        constexpr size_t bits_per_mask_word = sizeof(unsigned long) * bits_per_byte;
+                        size_t node = static_cast<size_t>(alloc_policy.numa_node);
+                        vector<unsigned long> nodemask(node / bits_per_mask_word + 1, 0);
+                        nodemask[node / bits_per_mask_word] = 1UL << (node % bits_per_mask_word);
+                        syscall(
+                            SYS_mbind, ptr, mapped_byte_count, MPOL_PREFERRED, nodemask.data(),
+                            nodemask.size() * bits_per_mask_word + 1, 0);
+                    }
+                    return static_cast<seal_byte *>(ptr);
+                }
+#else
+                (void)alloc_policy;
+#endif
+                return SEAL_MALLOC(byte_count);
+            }
+
+            void free_memory(seal_byte *ptr, size_t byte_count, const MemoryPoolAllocPolicy &alloc_policy) noexcept
+            {
+#ifdef SEAL_USE_HUGE_PAGES
+                if (is_mapped(byte_count, alloc_policy))
+                {
+                    munmap(ptr, round_up_to_huge_pages(byte_count));
+                    return;
+                }
+#else
+                (void)byte_count;
+                (void)alloc_policy;
+#endif
+                SEAL_FREE(ptr);
+            }
+
+            void validate_alloc_policy(const MemoryPoolAllocPolicy &alloc_policy)
+            {
+                if (alloc_policy.numa_node < -1)
+                {
+                    throw invalid_argument("invalid NUMA node");
+                }
+            }
+
+            // Returns the number of items in the next allocation when the last one is full
+            size_t next_alloc_size(const vector<allocation> &allocs, size_t item_byte_count)
+            {
+                if (allocs.empty())
+                {
+                    return MemoryPool::first_alloc_count;
+                }
+
+                // Increase allocation size unless we are already at max
+                size_t last_size = allocs.back().size;
+                size_t new_size =
+                    safe_cast<size_t>(ceil(MemoryPool::alloc_size_multiplier * static_cast<double>(last_size)));
+                if (mul_safe(new_size, item_byte_count) > MemoryPool::max_batch_alloc_byte_count)
+                {
+                    new_size = last_size;
+                }
+                return new_size;
+            }
+
+            // Finds the allocations that the free items of a pool head point into
+            class AllocationIndex
+            {
+            public:
+                AllocationIndex(const vector<allocation> &allocs)
+                {
+                    starts_.reserve(allocs.size());
+                    for (size_t i = 0; i < allocs.size(); i++)
+                    {
+                        starts_.emplace_back(allocs[i].data_ptr, i);
+                    }
+                    sort(starts_.begin(), starts_.end(), [](const start_type &a, const start_type &b) {
+                        return less<const seal_byte *>()(a.first, b.first);
+                    });
+                }
+
+                // Returns the index of the allocation containing the item
+                SEAL_NODISCARD size_t find(const MemoryPoolItem *item) const noexcept
+                {
+                    auto it = upper_bound(
+                        starts_.cbegin(), starts_.cend(), item->data(), [](const seal_byte *ptr, const start_type &a) {
+                            return less<const seal_byte *>()(ptr, a.first);
+                        });
+                    return prev(it)->second;
+                }
+
+            private:
+                using start_type = pair<const seal_byte *, size_t>;
+
+                vector<start_type> starts_;
+            };
+
+            void count_free_items(
+                const MemoryPoolItem *first_item, const AllocationIndex &index, vector<size_t> &free_counts) noexcept
+            {
+                for (; first_item; first_item = first_item->next())
+                {
+                    free_counts[index.find(first_item)]++;
+                }
+            }
+
+            // An allocation is idle when every item carved from it is free
+            SEAL_NODISCARD vector<bool> find_idle_allocations(
+                const vector<allocation> &allocs, const vector<size_t> &free_counts)
+            {
+                vector<bool> idle(allocs.size());
+                for (size_t i = 0; i < allocs.size(); i++)
+                {
+                    idle[i] = (free_counts[i] == allocs[i].size - allocs[i].free);
+                }
+                return idle;
+            }
+
+            // Deletes the items pointing into idle allocations and returns their number
+            size_t remove_idle_items(
+                MemoryPoolItem *&first_item, const AllocationIndex &index, const vector<bool> &idle) noexcept
+            {
+                size_t removed_count = 0;
+                MemoryPoolItem **link = &first_item;
+                while (*link)
+                {
+                    MemoryPoolItem *item = *link;
+                    if (idle[index.find(item)])
+                    {
+                        *link = item->next();
+                        delete item;
+                        removed_count++;
+                    }
+                    else
+                    {
+                        link = &item->next();
+                    }
+                }
+                return removed_count;
+            }
+
+            // Frees the idle allocations and returns the number of items they held
+            size_t free_idle_allocations(
+                vector<allocation> &allocs, const vector<bool> &idle, size_t item_byte_count,
+                bool clear_on_destruction, const MemoryPoolAllocPolicy &alloc_policy) noexcept
+            {
+                size_t freed_item_count = 0;
+                size_t kept_count = 0;
+                for (size_t i = 0; i < allocs.size(); i++)
+                {
+                    if (!idle[i])
+                    {
+                        allocs[kept_count++] = allocs[i];
+                        continue;
+                    }
+                    size_t byte_count = mul_safe(item_byte_count, allocs[i].size);
+                    if (clear_on_destruction)
+                    {
+                        seal_memzero(allocs[i].data_ptr, byte_count);
+                    }
+                    free_memory(allocs[i].data_ptr, byte_count, alloc_policy);
+                    freed_item_count += allocs[i].size;
+                }
+                allocs.resize(kept_count);
+                return freed_item_count;
+            }
+        } // namespace
+
+        // Required for C++14 compliance: static constexpr member variables are not necessarily inlined so need to
+        // ensure symbol is created.
+        constexpr size_t MemoryPoolHeadMT::transfer_batch_size;
+
+        MemoryPoolHeadMT::MemoryPoolHeadMT(
+            size_t item_byte_count, bool clear_on_destruction, atomic<size_t> *pool_alloc_byte_count,
+            const MemoryPoolAllocPolicy &alloc_policy)
             : clear_on_destruction_(clear_on_destruction), locked_(false), item_byte_count_(item_byte_count),
-              item_count_(MemoryPool::first_alloc_count), first_item_(nullptr)
+              item_count_(MemoryPool::first_alloc_count), peak_item_count_(MemoryPool::first_alloc_count),
+              total_alloc_count_(1), pool_alloc_byte_count_(pool_alloc_byte_count), alloc_policy_(alloc_policy),
+              thread_cache_count_(max<size_t>(thread::hardware_concurrency(), 1)), free_batches_(nullptr),
+              pop_locked_(false)
         {
             if ((item_byte_count_ == 0) || (item_byte_count_ > MemoryPool::max_batch_alloc_byte_count) ||
                 (mul_safe(item_byte_count_, MemoryPool::first_alloc_count) > MemoryPool::max_batch_alloc_byte_count))
@@ -36,11 +360,14 @@ namespace seal
                 throw invalid_argument("invalid allocation size");
             }
 
+            thread_caches_.reset(new ThreadCache[thread_cache_count_]);
+
             // Initial allocation
             allocation new_alloc;
             try
             {
-                new_alloc.data_ptr = SEAL_MALLOC(mul_safe(MemoryPool::first_alloc_count, item_byte_count_));
+                new_alloc.data_ptr =
+                    allocate_memory(mul_safe(MemoryPool::first_alloc_count, item_byte_count_), alloc_policy_);
             }
             catch (const bad_alloc &)
             {
@@ -53,25 +380,34 @@ namespace seal
             new_alloc.head_ptr = new_alloc.data_ptr;
             allocs_.clear();
             allocs_.push_back(new_alloc);
+            if (pool_alloc_byte_count_)
+            {
+                pool_alloc_byte_count_->fetch_add(MemoryPool::first_alloc_count * item_byte_count_);
+            }
         }
 
         MemoryPoolHeadMT::~MemoryPoolHeadMT() noexcept
         {
-            bool expected = false;
-            while (!locked_.compare_exchange_strong(expected, true, memory_order_acquire))
+            acquire_spin_lock(locked_);
+
+            // Delete the items (but not the memory)
+            for (size_t i = 0; i < thread_cache_count_; i++)
             {
-                expected = false;
+                ThreadCache &cache = thread_caches_[i];
+                acquire_spin_lock(cache.locked);
+                delete_items(cache.first_item);
+                cache.first_item = nullptr;
+                cache.item_count = 0;
             }
 
-            // Delete the items (but not the memory)
-            MemoryPoolItem *curr_item = first_item_;
-            while (curr_item)
+            // Items within a batch are linked by next; the batches are linked by next_batch of their first items
+            MemoryPoolItem *batch = free_batches_.exchange(nullptr, memory_order_acquire);
+            while (batch)
             {
-                MemoryPoolItem *next_item = curr_item->next();
-                delete curr_item;
-                curr_item = next_item;
+                MemoryPoolItem *next_batch = batch->next_batch();
+                delete_items(batch);
+                batch = next_batch;
             }
-            first_item_ = nullptr;
 
             // Do we need to clear the memory?
             if (clear_on_destruction_)
@@ -83,7 +419,7 @@ namespace seal
                     seal_memzero(alloc.data_ptr, curr_alloc_byte_count);
 
                     // Delete this allocation
-                    SEAL_FREE(alloc.data_ptr);
+                    free_memory(alloc.data_ptr, curr_alloc_byte_count, alloc_policy_);
                 }
             }
             else
@@ -92,81 +428,313 @@ namespace seal
                 for (auto &alloc : allocs_)
                 {
                     // Delete this allocation
-                    SEAL_FREE(alloc.data_ptr);
+                    free_memory(alloc.data_ptr, mul_safe(item_byte_count_, alloc.size), alloc_policy_);
                 }
             }
 
             allocs_.clear();
         }
 
-        MemoryPoolItem *MemoryPoolHeadMT::get()
+        auto MemoryPoolHeadMT::thread_cache() const noexcept -> ThreadCache &
+        {
+            return thread_caches_[thread_cache_index.index() % thread_cache_count_];
+        }
+
+        void MemoryPoolHeadMT::push_batches(MemoryPoolItem *first_batch, MemoryPoolItem *last_batch) const noexcept
+        {
+            // Pushing is ABA-safe: the exchange only succeeds if the list head is unchanged, and whatever the head
+            // currently is, linking our batches in front of it is correct.
+            MemoryPoolItem *old_first = free_batches_.load(memory_order_relaxed);
+            do
+            {
+                last_batch->next_batch() = old_first;
+            } while (!free_batches_.compare_exchange_weak(
+                old_first, first_batch, memory_order_release, memory_order_relaxed));
+        }
+
+        MemoryPoolItem *MemoryPoolHeadMT::pop_batch() noexcept
         {
-            bool expected = false;
-            while (!locked_.compare_exchange_strong(expected, true, memory_order_acquire))
+            // Unlinking the first batch with a compare-and-swap is subject to the ABA problem only when the batch is
+            // concurrently popped and pushed again with a different successor, which cannot happen while the poppers
+            // are serialized. Pushes remain lock-free and the lock is held only for the few instructions below.
+            if (!free_batches_.load(memory_order_relaxed))
             {
-                expected = false;
+                return nullptr;
             }
-            MemoryPoolItem *old_first = first_item_;
+            acquire_spin_lock(pop_locked_);
+            MemoryPoolItem *batch = free_batches_.load(memory_order_acquire);
+            while (batch &&
+                   !free_batches_.compare_exchange_weak(
+                       batch, batch->next_batch(), memory_order_acquire, memory_order_acquire))
+            {
+            }
+            pop_locked_.store(false, memory_order_release);
 
-            // Is pool empty?
-            if (old_first == nullptr)
+            if (batch)
             {
-                allocation &last_alloc = allocs_.back();
-                MemoryPoolItem *new_item = nullptr;
-                if (last_alloc.free > 0)
+                batch->next_batch() = nullptr;
+            }
+            return batch;
+        }
+
+        MemoryPoolItem *MemoryPoolHeadMT::allocate_batch()
+        {
+            acquire_spin_lock(locked_);
+            if (allocs_.empty() || allocs_.back().free == 0)
+            {
+                // There is no memory
+                allocation new_alloc;
+                size_t new_size = next_alloc_size(allocs_, item_byte_count_);
+                try
                 {
-                    // Pool is empty; there is memory
-                    new_item = new MemoryPoolItem(last_alloc.head_ptr);
-                    last_alloc.free--;
-                    last_alloc.head_ptr += item_byte_count_;
+                    new_alloc.data_ptr = allocate_memory(new_size * item_byte_count_, alloc_policy_);
+                    new_alloc.size = new_size;
+                    new_alloc.free = new_size;
+                    new_alloc.head_ptr = new_alloc.data_ptr;
+                    allocs_.push_back(new_alloc);
                 }
-                else
+                catch (...)
                 {
-                    // Pool is empty; there is no memory
-                    allocation new_alloc;
-
-                    // Increase allocation size unless we are already at max
-                    size_t new_size = safe_cast<size_t>(
-                        ceil(MemoryPool::alloc_size_multiplier * static_cast<double>(last_alloc.size)));
-                    size_t new_alloc_byte_count = mul_safe(new_size, item_byte_count_);
-                    if (new_alloc_byte_count > MemoryPool::max_batch_alloc_byte_count)
+                    if (new_alloc.data_ptr)
                     {
-                        new_size = last_alloc.size;
-                        new_alloc_byte_count = new_size * item_byte_count_;
+                        free_memory(new_alloc.data_ptr, new_size * item_byte_count_, alloc_policy_);
                     }
+                    locked_.store(false, memory_order_release);
+                    throw;
+                }
+                size_t new_item_count = item_count_.fetch_add(new_size, memory_order_relaxed) + new_size;
+                peak_item_count_ = max(peak_item_count_, new_item_count);
+                total_alloc_count_++;
+                if (pool_alloc_byte_count_)
+                {
+                    pool_alloc_byte_count_->fetch_add(new_size * item_byte_count_);
+                }
+            }
 
-                    try
-                    {
-                        new_alloc.data_ptr = SEAL_MALLOC(new_alloc_byte_count);
-                    }
-                    catch (const bad_alloc &)
-                    {
-                        // Allocation failed; rethrow
-                        throw;
-                    }
+            // Carve the items in address order so that they are handed out in the same order as by MemoryPoolHeadST
+            allocation &alloc = allocs_.back();
+            size_t item_count = min(alloc.free, transfer_batch_size);
+            seal_byte *end_ptr = alloc.head_ptr + item_count * item_byte_count_;
+            MemoryPoolItem *first_item = nullptr;
+            try
+            {
+                for (size_t i = 0; i < item_count; i++)
+                {
+                    end_ptr -= item_byte_count_;
+                    MemoryPoolItem *new_item = new MemoryPoolItem(end_ptr);
+                    new_item->next() = first_item;
+                    first_item = new_item;
+                }
+            }
+            catch (...)
+            {
+                delete_items(first_item);
+                locked_.store(false, memory_order_release);
+                throw;
+            }
+            alloc.free -= item_count;
+            alloc.head_ptr += item_count * item_byte_count_;
+            locked_.store(false, memory_order_release);
+            return first_item;
+        }
 
-                    new_alloc.size = new_size;
-                    new_alloc.free = new_size - 1;
-                    new_alloc.head_ptr = new_alloc.data_ptr + item_byte_count_;
-                    allocs_.push_back(new_alloc);
-                    item_count_ += new_size;
-                    new_item = new MemoryPoolItem(new_alloc.data_ptr);
+        MemoryPoolItem *MemoryPoolHeadMT::get()
+        {
+            ThreadCache &cache = thread_cache();
+            acquire_spin_lock(cache.locked);
+            MemoryPoolItem *old_first = cache.first_item;
+            if (old_first)
+            {
+                // Cache is not empty
+                cache.first_item = old_first->next();
+                cache.item_count--;
+                cache.locked.store(false, memory_order_release);
+                old_first->next() = nullptr;
+                return old_first;
+            }
+            cache.locked.store(false, memory_order_release);
+
+            // Cache is empty; refill it from the shared list, or else from new memory
+            MemoryPoolItem *batch = pop_batch();
+            if (!batch)
+            {
+                batch = allocate_batch();
+            }
+
+            // Keep all but the first item in the cache
+            MemoryPoolItem *rest = batch->next();
+            batch->next() = nullptr;
+            if (rest)
+            {
+                size_t rest_count = 1;
+                MemoryPoolItem *last = rest;
+                while (last->next())
+                {
+                    last = last->next();
+                    rest_count++;
                 }
+                acquire_spin_lock(cache.locked);
+                last->next() = cache.first_item;
+                cache.first_item = rest;
+                cache.item_count += rest_count;
+                cache.locked.store(false, memory_order_release);
+            }
+            return batch;
+        }
 
-                locked_.store(false, memory_order_release);
-                return new_item;
+        void MemoryPoolHeadMT::add(MemoryPoolItem *new_first) noexcept
+        {
+            ThreadCache &cache = thread_cache();
+            acquire_spin_lock(cache.locked);
+            new_first->next() = cache.first_item;
+            cache.first_item = new_first;
+            if (++cache.item_count < 2 * transfer_batch_size)
+            {
+                cache.locked.store(false, memory_order_release);
+                return;
             }
 
-            // Pool is not empty
-            first_item_ = old_first->next();
-            old_first->next() = nullptr;
+            // Cache is full; keep the most recently added items, which are likely to be hot in the CPU cache, and
+            // move the others to the shared list as one batch
+            MemoryPoolItem *last_kept = cache.first_item;
+            for (size_t i = 1; i < cache.item_count - transfer_batch_size; i++)
+            {
+                last_kept = last_kept->next();
+            }
+            MemoryPoolItem *batch = last_kept->next();
+            last_kept->next() = nullptr;
+            cache.item_count -= transfer_batch_size;
+            cache.locked.store(false, memory_order_release);
+
+            push_batches(batch, batch);
+        }
+
+        MemoryPoolItem *MemoryPoolHeadMT::lock_all() const noexcept
+        {
+            // Same order as in get: a thread holding a cache lock never waits for locked_
+            acquire_spin_lock(locked_);
+            for (size_t i = 0; i < thread_cache_count_; i++)
+            {
+                acquire_spin_lock(thread_caches_[i].locked);
+            }
+            acquire_spin_lock(pop_locked_);
+
+            // Items in batches that other threads are transferring at this moment are not seen and count as in use
+            return free_batches_.exchange(nullptr, memory_order_acquire);
+        }
+
+        void MemoryPoolHeadMT::unlock_all(MemoryPoolItem *batches) const noexcept
+        {
+            if (batches)
+            {
+                MemoryPoolItem *last = batches;
+                while (last->next_batch())
+                {
+                    last = last->next_batch();
+                }
+                push_batches(batches, last);
+            }
+            for (size_t i = 0; i < thread_cache_count_; i++)
+            {
+                thread_caches_[i].locked.store(false, memory_order_release);
+            }
+            pop_locked_.store(false, memory_order_release);
             locked_.store(false, memory_order_release);
-            return old_first;
         }
 
-        MemoryPoolHeadST::MemoryPoolHeadST(size_t item_byte_count, bool clear_on_destruction)
+        MemoryPoolStats MemoryPoolHeadMT::stats() const
+        {
+            MemoryPoolStats result;
+            result.item_byte_count = item_byte_count_;
+
+            MemoryPoolItem *batches = lock_all();
+            for (size_t i = 0; i < thread_cache_count_; i++)
+            {
+                result.free_item_count += thread_caches_[i].item_count;
+            }
+            for (const MemoryPoolItem *batch = batches; batch; batch = batch->next_batch())
+            {
+                for (const MemoryPoolItem *item = batch; item; item = item->next())
+                {
+                    result.free_item_count++;
+                }
+            }
+            for (const auto &alloc : allocs_)
+            {
+                result.live_item_count += alloc.size - alloc.free;
+            }
+            result.live_item_count -= result.free_item_count;
+            result.item_count = item_count_.load(memory_order_relaxed);
+            result.peak_byte_count = mul_safe(peak_item_count_, item_byte_count_);
+            result.alloc_count = allocs_.size();
+            result.total_alloc_count = total_alloc_count_;
+            unlock_all(batches);
+            return result;
+        }
+
+        size_t MemoryPoolHeadMT::release_unused()
+        {
+            MemoryPoolItem *batches = lock_all();
+            size_t freed_item_count = 0;
+            try
+            {
+                AllocationIndex index(allocs_);
+                vector<size_t> free_counts(allocs_.size(), 0);
+                for (size_t i = 0; i < thread_cache_count_; i++)
+                {
+                    count_free_items(thread_caches_[i].first_item, index, free_counts);
+                }
+                for (const MemoryPoolItem *batch = batches; batch; batch = batch->next_batch())
+                {
+                    count_free_items(batch, index, free_counts);
+                }
+                vector<bool> idle = find_idle_allocations(allocs_, free_counts);
+
+                for (size_t i = 0; i < thread_cache_count_; i++)
+                {
+                    ThreadCache &cache = thread_caches_[i];
+                    cache.item_count -= remove_idle_items(cache.first_item, index, idle);
+                }
+
+                // Removing items may empty batches or change their first items, so link the batches anew
+                MemoryPoolItem *kept_batches = nullptr;
+                while (batches)
+                {
+                    MemoryPoolItem *batch = batches;
+                    batches = batches->next_batch();
+                    remove_idle_items(batch, index, idle);
+                    if (batch)
+                    {
+                        batch->next_batch() = kept_batches;
+                        kept_batches = batch;
+                    }
+                }
+                batches = kept_batches;
+
+                freed_item_count =
+                    free_idle_allocations(allocs_, idle, item_byte_count_, clear_on_destruction_, alloc_policy_);
+            }
+            catch (...)
+            {
+                unlock_all(batches);
+                throw;
+            }
+            item_count_.fetch_sub(freed_item_count, memory_order_relaxed);
+            if (pool_alloc_byte_count_)
+            {
+                pool_alloc_byte_count_->fetch_sub(freed_item_count * item_byte_count_);
+            }
+            unlock_all(batches);
+            return freed_item_count;
+        }
+
+        MemoryPoolHeadST::MemoryPoolHeadST(
+            size_t item_byte_count, bool clear_on_destruction, atomic<size_t> *pool_alloc_byte_count,
+            const MemoryPoolAllocPolicy &alloc_policy)
             : clear_on_destruction_(clear_on_destruction), item_byte_count_(item_byte_count),
-              item_count_(MemoryPool::first_alloc_count), first_item_(nullptr)
+              item_count_(MemoryPool::first_alloc_count), peak_item_count_(MemoryPool::first_alloc_count),
+              total_alloc_count_(1), pool_alloc_byte_count_(pool_alloc_byte_count), alloc_policy_(alloc_policy),
+              first_item_(nullptr)
         {
             if ((item_byte_count_ == 0) || (item_byte_count_ > MemoryPool::max_batch_alloc_byte_count) ||
                 (mul_safe(item_byte_count_, MemoryPool::first_alloc_count) > MemoryPool::max_batch_alloc_byte_count))
@@ -178,7 +746,8 @@ namespace seal
             allocation new_alloc;
             try
             {
-                new_alloc.data_ptr = SEAL_MALLOC(mul_safe(MemoryPool::first_alloc_count, item_byte_count_));
+                new_alloc.data_ptr =
+                    allocate_memory(mul_safe(MemoryPool::first_alloc_count, item_byte_count_), alloc_policy_);
             }
             catch (const bad_alloc &)
             {
@@ -191,6 +760,10 @@ namespace seal
             new_alloc.head_ptr = new_alloc.data_ptr;
             allocs_.clear();
             allocs_.push_back(new_alloc);
+            if (pool_alloc_byte_count_)
+            {
+                pool_alloc_byte_count_->fetch_add(MemoryPool::first_alloc_count * item_byte_count_);
+            }
         }
 
         MemoryPoolHeadST::~MemoryPoolHeadST() noexcept
@@ -215,7 +788,7 @@ namespace seal
                     seal_memzero(alloc.data_ptr, curr_alloc_byte_count);
 
                     // Delete this allocation
-                    SEAL_FREE(alloc.data_ptr);
+                    free_memory(alloc.data_ptr, curr_alloc_byte_count, alloc_policy_);
                 }
             }
             else
@@ -224,7 +797,7 @@ namespace seal
                 for (auto &alloc : allocs_)
                 {
                     // Delete this allocation
-                    SEAL_FREE(alloc.data_ptr);
+                    free_memory(alloc.data_ptr, mul_safe(item_byte_count_, alloc.size), alloc_policy_);
                 }
             }
 
@@ -238,33 +811,14 @@ namespace seal
             // Is pool empty?
             if (old_first == nullptr)
             {
-                allocation &last_alloc = allocs_.back();
-                MemoryPoolItem *new_item = nullptr;
-                if (last_alloc.free > 0)
-                {
-                    // Pool is empty; there is memory
-                    new_item = new MemoryPoolItem(last_alloc.head_ptr);
-                    last_alloc.free--;
-                    last_alloc.head_ptr += item_byte_count_;
-                }
-                else
+                if (allocs_.empty() || allocs_.back().free == 0)
                 {
                     // Pool is empty; there is no memory
                     allocation new_alloc;
-
-                    // Increase allocation size unless we are already at max
-                    size_t new_size = safe_cast<size_t>(
-                        ceil(MemoryPool::alloc_size_multiplier * static_cast<double>(last_alloc.size)));
-                    size_t new_alloc_byte_count = mul_safe(new_size, item_byte_count_);
-                    if (new_alloc_byte_count > MemoryPool::max_batch_alloc_byte_count)
-                    {
-                        new_size = last_alloc.size;
-                        new_alloc_byte_count = new_size * item_byte_count_;
-                    }
-
+                    size_t new_size = next_alloc_size(allocs_, item_byte_count_);
                     try
                     {
-                        new_alloc.data_ptr = SEAL_MALLOC(new_alloc_byte_count);
+                        new_alloc.data_ptr = allocate_memory(new_size * item_byte_count_, alloc_policy_);
                     }
                     catch (const bad_alloc &)
                     {
@@ -273,13 +827,23 @@ namespace seal
                     }
 
                     new_alloc.size = new_size;
-                    new_alloc.free = new_size - 1;
-                    new_alloc.head_ptr = new_alloc.data_ptr + item_byte_count_;
+                    new_alloc.free = new_size;
+                    new_alloc.head_ptr = new_alloc.data_ptr;
                     allocs_.push_back(new_alloc);
                     item_count_ += new_size;
-                    new_item = new MemoryPoolItem(new_alloc.data_ptr);
+                    peak_item_count_ = max(peak_item_count_, item_count_);
+                    total_alloc_count_++;
+                    if (pool_alloc_byte_count_)
+                    {
+                        pool_alloc_byte_count_->fetch_add(new_size * item_byte_count_);
+                    }
                 }
 
+                // Pool is empty; there is memory
+                allocation &last_alloc = allocs_.back();
+                MemoryPoolItem *new_item = new MemoryPoolItem(last_alloc.head_ptr);
+                last_alloc.free--;
+                last_alloc.head_ptr += item_byte_count_;
                 return new_item;
             }
 
@@ -289,6 +853,43 @@ namespace seal
             return old_first;
         }
 
+        MemoryPoolStats MemoryPoolHeadST::stats() const
+        {
+            MemoryPoolStats result;
+            result.item_byte_count = item_byte_count_;
+            for (const MemoryPoolItem *item = first_item_; item; item = item->next())
+            {
+                result.free_item_count++;
+            }
+            for (const auto &alloc : allocs_)
+            {
+                result.live_item_count += alloc.size - alloc.free;
+            }
+            result.live_item_count -= result.free_item_count;
+            result.item_count = item_count_;
+            result.peak_byte_count = mul_safe(peak_item_count_, item_byte_count_);
+            result.alloc_count = allocs_.size();
+            result.total_alloc_count = total_alloc_count_;
+            return result;
+        }
+
+        size_t MemoryPoolHeadST::release_unused()
+        {
+            AllocationIndex index(allocs_);
+            vector<size_t> free_counts(allocs_.size(), 0);
+            count_free_items(first_item_, index, free_counts);
+            vector<bool> idle = find_idle_allocations(allocs_, free_counts);
+            remove_idle_items(first_item_, index, idle);
+            size_t freed_item_count =
+                free_idle_allocations(allocs_, idle, item_byte_count_, clear_on_destruction_, alloc_policy_);
+            item_count_ -= freed_item_count;
+            if (pool_alloc_byte_count_)
+            {
+                pool_alloc_byte_count_->fetch_sub(freed_item_count * item_byte_count_);
+            }
+            return freed_item_count;
+        }
+
         const size_t MemoryPool::max_single_alloc_byte_count = []() -> size_t {
             int bit_shift = static_cast<int>(ceil(log2(MemoryPool::alloc_size_multiplier)));
             if (bit_shift < 0 || unsigned_geq(bit_shift, sizeof(size_t) * static_cast<size_t>(bits_per_byte)))
@@ -307,6 +908,26 @@ namespace seal
             return numeric_limits<size_t>::max() >> bit_shift;
         }();
 
+        void MemoryPool::release_unused_over_limit()
+        {
+            // Skip the work if nothing was allocated since the limit was last enforced, which happens when the memory
+            // in use alone exceeds the limit
+            size_t byte_count = pool_alloc_byte_count_.load(memory_order_relaxed);
+            if (byte_count <= byte_count_limit_.load(memory_order_relaxed) ||
+                byte_count == enforced_byte_count_.load(memory_order_relaxed))
+            {
+                return;
+            }
+            release_unused();
+            enforced_byte_count_.store(pool_alloc_byte_count_.load(memory_order_relaxed), memory_order_relaxed);
+        }
+
+        MemoryPoolMT::MemoryPoolMT(bool clear_on_destruction, const MemoryPoolAllocPolicy &alloc_policy)
+            : clear_on_destruction_(clear_on_destruction), alloc_policy_(alloc_policy)
+        {
+            validate_alloc_policy(alloc_policy_);
+        }
+
         MemoryPoolMT::~MemoryPoolMT() noexcept
         {
             WriterLock lock(pools_locker_.acquire_write());
@@ -347,7 +968,10 @@ namespace seal
                 }
                 else
                 {
-                    return Pointer<seal_byte>(mid_head);
+                    Pointer<seal_byte> result(mid_head);
+                    reader_lock.unlock();
+                    enforce_byte_count_limit();
+                    return result;
                 }
             }
             reader_lock.unlock();
@@ -371,7 +995,10 @@ namespace seal
                 }
                 else
                 {
-                    return Pointer<seal_byte>(mid_head);
+                    Pointer<seal_byte> result(mid_head);
+                    writer_lock.unlock();
+                    enforce_byte_count_limit();
+                    return result;
                 }
             }
 
@@ -382,7 +1009,8 @@ namespace seal
                 throw runtime_error("maximum pool head count reached");
             }
 
-            MemoryPoolHead *new_head = new MemoryPoolHeadMT(byte_count, clear_on_destruction_);
+            MemoryPoolHead *new_head =
+                new MemoryPoolHeadMT(byte_count, clear_on_destruction_, &pool_alloc_byte_count_, alloc_policy_);
             if (!pools_.empty())
             {
                 pools_.insert(pools_.begin() + static_cast<ptrdiff_t>(start), new_head);
@@ -392,7 +1020,10 @@ namespace seal
                 pools_.emplace_back(new_head);
             }
 
-            return Pointer<seal_byte>(new_head);
+            Pointer<seal_byte> result(new_head);
+            writer_lock.unlock();
+            enforce_byte_count_limit();
+            return result;
         }
 
         size_t MemoryPoolMT::alloc_byte_count() const
@@ -404,6 +1035,37 @@ namespace seal
             });
         }
 
+        vector<MemoryPoolStats> MemoryPoolMT::stats() const
+        {
+            ReaderLock lock(pools_locker_.acquire_read());
+
+            vector<MemoryPoolStats> result;
+            result.reserve(pools_.size());
+            for (MemoryPoolHead *head : pools_)
+            {
+                result.push_back(head->stats());
+            }
+            return result;
+        }
+
+        size_t MemoryPoolMT::release_unused()
+        {
+            ReaderLock lock(pools_locker_.acquire_read());
+
+            size_t byte_count = 0;
+            for (MemoryPoolHead *head : pools_)
+            {
+                byte_count += head->release_unused() * head->item_byte_count();
+            }
+            return byte_count;
+        }
+
+        MemoryPoolST::MemoryPoolST(bool clear_on_destruction, const MemoryPoolAllocPolicy &alloc_policy)
+            : clear_on_destruction_(clear_on_destruction), alloc_policy_(alloc_policy)
+        {
+            validate_alloc_policy(alloc_policy_);
+        }
+
         MemoryPoolST::~MemoryPoolST() noexcept
         {
             for (MemoryPoolHead *head : pools_)
@@ -442,7 +1104,9 @@ namespace seal
                 }
                 else
                 {
-                    return Pointer<seal_byte>(mid_head);
+                    Pointer<seal_byte> result(mid_head);
+                    enforce_byte_count_limit();
+                    return result;
                 }
             }
 
@@ -453,7 +1117,8 @@ namespace seal
                 throw runtime_error("maximum pool head count reached");
             }
 
-            MemoryPoolHead *new_head = new MemoryPoolHeadST(byte_count, clear_on_destruction_);
+            MemoryPoolHead *new_head =
+                new MemoryPoolHeadST(byte_count, clear_on_destruction_, &pool_alloc_byte_count_, alloc_policy_);
             if (!pools_.empty())
             {
                 pools_.insert(pools_.begin() + static_cast<ptrdiff_t>(start), new_head);
@@ -463,7 +1128,9 @@ namespace seal
                 pools_.emplace_back(new_head);
             }
 
-            return Pointer<seal_byte>(new_head);
+            Pointer<seal_byte> result(new_head);
+            enforce_byte_count_limit();
+            return result;
         }
 
         size_t MemoryPoolST::alloc_byte_count() const
@@ -472,5 +1139,303 @@ namespace seal
                 return add_safe(byte_count, mul_safe(head->item_count(), head->item_byte_count()));
             });
         }
+
+        vector<MemoryPoolStats> MemoryPoolST::stats() const
+        {
+            vector<MemoryPoolStats> result;
+            result.reserve(pools_.size());
+            for (MemoryPoolHead *head : pools_)
+            {
+                result.push_back(head->stats());
+            }
+            return result;
+        }
+
+        size_t MemoryPoolST::release_unused()
+        {
+            size_t byte_count = 0;
+            for (MemoryPoolHead *head : pools_)
+            {
+                byte_count += head->release_unused() * head->item_byte_count();
+            }
+            return byte_count;
+        }
+
+        // Required for C++14 compliance: static constexpr member variables are not necessarily inlined so need to
+        // ensure symbol is created.
+        constexpr size_t MemoryPoolHeadArena::arena_alignment;
+
+        MemoryPoolHeadArena::MemoryPoolHeadArena(
+            size_t byte_count, bool clear_on_destruction, atomic<size_t> *pool_alloc_byte_count,
+            const MemoryPoolAllocPolicy &alloc_policy)
+            : clear_on_destruction_(clear_on_destruction), pool_alloc_byte_count_(pool_alloc_byte_count),
+              alloc_policy_(alloc_policy)
+        {
+            if (byte_count > MemoryPool::max_batch_alloc_byte_count)
+            {
+                throw invalid_argument("invalid allocation size");
+            }
+            if (byte_count)
+            {
+                add_chunk(0, reserved_byte_count(byte_count));
+            }
+        }
+
+        MemoryPoolHeadArena::~MemoryPoolHeadArena() noexcept
+        {
+            // Delete the items that are not in use (but not the memory)
+            MemoryPoolItem *curr_item = spare_items_;
+            while (curr_item)
+            {
+                MemoryPoolItem *next_item = curr_item->next();
+                delete curr_item;
+                curr_item = next_item;
+            }
+            spare_items_ = nullptr;
+            for (auto &curr_entry : entries_)
+            {
+                if (curr_entry.released)
+                {
+                    delete curr_entry.item;
+                }
+            }
+            entries_.clear();
+
+            // Delete the memory
+            while (!chunks_.empty())
+            {
+                free_chunk(chunks_.size() - 1);
+            }
+        }
+
+        size_t MemoryPoolHeadArena::reserved_byte_count(size_t byte_count)
+        {
+            return mul_safe(add_safe(byte_count, arena_alignment - 1) / arena_alignment, arena_alignment);
+        }
+
+        size_t MemoryPoolHeadArena::find_entry(const MemoryPoolItem *item) const noexcept
+        {
+            // Items are usually released in reverse order, so start from the top
+            for (size_t index = entries_.size(); index--;)
+            {
+                if (entries_[index].item == item)
+                {
+                    return index;
+                }
+            }
+            return entries_.size();
+        }
+
+        size_t MemoryPoolHeadArena::item_byte_count_of(const MemoryPoolItem *item) const noexcept
+        {
+            size_t index = find_entry(item);
+            return index < entries_.size() ? entries_[index].byte_count : size_t(0);
+        }
+
+        MemoryPoolItem *MemoryPoolHeadArena::get()
+        {
+            if (entries_.empty() && chunks_.size() > 1)
+            {
+                coalesce_chunks();
+            }
+
+            // Move to the next chunk if the item does not fit in the current one
+            size_t byte_count = reserved_byte_count(next_byte_count_);
+            if (chunks_.empty())
+            {
+                add_chunk(0, byte_count);
+                curr_chunk_ = 0;
+            }
+            else if (byte_count > chunks_[curr_chunk_].byte_count - chunks_[curr_chunk_].used_byte_count)
+            {
+                size_t index = chunks_[curr_chunk_].used_byte_count ? curr_chunk_ + 1 : curr_chunk_;
+                if (index == chunks_.size() || chunks_[index].byte_count < byte_count)
+                {
+                    // The chunks after the current one are empty, so a chunk that is too small can be replaced
+                    size_t new_byte_count = max(byte_count, alloc_byte_count());
+                    if (index < chunks_.size())
+                    {
+                        free_chunk(index);
+                    }
+                    add_chunk(index, new_byte_count);
+                }
+                curr_chunk_ = index;
+            }
+
+            chunk &curr = chunks_[curr_chunk_];
+            seal_byte *data = curr.data_ptr + curr.used_byte_count;
+            MemoryPoolItem *item = spare_items_;
+            if (item)
+            {
+                spare_items_ = item->next();
+                item->set_data(data);
+            }
+            else
+            {
+                item = new MemoryPoolItem(data);
+            }
+
+            try
+            {
+                entries_.push_back({ item, curr_chunk_, next_byte_count_, false });
+            }
+            catch (...)
+            {
+                item->next() = spare_items_;
+                spare_items_ = item;
+                throw;
+            }
+            curr.used_byte_count += byte_count;
+            return item;
+        }
+
+        void MemoryPoolHeadArena::add(MemoryPoolItem *new_first) noexcept
+        {
+            size_t index = find_entry(new_first);
+            if (index == entries_.size())
+            {
+                return;
+            }
+            entries_[index].released = true;
+
+            // Reclaim the memory of all released items at the top of the stack
+            while (!entries_.empty() && entries_.back().released)
+            {
+                entry &top = entries_.back();
+                chunks_[top.chunk_index].used_byte_count -= reserved_byte_count(top.byte_count);
+                top.item->next() = spare_items_;
+                spare_items_ = top.item;
+                entries_.pop_back();
+            }
+            while (curr_chunk_ && !chunks_[curr_chunk_].used_byte_count)
+            {
+                curr_chunk_--;
+            }
+        }
+
+        MemoryPoolStats MemoryPoolHeadArena::stats() const
+        {
+            MemoryPoolStats result;
+            result.item_byte_count = arena_alignment;
+            result.item_count = alloc_byte_count() / arena_alignment;
+            for (const auto &curr_entry : entries_)
+            {
+                size_t item_count = reserved_byte_count(curr_entry.byte_count) / arena_alignment;
+                if (curr_entry.released)
+                {
+                    result.free_item_count += item_count;
+                }
+                else
+                {
+                    result.live_item_count += item_count;
+                }
+            }
+            result.peak_byte_count = peak_byte_count_;
+            result.alloc_count = chunks_.size();
+            result.total_alloc_count = total_alloc_count_;
+            return result;
+        }
+
+        size_t MemoryPoolHeadArena::release_unused()
+        {
+            // Only the chunks after the current one, or all of them if no item is in use, are empty
+            size_t keep_count = entries_.empty() ? 0 : curr_chunk_ + 1;
+            size_t freed_byte_count = 0;
+            while (chunks_.size() > keep_count)
+            {
+                freed_byte_count += chunks_.back().byte_count;
+                free_chunk(chunks_.size() - 1);
+            }
+            if (chunks_.empty())
+            {
+                curr_chunk_ = 0;
+            }
+            return freed_byte_count / arena_alignment;
+        }
+
+        size_t MemoryPoolHeadArena::alloc_byte_count() const noexcept
+        {
+            size_t byte_count = 0;
+            for (const auto &curr : chunks_)
+            {
+                byte_count += curr.byte_count;
+            }
+            return byte_count;
+        }
+
+        void MemoryPoolHeadArena::add_chunk(size_t index, size_t byte_count)
+        {
+            if (byte_count > MemoryPool::max_batch_alloc_byte_count)
+            {
+                throw invalid_argument("invalid allocation size");
+            }
+            seal_byte *data_ptr = allocate_memory(byte_count, alloc_policy_);
+            try
+            {
+                chunks_.insert(chunks_.begin() + static_cast<ptrdiff_t>(index), { data_ptr, byte_count, 0 });
+            }
+            catch (...)
+            {
+                free_memory(data_ptr, byte_count, alloc_policy_);
+                throw;
+            }
+            total_alloc_count_++;
+            peak_byte_count_ = max(peak_byte_count_, alloc_byte_count());
+            if (pool_alloc_byte_count_)
+            {
+                pool_alloc_byte_count_->fetch_add(byte_count);
+            }
+        }
+
+        void MemoryPoolHeadArena::free_chunk(size_t index) noexcept
+        {
+            chunk &curr = chunks_[index];
+            if (clear_on_destruction_)
+            {
+                seal_memzero(curr.data_ptr, curr.byte_count);
+            }
+            free_memory(curr.data_ptr, curr.byte_count, alloc_policy_);
+            if (pool_alloc_byte_count_)
+            {
+                pool_alloc_byte_count_->fetch_sub(curr.byte_count);
+            }
+            chunks_.erase(chunks_.begin() + static_cast<ptrdiff_t>(index));
+        }
+
+        void MemoryPoolHeadArena::coalesce_chunks()
+        {
+            size_t byte_count = alloc_byte_count();
+            while (!chunks_.empty())
+            {
+                free_chunk(chunks_.size() - 1);
+            }
+            curr_chunk_ = 0;
+            add_chunk(0, byte_count);
+        }
+
+        MemoryPoolArena::MemoryPoolArena(
+            size_t byte_count, bool clear_on_destruction, const MemoryPoolAllocPolicy &alloc_policy)
+            : alloc_policy_(alloc_policy),
+              head_(byte_count, clear_on_destruction, &pool_alloc_byte_count_, alloc_policy_)
+        {
+            validate_alloc_policy(alloc_policy_);
+        }
+
+        Pointer<seal_byte> MemoryPoolArena::get_for_byte_count(size_t byte_count)
+        {
+            if (byte_count > MemoryPool::max_single_alloc_byte_count)
+            {
+                throw invalid_argument("invalid allocation size");
+            }
+            else if (byte_count == 0)
+            {
+                return Pointer<seal_byte>();
+            }
+
+            head_.set_next_byte_count(byte_count);
+            Pointer<seal_byte> result(&head_);
+            enforce_byte_count_limit();
+            return result;
+        }
     } // namespace util
 } // namespace seal
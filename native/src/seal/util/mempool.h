@@ -9,6 +9,7 @@
 #include "seal/util/locks.h"
 #include <algorithm>
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <limits>
@@ -20,6 +21,81 @@
 
 namespace seal
 {
+    /**
+    Statistics of the allocations of one size made by a memory pool. A memory pool obtains memory from the system
+    in allocations that each hold one or more items of the same byte size. Items are handed out to the library and
+    returned to the pool for reuse, but the memory is only returned to the system when the pool is destroyed or
+    when unused allocations are explicitly released.
+    */
+    struct MemoryPoolStats
+    {
+        /**
+        The byte size of the items.
+        */
+        std::size_t item_byte_count = 0;
+
+        /**
+        The number of items that fit in the memory currently allocated from the system.
+        */
+        std::size_t item_count = 0;
+
+        /**
+        The number of items currently in use.
+        */
+        std::size_t live_item_count = 0;
+
+        /**
+        The number of items that were returned to the pool and are waiting to be reused. The remaining
+        item_count - live_item_count - free_item_count items have never been used.
+        */
+        std::size_t free_item_count = 0;
+
+        /**
+        The largest number of bytes ever allocated from the system at once.
+        */
+        std::size_t peak_byte_count = 0;
+
+        /**
+        The number of allocations currently held.
+        */
+        std::size_t alloc_count = 0;
+
+        /**
+        The total number of allocations made from the system, including the released ones.
+        */
+        std::uint64_t total_alloc_count = 0;
+    };
+
+    /**
+    Controls how a memory pool obtains large allocations from the system. Key material and key switching temporaries
+    for large encryption parameters occupy up to gigabytes of memory that is accessed with little locality. Backing
+    such allocations with 2 MB transparent huge pages reduces TLB misses, and placing them on the NUMA node of the
+    cores that use them avoids remote memory accesses.
+
+    Allocations of at least large_alloc_byte_count bytes are mapped directly from the operating system, aligned to
+    2 MB boundaries, when huge_pages is set or numa_node is non-negative. Smaller allocations and all allocations
+    with the default policy use the regular allocator. Huge pages and NUMA placement are only available on Linux and
+    are requests to the kernel: if transparent huge pages are disabled or the NUMA node does not exist, the memory is
+    backed by regular pages with default placement instead. On other platforms the policy has no effect.
+    */
+    struct MemoryPoolAllocPolicy
+    {
+        /**
+        Whether to back large allocations with transparent huge pages.
+        */
+        bool huge_pages = false;
+
+        /**
+        The NUMA node on which the memory of large allocations is preferably placed, or -1 for the default placement.
+        */
+        int numa_node = -1;
+
+        /**
+        The smallest allocation size in bytes to which the policy applies.
+        */
+        std::size_t large_alloc_byte_count = std::size_t(1) << 21;
+    };
+
     namespace util
     {
         template <typename T = void, typename = std::enable_if_t<std::is_standard_layout<T>::value>>
@@ -47,6 +123,12 @@ namespace seal
                 return data_;
             }
 
+            // Points a recycled item of MemoryPoolHeadArena to new memory
+            inline void set_data(seal_byte *data) noexcept
+            {
+                data_ = data;
+            }
+
             SEAL_NODISCARD inline MemoryPoolItem *&next() noexcept
             {
                 return next_;
@@ -57,6 +139,17 @@ namespace seal
                 return next_;
             }
 
+            // Links the first items of batches of items in the shared free list of MemoryPoolHeadMT
+            SEAL_NODISCARD inline MemoryPoolItem *&next_batch() noexcept
+            {
+                return next_batch_;
+            }
+
+            SEAL_NODISCARD inline const MemoryPoolItem *next_batch() const noexcept
+            {
+                return next_batch_;
+            }
+
         private:
             MemoryPoolItem(const MemoryPoolItem &copy) = delete;
 
@@ -65,6 +158,8 @@ namespace seal
             seal_byte *data_ = nullptr;
 
             MemoryPoolItem *next_ = nullptr;
+
+            MemoryPoolItem *next_batch_ = nullptr;
         };
 
         class MemoryPoolHead
@@ -94,6 +189,13 @@ namespace seal
             // Byte size of the allocations (items) owned by this pool
             virtual std::size_t item_byte_count() const noexcept = 0;
 
+            // Byte size of an item handed out by this pool; pool heads serving items of different sizes override it
+            SEAL_NODISCARD virtual std::size_t item_byte_count_of(const MemoryPoolItem *item) const noexcept
+            {
+                (void)item;
+                return item_byte_count();
+            }
+
             // Total number of items allocated
             virtual std::size_t item_count() const noexcept = 0;
 
@@ -101,13 +203,37 @@ namespace seal
 
             // Return item back to this pool
             virtual void add(MemoryPoolItem *new_first) noexcept = 0;
+
+            // Returns a snapshot of the statistics of this pool
+            virtual MemoryPoolStats stats() const = 0;
+
+            // Frees the allocations none of whose items is in use and returns the number of items they held
+            virtual std::size_t release_unused() = 0;
         };
 
+        /*
+        Thread-safe pool head. Free items are kept in small per-thread caches that serve get and add without any
+        shared writes. A cache that grows beyond twice transfer_batch_size items moves a batch of transfer_batch_size
+        items to a shared lock-free list of batches, and an empty cache takes a whole batch from that list before
+        falling back to carving new items from the allocations.
+
+        The caches are owned by the head and threads are mapped to them by a per-thread index, so a cache is shared
+        only when more threads are alive than there are caches. This keeps the lifetime of cached items tied to the
+        head. The shared list is a Treiber stack of batches with lock-free pushes and pops serialized by a spin lock,
+        which makes it immune to the ABA problem without double-width atomics.
+        */
         class MemoryPoolHeadMT : public MemoryPoolHead
         {
         public:
-            // Creates a new MemoryPoolHeadMT with allocation for one single item.
-            MemoryPoolHeadMT(std::size_t item_byte_count, bool clear_on_destruction = false);
+            // Number of items moved at once between a per-thread cache and the shared list
+            static constexpr std::size_t transfer_batch_size = 16;
+
+            // Creates a new MemoryPoolHeadMT with allocation for one single item. If pool_alloc_byte_count is given,
+            // the bytes allocated and released by this pool head are added to and subtracted from it.
+            MemoryPoolHeadMT(
+                std::size_t item_byte_count, bool clear_on_destruction = false,
+                std::atomic<std::size_t> *pool_alloc_byte_count = nullptr,
+                const MemoryPoolAllocPolicy &alloc_policy = MemoryPoolAllocPolicy());
 
             ~MemoryPoolHeadMT() noexcept override;
 
@@ -120,47 +246,87 @@ namespace seal
             // Returns the total number of items allocated
             SEAL_NODISCARD inline std::size_t item_count() const noexcept override
             {
-                return item_count_;
+                return item_count_.load(std::memory_order_relaxed);
             }
 
             MemoryPoolItem *get() override;
 
-            inline void add(MemoryPoolItem *new_first) noexcept override
-            {
-                bool expected = false;
-                while (!locked_.compare_exchange_strong(expected, true, std::memory_order_acquire))
-                {
-                    expected = false;
-                }
-                MemoryPoolItem *old_first = first_item_;
-                new_first->next() = old_first;
-                first_item_ = new_first;
-                locked_.store(false, std::memory_order_release);
-            }
+            void add(MemoryPoolItem *new_first) noexcept override;
+
+            SEAL_NODISCARD MemoryPoolStats stats() const override;
+
+            std::size_t release_unused() override;
 
         private:
+            // Free items used by one or more threads; aligned to avoid false sharing
+            struct alignas(64) ThreadCache
+            {
+                std::atomic<bool> locked{ false };
+
+                MemoryPoolItem *first_item = nullptr;
+
+                std::size_t item_count = 0;
+            };
+
             MemoryPoolHeadMT(const MemoryPoolHeadMT &copy) = delete;
 
             MemoryPoolHeadMT &operator=(const MemoryPoolHeadMT &assign) = delete;
 
+            SEAL_NODISCARD ThreadCache &thread_cache() const noexcept;
+
+            // Pushes a list of batches linked by next_batch onto the shared list
+            void push_batches(MemoryPoolItem *first_batch, MemoryPoolItem *last_batch) const noexcept;
+
+            // Returns a batch from the shared list, or nullptr if the shared list is empty
+            SEAL_NODISCARD MemoryPoolItem *pop_batch() noexcept;
+
+            // Creates up to transfer_batch_size new items linked by next, allocating memory if needed
+            SEAL_NODISCARD MemoryPoolItem *allocate_batch();
+
+            // Acquires all locks and takes the shared list, so that all free items are accessible
+            MemoryPoolItem *lock_all() const noexcept;
+
+            // Releases all locks and returns the given batches to the shared list
+            void unlock_all(MemoryPoolItem *batches) const noexcept;
+
             const bool clear_on_destruction_;
 
+            // Protects allocs_, peak_item_count_, and total_alloc_count_
             mutable std::atomic<bool> locked_;
 
             const std::size_t item_byte_count_;
 
-            volatile std::size_t item_count_;
+            std::atomic<std::size_t> item_count_;
+
+            std::size_t peak_item_count_;
+
+            std::uint64_t total_alloc_count_;
+
+            std::atomic<std::size_t> *pool_alloc_byte_count_;
+
+            const MemoryPoolAllocPolicy alloc_policy_;
 
             std::vector<allocation> allocs_;
 
-            MemoryPoolItem *volatile first_item_;
+            const std::size_t thread_cache_count_;
+
+            std::unique_ptr<ThreadCache[]> thread_caches_;
+
+            mutable std::atomic<MemoryPoolItem *> free_batches_;
+
+            // Serializes pops from free_batches_ with each other and with lock_all
+            mutable std::atomic<bool> pop_locked_;
         };
 
         class MemoryPoolHeadST : public MemoryPoolHead
         {
         public:
-            // Creates a new MemoryPoolHeadST with allocation for one single item.
-            MemoryPoolHeadST(std::size_t item_byte_count, bool clear_on_destruction = false);
+            // Creates a new MemoryPoolHeadST with allocation for one single item. If pool_alloc_byte_count is given,
+            // the bytes allocated and released by this pool head are added to and subtracted from it.
+            MemoryPoolHeadST(
+                std::size_t item_byte_count, bool clear_on_destruction = false,
+                std::atomic<std::size_t> *pool_alloc_byte_count = nullptr,
+                const MemoryPoolAllocPolicy &alloc_policy = MemoryPoolAllocPolicy());
 
             ~MemoryPoolHeadST() noexcept override;
 
@@ -184,6 +350,10 @@ namespace seal
                 first_item_ = new_first;
             }
 
+            SEAL_NODISCARD MemoryPoolStats stats() const override;
+
+            std::size_t release_unused() override;
+
         private:
             MemoryPoolHeadST(const MemoryPoolHeadST &copy) = delete;
 
@@ -195,11 +365,144 @@ namespace seal
 
             std::size_t item_count_;
 
+            std::size_t peak_item_count_;
+
+            std::uint64_t total_alloc_count_;
+
+            std::atomic<std::size_t> *pool_alloc_byte_count_;
+
+            const MemoryPoolAllocPolicy alloc_policy_;
+
             std::vector<allocation> allocs_;
 
             MemoryPoolItem *first_item_;
         };
 
+        /*
+        Single-threaded pool head that serves items of any size from a stack of bump allocations. Each get reserves
+        the byte count last set with set_next_byte_count at the top of the current chunk of memory, rounded up to
+        arena_alignment bytes, and the reservation is reclaimed when it is released in last-in-first-out order.
+        Items released out of order are only marked; their memory is reclaimed once every item above them has been
+        released, so items that outlive an operation remain valid and merely keep the memory beneath them in use.
+
+        When the current chunk is full, a new chunk at least as large as all chunks together is added. Once no item
+        is in use the chunks are replaced by a single one of their combined size, so after the first use of the
+        largest operation every later operation is served from one chunk without touching the system allocator.
+        */
+        class MemoryPoolHeadArena : public MemoryPoolHead
+        {
+        public:
+            // Alignment in bytes of every item, which is also the granularity of the arena statistics
+            static constexpr std::size_t arena_alignment = 64;
+
+            // Creates a new MemoryPoolHeadArena with an initial chunk of at least byte_count bytes. If
+            // pool_alloc_byte_count is given, the bytes allocated and released by this pool head are added to and
+            // subtracted from it.
+            MemoryPoolHeadArena(
+                std::size_t byte_count, bool clear_on_destruction = false,
+                std::atomic<std::size_t> *pool_alloc_byte_count = nullptr,
+                const MemoryPoolAllocPolicy &alloc_policy = MemoryPoolAllocPolicy());
+
+            ~MemoryPoolHeadArena() noexcept override;
+
+            // Sets the byte count of the item returned by the next call to get
+            inline void set_next_byte_count(std::size_t byte_count) noexcept
+            {
+                next_byte_count_ = byte_count;
+            }
+
+            // Byte size of the most recently requested item
+            SEAL_NODISCARD inline std::size_t item_byte_count() const noexcept override
+            {
+                return next_byte_count_;
+            }
+
+            SEAL_NODISCARD std::size_t item_byte_count_of(const MemoryPoolItem *item) const noexcept override;
+
+            // Returns the number of items on the stack
+            SEAL_NODISCARD inline std::size_t item_count() const noexcept override
+            {
+                return entries_.size();
+            }
+
+            SEAL_NODISCARD MemoryPoolItem *get() override;
+
+            void add(MemoryPoolItem *new_first) noexcept override;
+
+            // Reports the memory in units of arena_alignment bytes
+            SEAL_NODISCARD MemoryPoolStats stats() const override;
+
+            std::size_t release_unused() override;
+
+            // Returns the total byte count of the chunks
+            SEAL_NODISCARD std::size_t alloc_byte_count() const noexcept;
+
+        private:
+            MemoryPoolHeadArena(const MemoryPoolHeadArena &copy) = delete;
+
+            MemoryPoolHeadArena &operator=(const MemoryPoolHeadArena &assign) = delete;
+
+            struct chunk
+            {
+                seal_byte *data_ptr;
+
+                std::size_t byte_count;
+
+                // Number of bytes reserved from the start of the chunk
+                std::size_t used_byte_count;
+            };
+
+            struct entry
+            {
+                MemoryPoolItem *item;
+
+                std::size_t chunk_index;
+
+                // Requested byte count of the item
+                std::size_t byte_count;
+
+                // Whether the item was released while items above it were still in use
+                bool released;
+            };
+
+            // Returns byte_count rounded up to a multiple of arena_alignment
+            SEAL_NODISCARD static std::size_t reserved_byte_count(std::size_t byte_count);
+
+            // Returns the index of the entry of an item on the stack or the stack size if it is not found
+            SEAL_NODISCARD std::size_t find_entry(const MemoryPoolItem *item) const noexcept;
+
+            // Adds a chunk of byte_count bytes at the given index
+            void add_chunk(std::size_t index, std::size_t byte_count);
+
+            // Frees the chunk at the given index
+            void free_chunk(std::size_t index) noexcept;
+
+            // Replaces all chunks by a single one of their combined size; requires that no item is in use
+            void coalesce_chunks();
+
+            const bool clear_on_destruction_;
+
+            std::size_t next_byte_count_ = 0;
+
+            std::size_t peak_byte_count_ = 0;
+
+            std::uint64_t total_alloc_count_ = 0;
+
+            std::atomic<std::size_t> *pool_alloc_byte_count_;
+
+            const MemoryPoolAllocPolicy alloc_policy_;
+
+            std::vector<chunk> chunks_;
+
+            // Index of the chunk that serves the next item; the chunks after it are empty
+            std::size_t curr_chunk_ = 0;
+
+            std::vector<entry> entries_;
+
+            // Items that are not on the stack, kept for reuse
+            MemoryPoolItem *spare_items_ = nullptr;
+        };
+
         class MemoryPool
         {
         public:
@@ -223,12 +526,57 @@ namespace seal
             virtual std::size_t pool_count() const = 0;
 
             virtual std::size_t alloc_byte_count() const = 0;
+
+            // Returns the statistics of every allocation size in decreasing order of size
+            virtual std::vector<MemoryPoolStats> stats() const = 0;
+
+            // Frees the allocations none of whose items is in use and returns the number of bytes freed
+            virtual std::size_t release_unused() = 0;
+
+            /*
+            Sets a limit on alloc_byte_count; zero means no limit. When an allocation request grows the memory
+            allocated from the system beyond the limit, the pool releases its unused allocations. The limit is soft:
+            memory in use is never released, so alloc_byte_count can stay above the limit.
+            */
+            inline void set_byte_count_limit(std::size_t limit) noexcept
+            {
+                byte_count_limit_.store(limit, std::memory_order_relaxed);
+            }
+
+            SEAL_NODISCARD inline std::size_t byte_count_limit() const noexcept
+            {
+                return byte_count_limit_.load(std::memory_order_relaxed);
+            }
+
+            SEAL_NODISCARD virtual const MemoryPoolAllocPolicy &alloc_policy() const noexcept = 0;
+
+        protected:
+            // Releases unused allocations if the byte count limit is set and exceeded
+            inline void enforce_byte_count_limit()
+            {
+                if (byte_count_limit_.load(std::memory_order_relaxed))
+                {
+                    release_unused_over_limit();
+                }
+            }
+
+            // Bytes allocated from the system by all pool heads
+            std::atomic<std::size_t> pool_alloc_byte_count_{ 0 };
+
+        private:
+            void release_unused_over_limit();
+
+            std::atomic<std::size_t> byte_count_limit_{ 0 };
+
+            // The value of pool_alloc_byte_count_ after the limit was last enforced
+            std::atomic<std::size_t> enforced_byte_count_{ 0 };
         };
 
         class MemoryPoolMT : public MemoryPool
         {
         public:
-            MemoryPoolMT(bool clear_on_destruction = false) : clear_on_destruction_(clear_on_destruction){};
+            MemoryPoolMT(
+                bool clear_on_destruction = false, const MemoryPoolAllocPolicy &alloc_policy = MemoryPoolAllocPolicy());
 
             ~MemoryPoolMT() noexcept override;
 
@@ -242,6 +590,15 @@ namespace seal
 
             SEAL_NODISCARD std::size_t alloc_byte_count() const override;
 
+            SEAL_NODISCARD std::vector<MemoryPoolStats> stats() const override;
+
+            std::size_t release_unused() override;
+
+            SEAL_NODISCARD inline const MemoryPoolAllocPolicy &alloc_policy() const noexcept override
+            {
+                return alloc_policy_;
+            }
+
         protected:
             MemoryPoolMT(const MemoryPoolMT &copy) = delete;
 
@@ -249,6 +606,8 @@ namespace seal
 
             const bool clear_on_destruction_;
 
+            const MemoryPoolAllocPolicy alloc_policy_;
+
             mutable ReaderWriterLocker pools_locker_;
 
             std::vector<MemoryPoolHead *> pools_;
@@ -257,7 +616,8 @@ namespace seal
         class MemoryPoolST : public MemoryPool
         {
         public:
-            MemoryPoolST(bool clear_on_destruction = false) : clear_on_destruction_(clear_on_destruction){};
+            MemoryPoolST(
+                bool clear_on_destruction = false, const MemoryPoolAllocPolicy &alloc_policy = MemoryPoolAllocPolicy());
 
             ~MemoryPoolST() noexcept override;
 
@@ -270,6 +630,15 @@ namespace seal
 
             std::size_t alloc_byte_count() const override;
 
+            SEAL_NODISCARD std::vector<MemoryPoolStats> stats() const override;
+
+            std::size_t release_unused() override;
+
+            SEAL_NODISCARD inline const MemoryPoolAllocPolicy &alloc_policy() const noexcept override
+            {
+                return alloc_policy_;
+            }
+
         protected:
             MemoryPoolST(const MemoryPoolST &copy) = delete;
 
@@ -277,7 +646,58 @@ namespace seal
 
             const bool clear_on_destruction_;
 
+            const MemoryPoolAllocPolicy alloc_policy_;
+
             std::vector<MemoryPoolHead *> pools_;
         };
+
+        /*
+        Single-threaded memory pool for short-lived temporaries that serves requests of all sizes from one
+        MemoryPoolHeadArena. Allocation and release take constant time and do not lock, at the cost of keeping memory
+        reserved while any item allocated after it is in use.
+        */
+        class MemoryPoolArena : public MemoryPool
+        {
+        public:
+            MemoryPoolArena(
+                std::size_t byte_count = 0, bool clear_on_destruction = false,
+                const MemoryPoolAllocPolicy &alloc_policy = MemoryPoolAllocPolicy());
+
+            SEAL_NODISCARD Pointer<seal_byte> get_for_byte_count(std::size_t byte_count) override;
+
+            SEAL_NODISCARD inline std::size_t pool_count() const override
+            {
+                return 1;
+            }
+
+            SEAL_NODISCARD inline std::size_t alloc_byte_count() const override
+            {
+                return head_.alloc_byte_count();
+            }
+
+            SEAL_NODISCARD inline std::vector<MemoryPoolStats> stats() const override
+            {
+                return { head_.stats() };
+            }
+
+            inline std::size_t release_unused() override
+            {
+                return head_.release_unused() * MemoryPoolHeadArena::arena_alignment;
+            }
+
+            SEAL_NODISCARD inline const MemoryPoolAllocPolicy &alloc_policy() const noexcept override
+            {
+                return alloc_policy_;
+            }
+
+        protected:
+            MemoryPoolArena(const MemoryPoolArena &copy) = delete;
+
+            MemoryPoolArena &operator=(const MemoryPoolArena &assign) = delete;
+
+            const MemoryPoolAllocPolicy alloc_policy_;
+
+            MemoryPoolHeadArena head_;
+        };
     } // namespace util
 } // namespace seal
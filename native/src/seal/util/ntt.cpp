@@ -1,10 +1,15 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT license.
 
+#include "seal/util/cpufeatures.h"
 #include "seal/util/ntt.h"
+#include "seal/util/nttavx2.h"
+#include "seal/util/parallel.h"
 #include "seal/util/uintarith.h"
 #include "seal/util/uintarithsmallmod.h"
 #include <algorithm>
+#include <stdexcept>
+#include <vector>
 #ifdef SEAL_USE_INTEL_HEXL
 #include "seal/memorymanager.h"
 #include "seal/util/iterator.h"
@@ -296,6 +301,27 @@ namespace seal
 
             mod_arith_lazy_ = ModArithLazy(modulus_);
             ntt_handler_ = NTTHandler(mod_arith_lazy_);
+
+            // Lazy values of small moduli fit in 32 bits; narrow the tables for the std::uint32_t transforms
+            if (modulus_.bit_count() <= small_modulus_bit_count_max)
+            {
+                root_powers32_ = allocate<MultiplyUIntModOperand32>(coeff_count_, pool_);
+                inv_root_powers32_ = allocate<MultiplyUIntModOperand32>(coeff_count_, pool_);
+                for (size_t i = 0; i < coeff_count_; i++)
+                {
+                    root_powers32_[i].set(static_cast<uint32_t>(root_powers_[i].operand), modulus_);
+                    inv_root_powers32_[i].set(static_cast<uint32_t>(inv_root_powers_[i].operand), modulus_);
+                }
+                inv_degree_modulo32_.set(static_cast<uint32_t>(inv_degree_modulo_.operand), modulus_);
+
+                mod_arith_lazy32_ = ModArithLazy32(modulus_);
+                ntt_handler32_ = NTTHandler32(mod_arith_lazy32_);
+            }
+
+#ifdef SEAL_USE_AVX2
+            // Select the kernel once; the scalar handler remains the fallback
+            use_avx2_ = cpu_has_avx2() && (coeff_count_power_ >= ntt_avx2_log_n_min);
+#endif
         }
 
         class NTTTablesCreateIter
@@ -390,6 +416,48 @@ namespace seal
             tables = allocate(iter, modulus.size(), pool);
         }
 
+        namespace
+        {
+            using NTTKernel = void (*)(CoeffIter, const NTTTables &);
+
+            void ntt_rns_components(
+                RNSIter operand, size_t coeff_modulus_size, ConstNTTTablesIter tables, ThreadPool *thread_pool,
+                NTTKernel kernel)
+            {
+#ifdef SEAL_DEBUG
+                if (!operand)
+                {
+                    throw invalid_argument("operand");
+                }
+                if (!tables)
+                {
+                    throw invalid_argument("tables");
+                }
+#endif
+                parallel_for_each(thread_pool, coeff_modulus_size, [&](size_t i) { kernel(operand[i], tables[i]); });
+            }
+
+            void ntt_poly_components(
+                PolyIter operand, size_t size, ConstNTTTablesIter tables, ThreadPool *thread_pool, NTTKernel kernel)
+            {
+#ifdef SEAL_DEBUG
+                if (!operand)
+                {
+                    throw invalid_argument("operand");
+                }
+                if (!tables)
+                {
+                    throw invalid_argument("tables");
+                }
+#endif
+                size_t coeff_modulus_size = operand.coeff_modulus_size();
+                parallel_for_each(thread_pool, size * coeff_modulus_size, [&](size_t i) {
+                    size_t j = i % coeff_modulus_size;
+                    kernel(operand[i / coeff_modulus_size][j], tables[j]);
+                });
+            }
+        } // namespace
+
         void ntt_negacyclic_harvey_lazy(CoeffIter operand, const NTTTables &tables)
         {
 #ifdef SEAL_USE_INTEL_HEXL
@@ -399,7 +467,15 @@ namespace seal
 
             intel::seal_ext::compute_forward_ntt(operand, N, p, root, 4, 4);
 #else
-            tables.ntt_handler().transform_to_rev(
+#ifdef SEAL_USE_AVX2
+            if (tables.use_avx2())
+            {
+                ntt_transform_to_rev_avx2(
+                    operand.ptr(), tables.coeff_count_power(), tables.get_from_root_powers(), tables.modulus());
+                return;
+            }
+#endif
+            tables.ntt_handler().transform_to_rev_radix4(
                 operand.ptr(), tables.coeff_count_power(), tables.get_from_root_powers());
 #endif
         }
@@ -444,7 +520,16 @@ namespace seal
             intel::seal_ext::compute_inverse_ntt(operand, N, p, root, 2, 2);
 #else
             MultiplyUIntModOperand inv_degree_modulo = tables.inv_degree_modulo();
-            tables.ntt_handler().transform_from_rev(
+#ifdef SEAL_USE_AVX2
+            if (tables.use_avx2())
+            {
+                ntt_transform_from_rev_avx2(
+                    operand.ptr(), tables.coeff_count_power(), tables.get_from_inv_root_powers(), tables.modulus(),
+                    &inv_degree_modulo);
+                return;
+            }
+#endif
+            tables.ntt_handler().transform_from_rev_radix4(
                 operand.ptr(), tables.coeff_count_power(), tables.get_from_inv_root_powers(), &inv_degree_modulo);
 #endif
         }
@@ -472,5 +557,118 @@ namespace seal
             });
 #endif
         }
+
+        void ntt_negacyclic_harvey_lazy(uint32_t *operand, const NTTTables &tables)
+        {
+            if (!tables.supports_uint32())
+            {
+                throw invalid_argument("tables do not support 32-bit operands");
+            }
+#ifdef SEAL_USE_AVX2
+            if (tables.use_avx2() && tables.coeff_count_power() >= ntt_avx2_uint32_log_n_min)
+            {
+                ntt_transform_to_rev_avx2(
+                    operand, tables.coeff_count_power(), tables.get_from_root_powers32(), tables.modulus());
+                return;
+            }
+#endif
+            tables.ntt_handler32().transform_to_rev_radix4(
+                operand, tables.coeff_count_power(), tables.get_from_root_powers32());
+        }
+
+        void ntt_negacyclic_harvey(uint32_t *operand, const NTTTables &tables)
+        {
+            ntt_negacyclic_harvey_lazy(operand, tables);
+            // Reduce every coefficient from [0, 4q) to [0, q)
+            uint32_t modulus = static_cast<uint32_t>(tables.modulus().value());
+            uint32_t two_times_modulus = modulus * 2;
+            size_t n = size_t(1) << tables.coeff_count_power();
+            for (size_t i = 0; i < n; i++)
+            {
+                uint32_t value = operand[i];
+                value = SEAL_COND_SELECT(value >= two_times_modulus, value - two_times_modulus, value);
+                operand[i] = SEAL_COND_SELECT(value >= modulus, value - modulus, value);
+            }
+        }
+
+        void inverse_ntt_negacyclic_harvey_lazy(uint32_t *operand, const NTTTables &tables)
+        {
+            if (!tables.supports_uint32())
+            {
+                throw invalid_argument("tables do not support 32-bit operands");
+            }
+            MultiplyUIntModOperand32 inv_degree_modulo = tables.inv_degree_modulo32();
+#ifdef SEAL_USE_AVX2
+            if (tables.use_avx2() && tables.coeff_count_power() >= ntt_avx2_uint32_log_n_min)
+            {
+                ntt_transform_from_rev_avx2(
+                    operand, tables.coeff_count_power(), tables.get_from_inv_root_powers32(), tables.modulus(),
+                    &inv_degree_modulo);
+                return;
+            }
+#endif
+            tables.ntt_handler32().transform_from_rev_radix4(
+                operand, tables.coeff_count_power(), tables.get_from_inv_root_powers32(), &inv_degree_modulo);
+        }
+
+        void inverse_ntt_negacyclic_harvey(uint32_t *operand, const NTTTables &tables)
+        {
+            inverse_ntt_negacyclic_harvey_lazy(operand, tables);
+            // Reduce every coefficient from [0, 2q) to [0, q)
+            uint32_t modulus = static_cast<uint32_t>(tables.modulus().value());
+            size_t n = size_t(1) << tables.coeff_count_power();
+            for (size_t i = 0; i < n; i++)
+            {
+                uint32_t value = operand[i];
+                operand[i] = SEAL_COND_SELECT(value >= modulus, value - modulus, value);
+            }
+        }
+
+        void ntt_negacyclic_harvey_lazy(
+            RNSIter operand, size_t coeff_modulus_size, ConstNTTTablesIter tables, ThreadPool *thread_pool)
+        {
+            ntt_rns_components(operand, coeff_modulus_size, tables, thread_pool, ntt_negacyclic_harvey_lazy);
+        }
+
+        void ntt_negacyclic_harvey_lazy(
+            PolyIter operand, size_t size, ConstNTTTablesIter tables, ThreadPool *thread_pool)
+        {
+            ntt_poly_components(operand, size, tables, thread_pool, ntt_negacyclic_harvey_lazy);
+        }
+
+        void ntt_negacyclic_harvey(
+            RNSIter operand, size_t coeff_modulus_size, ConstNTTTablesIter tables, ThreadPool *thread_pool)
+        {
+            ntt_rns_components(operand, coeff_modulus_size, tables, thread_pool, ntt_negacyclic_harvey);
+        }
+
+        void ntt_negacyclic_harvey(PolyIter operand, size_t size, ConstNTTTablesIter tables, ThreadPool *thread_pool)
+        {
+            ntt_poly_components(operand, size, tables, thread_pool, ntt_negacyclic_harvey);
+        }
+
+        void inverse_ntt_negacyclic_harvey_lazy(
+            RNSIter operand, size_t coeff_modulus_size, ConstNTTTablesIter tables, ThreadPool *thread_pool)
+        {
+            ntt_rns_components(operand, coeff_modulus_size, tables, thread_pool, inverse_ntt_negacyclic_harvey_lazy);
+        }
+
+        void inverse_ntt_negacyclic_harvey_lazy(
+            PolyIter operand, size_t size, ConstNTTTablesIter tables, ThreadPool *thread_pool)
+        {
+            ntt_poly_components(operand, size, tables, thread_pool, inverse_ntt_negacyclic_harvey_lazy);
+        }
+
+        void inverse_ntt_negacyclic_harvey(
+            RNSIter operand, size_t coeff_modulus_size, ConstNTTTablesIter tables, ThreadPool *thread_pool)
+        {
+            ntt_rns_components(operand, coeff_modulus_size, tables, thread_pool, inverse_ntt_negacyclic_harvey);
+        }
+
+        void inverse_ntt_negacyclic_harvey(
+            PolyIter operand, size_t size, ConstNTTTablesIter tables, ThreadPool *thread_pool)
+        {
+            ntt_poly_components(operand, size, tables, thread_pool, inverse_ntt_negacyclic_harvey);
+        }
     } // namespace util
 } // namespace seal
@@ -15,6 +15,8 @@
 
 namespace seal
 {
+    class ThreadPool;
+
     namespace util
     {
         template <>
@@ -66,23 +68,91 @@ namespace seal
             std::uint64_t two_times_modulus_;
         };
 
+        /**
+        The 32-bit arithmetic for moduli of at most small_modulus_bit_count_max bits. Lazy values are less than
+        4 * modulus and hence fit in 32 bits.
+        */
+        template <>
+        class Arithmetic<std::uint32_t, MultiplyUIntModOperand32, MultiplyUIntModOperand32>
+        {
+        public:
+            Arithmetic()
+            {}
+
+            Arithmetic(const Modulus &modulus)
+                : modulus_(modulus), two_times_modulus_(static_cast<std::uint32_t>(modulus.value() << 1))
+            {}
+
+            inline std::uint32_t add(const std::uint32_t &a, const std::uint32_t &b) const
+            {
+                return a + b;
+            }
+
+            inline std::uint32_t sub(const std::uint32_t &a, const std::uint32_t &b) const
+            {
+                return a + two_times_modulus_ - b;
+            }
+
+            inline std::uint32_t mul_root(const std::uint32_t &a, const MultiplyUIntModOperand32 &r) const
+            {
+                return multiply_uint_mod_lazy(a, r, modulus_);
+            }
+
+            inline std::uint32_t mul_scalar(const std::uint32_t &a, const MultiplyUIntModOperand32 &s) const
+            {
+                return multiply_uint_mod_lazy(a, s, modulus_);
+            }
+
+            inline MultiplyUIntModOperand32 mul_root_scalar(
+                const MultiplyUIntModOperand32 &r, const MultiplyUIntModOperand32 &s) const
+            {
+                MultiplyUIntModOperand32 result;
+                result.set(multiply_uint_mod(r.operand, s, modulus_), modulus_);
+                return result;
+            }
+
+            inline std::uint32_t guard(const std::uint32_t &a) const
+            {
+                return SEAL_COND_SELECT(a >= two_times_modulus_, a - two_times_modulus_, a);
+            }
+
+        private:
+            Modulus modulus_;
+
+            std::uint32_t two_times_modulus_ = 0;
+        };
+
         class NTTTables
         {
             using ModArithLazy = Arithmetic<uint64_t, MultiplyUIntModOperand, MultiplyUIntModOperand>;
             using NTTHandler = DWTHandler<std::uint64_t, MultiplyUIntModOperand, MultiplyUIntModOperand>;
+            using ModArithLazy32 = Arithmetic<std::uint32_t, MultiplyUIntModOperand32, MultiplyUIntModOperand32>;
+            using NTTHandler32 = DWTHandler<std::uint32_t, MultiplyUIntModOperand32, MultiplyUIntModOperand32>;
 
         public:
             NTTTables(NTTTables &&source) = default;
 
             NTTTables(NTTTables &copy)
                 : pool_(copy.pool_), root_(copy.root_), coeff_count_power_(copy.coeff_count_power_),
-                  coeff_count_(copy.coeff_count_), modulus_(copy.modulus_), inv_degree_modulo_(copy.inv_degree_modulo_)
+                  coeff_count_(copy.coeff_count_), modulus_(copy.modulus_), inv_degree_modulo_(copy.inv_degree_modulo_),
+                  mod_arith_lazy_(copy.mod_arith_lazy_), ntt_handler_(copy.ntt_handler_),
+                  inv_degree_modulo32_(copy.inv_degree_modulo32_), mod_arith_lazy32_(copy.mod_arith_lazy32_),
+                  ntt_handler32_(copy.ntt_handler32_), use_avx2_(copy.use_avx2_)
             {
                 root_powers_ = allocate<MultiplyUIntModOperand>(coeff_count_, pool_);
                 inv_root_powers_ = allocate<MultiplyUIntModOperand>(coeff_count_, pool_);
 
                 std::copy_n(copy.root_powers_.get(), coeff_count_, root_powers_.get());
                 std::copy_n(copy.inv_root_powers_.get(), coeff_count_, inv_root_powers_.get());
+
+                if (copy.supports_uint32())
+                {
+                    root_powers32_ = allocate<MultiplyUIntModOperand32>(coeff_count_, pool_);
+                    inv_root_powers32_ = allocate<MultiplyUIntModOperand32>(coeff_count_, pool_);
+
+                    std::copy_n(copy.root_powers32_.get(), coeff_count_, root_powers32_.get());
+                    std::copy_n(copy.inv_root_powers32_.get(), coeff_count_, inv_root_powers32_.get());
+                }
             }
 
             NTTTables(int coeff_count_power, const Modulus &modulus, MemoryPoolHandle pool = MemoryManager::GetPool());
@@ -149,6 +219,44 @@ namespace seal
                 return ntt_handler_;
             }
 
+            /**
+            Returns true if the modulus has at most small_modulus_bit_count_max bits. Only then are the 32-bit tables
+            populated and can the transforms run on std::uint32_t buffers.
+            */
+            SEAL_NODISCARD inline bool supports_uint32() const noexcept
+            {
+                return static_cast<bool>(root_powers32_);
+            }
+
+            SEAL_NODISCARD inline const MultiplyUIntModOperand32 *get_from_root_powers32() const
+            {
+                return root_powers32_.get();
+            }
+
+            SEAL_NODISCARD inline const MultiplyUIntModOperand32 *get_from_inv_root_powers32() const
+            {
+                return inv_root_powers32_.get();
+            }
+
+            SEAL_NODISCARD inline const MultiplyUIntModOperand32 &inv_degree_modulo32() const
+            {
+                return inv_degree_modulo32_;
+            }
+
+            const NTTHandler32 &ntt_handler32() const
+            {
+                return ntt_handler32_;
+            }
+
+            /**
+            Returns true if the transforms on these tables run the AVX2 kernels instead of ntt_handler(). This is
+            decided once at construction from the CPU features and the transform size.
+            */
+            SEAL_NODISCARD inline bool use_avx2() const noexcept
+            {
+                return use_avx2_;
+            }
+
         private:
             NTTTables &operator=(const NTTTables &assign) = delete;
 
@@ -180,6 +288,19 @@ namespace seal
             ModArithLazy mod_arith_lazy_;
 
             NTTHandler ntt_handler_;
+
+            // The 32-bit counterparts of the tables above, populated only if supports_uint32() is true.
+            Pointer<MultiplyUIntModOperand32> root_powers32_;
+
+            Pointer<MultiplyUIntModOperand32> inv_root_powers32_;
+
+            MultiplyUIntModOperand32 inv_degree_modulo32_{ 0, 0 };
+
+            ModArithLazy32 mod_arith_lazy32_;
+
+            NTTHandler32 ntt_handler32_;
+
+            bool use_avx2_ = false;
         };
 
         /**
@@ -194,147 +315,99 @@ namespace seal
 
         void ntt_negacyclic_harvey_lazy(CoeffIter operand, const NTTTables &tables);
 
-        inline void ntt_negacyclic_harvey_lazy(
-            RNSIter operand, std::size_t coeff_modulus_size, ConstNTTTablesIter tables)
-        {
-#ifdef SEAL_DEBUG
-            if (!operand)
-            {
-                throw std::invalid_argument("operand");
-            }
-            if (!tables)
-            {
-                throw std::invalid_argument("tables");
-            }
-#endif
-            SEAL_ITERATE(iter(operand, tables), coeff_modulus_size, [&](auto I) {
-                ntt_negacyclic_harvey_lazy(get<0>(I), get<1>(I));
-            });
-        }
+        /**
+        Computes in place the lazy forward negacyclic NTT of every RNS component of operand with the matching tables.
+        The components are distributed across thread_pool unless it is nullptr.
+        */
+        void ntt_negacyclic_harvey_lazy(
+            RNSIter operand, std::size_t coeff_modulus_size, ConstNTTTablesIter tables,
+            ThreadPool *thread_pool = nullptr);
 
-        inline void ntt_negacyclic_harvey_lazy(PolyIter operand, std::size_t size, ConstNTTTablesIter tables)
-        {
-#ifdef SEAL_DEBUG
-            if (!operand)
-            {
-                throw std::invalid_argument("operand");
-            }
-            if (!tables)
-            {
-                throw std::invalid_argument("tables");
-            }
-#endif
-            SEAL_ITERATE(
-                operand, size, [&](auto I) { ntt_negacyclic_harvey_lazy(I, operand.coeff_modulus_size(), tables); });
-        }
+        /**
+        Computes in place the lazy forward negacyclic NTT of every RNS component of size polynomials; see the RNSIter
+        overload. All size * coeff_modulus_size components are distributed across thread_pool.
+        */
+        void ntt_negacyclic_harvey_lazy(
+            PolyIter operand, std::size_t size, ConstNTTTablesIter tables, ThreadPool *thread_pool = nullptr);
 
         void ntt_negacyclic_harvey(CoeffIter operand, const NTTTables &tables);
 
-        inline void ntt_negacyclic_harvey(RNSIter operand, std::size_t coeff_modulus_size, ConstNTTTablesIter tables)
-        {
-#ifdef SEAL_DEBUG
-            if (!operand)
-            {
-                throw std::invalid_argument("operand");
-            }
-            if (!tables)
-            {
-                throw std::invalid_argument("tables");
-            }
-#endif
-            SEAL_ITERATE(iter(operand, tables), coeff_modulus_size, [&](auto I) {
-                ntt_negacyclic_harvey(get<0>(I), get<1>(I));
-            });
-        }
+        /**
+        Computes in place the forward negacyclic NTT of every RNS component of operand; see the lazy overload.
+        */
+        void ntt_negacyclic_harvey(
+            RNSIter operand, std::size_t coeff_modulus_size, ConstNTTTablesIter tables,
+            ThreadPool *thread_pool = nullptr);
 
-        inline void ntt_negacyclic_harvey(PolyIter operand, std::size_t size, ConstNTTTablesIter tables)
-        {
-#ifdef SEAL_DEBUG
-            if (!operand)
-            {
-                throw std::invalid_argument("operand");
-            }
-            if (!tables)
-            {
-                throw std::invalid_argument("tables");
-            }
-#endif
-            SEAL_ITERATE(
-                operand, size, [&](auto I) { ntt_negacyclic_harvey(I, operand.coeff_modulus_size(), tables); });
-        }
+        /**
+        Computes in place the forward negacyclic NTT of every RNS component of size polynomials; see the lazy
+        overload.
+        */
+        void ntt_negacyclic_harvey(
+            PolyIter operand, std::size_t size, ConstNTTTablesIter tables, ThreadPool *thread_pool = nullptr);
 
         void inverse_ntt_negacyclic_harvey_lazy(CoeffIter operand, const NTTTables &tables);
 
-        inline void inverse_ntt_negacyclic_harvey_lazy(
-            RNSIter operand, std::size_t coeff_modulus_size, ConstNTTTablesIter tables)
-        {
-#ifdef SEAL_DEBUG
-            if (!operand)
-            {
-                throw std::invalid_argument("operand");
-            }
-            if (!tables)
-            {
-                throw std::invalid_argument("tables");
-            }
-#endif
-            SEAL_ITERATE(iter(operand, tables), coeff_modulus_size, [&](auto I) {
-                inverse_ntt_negacyclic_harvey_lazy(get<0>(I), get<1>(I));
-            });
-        }
+        /**
+        Computes in place the lazy inverse negacyclic NTT of every RNS component of operand; see the forward overload.
+        */
+        void inverse_ntt_negacyclic_harvey_lazy(
+            RNSIter operand, std::size_t coeff_modulus_size, ConstNTTTablesIter tables,
+            ThreadPool *thread_pool = nullptr);
 
-        inline void inverse_ntt_negacyclic_harvey_lazy(PolyIter operand, std::size_t size, ConstNTTTablesIter tables)
-        {
-#ifdef SEAL_DEBUG
-            if (!operand)
-            {
-                throw std::invalid_argument("operand");
-            }
-            if (!tables)
-            {
-                throw std::invalid_argument("tables");
-            }
-#endif
-            SEAL_ITERATE(operand, size, [&](auto I) {
-                inverse_ntt_negacyclic_harvey_lazy(I, operand.coeff_modulus_size(), tables);
-            });
-        }
+        /**
+        Computes in place the lazy inverse negacyclic NTT of every RNS component of size polynomials; see the forward
+        overload.
+        */
+        void inverse_ntt_negacyclic_harvey_lazy(
+            PolyIter operand, std::size_t size, ConstNTTTablesIter tables, ThreadPool *thread_pool = nullptr);
 
         void inverse_ntt_negacyclic_harvey(CoeffIter operand, const NTTTables &tables);
 
-        inline void inverse_ntt_negacyclic_harvey(
-            RNSIter operand, std::size_t coeff_modulus_size, ConstNTTTablesIter tables)
-        {
-#ifdef SEAL_DEBUG
-            if (!operand)
-            {
-                throw std::invalid_argument("operand");
-            }
-            if (!tables)
-            {
-                throw std::invalid_argument("tables");
-            }
-#endif
-            SEAL_ITERATE(iter(operand, tables), coeff_modulus_size, [&](auto I) {
-                inverse_ntt_negacyclic_harvey(get<0>(I), get<1>(I));
-            });
-        }
+        /**
+        Computes in place the inverse negacyclic NTT of every RNS component of operand; see the forward overload.
+        */
+        void inverse_ntt_negacyclic_harvey(
+            RNSIter operand, std::size_t coeff_modulus_size, ConstNTTTablesIter tables,
+            ThreadPool *thread_pool = nullptr);
 
-        inline void inverse_ntt_negacyclic_harvey(PolyIter operand, std::size_t size, ConstNTTTablesIter tables)
-        {
-#ifdef SEAL_DEBUG
-            if (!operand)
-            {
-                throw std::invalid_argument("operand");
-            }
-            if (!tables)
-            {
-                throw std::invalid_argument("tables");
-            }
-#endif
-            SEAL_ITERATE(
-                operand, size, [&](auto I) { inverse_ntt_negacyclic_harvey(I, operand.coeff_modulus_size(), tables); });
-        }
+        /**
+        Computes in place the inverse negacyclic NTT of every RNS component of size polynomials; see the forward
+        overload.
+        */
+        void inverse_ntt_negacyclic_harvey(
+            PolyIter operand, std::size_t size, ConstNTTTablesIter tables, ThreadPool *thread_pool = nullptr);
+
+        /**
+        Computes in place the lazy forward negacyclic NTT of a std::uint32_t buffer, whose inputs and outputs are in
+        [0, 4 * modulus), with the 32-bit tables. Halves the memory traffic of the std::uint64_t overload for moduli of
+        at most small_modulus_bit_count_max bits.
+
+        @throws std::invalid_argument if tables.supports_uint32() is false
+        */
+        void ntt_negacyclic_harvey_lazy(std::uint32_t *operand, const NTTTables &tables);
+
+        /**
+        Computes in place the forward negacyclic NTT of a std::uint32_t buffer; see the lazy overload.
+
+        @throws std::invalid_argument if tables.supports_uint32() is false
+        */
+        void ntt_negacyclic_harvey(std::uint32_t *operand, const NTTTables &tables);
+
+        /**
+        Computes in place the lazy inverse negacyclic NTT of a std::uint32_t buffer, whose inputs and outputs are in
+        [0, 2 * modulus), with the 32-bit tables.
+
+        @throws std::invalid_argument if tables.supports_uint32() is false
+        */
+        void inverse_ntt_negacyclic_harvey_lazy(std::uint32_t *operand, const NTTTables &tables);
+
+        /**
+        Computes in place the inverse negacyclic NTT of a std::uint32_t buffer; see the lazy overload.
+
+        @throws std::invalid_argument if tables.supports_uint32() is false
+        */
+        void inverse_ntt_negacyclic_harvey(std::uint32_t *operand, const NTTTables &tables);
 
         void ntt_negacyclic_harvey_new(CoeffIter operand, const NTTTables &tables);
         void inverse_ntt_negacyclic_harvey_new(CoeffIter operand, const NTTTables &tables);
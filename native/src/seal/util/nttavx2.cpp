@@ -0,0 +1,753 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/util/nttavx2.h"
+
+#ifdef SEAL_USE_AVX2
+#include <cstddef>
+#include <immintrin.h>
+#include <stdexcept>
+
+// The library is not compiled with AVX2 enabled; only the kernels below are, and they are entered only after a
+// run-time CPU check.
+#if SEAL_COMPILER == SEAL_COMPILER_MSVC
+#define SEAL_TARGET_AVX2
+#else
+#define SEAL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            static_assert(sizeof(MultiplyUIntModOperand) == 2 * sizeof(uint64_t), "unexpected operand layout");
+
+            /**
+            Four lanes of a root or scalar operand, i.e., MultiplyUIntModOperand in vector form.
+            */
+            struct MultiplyUIntModOperandAVX2
+            {
+                __m256i operand;
+
+                __m256i quotient;
+            };
+
+            /**
+            Four-lane form of Arithmetic<std::uint64_t, MultiplyUIntModOperand, MultiplyUIntModOperand>. All lanes must
+            stay below 2^63 so that signed 64-bit comparisons can be used; this holds for moduli of at most 61 bits.
+            */
+            class ArithmeticAVX2
+            {
+            public:
+                SEAL_TARGET_AVX2 ArithmeticAVX2(uint64_t modulus)
+                    : modulus_(_mm256_set1_epi64x(static_cast<long long>(modulus))),
+                      two_times_modulus_(_mm256_set1_epi64x(static_cast<long long>(modulus << 1))),
+                      two_times_modulus_minus_one_(_mm256_set1_epi64x(static_cast<long long>((modulus << 1) - 1)))
+                {}
+
+                SEAL_TARGET_AVX2 inline __m256i add(__m256i a, __m256i b) const
+                {
+                    return _mm256_add_epi64(a, b);
+                }
+
+                SEAL_TARGET_AVX2 inline __m256i sub(__m256i a, __m256i b) const
+                {
+                    return _mm256_sub_epi64(_mm256_add_epi64(a, two_times_modulus_), b);
+                }
+
+                SEAL_TARGET_AVX2 inline __m256i mul_root(__m256i a, const MultiplyUIntModOperandAVX2 &r) const
+                {
+                    // Same as multiply_uint_mod_lazy: r * a - hw64(a * quotient(r)) * modulus
+                    __m256i tmp = mul_hi(a, r.quotient);
+                    return _mm256_sub_epi64(mul_lo(a, r.operand), mul_lo(tmp, modulus_));
+                }
+
+                SEAL_TARGET_AVX2 inline __m256i mul_scalar(__m256i a, const MultiplyUIntModOperandAVX2 &s) const
+                {
+                    return mul_root(a, s);
+                }
+
+                SEAL_TARGET_AVX2 inline __m256i guard(__m256i a) const
+                {
+                    __m256i mask = _mm256_cmpgt_epi64(a, two_times_modulus_minus_one_);
+                    return _mm256_sub_epi64(a, _mm256_and_si256(mask, two_times_modulus_));
+                }
+
+            private:
+                // Low 64 bits of the lane-wise 64x64-bit products
+                SEAL_TARGET_AVX2 static inline __m256i mul_lo(__m256i a, __m256i b)
+                {
+                    __m256i cross = _mm256_add_epi64(
+                        _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b), _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+                    return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(cross, 32));
+                }
+
+                // High 64 bits of the lane-wise 64x64-bit products
+                SEAL_TARGET_AVX2 static inline __m256i mul_hi(__m256i a, __m256i b)
+                {
+                    const __m256i low_mask = _mm256_set1_epi64x(0xFFFFFFFF);
+                    __m256i a_hi = _mm256_srli_epi64(a, 32);
+                    __m256i b_hi = _mm256_srli_epi64(b, 32);
+                    __m256i lo_lo = _mm256_mul_epu32(a, b);
+                    __m256i lo_hi = _mm256_mul_epu32(a, b_hi);
+                    __m256i hi_lo = _mm256_mul_epu32(a_hi, b);
+                    __m256i hi_hi = _mm256_mul_epu32(a_hi, b_hi);
+
+                    // The middle column sums three 32-bit values and cannot overflow
+                    __m256i mid = _mm256_add_epi64(
+                        _mm256_add_epi64(_mm256_srli_epi64(lo_lo, 32), _mm256_and_si256(lo_hi, low_mask)),
+                        _mm256_and_si256(hi_lo, low_mask));
+                    __m256i result = _mm256_add_epi64(
+                        _mm256_add_epi64(hi_hi, _mm256_srli_epi64(lo_hi, 32)), _mm256_srli_epi64(hi_lo, 32));
+                    return _mm256_add_epi64(result, _mm256_srli_epi64(mid, 32));
+                }
+
+                __m256i modulus_;
+
+                __m256i two_times_modulus_;
+
+                __m256i two_times_modulus_minus_one_;
+            };
+
+            /**
+            ArithmeticAVX2 for moduli of at most small_modulus_bit_count_max bits. The lazy values below 4 * modulus fit
+            in 32 bits, so every product in the Shoup multiplication is a single native 32x32-bit multiplication: three
+            _mm256_mul_epu32 per butterfly instead of the ten needed to emulate 64-bit products.
+            */
+            class ArithmeticAVX2Small
+            {
+            public:
+                SEAL_TARGET_AVX2 ArithmeticAVX2Small(uint64_t modulus)
+                    : modulus_(_mm256_set1_epi64x(static_cast<long long>(modulus))),
+                      two_times_modulus_(_mm256_set1_epi64x(static_cast<long long>(modulus << 1))),
+                      two_times_modulus_minus_one_(_mm256_set1_epi64x(static_cast<long long>((modulus << 1) - 1)))
+                {}
+
+                SEAL_TARGET_AVX2 inline __m256i add(__m256i a, __m256i b) const
+                {
+                    return _mm256_add_epi64(a, b);
+                }
+
+                SEAL_TARGET_AVX2 inline __m256i sub(__m256i a, __m256i b) const
+                {
+                    return _mm256_sub_epi64(_mm256_add_epi64(a, two_times_modulus_), b);
+                }
+
+                SEAL_TARGET_AVX2 inline __m256i mul_root(__m256i a, const MultiplyUIntModOperandAVX2 &r) const
+                {
+                    // Shoup multiplication with base 2^32; floor(r * 2^32 / modulus) is the high half of the quotient
+                    __m256i quotient = _mm256_srli_epi64(r.quotient, 32);
+                    __m256i tmp = _mm256_srli_epi64(_mm256_mul_epu32(a, quotient), 32);
+                    return _mm256_sub_epi64(_mm256_mul_epu32(a, r.operand), _mm256_mul_epu32(tmp, modulus_));
+                }
+
+                SEAL_TARGET_AVX2 inline __m256i mul_scalar(__m256i a, const MultiplyUIntModOperandAVX2 &s) const
+                {
+                    return mul_root(a, s);
+                }
+
+                SEAL_TARGET_AVX2 inline __m256i guard(__m256i a) const
+                {
+                    __m256i mask = _mm256_cmpgt_epi64(a, two_times_modulus_minus_one_);
+                    return _mm256_sub_epi64(a, _mm256_and_si256(mask, two_times_modulus_));
+                }
+
+            private:
+                __m256i modulus_;
+
+                __m256i two_times_modulus_;
+
+                __m256i two_times_modulus_minus_one_;
+            };
+
+            SEAL_TARGET_AVX2 inline __m256i load(const uint64_t *ptr)
+            {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+            }
+
+            SEAL_TARGET_AVX2 inline void store(uint64_t *ptr, __m256i value)
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr), value);
+            }
+
+            SEAL_TARGET_AVX2 inline MultiplyUIntModOperandAVX2 broadcast(const MultiplyUIntModOperand &r)
+            {
+                return { _mm256_set1_epi64x(static_cast<long long>(r.operand)),
+                         _mm256_set1_epi64x(static_cast<long long>(r.quotient)) };
+            }
+
+            // Lanes hold roots[0], roots[0], roots[1], roots[1]; matches the gap-2 data layout
+            SEAL_TARGET_AVX2 inline MultiplyUIntModOperandAVX2 load_roots_gap2(const MultiplyUIntModOperand *roots)
+            {
+                __m256i r = load(reinterpret_cast<const uint64_t *>(roots));
+                return { _mm256_permute4x64_epi64(r, 0xA0), _mm256_permute4x64_epi64(r, 0xF5) };
+            }
+
+            // Lanes hold roots[0], roots[2], roots[1], roots[3]; matches the gap-1 data layout
+            SEAL_TARGET_AVX2 inline MultiplyUIntModOperandAVX2 load_roots_gap1(const MultiplyUIntModOperand *roots)
+            {
+                __m256i r0 = load(reinterpret_cast<const uint64_t *>(roots));
+                __m256i r1 = load(reinterpret_cast<const uint64_t *>(roots + 2));
+                return { _mm256_unpacklo_epi64(r0, r1), _mm256_unpackhi_epi64(r0, r1) };
+            }
+
+            template <typename ArithmeticT>
+            SEAL_TARGET_AVX2 void transform_to_rev_kernel(
+                uint64_t *values, int log_n, const MultiplyUIntModOperand *roots, uint64_t modulus)
+            {
+                const ArithmeticT arithmetic(modulus);
+                size_t n = size_t(1) << log_n;
+                size_t gap = n >> 1;
+                size_t m = 1;
+                __m256i u, v;
+
+                // Layers with gap at least 4: each vector holds four consecutive butterflies sharing one root
+                for (; m < (n >> 2); m <<= 1)
+                {
+                    uint64_t *x = values;
+                    for (size_t i = 0; i < m; i++)
+                    {
+                        MultiplyUIntModOperandAVX2 r = broadcast(*++roots);
+                        uint64_t *y = x + gap;
+                        for (size_t j = 0; j < gap; j += 4)
+                        {
+                            u = arithmetic.guard(load(x + j));
+                            v = arithmetic.mul_root(load(y + j), r);
+                            store(x + j, arithmetic.add(u, v));
+                            store(y + j, arithmetic.sub(u, v));
+                        }
+                        x += gap << 1;
+                    }
+                    gap >>= 1;
+                }
+
+                // Gap 2: two groups [x0 x1 y0 y1] per pair of vectors
+                uint64_t *x = values;
+                for (size_t i = 0; i < m; i += 2)
+                {
+                    MultiplyUIntModOperandAVX2 r = load_roots_gap2(roots + 1);
+                    roots += 2;
+                    __m256i a = load(x);
+                    __m256i b = load(x + 4);
+                    u = arithmetic.guard(_mm256_permute2x128_si256(a, b, 0x20));
+                    v = arithmetic.mul_root(_mm256_permute2x128_si256(a, b, 0x31), r);
+                    a = arithmetic.add(u, v);
+                    b = arithmetic.sub(u, v);
+                    store(x, _mm256_permute2x128_si256(a, b, 0x20));
+                    store(x + 4, _mm256_permute2x128_si256(a, b, 0x31));
+                    x += 8;
+                }
+                m <<= 1;
+
+                // Gap 1: four groups [x y] per pair of vectors
+                x = values;
+                for (size_t i = 0; i < m; i += 4)
+                {
+                    MultiplyUIntModOperandAVX2 r = load_roots_gap1(roots + 1);
+                    roots += 4;
+                    __m256i a = load(x);
+                    __m256i b = load(x + 4);
+                    u = arithmetic.guard(_mm256_unpacklo_epi64(a, b));
+                    v = arithmetic.mul_root(_mm256_unpackhi_epi64(a, b), r);
+                    a = arithmetic.add(u, v);
+                    b = arithmetic.sub(u, v);
+                    store(x, _mm256_unpacklo_epi64(a, b));
+                    store(x + 4, _mm256_unpackhi_epi64(a, b));
+                    x += 8;
+                }
+            }
+
+            template <typename ArithmeticT>
+            SEAL_TARGET_AVX2 void transform_from_rev_kernel(
+                uint64_t *values, int log_n, const MultiplyUIntModOperand *roots, uint64_t modulus,
+                const MultiplyUIntModOperand *scalar, const MultiplyUIntModOperand *scaled_root)
+            {
+                const ArithmeticT arithmetic(modulus);
+                size_t n = size_t(1) << log_n;
+                size_t m = n >> 1;
+                __m256i u, v;
+
+                // Gap 1: four groups [x y] per pair of vectors
+                uint64_t *x = values;
+                for (size_t i = 0; i < m; i += 4)
+                {
+                    MultiplyUIntModOperandAVX2 r = load_roots_gap1(roots + 1);
+                    roots += 4;
+                    __m256i a = load(x);
+                    __m256i b = load(x + 4);
+                    u = _mm256_unpacklo_epi64(a, b);
+                    v = _mm256_unpackhi_epi64(a, b);
+                    a = arithmetic.guard(arithmetic.add(u, v));
+                    b = arithmetic.mul_root(arithmetic.sub(u, v), r);
+                    store(x, _mm256_unpacklo_epi64(a, b));
+                    store(x + 4, _mm256_unpackhi_epi64(a, b));
+                    x += 8;
+                }
+                m >>= 1;
+
+                // Gap 2: two groups [x0 x1 y0 y1] per pair of vectors
+                x = values;
+                for (size_t i = 0; i < m; i += 2)
+                {
+                    MultiplyUIntModOperandAVX2 r = load_roots_gap2(roots + 1);
+                    roots += 2;
+                    __m256i a = load(x);
+                    __m256i b = load(x + 4);
+                    u = _mm256_permute2x128_si256(a, b, 0x20);
+                    v = _mm256_permute2x128_si256(a, b, 0x31);
+                    a = arithmetic.guard(arithmetic.add(u, v));
+                    b = arithmetic.mul_root(arithmetic.sub(u, v), r);
+                    store(x, _mm256_permute2x128_si256(a, b, 0x20));
+                    store(x + 4, _mm256_permute2x128_si256(a, b, 0x31));
+                    x += 8;
+                }
+                m >>= 1;
+
+                // Layers with gap at least 4: each vector holds four consecutive butterflies sharing one root
+                size_t gap = 4;
+                for (; m > 1; m >>= 1)
+                {
+                    x = values;
+                    for (size_t i = 0; i < m; i++)
+                    {
+                        MultiplyUIntModOperandAVX2 r = broadcast(*++roots);
+                        uint64_t *y = x + gap;
+                        for (size_t j = 0; j < gap; j += 4)
+                        {
+                            u = load(x + j);
+                            v = load(y + j);
+                            store(x + j, arithmetic.guard(arithmetic.add(u, v)));
+                            store(y + j, arithmetic.mul_root(arithmetic.sub(u, v), r));
+                        }
+                        x += gap << 1;
+                    }
+                    gap <<= 1;
+                }
+
+                // Last layer, optionally merged with the multiplication by scalar
+                uint64_t *y = values + gap;
+                if (scalar != nullptr)
+                {
+                    MultiplyUIntModOperandAVX2 s = broadcast(*scalar);
+                    MultiplyUIntModOperandAVX2 r = broadcast(*scaled_root);
+                    for (size_t j = 0; j < gap; j += 4)
+                    {
+                        u = arithmetic.guard(load(values + j));
+                        v = load(y + j);
+                        store(values + j, arithmetic.mul_scalar(arithmetic.guard(arithmetic.add(u, v)), s));
+                        store(y + j, arithmetic.mul_root(arithmetic.sub(u, v), r));
+                    }
+                }
+                else
+                {
+                    MultiplyUIntModOperandAVX2 r = broadcast(*++roots);
+                    for (size_t j = 0; j < gap; j += 4)
+                    {
+                        u = load(values + j);
+                        v = load(y + j);
+                        store(values + j, arithmetic.guard(arithmetic.add(u, v)));
+                        store(y + j, arithmetic.mul_root(arithmetic.sub(u, v), r));
+                    }
+                }
+            }
+
+            static_assert(sizeof(MultiplyUIntModOperand32) == 2 * sizeof(uint32_t), "unexpected operand layout");
+
+            /**
+            Eight lanes of a root or scalar operand, i.e., MultiplyUIntModOperand32 in vector form.
+            */
+            struct MultiplyUIntModOperand32AVX2
+            {
+                __m256i operand;
+
+                __m256i quotient;
+            };
+
+            /**
+            Eight-lane form of Arithmetic<std::uint32_t, MultiplyUIntModOperand32, MultiplyUIntModOperand32>. The lazy
+            values below 4 * modulus fill all 32 bits, so comparisons are unsigned.
+            */
+            class ArithmeticAVX2x32
+            {
+            public:
+                SEAL_TARGET_AVX2 ArithmeticAVX2x32(uint32_t modulus)
+                    : modulus_(_mm256_set1_epi32(static_cast<int>(modulus))),
+                      two_times_modulus_(_mm256_set1_epi32(static_cast<int>(modulus << 1)))
+                {}
+
+                SEAL_TARGET_AVX2 inline __m256i add(__m256i a, __m256i b) const
+                {
+                    return _mm256_add_epi32(a, b);
+                }
+
+                SEAL_TARGET_AVX2 inline __m256i sub(__m256i a, __m256i b) const
+                {
+                    return _mm256_sub_epi32(_mm256_add_epi32(a, two_times_modulus_), b);
+                }
+
+                SEAL_TARGET_AVX2 inline __m256i mul_root(__m256i a, const MultiplyUIntModOperand32AVX2 &r) const
+                {
+                    // Same as multiply_uint_mod_lazy: r * a - hw32(a * quotient(r)) * modulus, with the high halves
+                    // of the even and odd lanes computed separately
+                    __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(a, r.quotient), 32);
+                    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(r.quotient, 32));
+                    __m256i tmp = _mm256_blend_epi32(even, odd, 0xAA);
+                    return _mm256_sub_epi32(_mm256_mullo_epi32(a, r.operand), _mm256_mullo_epi32(tmp, modulus_));
+                }
+
+                SEAL_TARGET_AVX2 inline __m256i mul_scalar(__m256i a, const MultiplyUIntModOperand32AVX2 &s) const
+                {
+                    return mul_root(a, s);
+                }
+
+                SEAL_TARGET_AVX2 inline __m256i guard(__m256i a) const
+                {
+                    // For a >= 2 * modulus the difference is smaller than a; otherwise it wraps around and is larger
+                    return _mm256_min_epu32(a, _mm256_sub_epi32(a, two_times_modulus_));
+                }
+
+            private:
+                __m256i modulus_;
+
+                __m256i two_times_modulus_;
+            };
+
+            SEAL_TARGET_AVX2 inline __m256i load(const uint32_t *ptr)
+            {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+            }
+
+            SEAL_TARGET_AVX2 inline void store(uint32_t *ptr, __m256i value)
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr), value);
+            }
+
+            SEAL_TARGET_AVX2 inline MultiplyUIntModOperand32AVX2 broadcast(const MultiplyUIntModOperand32 &r)
+            {
+                return { _mm256_set1_epi32(static_cast<int>(r.operand)),
+                         _mm256_set1_epi32(static_cast<int>(r.quotient)) };
+            }
+
+            // Lanes hold roots[0] four times, then roots[1] four times; matches the gap-4 data layout
+            SEAL_TARGET_AVX2 inline MultiplyUIntModOperand32AVX2 load_roots_gap4(const MultiplyUIntModOperand32 *roots)
+            {
+                __m256i r = _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(roots)));
+                return { _mm256_permutevar8x32_epi32(r, _mm256_setr_epi32(0, 0, 0, 0, 2, 2, 2, 2)),
+                         _mm256_permutevar8x32_epi32(r, _mm256_setr_epi32(1, 1, 1, 1, 3, 3, 3, 3)) };
+            }
+
+            // Lanes hold roots[0], roots[0], roots[2], roots[2], roots[1], roots[1], roots[3], roots[3]; matches the
+            // gap-2 data layout
+            SEAL_TARGET_AVX2 inline MultiplyUIntModOperand32AVX2 load_roots_gap2(const MultiplyUIntModOperand32 *roots)
+            {
+                __m256i r = load(reinterpret_cast<const uint32_t *>(roots));
+                return { _mm256_permutevar8x32_epi32(r, _mm256_setr_epi32(0, 0, 4, 4, 2, 2, 6, 6)),
+                         _mm256_permutevar8x32_epi32(r, _mm256_setr_epi32(1, 1, 5, 5, 3, 3, 7, 7)) };
+            }
+
+            // Lanes hold roots[0], roots[1], roots[4], roots[5], roots[2], roots[3], roots[6], roots[7]; matches the
+            // gap-1 data layout
+            SEAL_TARGET_AVX2 inline MultiplyUIntModOperand32AVX2 load_roots_gap1(const MultiplyUIntModOperand32 *roots)
+            {
+                __m256i r0 = _mm256_shuffle_epi32(load(reinterpret_cast<const uint32_t *>(roots)), 0xD8);
+                __m256i r1 = _mm256_shuffle_epi32(load(reinterpret_cast<const uint32_t *>(roots + 4)), 0xD8);
+                return { _mm256_unpacklo_epi64(r0, r1), _mm256_unpackhi_epi64(r0, r1) };
+            }
+
+            SEAL_TARGET_AVX2 void transform_to_rev_kernel32(
+                uint32_t *values, int log_n, const MultiplyUIntModOperand32 *roots, uint32_t modulus)
+            {
+                const ArithmeticAVX2x32 arithmetic(modulus);
+                size_t n = size_t(1) << log_n;
+                size_t gap = n >> 1;
+                size_t m = 1;
+                __m256i u, v;
+
+                // Layers with gap at least 8: each vector holds eight consecutive butterflies sharing one root
+                for (; m < (n >> 3); m <<= 1)
+                {
+                    uint32_t *x = values;
+                    for (size_t i = 0; i < m; i++)
+                    {
+                        MultiplyUIntModOperand32AVX2 r = broadcast(*++roots);
+                        uint32_t *y = x + gap;
+                        for (size_t j = 0; j < gap; j += 8)
+                        {
+                            u = arithmetic.guard(load(x + j));
+                            v = arithmetic.mul_root(load(y + j), r);
+                            store(x + j, arithmetic.add(u, v));
+                            store(y + j, arithmetic.sub(u, v));
+                        }
+                        x += gap << 1;
+                    }
+                    gap >>= 1;
+                }
+
+                // Gap 4: two groups [x0 x1 x2 x3 y0 y1 y2 y3] per pair of vectors
+                uint32_t *x = values;
+                for (size_t i = 0; i < m; i += 2)
+                {
+                    MultiplyUIntModOperand32AVX2 r = load_roots_gap4(roots + 1);
+                    roots += 2;
+                    __m256i a = load(x);
+                    __m256i b = load(x + 8);
+                    u = arithmetic.guard(_mm256_permute2x128_si256(a, b, 0x20));
+                    v = arithmetic.mul_root(_mm256_permute2x128_si256(a, b, 0x31), r);
+                    a = arithmetic.add(u, v);
+                    b = arithmetic.sub(u, v);
+                    store(x, _mm256_permute2x128_si256(a, b, 0x20));
+                    store(x + 8, _mm256_permute2x128_si256(a, b, 0x31));
+                    x += 16;
+                }
+                m <<= 1;
+
+                // Gap 2: four groups [x0 x1 y0 y1] per pair of vectors
+                x = values;
+                for (size_t i = 0; i < m; i += 4)
+                {
+                    MultiplyUIntModOperand32AVX2 r = load_roots_gap2(roots + 1);
+                    roots += 4;
+                    __m256i a = load(x);
+                    __m256i b = load(x + 8);
+                    u = arithmetic.guard(_mm256_unpacklo_epi64(a, b));
+                    v = arithmetic.mul_root(_mm256_unpackhi_epi64(a, b), r);
+                    a = arithmetic.add(u, v);
+                    b = arithmetic.sub(u, v);
+                    store(x, _mm256_unpacklo_epi64(a, b));
+                    store(x + 8, _mm256_unpackhi_epi64(a, b));
+                    x += 16;
+                }
+                m <<= 1;
+
+                // Gap 1: eight groups [x y] per pair of vectors, regrouped as [x x y y] within each 128-bit lane
+                x = values;
+                for (size_t i = 0; i < m; i += 8)
+                {
+                    MultiplyUIntModOperand32AVX2 r = load_roots_gap1(roots + 1);
+                    roots += 8;
+                    __m256i a = _mm256_shuffle_epi32(load(x), 0xD8);
+                    __m256i b = _mm256_shuffle_epi32(load(x + 8), 0xD8);
+                    u = arithmetic.guard(_mm256_unpacklo_epi64(a, b));
+                    v = arithmetic.mul_root(_mm256_unpackhi_epi64(a, b), r);
+                    a = arithmetic.add(u, v);
+                    b = arithmetic.sub(u, v);
+                    store(x, _mm256_shuffle_epi32(_mm256_unpacklo_epi64(a, b), 0xD8));
+                    store(x + 8, _mm256_shuffle_epi32(_mm256_unpackhi_epi64(a, b), 0xD8));
+                    x += 16;
+                }
+            }
+
+            SEAL_TARGET_AVX2 void transform_from_rev_kernel32(
+                uint32_t *values, int log_n, const MultiplyUIntModOperand32 *roots, uint32_t modulus,
+                const MultiplyUIntModOperand32 *scalar, const MultiplyUIntModOperand32 *scaled_root)
+            {
+                const ArithmeticAVX2x32 arithmetic(modulus);
+                size_t n = size_t(1) << log_n;
+                size_t m = n >> 1;
+                __m256i u, v;
+
+                // Gap 1: eight groups [x y] per pair of vectors, regrouped as [x x y y] within each 128-bit lane
+                uint32_t *x = values;
+                for (size_t i = 0; i < m; i += 8)
+                {
+                    MultiplyUIntModOperand32AVX2 r = load_roots_gap1(roots + 1);
+                    roots += 8;
+                    __m256i a = _mm256_shuffle_epi32(load(x), 0xD8);
+                    __m256i b = _mm256_shuffle_epi32(load(x + 8), 0xD8);
+                    u = _mm256_unpacklo_epi64(a, b);
+                    v = _mm256_unpackhi_epi64(a, b);
+                    a = arithmetic.guard(arithmetic.add(u, v));
+                    b = arithmetic.mul_root(arithmetic.sub(u, v), r);
+                    store(x, _mm256_shuffle_epi32(_mm256_unpacklo_epi64(a, b), 0xD8));
+                    store(x + 8, _mm256_shuffle_epi32(_mm256_unpackhi_epi64(a, b), 0xD8));
+                    x += 16;
+                }
+                m >>= 1;
+
+                // Gap 2: four groups [x0 x1 y0 y1] per pair of vectors
+                x = values;
+                for (size_t i = 0; i < m; i += 4)
+                {
+                    MultiplyUIntModOperand32AVX2 r = load_roots_gap2(roots + 1);
+                    roots += 4;
+                    __m256i a = load(x);
+                    __m256i b = load(x + 8);
+                    u = _mm256_unpacklo_epi64(a, b);
+                    v = _mm256_unpackhi_epi64(a, b);
+                    a = arithmetic.guard(arithmetic.add(u, v));
+                    b = arithmetic.mul_root(arithmetic.sub(u, v), r);
+                    store(x, _mm256_unpacklo_epi64(a, b));
+                    store(x + 8, _mm256_unpackhi_epi64(a, b));
+                    x += 16;
+                }
+                m >>= 1;
+
+                // Gap 4: two groups [x0 x1 x2 x3 y0 y1 y2 y3] per pair of vectors
+                x = values;
+                for (size_t i = 0; i < m; i += 2)
+                {
+                    MultiplyUIntModOperand32AVX2 r = load_roots_gap4(roots + 1);
+                    roots += 2;
+                    __m256i a = load(x);
+                    __m256i b = load(x + 8);
+                    u = _mm256_permute2x128_si256(a, b, 0x20);
+                    v = _mm256_permute2x128_si256(a, b, 0x31);
+                    a = arithmetic.guard(arithmetic.add(u, v));
+                    b = arithmetic.mul_root(arithmetic.sub(u, v), r);
+                    store(x, _mm256_permute2x128_si256(a, b, 0x20));
+                    store(x + 8, _mm256_permute2x128_si256(a, b, 0x31));
+                    x += 16;
+                }
+                m >>= 1;
+
+                // Layers with gap at least 8: each vector holds eight consecutive butterflies sharing one root
+                size_t gap = 8;
+                for (; m > 1; m >>= 1)
+                {
+                    x = values;
+                    for (size_t i = 0; i < m; i++)
+                    {
+                        MultiplyUIntModOperand32AVX2 r = broadcast(*++roots);
+                        uint32_t *y = x + gap;
+                        for (size_t j = 0; j < gap; j += 8)
+                        {
+                            u = load(x + j);
+                            v = load(y + j);
+                            store(x + j, arithmetic.guard(arithmetic.add(u, v)));
+                            store(y + j, arithmetic.mul_root(arithmetic.sub(u, v), r));
+                        }
+                        x += gap << 1;
+                    }
+                    gap <<= 1;
+                }
+
+                // Last layer, optionally merged with the multiplication by scalar
+                uint32_t *y = values + gap;
+                if (scalar != nullptr)
+                {
+                    MultiplyUIntModOperand32AVX2 s = broadcast(*scalar);
+                    MultiplyUIntModOperand32AVX2 r = broadcast(*scaled_root);
+                    for (size_t j = 0; j < gap; j += 8)
+                    {
+                        u = arithmetic.guard(load(values + j));
+                        v = load(y + j);
+                        store(values + j, arithmetic.mul_scalar(arithmetic.guard(arithmetic.add(u, v)), s));
+                        store(y + j, arithmetic.mul_root(arithmetic.sub(u, v), r));
+                    }
+                }
+                else
+                {
+                    MultiplyUIntModOperand32AVX2 r = broadcast(*++roots);
+                    for (size_t j = 0; j < gap; j += 8)
+                    {
+                        u = load(values + j);
+                        v = load(y + j);
+                        store(values + j, arithmetic.guard(arithmetic.add(u, v)));
+                        store(y + j, arithmetic.mul_root(arithmetic.sub(u, v), r));
+                    }
+                }
+            }
+        } // namespace
+
+        void ntt_transform_to_rev_avx2(
+            uint64_t *values, int log_n, const MultiplyUIntModOperand *roots, const Modulus &modulus)
+        {
+#ifdef SEAL_DEBUG
+            if (log_n < ntt_avx2_log_n_min)
+            {
+                throw invalid_argument("log_n is too small");
+            }
+            if (modulus.bit_count() > SEAL_MOD_BIT_COUNT_MAX)
+            {
+                throw invalid_argument("modulus is too large");
+            }
+#endif
+            if (modulus.bit_count() <= small_modulus_bit_count_max)
+            {
+                transform_to_rev_kernel<ArithmeticAVX2Small>(values, log_n, roots, modulus.value());
+            }
+            else
+            {
+                transform_to_rev_kernel<ArithmeticAVX2>(values, log_n, roots, modulus.value());
+            }
+        }
+
+        void ntt_transform_from_rev_avx2(
+            uint64_t *values, int log_n, const MultiplyUIntModOperand *roots, const Modulus &modulus,
+            const MultiplyUIntModOperand *scalar)
+        {
+#ifdef SEAL_DEBUG
+            if (log_n < ntt_avx2_log_n_min)
+            {
+                throw invalid_argument("log_n is too small");
+            }
+            if (modulus.bit_count() > SEAL_MOD_BIT_COUNT_MAX)
+            {
+                throw invalid_argument("modulus is too large");
+            }
+#endif
+            // The scaled root of the last layer is prepared here with scalar code
+            MultiplyUIntModOperand scaled_root{};
+            if (scalar != nullptr)
+            {
+                size_t n = size_t(1) << log_n;
+                scaled_root.set(multiply_uint_mod(roots[n - 1].operand, *scalar, modulus), modulus);
+            }
+            if (modulus.bit_count() <= small_modulus_bit_count_max)
+            {
+                transform_from_rev_kernel<ArithmeticAVX2Small>(
+                    values, log_n, roots, modulus.value(), scalar, &scaled_root);
+            }
+            else
+            {
+                transform_from_rev_kernel<ArithmeticAVX2>(values, log_n, roots, modulus.value(), scalar, &scaled_root);
+            }
+        }
+
+        void ntt_transform_to_rev_avx2(
+            uint32_t *values, int log_n, const MultiplyUIntModOperand32 *roots, const Modulus &modulus)
+        {
+#ifdef SEAL_DEBUG
+            if (log_n < ntt_avx2_uint32_log_n_min)
+            {
+                throw invalid_argument("log_n is too small");
+            }
+            if (modulus.bit_count() > small_modulus_bit_count_max)
+            {
+                throw invalid_argument("modulus is too large");
+            }
+#endif
+            transform_to_rev_kernel32(values, log_n, roots, static_cast<uint32_t>(modulus.value()));
+        }
+
+        void ntt_transform_from_rev_avx2(
+            uint32_t *values, int log_n, const MultiplyUIntModOperand32 *roots, const Modulus &modulus,
+            const MultiplyUIntModOperand32 *scalar)
+        {
+#ifdef SEAL_DEBUG
+            if (log_n < ntt_avx2_uint32_log_n_min)
+            {
+                throw invalid_argument("log_n is too small");
+            }
+            if (modulus.bit_count() > small_modulus_bit_count_max)
+            {
+                throw invalid_argument("modulus is too large");
+            }
+#endif
+            // The scaled root of the last layer is prepared here with scalar code
+            MultiplyUIntModOperand32 scaled_root{};
+            if (scalar != nullptr)
+            {
+                size_t n = size_t(1) << log_n;
+                scaled_root.set(multiply_uint_mod(roots[n - 1].operand, *scalar, modulus), modulus);
+            }
+            transform_from_rev_kernel32(
+                values, log_n, roots, static_cast<uint32_t>(modulus.value()), scalar, &scaled_root);
+        }
+    } // namespace util
+} // namespace seal
+#endif
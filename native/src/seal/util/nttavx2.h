@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/modulus.h"
+#include "seal/util/defines.h"
+#include "seal/util/uintarithsmallmod.h"
+#include <cstdint>
+
+#ifdef SEAL_USE_AVX2
+namespace seal
+{
+    namespace util
+    {
+        /**
+        The smallest log2 of the transform size handled by the AVX2 kernels; the last two layers process two and four
+        butterfly groups per vector, respectively.
+        */
+        constexpr int ntt_avx2_log_n_min = 3;
+
+        /**
+        AVX2 counterpart of DWTHandler<std::uint64_t, MultiplyUIntModOperand, MultiplyUIntModOperand>::transform_to_rev
+        with four butterflies per instruction. The output is identical to that of the scalar implementation, except
+        that for moduli of at most small_modulus_bit_count_max bits, which use native 32-bit products, it may differ
+        by a multiple of modulus within the same range. Must only be called if cpu_has_avx2() returns true.
+
+        @param[values] inputs in normal order in [0, 4 * modulus), outputs in bit-reversed order in [0, 4 * modulus)
+        @param[log_n] log 2 of the DWT size; must be at least ntt_avx2_log_n_min
+        @param[roots] powers of a root in bit-reversed order
+        @param[modulus] the modulus; must be at most 61 bits
+        */
+        void ntt_transform_to_rev_avx2(
+            std::uint64_t *values, int log_n, const MultiplyUIntModOperand *roots, const Modulus &modulus);
+
+        /**
+        AVX2 counterpart of
+        DWTHandler<std::uint64_t, MultiplyUIntModOperand, MultiplyUIntModOperand>::transform_from_rev with four
+        butterflies per instruction. The output is identical to that of the scalar implementation, except that for
+        moduli of at most small_modulus_bit_count_max bits, which use native 32-bit products, it may differ by a
+        multiple of modulus within the same range. Must only be called if cpu_has_avx2() returns true.
+
+        @param[values] inputs in bit-reversed order in [0, 2 * modulus), outputs in normal order in [0, 2 * modulus)
+        @param[log_n] log 2 of the DWT size; must be at least ntt_avx2_log_n_min
+        @param[roots] powers of a root in scrambled order
+        @param[modulus] the modulus; must be at most 61 bits
+        @param[scalar] an optional scalar that is multiplied to all output values
+        */
+        void ntt_transform_from_rev_avx2(
+            std::uint64_t *values, int log_n, const MultiplyUIntModOperand *roots, const Modulus &modulus,
+            const MultiplyUIntModOperand *scalar = nullptr);
+
+        /**
+        The smallest log2 of the transform size handled by the std::uint32_t AVX2 kernels; the last three layers
+        process two, four, and eight butterfly groups per pair of vectors, respectively.
+        */
+        constexpr int ntt_avx2_uint32_log_n_min = 4;
+
+        /**
+        AVX2 counterpart of
+        DWTHandler<std::uint32_t, MultiplyUIntModOperand32, MultiplyUIntModOperand32>::transform_to_rev with eight
+        butterflies per instruction. The output is identical to that of the scalar implementation. Must only be called
+        if cpu_has_avx2() returns true.
+
+        @param[values] inputs in normal order in [0, 4 * modulus), outputs in bit-reversed order in [0, 4 * modulus)
+        @param[log_n] log 2 of the DWT size; must be at least ntt_avx2_uint32_log_n_min
+        @param[roots] powers of a root in bit-reversed order
+        @param[modulus] the modulus; must be at most small_modulus_bit_count_max bits
+        */
+        void ntt_transform_to_rev_avx2(
+            std::uint32_t *values, int log_n, const MultiplyUIntModOperand32 *roots, const Modulus &modulus);
+
+        /**
+        AVX2 counterpart of
+        DWTHandler<std::uint32_t, MultiplyUIntModOperand32, MultiplyUIntModOperand32>::transform_from_rev with eight
+        butterflies per instruction. The output is identical to that of the scalar implementation. Must only be called
+        if cpu_has_avx2() returns true.
+
+        @param[values] inputs in bit-reversed order in [0, 2 * modulus), outputs in normal order in [0, 2 * modulus)
+        @param[log_n] log 2 of the DWT size; must be at least ntt_avx2_uint32_log_n_min
+        @param[roots] powers of a root in scrambled order
+        @param[modulus] the modulus; must be at most small_modulus_bit_count_max bits
+        @param[scalar] an optional scalar that is multiplied to all output values
+        */
+        void ntt_transform_from_rev_avx2(
+            std::uint32_t *values, int log_n, const MultiplyUIntModOperand32 *roots, const Modulus &modulus,
+            const MultiplyUIntModOperand32 *scalar = nullptr);
+    } // namespace util
+} // namespace seal
+#endif
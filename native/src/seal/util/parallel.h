@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "seal/context.h"
+#include "seal/memorymanager.h"
+#include "seal/threadpool.h"
+#include "seal/util/defines.h"
+#include <cstddef>
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        Returns the ThreadPool of context if loops whose iterations allocate from pool may run on it, or nullptr if
+        context has no ThreadPool or pool is not thread-safe.
+        */
+        SEAL_NODISCARD inline ThreadPool *get_thread_pool(const SEALContext &context, const MemoryPoolHandle &pool)
+        {
+            if (!dynamic_cast<MemoryPoolMT *>(&static_cast<MemoryPool &>(pool)))
+            {
+                return nullptr;
+            }
+            return context.thread_pool().get();
+        }
+
+        /**
+        Calls kernel(i) for every i in [0, count), distributed across thread_pool unless it is nullptr.
+        */
+        template <typename KernelT>
+        inline void parallel_for_each(ThreadPool *thread_pool, std::size_t count, KernelT &&kernel)
+        {
+            if (thread_pool)
+            {
+                thread_pool->parallel_for(count, kernel);
+                return;
+            }
+            for (std::size_t i = 0; i < count; i++)
+            {
+                kernel(i);
+            }
+        }
+    } // namespace util
+} // namespace seal
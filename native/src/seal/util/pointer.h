@@ -21,6 +21,7 @@ namespace seal
         {
             friend class MemoryPoolST;
             friend class MemoryPoolMT;
+            friend class MemoryPoolArena;
 
         public:
             template <typename, typename>
@@ -43,14 +44,14 @@ namespace seal
             // Move of the same type
             Pointer(Pointer<seal_byte> &&source, seal_byte value) : Pointer(std::move(source))
             {
-                std::fill_n(data_, head_->item_byte_count(), value);
+                std::fill_n(data_, head_->item_byte_count_of(item_), value);
             }
 
             // Copy a range of elements
             template <typename InputIt>
             Pointer(InputIt first, Pointer<seal_byte> &&source) : Pointer(std::move(source))
             {
-                std::copy_n(first, head_->item_byte_count(), data_);
+                std::copy_n(first, head_->item_byte_count_of(item_), data_);
             }
 
             SEAL_NODISCARD inline seal_byte &operator[](std::size_t index)
@@ -192,6 +193,7 @@ namespace seal
         {
             friend class MemoryPoolST;
             friend class MemoryPoolMT;
+            friend class MemoryPoolArena;
 
         public:
             friend class Pointer<seal_byte>;
@@ -226,7 +228,7 @@ namespace seal
                     data_ = reinterpret_cast<T *>(item_->data());
                     SEAL_IF_CONSTEXPR(!std::is_trivially_constructible<T>::value)
                     {
-                        auto count = head_->item_byte_count() / sizeof(T);
+                        auto count = head_->item_byte_count_of(item_) / sizeof(T);
                         for (auto alloc_ptr = data_; count--; alloc_ptr++)
                         {
                             new (alloc_ptr) T;
@@ -256,7 +258,7 @@ namespace seal
                 if (head_)
                 {
                     data_ = reinterpret_cast<T *>(item_->data());
-                    auto count = head_->item_byte_count() / sizeof(T);
+                    auto count = head_->item_byte_count_of(item_) / sizeof(T);
                     for (auto alloc_ptr = data_; count--; alloc_ptr++)
                     {
                         new (alloc_ptr) T(std::forward<Args>(args)...);
@@ -285,7 +287,7 @@ namespace seal
                 if (head_)
                 {
                     data_ = reinterpret_cast<T *>(item_->data());
-                    auto count = head_->item_byte_count() / sizeof(T);
+                    auto count = head_->item_byte_count_of(item_) / sizeof(T);
                     std::uninitialized_copy_n(first, count, data_);
                 }
                 alias_ = source.alias_;
@@ -350,7 +352,7 @@ namespace seal
                     SEAL_IF_CONSTEXPR(!std::is_trivially_destructible<T>::value)
                     {
                         // Manual destructor calls
-                        auto count = head_->item_byte_count() / sizeof(T);
+                        auto count = head_->item_byte_count_of(item_) / sizeof(T);
                         for (auto alloc_ptr = data_; count--; alloc_ptr++)
                         {
                             alloc_ptr->~T();
@@ -413,7 +415,7 @@ namespace seal
                     data_ = reinterpret_cast<T *>(item_->data());
                     SEAL_IF_CONSTEXPR(!std::is_trivially_constructible<T>::value)
                     {
-                        auto count = head_->item_byte_count() / sizeof(T);
+                        auto count = head_->item_byte_count_of(item_) / sizeof(T);
                         for (auto alloc_ptr = data_; count--; alloc_ptr++)
                         {
                             new (alloc_ptr) T;
@@ -473,7 +475,7 @@ namespace seal
                 data_ = reinterpret_cast<T *>(item_->data());
                 SEAL_IF_CONSTEXPR(!std::is_trivially_constructible<T>::value)
                 {
-                    auto count = head_->item_byte_count() / sizeof(T);
+                    auto count = head_->item_byte_count_of(item_) / sizeof(T);
                     for (auto alloc_ptr = data_; count--; alloc_ptr++)
                     {
                         new (alloc_ptr) T;
@@ -493,7 +495,7 @@ namespace seal
                 head_ = head;
                 item_ = head->get();
                 data_ = reinterpret_cast<T *>(item_->data());
-                auto count = head_->item_byte_count() / sizeof(T);
+                auto count = head_->item_byte_count_of(item_) / sizeof(T);
                 for (auto alloc_ptr = data_; count--; alloc_ptr++)
                 {
                     new (alloc_ptr) T(std::forward<Args>(args)...);
@@ -512,7 +514,7 @@ namespace seal
                 head_ = head;
                 item_ = head->get();
                 data_ = reinterpret_cast<T *>(item_->data());
-                auto count = head_->item_byte_count() / sizeof(T);
+                auto count = head_->item_byte_count_of(item_) / sizeof(T);
                 std::uninitialized_copy_n(first, count, data_);
             }
 
@@ -531,6 +533,7 @@ namespace seal
         {
             friend class MemoryPoolST;
             friend class MemoryPoolMT;
+            friend class MemoryPoolArena;
 
         public:
             template <typename, typename>
@@ -551,7 +554,7 @@ namespace seal
             // Move of the same type
             ConstPointer(Pointer<seal_byte> &&source, seal_byte value) : ConstPointer(std::move(source))
             {
-                std::fill_n(data_, head_->item_byte_count(), value);
+                std::fill_n(data_, head_->item_byte_count_of(item_), value);
             }
 
             // Move of the same type
@@ -567,14 +570,14 @@ namespace seal
             // Move of the same type
             ConstPointer(ConstPointer<seal_byte> &&source, seal_byte value) : ConstPointer(std::move(source))
             {
-                std::fill_n(data_, head_->item_byte_count(), value);
+                std::fill_n(data_, head_->item_byte_count_of(item_), value);
             }
 
             // Copy a range of elements
             template <typename InputIt>
             ConstPointer(InputIt first, ConstPointer<seal_byte> &&source) : ConstPointer(std::move(source))
             {
-                std::copy_n(first, head_->item_byte_count(), data_);
+                std::copy_n(first, head_->item_byte_count_of(item_), data_);
             }
 
             inline auto &operator=(ConstPointer<seal_byte> &&assign) noexcept
@@ -731,6 +734,7 @@ namespace seal
         {
             friend class MemoryPoolST;
             friend class MemoryPoolMT;
+            friend class MemoryPoolArena;
 
         public:
             ConstPointer() = default;
@@ -761,7 +765,7 @@ namespace seal
                     data_ = reinterpret_cast<T *>(item_->data());
                     SEAL_IF_CONSTEXPR(!std::is_trivially_constructible<T>::value)
                     {
-                        auto count = head_->item_byte_count() / sizeof(T);
+                        auto count = head_->item_byte_count_of(item_) / sizeof(T);
                         for (auto alloc_ptr = data_; count--; alloc_ptr++)
                         {
                             new (alloc_ptr) T;
@@ -791,7 +795,7 @@ namespace seal
                 if (head_)
                 {
                     data_ = reinterpret_cast<T *>(item_->data());
-                    auto count = head_->item_byte_count() / sizeof(T);
+                    auto count = head_->item_byte_count_of(item_) / sizeof(T);
                     for (auto alloc_ptr = data_; count--; alloc_ptr++)
                     {
                         new (alloc_ptr) T(std::forward<Args>(args)...);
@@ -820,7 +824,7 @@ namespace seal
                 if (head_)
                 {
                     data_ = reinterpret_cast<T *>(item_->data());
-                    auto count = head_->item_byte_count() / sizeof(T);
+                    auto count = head_->item_byte_count_of(item_) / sizeof(T);
                     std::uninitialized_copy_n(first, count, data_);
                 }
                 alias_ = source.alias_;
@@ -857,7 +861,7 @@ namespace seal
                     data_ = reinterpret_cast<T *>(item_->data());
                     SEAL_IF_CONSTEXPR(!std::is_trivially_constructible<T>::value)
                     {
-                        auto count = head_->item_byte_count() / sizeof(T);
+                        auto count = head_->item_byte_count_of(item_) / sizeof(T);
                         for (auto alloc_ptr = data_; count--; alloc_ptr++)
                         {
                             new (alloc_ptr) T;
@@ -887,7 +891,7 @@ namespace seal
                 if (head_)
                 {
                     data_ = reinterpret_cast<T *>(item_->data());
-                    auto count = head_->item_byte_count() / sizeof(T);
+                    auto count = head_->item_byte_count_of(item_) / sizeof(T);
                     for (auto alloc_ptr = data_; count--; alloc_ptr++)
                     {
                         new (alloc_ptr) T(std::forward<Args>(args)...);
@@ -916,7 +920,7 @@ namespace seal
                 if (head_)
                 {
                     data_ = reinterpret_cast<T *>(item_->data());
-                    auto count = head_->item_byte_count() / sizeof(T);
+                    auto count = head_->item_byte_count_of(item_) / sizeof(T);
                     std::uninitialized_copy_n(first, count, data_);
                 }
                 alias_ = source.alias_;
@@ -983,7 +987,7 @@ namespace seal
                     SEAL_IF_CONSTEXPR(!std::is_trivially_destructible<T>::value)
                     {
                         // Manual destructor calls
-                        auto count = head_->item_byte_count() / sizeof(T);
+                        auto count = head_->item_byte_count_of(item_) / sizeof(T);
                         for (auto alloc_ptr = data_; count--; alloc_ptr++)
                         {
                             alloc_ptr->~T();
@@ -1046,7 +1050,7 @@ namespace seal
                     data_ = reinterpret_cast<T *>(item_->data());
                     SEAL_IF_CONSTEXPR(!std::is_trivially_constructible<T>::value)
                     {
-                        auto count = head_->item_byte_count() / sizeof(T);
+                        auto count = head_->item_byte_count_of(item_) / sizeof(T);
                         for (auto alloc_ptr = data_; count--; alloc_ptr++)
                         {
                             new (alloc_ptr) T;
@@ -1101,7 +1105,7 @@ namespace seal
                     data_ = reinterpret_cast<T *>(item_->data());
                     SEAL_IF_CONSTEXPR(!std::is_trivially_constructible<T>::value)
                     {
-                        auto count = head_->item_byte_count() / sizeof(T);
+                        auto count = head_->item_byte_count_of(item_) / sizeof(T);
                         for (auto alloc_ptr = data_; count--; alloc_ptr++)
                         {
                             new (alloc_ptr) T;
@@ -1161,7 +1165,7 @@ namespace seal
                 data_ = reinterpret_cast<T *>(item_->data());
                 SEAL_IF_CONSTEXPR(!std::is_trivially_constructible<T>::value)
                 {
-                    auto count = head_->item_byte_count() / sizeof(T);
+                    auto count = head_->item_byte_count_of(item_) / sizeof(T);
                     for (auto alloc_ptr = data_; count--; alloc_ptr++)
                     {
                         new (alloc_ptr) T;
@@ -1181,7 +1185,7 @@ namespace seal
                 head_ = head;
                 item_ = head->get();
                 data_ = reinterpret_cast<T *>(item_->data());
-                auto count = head_->item_byte_count() / sizeof(T);
+                auto count = head_->item_byte_count_of(item_) / sizeof(T);
                 for (auto alloc_ptr = data_; count--; alloc_ptr++)
                 {
                     new (alloc_ptr) T(std::forward<Args>(args)...);
@@ -1200,7 +1204,7 @@ namespace seal
                 head_ = head;
                 item_ = head->get();
                 data_ = reinterpret_cast<T *>(item_->data());
-                auto count = head_->item_byte_count() / sizeof(T);
+                auto count = head_->item_byte_count_of(item_) / sizeof(T);
                 std::uninitialized_copy_n(first, count, data_);
             }
 
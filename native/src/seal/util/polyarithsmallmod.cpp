@@ -85,6 +85,36 @@ namespace seal
 #endif
         }
 
+        void add_poly_coeffmod(
+            const uint32_t *operand1, const uint32_t *operand2, size_t coeff_count, const Modulus &modulus,
+            uint32_t *result)
+        {
+#ifdef SEAL_DEBUG
+            if (!operand1 && coeff_count > 0)
+            {
+                throw invalid_argument("operand1");
+            }
+            if (!operand2 && coeff_count > 0)
+            {
+                throw invalid_argument("operand2");
+            }
+            if (!result && coeff_count > 0)
+            {
+                throw invalid_argument("result");
+            }
+            if (modulus.is_zero() || modulus.bit_count() > small_modulus_bit_count_max)
+            {
+                throw invalid_argument("modulus");
+            }
+#endif
+            const uint32_t modulus_value = static_cast<uint32_t>(modulus.value());
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                uint32_t sum = operand1[i] + operand2[i];
+                result[i] = SEAL_COND_SELECT(sum >= modulus_value, sum - modulus_value, sum);
+            }
+        }
+
         void sub_poly_coeffmod(
             ConstCoeffIter operand1, ConstCoeffIter operand2, std::size_t coeff_count, const Modulus &modulus,
             CoeffIter result)
@@ -130,6 +160,36 @@ namespace seal
 #endif
         }
 
+        void sub_poly_coeffmod(
+            const uint32_t *operand1, const uint32_t *operand2, size_t coeff_count, const Modulus &modulus,
+            uint32_t *result)
+        {
+#ifdef SEAL_DEBUG
+            if (!operand1 && coeff_count > 0)
+            {
+                throw invalid_argument("operand1");
+            }
+            if (!operand2 && coeff_count > 0)
+            {
+                throw invalid_argument("operand2");
+            }
+            if (!result && coeff_count > 0)
+            {
+                throw invalid_argument("result");
+            }
+            if (modulus.is_zero() || modulus.bit_count() > small_modulus_bit_count_max)
+            {
+                throw invalid_argument("modulus");
+            }
+#endif
+            const uint32_t modulus_value = static_cast<uint32_t>(modulus.value());
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                uint32_t difference = operand1[i] - operand2[i];
+                result[i] = SEAL_COND_SELECT(operand1[i] < operand2[i], difference + modulus_value, difference);
+            }
+        }
+
         void add_poly_scalar_coeffmod(
             ConstCoeffIter poly, size_t coeff_count, uint64_t scalar, const Modulus &modulus, CoeffIter result)
         {
@@ -248,6 +308,14 @@ namespace seal
             {
                 throw invalid_argument("modulus");
             }
+            const uint64_t input_bound = mul_safe(modulus.value(), uint64_t(4));
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                if (operand1[i] >= input_bound || operand2[i] >= input_bound)
+                {
+                    throw invalid_argument("operands must be less than 4 * modulus");
+                }
+            }
 #endif
 #ifdef SEAL_USE_INTEL_HEXL
             intel::hexl::EltwiseMultMod(&result[0], &operand1[0], &operand2[0], coeff_count, modulus.value(), 4);
@@ -256,6 +324,20 @@ namespace seal
             const uint64_t const_ratio_0 = modulus.const_ratio()[0];
             const uint64_t const_ratio_1 = modulus.const_ratio()[1];
 
+            if (modulus.bit_count() <= small_modulus_bit_count_max)
+            {
+                // Inputs less than 4 * modulus are less than 2^32, so the product fits in 64 bits and a single-word
+                // Barrett reduction suffices: three multiplications per coefficient instead of six.
+                SEAL_ITERATE(iter(operand1, operand2, result), coeff_count, [&](auto I) {
+                    uint64_t z = get<0>(I) * get<1>(I);
+                    unsigned long long tmp;
+                    multiply_uint64_hw64(z, const_ratio_1, &tmp);
+                    tmp = z - tmp * modulus_value;
+                    get<2>(I) = SEAL_COND_SELECT(tmp >= modulus_value, tmp - modulus_value, tmp);
+                });
+                return;
+            }
+
             SEAL_ITERATE(iter(operand1, operand2, result), coeff_count, [&](auto I) {
                 // Reduces z using base 2^64 Barrett reduction
                 unsigned long long z[2], tmp1, tmp2[2], tmp3, carry;
@@ -283,6 +365,145 @@ namespace seal
 #endif
         }
 
+        void dyadic_product_coeffmod(
+            const uint32_t *operand1, const uint32_t *operand2, size_t coeff_count, const Modulus &modulus,
+            uint32_t *result)
+        {
+#ifdef SEAL_DEBUG
+            if (!operand1 && coeff_count > 0)
+            {
+                throw invalid_argument("operand1");
+            }
+            if (!operand2 && coeff_count > 0)
+            {
+                throw invalid_argument("operand2");
+            }
+            if (!result && coeff_count > 0)
+            {
+                throw invalid_argument("result");
+            }
+            if (modulus.is_zero() || modulus.bit_count() > small_modulus_bit_count_max)
+            {
+                throw invalid_argument("modulus");
+            }
+#endif
+            const uint64_t modulus_value = modulus.value();
+            const uint64_t const_ratio_1 = modulus.const_ratio()[1];
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                // Reduces z using base 2^64 Barrett reduction; z < 2^64 since both inputs are less than 2^32
+                uint64_t z = static_cast<uint64_t>(operand1[i]) * operand2[i];
+                unsigned long long tmp;
+                multiply_uint64_hw64(z, const_ratio_1, &tmp);
+                tmp = z - tmp * modulus_value;
+                result[i] = static_cast<uint32_t>(SEAL_COND_SELECT(tmp >= modulus_value, tmp - modulus_value, tmp));
+            }
+        }
+
+        void to_montgomery_coeffmod(ConstCoeffIter poly, size_t coeff_count, const Modulus &modulus, CoeffIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!poly && coeff_count > 0)
+            {
+                throw invalid_argument("poly");
+            }
+            if (!result && coeff_count > 0)
+            {
+                throw invalid_argument("result");
+            }
+            if (!(modulus.value() & 1))
+            {
+                throw invalid_argument("modulus");
+            }
+#endif
+            const uint64_t r2 = modulus.const_ratio()[2];
+            SEAL_ITERATE(iter(poly, result), coeff_count, [&](auto I) {
+                get<1>(I) = multiply_uint_mod_montgomery(get<0>(I), r2, modulus);
+            });
+        }
+
+        void from_montgomery_coeffmod(ConstCoeffIter poly, size_t coeff_count, const Modulus &modulus, CoeffIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!poly && coeff_count > 0)
+            {
+                throw invalid_argument("poly");
+            }
+            if (!result && coeff_count > 0)
+            {
+                throw invalid_argument("result");
+            }
+            if (!(modulus.value() & 1))
+            {
+                throw invalid_argument("modulus");
+            }
+#endif
+            SEAL_ITERATE(iter(poly, result), coeff_count, [&](auto I) {
+                get<1>(I) = from_montgomery(get<0>(I), modulus);
+            });
+        }
+
+        void multiply_poly_scalar_montgomery_coeffmod(
+            ConstCoeffIter poly, size_t coeff_count, MontgomeryOperand scalar, const Modulus &modulus, CoeffIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!poly && coeff_count > 0)
+            {
+                throw invalid_argument("poly");
+            }
+            if (!result && coeff_count > 0)
+            {
+                throw invalid_argument("result");
+            }
+            if (!(modulus.value() & 1))
+            {
+                throw invalid_argument("modulus");
+            }
+#endif
+            SEAL_ITERATE(iter(poly, result), coeff_count, [&](auto I) {
+                get<1>(I) = multiply_uint_mod_montgomery(get<0>(I), scalar.operand, modulus);
+            });
+        }
+
+        void dyadic_product_montgomery_coeffmod(
+            ConstCoeffIter operand1, ConstCoeffIter operand2, size_t coeff_count, const Modulus &modulus,
+            CoeffIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!operand1)
+            {
+                throw invalid_argument("operand1");
+            }
+            if (!operand2)
+            {
+                throw invalid_argument("operand2");
+            }
+            if (!result)
+            {
+                throw invalid_argument("result");
+            }
+            if (coeff_count == 0)
+            {
+                throw invalid_argument("coeff_count");
+            }
+            if (!(modulus.value() & 1))
+            {
+                throw invalid_argument("modulus");
+            }
+#endif
+            const uint64_t modulus_value = modulus.value();
+            const uint64_t montgomery_inv = modulus.montgomery_inv();
+
+            SEAL_ITERATE(iter(operand1, operand2, result), coeff_count, [&](auto I) {
+                // Three multiplications per coefficient instead of the six needed by Barrett reduction
+                unsigned long long z[2], tmp;
+                multiply_uint64(get<0>(I), get<1>(I), z);
+                multiply_uint64_hw64(z[0] * montgomery_inv, modulus_value, &tmp);
+                tmp += z[1] + static_cast<uint64_t>(z[0] != 0);
+                get<2>(I) = SEAL_COND_SELECT(tmp >= modulus_value, tmp - modulus_value, tmp);
+            });
+        }
+
         uint64_t poly_infty_norm_coeffmod(ConstCoeffIter operand, size_t coeff_count, const Modulus &modulus)
         {
 #ifdef SEAL_DEBUG
@@ -228,6 +228,13 @@ namespace seal
             });
         }
 
+        /**
+        The std::uint32_t counterpart of add_poly_coeffmod for moduli of at most small_modulus_bit_count_max bits.
+        */
+        void add_poly_coeffmod(
+            const std::uint32_t *operand1, const std::uint32_t *operand2, std::size_t coeff_count,
+            const Modulus &modulus, std::uint32_t *result);
+
         void sub_poly_coeffmod(
             ConstCoeffIter operand1, ConstCoeffIter operand2, std::size_t coeff_count, const Modulus &modulus,
             CoeffIter result);
@@ -297,6 +304,13 @@ namespace seal
             });
         }
 
+        /**
+        The std::uint32_t counterpart of sub_poly_coeffmod for moduli of at most small_modulus_bit_count_max bits.
+        */
+        void sub_poly_coeffmod(
+            const std::uint32_t *operand1, const std::uint32_t *operand2, std::size_t coeff_count,
+            const Modulus &modulus, std::uint32_t *result);
+
         /**
         @param[in] scalar Must be less than modulus.value().
         */
@@ -502,6 +516,10 @@ namespace seal
             });
         }
 
+        /**
+        @param[in] operand1 Coefficients must be less than 4 * modulus.value().
+        @param[in] operand2 Coefficients must be less than 4 * modulus.value().
+        */
         void dyadic_product_coeffmod(
             ConstCoeffIter operand1, ConstCoeffIter operand2, std::size_t coeff_count, const Modulus &modulus,
             CoeffIter result);
@@ -571,6 +589,263 @@ namespace seal
             });
         }
 
+        /**
+        The std::uint32_t counterpart of dyadic_product_coeffmod for moduli of at most small_modulus_bit_count_max
+        bits. Each product fits in 64 bits and is reduced with a single-word Barrett reduction.
+
+        @param[in] operand1 Coefficients must be less than 4 * modulus.value().
+        @param[in] operand2 Coefficients must be less than 4 * modulus.value().
+        */
+        void dyadic_product_coeffmod(
+            const std::uint32_t *operand1, const std::uint32_t *operand2, std::size_t coeff_count,
+            const Modulus &modulus, std::uint32_t *result);
+
+        /**
+        Converts every coefficient of poly, which must be less than 2^64, to Montgomery form x * 2^64 mod modulus.
+        The modulus must be odd.
+        */
+        void to_montgomery_coeffmod(
+            ConstCoeffIter poly, std::size_t coeff_count, const Modulus &modulus, CoeffIter result);
+
+        inline void to_montgomery_coeffmod(
+            ConstRNSIter poly, std::size_t coeff_modulus_size, ConstModulusIter modulus, RNSIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!poly && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("poly");
+            }
+            if (!result && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("result");
+            }
+            if (!modulus && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("modulus");
+            }
+            if (poly.poly_modulus_degree() != result.poly_modulus_degree())
+            {
+                throw std::invalid_argument("incompatible iterators");
+            }
+#endif
+            auto poly_modulus_degree = result.poly_modulus_degree();
+            SEAL_ITERATE(iter(poly, modulus, result), coeff_modulus_size, [&](auto I) {
+                to_montgomery_coeffmod(get<0>(I), poly_modulus_degree, get<1>(I), get<2>(I));
+            });
+        }
+
+        inline void to_montgomery_coeffmod(
+            ConstPolyIter poly_array, std::size_t size, ConstModulusIter modulus, PolyIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!poly_array && size > 0)
+            {
+                throw std::invalid_argument("poly_array");
+            }
+            if (!result && size > 0)
+            {
+                throw std::invalid_argument("result");
+            }
+            if (!modulus && size > 0)
+            {
+                throw std::invalid_argument("modulus");
+            }
+            if (poly_array.coeff_modulus_size() != result.coeff_modulus_size())
+            {
+                throw std::invalid_argument("incompatible iterators");
+            }
+#endif
+            auto coeff_modulus_size = result.coeff_modulus_size();
+            SEAL_ITERATE(iter(poly_array, result), size, [&](auto I) {
+                to_montgomery_coeffmod(get<0>(I), coeff_modulus_size, modulus, get<1>(I));
+            });
+        }
+
+        /**
+        Converts every coefficient of poly from Montgomery form, i.e., computes x * 2^(-64) mod modulus. The modulus
+        must be odd.
+        */
+        void from_montgomery_coeffmod(
+            ConstCoeffIter poly, std::size_t coeff_count, const Modulus &modulus, CoeffIter result);
+
+        inline void from_montgomery_coeffmod(
+            ConstRNSIter poly, std::size_t coeff_modulus_size, ConstModulusIter modulus, RNSIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!poly && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("poly");
+            }
+            if (!result && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("result");
+            }
+            if (!modulus && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("modulus");
+            }
+            if (poly.poly_modulus_degree() != result.poly_modulus_degree())
+            {
+                throw std::invalid_argument("incompatible iterators");
+            }
+#endif
+            auto poly_modulus_degree = result.poly_modulus_degree();
+            SEAL_ITERATE(iter(poly, modulus, result), coeff_modulus_size, [&](auto I) {
+                from_montgomery_coeffmod(get<0>(I), poly_modulus_degree, get<1>(I), get<2>(I));
+            });
+        }
+
+        inline void from_montgomery_coeffmod(
+            ConstPolyIter poly_array, std::size_t size, ConstModulusIter modulus, PolyIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!poly_array && size > 0)
+            {
+                throw std::invalid_argument("poly_array");
+            }
+            if (!result && size > 0)
+            {
+                throw std::invalid_argument("result");
+            }
+            if (!modulus && size > 0)
+            {
+                throw std::invalid_argument("modulus");
+            }
+            if (poly_array.coeff_modulus_size() != result.coeff_modulus_size())
+            {
+                throw std::invalid_argument("incompatible iterators");
+            }
+#endif
+            auto coeff_modulus_size = result.coeff_modulus_size();
+            SEAL_ITERATE(iter(poly_array, result), size, [&](auto I) {
+                from_montgomery_coeffmod(get<0>(I), coeff_modulus_size, modulus, get<1>(I));
+            });
+        }
+
+        /**
+        Multiplies every coefficient of poly by scalar with Montgomery reduction. If poly is in Montgomery form, so is
+        the result; otherwise the result is in normal form. The overloads taking a std::uint64_t scalar convert it to
+        Montgomery form first. Coefficients of poly may be lazy up to 4 * modulus, and
+        the result is fully reduced. The modulus must be odd.
+        */
+        void multiply_poly_scalar_montgomery_coeffmod(
+            ConstCoeffIter poly, std::size_t coeff_count, MontgomeryOperand scalar, const Modulus &modulus,
+            CoeffIter result);
+
+        inline void multiply_poly_scalar_montgomery_coeffmod(
+            ConstCoeffIter poly, std::size_t coeff_count, std::uint64_t scalar, const Modulus &modulus,
+            CoeffIter result)
+        {
+            // Scalar must be first reduced modulo modulus
+            MontgomeryOperand temp_scalar;
+            temp_scalar.set(barrett_reduce_64(scalar, modulus), modulus);
+            multiply_poly_scalar_montgomery_coeffmod(poly, coeff_count, temp_scalar, modulus, result);
+        }
+
+        inline void multiply_poly_scalar_montgomery_coeffmod(
+            ConstRNSIter poly, std::size_t coeff_modulus_size, std::uint64_t scalar, ConstModulusIter modulus,
+            RNSIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!poly && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("poly");
+            }
+            if (!result && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("result");
+            }
+            if (!modulus && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("modulus");
+            }
+            if (poly.poly_modulus_degree() != result.poly_modulus_degree())
+            {
+                throw std::invalid_argument("incompatible iterators");
+            }
+#endif
+            auto poly_modulus_degree = result.poly_modulus_degree();
+            SEAL_ITERATE(iter(poly, modulus, result), coeff_modulus_size, [&](auto I) {
+                multiply_poly_scalar_montgomery_coeffmod(get<0>(I), poly_modulus_degree, scalar, get<1>(I), get<2>(I));
+            });
+        }
+
+        /**
+        Computes the dyadic product of operand1 and operand2 with Montgomery reduction, i.e., each result coefficient
+        is x * y * 2^(-64) mod modulus. If both operands are in Montgomery form, so is the result; if exactly one is,
+        the result is in normal form. The result is fully reduced. The modulus must be odd, and every product of
+        coefficients must be less than modulus * 2^64; this holds if one operand is in [0, 4 * modulus) and the other
+        in [0, modulus), or if both are in [0, 2 * modulus).
+        */
+        void dyadic_product_montgomery_coeffmod(
+            ConstCoeffIter operand1, ConstCoeffIter operand2, std::size_t coeff_count, const Modulus &modulus,
+            CoeffIter result);
+
+        inline void dyadic_product_montgomery_coeffmod(
+            ConstRNSIter operand1, ConstRNSIter operand2, std::size_t coeff_modulus_size, ConstModulusIter modulus,
+            RNSIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!operand1 && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("operand1");
+            }
+            if (!operand2 && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("operand2");
+            }
+            if (!result && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("result");
+            }
+            if (!modulus && coeff_modulus_size > 0)
+            {
+                throw std::invalid_argument("modulus");
+            }
+            if (operand1.poly_modulus_degree() != result.poly_modulus_degree() ||
+                operand2.poly_modulus_degree() != result.poly_modulus_degree())
+            {
+                throw std::invalid_argument("incompatible iterators");
+            }
+#endif
+            auto poly_modulus_degree = result.poly_modulus_degree();
+            SEAL_ITERATE(iter(operand1, operand2, modulus, result), coeff_modulus_size, [&](auto I) {
+                dyadic_product_montgomery_coeffmod(get<0>(I), get<1>(I), poly_modulus_degree, get<2>(I), get<3>(I));
+            });
+        }
+
+        inline void dyadic_product_montgomery_coeffmod(
+            ConstPolyIter operand1, ConstPolyIter operand2, std::size_t size, ConstModulusIter modulus, PolyIter result)
+        {
+#ifdef SEAL_DEBUG
+            if (!operand1 && size > 0)
+            {
+                throw std::invalid_argument("operand1");
+            }
+            if (!operand2 && size > 0)
+            {
+                throw std::invalid_argument("operand2");
+            }
+            if (!result && size > 0)
+            {
+                throw std::invalid_argument("result");
+            }
+            if (!modulus && size > 0)
+            {
+                throw std::invalid_argument("modulus");
+            }
+            if (operand1.coeff_modulus_size() != result.coeff_modulus_size() ||
+                operand2.coeff_modulus_size() != result.coeff_modulus_size())
+            {
+                throw std::invalid_argument("incompatible iterators");
+            }
+#endif
+            auto coeff_modulus_size = result.coeff_modulus_size();
+            SEAL_ITERATE(iter(operand1, operand2, result), size, [&](auto I) {
+                dyadic_product_montgomery_coeffmod(get<0>(I), get<1>(I), coeff_modulus_size, modulus, get<2>(I));
+            });
+        }
+
         std::uint64_t poly_infty_norm_coeffmod(ConstCoeffIter operand, std::size_t coeff_count, const Modulus &modulus);
 
         void negacyclic_shift_poly_coeffmod(
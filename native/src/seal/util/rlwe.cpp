@@ -18,23 +18,52 @@ namespace seal
 {
     namespace util
     {
+        namespace
+        {
+            // Writes small signed values to every RNS component of destination. Each component is written in one
+            // contiguous pass, which the compiler can vectorize.
+            void set_poly_signed(
+                const int64_t *values, size_t coeff_count, const vector<Modulus> &coeff_modulus, uint64_t *destination)
+            {
+                for (const auto &modulus : coeff_modulus)
+                {
+                    uint64_t modulus_value = modulus.value();
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        int64_t value = values[i];
+                        uint64_t flag = static_cast<uint64_t>(-static_cast<int64_t>(value < 0));
+                        destination[i] = static_cast<uint64_t>(value) + (flag & modulus_value);
+                    }
+                    destination += coeff_count;
+                }
+            }
+        } // namespace
+
         void sample_poly_ternary(
             shared_ptr<UniformRandomGenerator> prng, const EncryptionParameters &parms, uint64_t *destination)
         {
             auto coeff_modulus = parms.coeff_modulus();
-            size_t coeff_modulus_size = coeff_modulus.size();
             size_t coeff_count = parms.poly_modulus_degree();
 
-            RandomToStandardAdapter engine(prng);
-            uniform_int_distribution<uint64_t> dist(0, 2);
-
-            SEAL_ITERATE(iter(destination), coeff_count, [&](auto &I) {
-                uint64_t rand = dist(engine);
-                uint64_t flag = static_cast<uint64_t>(-static_cast<int64_t>(rand == 0));
-                SEAL_ITERATE(
-                    iter(StrideIter<uint64_t *>(&I, coeff_count), coeff_modulus), coeff_modulus_size,
-                    [&](auto J) { *get<0>(J) = rand + (flag & get<1>(J).value()) - 1; });
-            });
+            // The sampled values are secret, so we use a fresh memory pool with `clear_on_destruction' enabled
+            MemoryPoolHandle pool = MemoryManager::GetPool(mm_prof_opt::mm_force_new, true);
+            auto values(allocate<int64_t>(coeff_count, pool));
+
+            // Draw one byte per coefficient in a single block; bytes below 255 are uniform modulo 3, and the rare
+            // byte 255 is replaced by a fresh one
+            auto rand(allocate<uint8_t>(coeff_count, pool));
+            prng->generate(coeff_count, reinterpret_cast<seal_byte *>(rand.get()));
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                uint8_t byte = rand[i];
+                while (byte == 0xFF)
+                {
+                    prng->generate(1, reinterpret_cast<seal_byte *>(&byte));
+                }
+                values[i] = static_cast<int64_t>(byte % 3) - 1;
+            }
+
+            set_poly_signed(values.get(), coeff_count, coeff_modulus, destination);
         }
 
         void sample_poly_normal(
@@ -54,13 +83,15 @@ namespace seal
             ClippedNormalDistribution dist(
                 0, global_variables::noise_standard_deviation, global_variables::noise_max_deviation);
 
-            SEAL_ITERATE(iter(destination), coeff_count, [&](auto &I) {
-                int64_t noise = static_cast<int64_t>(dist(engine));
-                uint64_t flag = static_cast<uint64_t>(-static_cast<int64_t>(noise < 0));
-                SEAL_ITERATE(
-                    iter(StrideIter<uint64_t *>(&I, coeff_count), coeff_modulus), coeff_modulus_size,
-                    [&](auto J) { *get<0>(J) = static_cast<uint64_t>(noise) + (flag & get<1>(J).value()); });
-            });
+            // The sampled values are secret, so we use a fresh memory pool with `clear_on_destruction' enabled
+            MemoryPoolHandle pool = MemoryManager::GetPool(mm_prof_opt::mm_force_new, true);
+            auto values(allocate<int64_t>(coeff_count, pool));
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                values[i] = static_cast<int64_t>(dist(engine));
+            }
+
+            set_poly_signed(values.get(), coeff_count, coeff_modulus, destination);
         }
 
         void sample_poly_cbd(
@@ -82,22 +113,29 @@ namespace seal
                                   "Gaussian instead");
             }
 
-            auto cbd = [&]() {
-                unsigned char x[6];
-                prng->generate(6, reinterpret_cast<seal_byte *>(x));
-                x[2] &= 0x1F;
-                x[5] &= 0x1F;
-                return hamming_weight(x[0]) + hamming_weight(x[1]) + hamming_weight(x[2]) - hamming_weight(x[3]) -
-                       hamming_weight(x[4]) - hamming_weight(x[5]);
-            };
-
-            SEAL_ITERATE(iter(destination), coeff_count, [&](auto &I) {
-                int32_t noise = cbd();
-                uint64_t flag = static_cast<uint64_t>(-static_cast<int64_t>(noise < 0));
-                SEAL_ITERATE(
-                    iter(StrideIter<uint64_t *>(&I, coeff_count), coeff_modulus), coeff_modulus_size,
-                    [&](auto J) { *get<0>(J) = static_cast<uint64_t>(noise) + (flag & get<1>(J).value()); });
-            });
+            // The sampled values are secret, so we use a fresh memory pool with `clear_on_destruction' enabled
+            MemoryPoolHandle pool = MemoryManager::GetPool(mm_prof_opt::mm_force_new, true);
+            auto values(allocate<int64_t>(coeff_count, pool));
+
+            // Draw six bytes per coefficient in a single block. The difference of the Hamming weights of the low 21
+            // bits of the first three bytes and of the last three bytes has standard deviation sqrt(42/4) = 3.24.
+            constexpr size_t cbd_byte_count = 6;
+            constexpr uint64_t cbd_mask = 0x1FFFFF;
+            auto rand(allocate<uint8_t>(mul_safe(coeff_count, cbd_byte_count), pool));
+            prng->generate(coeff_count * cbd_byte_count, reinterpret_cast<seal_byte *>(rand.get()));
+            const uint8_t *rand_ptr = rand.get();
+            for (size_t i = 0; i < coeff_count; i++, rand_ptr += cbd_byte_count)
+            {
+                uint64_t x = 0;
+                for (size_t j = 0; j < cbd_byte_count; j++)
+                {
+                    x |= static_cast<uint64_t>(rand_ptr[j]) << (j * bits_per_byte);
+                }
+                values[i] = static_cast<int64_t>(hamming_weight(x & cbd_mask)) -
+                            static_cast<int64_t>(hamming_weight((x >> 24) & cbd_mask));
+            }
+
+            set_poly_signed(values.get(), coeff_count, coeff_modulus, destination);
         }
 
         void sample_poly_uniform(
@@ -190,6 +228,15 @@ namespace seal
             const PublicKey &public_key, const SEALContext &context, parms_id_type parms_id, bool is_ntt_form,
             Ciphertext &destination)
         {
+            // Create a PRNG; u and the noise/error share the same PRNG
+            auto prng = context.get_context_data(parms_id)->parms().random_generator()->create();
+            encrypt_zero_asymmetric_many(public_key, context, parms_id, is_ntt_form, prng, &destination, 1);
+        }
+
+        void encrypt_zero_asymmetric_many(
+            const PublicKey &public_key, const SEALContext &context, parms_id_type parms_id, bool is_ntt_form,
+            shared_ptr<UniformRandomGenerator> prng, Ciphertext *destinations, size_t count)
+        {
 #ifdef SEAL_DEBUG
             if (!is_valid_for(public_key, context))
             {
@@ -204,57 +251,70 @@ namespace seal
             auto &coeff_modulus = parms.coeff_modulus();
             size_t coeff_modulus_size = coeff_modulus.size();
             size_t coeff_count = parms.poly_modulus_degree();
+            size_t poly_uint64_count = mul_safe(coeff_count, coeff_modulus_size);
             auto ntt_tables = context_data.small_ntt_tables();
             size_t encrypted_size = public_key.data().size();
 
-            // Make destination have right size and parms_id
+            // Make destinations have right size and parms_id
             // Ciphertext (c_0,c_1, ...)
-            destination.resize(context, parms_id, encrypted_size);
-            destination.is_ntt_form() = is_ntt_form;
-            destination.scale() = 1.0;
+            for (size_t k = 0; k < count; k++)
+            {
+                destinations[k].resize(context, parms_id, encrypted_size);
+                destinations[k].is_ntt_form() = is_ntt_form;
+                destinations[k].scale() = 1.0;
+            }
 
             // c[j] = public_key[j] * u + e[j] where e[j] <-- chi, u <-- R_3
 
-            // Create a PRNG; u and the noise/error share the same PRNG
-            auto prng = parms.random_generator()->create();
-
-            // Generate u <-- R_3
-            auto u(allocate_poly(coeff_count, coeff_modulus_size, pool));
-            sample_poly_ternary(prng, parms, u.get());
+            // Generate u <-- R_3 for every ciphertext
+            auto u(allocate_poly_array(count, coeff_count, coeff_modulus_size, pool));
+            for (size_t k = 0; k < count; k++)
+            {
+                sample_poly_ternary(prng, parms, u.get() + k * poly_uint64_count);
+            }
 
-            // c[j] = u * public_key[j]
+            // c[j] = u * public_key[j]; all ciphertexts are processed for one RNS component before the next
             for (size_t i = 0; i < coeff_modulus_size; i++)
             {
-                ntt_negacyclic_harvey(u.get() + i * coeff_count, ntt_tables[i]);
-                for (size_t j = 0; j < encrypted_size; j++)
+                for (size_t k = 0; k < count; k++)
                 {
-                    dyadic_product_coeffmod(
-                        u.get() + i * coeff_count, public_key.data().data(j) + i * coeff_count, coeff_count,
-                        coeff_modulus[i], destination.data(j) + i * coeff_count);
-
-                    // Addition with e_0, e_1 is in non-NTT form
-                    if (!is_ntt_form)
+                    uint64_t *u_i = u.get() + k * poly_uint64_count + i * coeff_count;
+                    ntt_negacyclic_harvey(u_i, ntt_tables[i]);
+                    for (size_t j = 0; j < encrypted_size; j++)
                     {
-                        inverse_ntt_negacyclic_harvey(destination.data(j) + i * coeff_count, ntt_tables[i]);
+                        uint64_t *destination_i = destinations[k].data(j) + i * coeff_count;
+                        dyadic_product_coeffmod(
+                            u_i, public_key.data().data(j) + i * coeff_count, coeff_count, coeff_modulus[i],
+                            destination_i);
+
+                        // Addition with e_0, e_1 is in non-NTT form
+                        if (!is_ntt_form)
+                        {
+                            inverse_ntt_negacyclic_harvey(destination_i, ntt_tables[i]);
+                        }
                     }
                 }
             }
 
-            // Generate e_j <-- chi
+            // Generate e_j <-- chi into the space of the first u
             // c[j] = public_key[j] * u + e[j]
-            for (size_t j = 0; j < encrypted_size; j++)
+            uint64_t *noise = u.get();
+            for (size_t k = 0; k < count; k++)
             {
-                SEAL_NOISE_SAMPLER(prng, parms, u.get());
-                for (size_t i = 0; i < coeff_modulus_size; i++)
+                for (size_t j = 0; j < encrypted_size; j++)
                 {
-                    // Addition with e_0, e_1 is in NTT form
-                    if (is_ntt_form)
+                    SEAL_NOISE_SAMPLER(prng, parms, noise);
+                    for (size_t i = 0; i < coeff_modulus_size; i++)
                     {
-                        ntt_negacyclic_harvey(u.get() + i * coeff_count, ntt_tables[i]);
+                        // Addition with e_0, e_1 is in NTT form
+                        if (is_ntt_form)
+                        {
+                            ntt_negacyclic_harvey(noise + i * coeff_count, ntt_tables[i]);
+                        }
+                        add_poly_coeffmod(
+                            noise + i * coeff_count, destinations[k].data(j) + i * coeff_count, coeff_count,
+                            coeff_modulus[i], destinations[k].data(j) + i * coeff_count);
                     }
-                    add_poly_coeffmod(
-                        u.get() + i * coeff_count, destination.data(j) + i * coeff_count, coeff_count, coeff_modulus[i],
-                        destination.data(j) + i * coeff_count);
                 }
             }
         }
@@ -263,6 +323,16 @@ namespace seal
             const SecretKey &secret_key, const SEALContext &context, parms_id_type parms_id, bool is_ntt_form,
             bool save_seed, Ciphertext &destination)
         {
+            auto &parms = context.get_context_data(parms_id)->parms();
+            encrypt_zero_symmetric(
+                secret_key, context, parms_id, is_ntt_form, save_seed, parms.random_generator()->create(),
+                destination);
+        }
+
+        void encrypt_zero_symmetric(
+            const SecretKey &secret_key, const SEALContext &context, parms_id_type parms_id, bool is_ntt_form,
+            bool save_seed, shared_ptr<UniformRandomGenerator> prng, Ciphertext &destination)
+        {
 #ifdef SEAL_DEBUG
             if (!is_valid_for(secret_key, context))
             {
@@ -298,17 +368,23 @@ namespace seal
             destination.is_ntt_form() = is_ntt_form;
             destination.scale() = 1.0;
 
-            // Create an instance of a random number generator. We use this for sampling
-            // a seed for a second PRNG used for sampling u (the seed can be public
-            // information. This PRNG is also used for sampling the noise/error below.
-            auto bootstrap_prng = parms.random_generator()->create();
+            // The given PRNG is used for sampling a seed for a second PRNG used for
+            // sampling u (the seed can be public information). This PRNG is also used
+            // for sampling the noise/error below.
+            auto bootstrap_prng = move(prng);
 
             // Sample a public seed for generating uniform randomness
             prng_seed_type public_prng_seed;
             bootstrap_prng->generate(prng_seed_byte_count, reinterpret_cast<seal_byte *>(public_prng_seed.data()));
 
-            // Set up a new default PRNG for expanding u from the seed sampled above
-            auto ciphertext_prng = UniformRandomGeneratorFactory::DefaultFactory()->create(public_prng_seed);
+            // Set up a new PRNG for expanding u from the seed sampled above. It is of the same type as the bootstrap
+            // PRNG, so that e.g. Aes256CtrPRNG is used throughout, unless that type cannot be recreated from a seed.
+            auto ciphertext_prng =
+                UniformRandomGeneratorInfo(bootstrap_prng->info().type(), public_prng_seed).make_prng();
+            if (!ciphertext_prng)
+            {
+                ciphertext_prng = UniformRandomGeneratorFactory::DefaultFactory()->create(public_prng_seed);
+            }
 
             // Generate ciphertext: (c[0], c[1]) = ([-(as+e)]_q, a)
             uint64_t *c0 = destination.data();
@@ -96,6 +96,23 @@ namespace seal
             const PublicKey &public_key, const SEALContext &context, parms_id_type parms_id, bool is_ntt_form,
             Ciphertext &destination);
 
+        /**
+        Create encryptions of zero with a public key and store them in count ciphertexts. All randomness is drawn
+        from the given PRNG, which is consumed in the same order as by encrypt_zero_asymmetric for count equal to
+        one. The transforms of all ciphertexts are done one RNS component at a time.
+
+        @param[in] public_key The public key used for encryption
+        @param[in] context The SEALContext containing a chain of ContextData
+        @param[in] parms_id Indicates the level of encryption
+        @param[in] is_ntt_form If true, store ciphertexts in NTT form
+        @param[in] prng The uniform random generator for all ciphertexts
+        @param[out] destinations The count output ciphertexts - encryptions of zero
+        @param[in] count The number of ciphertexts
+        */
+        void encrypt_zero_asymmetric_many(
+            const PublicKey &public_key, const SEALContext &context, parms_id_type parms_id, bool is_ntt_form,
+            std::shared_ptr<UniformRandomGenerator> prng, Ciphertext *destinations, std::size_t count);
+
         /**
         Create an encryption of zero with a secret key and store in a ciphertext.
 
@@ -110,5 +127,22 @@ namespace seal
         void encrypt_zero_symmetric(
             const SecretKey &secret_key, const SEALContext &context, parms_id_type parms_id, bool is_ntt_form,
             bool save_seed, Ciphertext &destination);
+
+        /**
+        Create an encryption of zero with a secret key and store in a ciphertext. All randomness is drawn from the
+        given PRNG, so that independent encryptions can be made deterministic by seeding their PRNGs.
+
+        @param[out] destination The output ciphertext - an encryption of zero
+        @param[in] secret_key The secret key used for encryption
+        @param[in] context The SEALContext containing a chain of ContextData
+        @param[in] parms_id Indicates the level of encryption
+        @param[in] is_ntt_form If true, store ciphertext in NTT form
+        @param[in] save_seed If true, the second component of ciphertext is
+        replaced with the random seed used to sample this component
+        @param[in] prng The uniform random generator for the ciphertext
+        */
+        void encrypt_zero_symmetric(
+            const SecretKey &secret_key, const SEALContext &context, parms_id_type parms_id, bool is_ntt_form,
+            bool save_seed, std::shared_ptr<UniformRandomGenerator> prng, Ciphertext &destination);
     } // namespace util
 } // namespace seal
@@ -1106,5 +1106,154 @@ namespace seal
                 }
             });
         }
+
+        KSwitchTool::KSwitchTool(
+            const vector<Modulus> &q, const vector<Modulus> &p, size_t digit_size, MemoryPoolHandle pool)
+            : pool_(move(pool)), digit_size_(digit_size)
+        {
+            if (!pool_)
+            {
+                throw invalid_argument("pool is uninitialized");
+            }
+            if (q.empty() || p.empty() || !digit_size_)
+            {
+                throw invalid_argument("invalid parameters");
+            }
+
+            size_t base_q_size = q.size();
+            size_t base_p_size = p.size();
+            digit_count_ = (base_q_size + digit_size_ - 1) / digit_size_;
+
+            // Populate the base arrays; q U p must be coprime
+            base_q_ = allocate<RNSBase>(pool_, q, pool_);
+            base_p_ = allocate<RNSBase>(pool_, p, pool_);
+            RNSBase base_qp(base_q_->extend(*base_p_));
+
+            // Set up BaseConverters for each digit --> (q U p) without the digit
+            digit_convs_.resize(digit_count_);
+            for (size_t digit_index = 0; digit_index < digit_count_; digit_index++)
+            {
+                size_t digit_begin = digit_index * digit_size_;
+                size_t digit_end = min(digit_begin + digit_size_, base_q_size);
+                if (digit_end - digit_begin == 1)
+                {
+                    continue;
+                }
+
+                vector<Modulus> digit_primes(
+                    q.cbegin() + static_cast<ptrdiff_t>(digit_begin), q.cbegin() + static_cast<ptrdiff_t>(digit_end));
+                vector<Modulus> rest_primes(q.cbegin(), q.cbegin() + static_cast<ptrdiff_t>(digit_begin));
+                copy(q.cbegin() + static_cast<ptrdiff_t>(digit_end), q.cend(), back_inserter(rest_primes));
+                copy(p.cbegin(), p.cend(), back_inserter(rest_primes));
+                digit_convs_[digit_index] = allocate<BaseConverter>(
+                    pool_, RNSBase(digit_primes, pool_), RNSBase(rest_primes, pool_), pool_);
+            }
+
+            // Set up BaseConverter for p --> q
+            if (base_p_size > 1)
+            {
+                base_p_to_q_conv_ = allocate<BaseConverter>(pool_, *base_p_, *base_q_, pool_);
+            }
+
+            // Compute prod(p)^(-1) mod q
+            uint64_t temp;
+            inv_p_mod_q_ = allocate<MultiplyUIntModOperand>(base_q_size, pool_);
+            SEAL_ITERATE(iter(inv_p_mod_q_, base_q_->base()), base_q_size, [&](auto I) {
+                if (!try_invert_uint_mod(modulo_uint(base_p_->base_prod(), base_p_size, get<1>(I)), get<1>(I), temp))
+                {
+                    throw logic_error("invalid rns bases");
+                }
+                get<0>(I).set(temp, get<1>(I));
+            });
+
+            // Compute floor(prod(p) / 2) mod q and mod p
+            auto half_p(allocate_uint(base_p_size, pool_));
+            right_shift_uint(base_p_->base_prod(), 1, base_p_size, half_p.get());
+            half_p_mod_q_ = allocate_uint(base_q_size, pool_);
+            SEAL_ITERATE(iter(half_p_mod_q_, base_q_->base()), base_q_size, [&](auto I) {
+                get<0>(I) = modulo_uint(half_p.get(), base_p_size, get<1>(I));
+            });
+            half_p_mod_p_ = allocate_uint(base_p_size, pool_);
+            SEAL_ITERATE(iter(half_p_mod_p_, base_p_->base()), base_p_size, [&](auto I) {
+                get<0>(I) = modulo_uint(half_p.get(), base_p_size, get<1>(I));
+            });
+        }
+
+        void KSwitchTool::extend_digit(
+            size_t digit_index, ConstRNSIter input, RNSIter destination, MemoryPoolHandle pool) const
+        {
+#ifdef SEAL_DEBUG
+            if (digit_index >= digit_count_)
+            {
+                throw out_of_range("digit_index");
+            }
+            if (input.poly_modulus_degree() != destination.poly_modulus_degree())
+            {
+                throw invalid_argument("input and destination are incompatible");
+            }
+#endif
+            size_t base_q_size = base_q_->size();
+            size_t base_qp_size = base_q_size + base_p_->size();
+            size_t coeff_count = input.poly_modulus_degree();
+            size_t digit_begin = digit_index * digit_size_;
+            size_t digit_end = min(digit_begin + digit_size_, base_q_size);
+            auto modulus_at = [&](size_t index) -> const Modulus & {
+                return index < base_q_size ? (*base_q_)[index] : (*base_p_)[index - base_q_size];
+            };
+
+            // The digit itself needs no conversion
+            set_poly(input + digit_begin, coeff_count, digit_end - digit_begin, destination + digit_begin);
+
+            if (!digit_convs_[digit_index])
+            {
+                // A single prime digit is extended by modular reduction
+                const Modulus &digit_modulus = (*base_q_)[digit_begin];
+                for (size_t i = 0; i < base_qp_size; i++)
+                {
+                    if (i == digit_begin)
+                    {
+                        continue;
+                    }
+                    if (digit_modulus.value() <= modulus_at(i).value())
+                    {
+                        set_uint(input[digit_begin], coeff_count, destination[i]);
+                    }
+                    else
+                    {
+                        modulo_poly_coeffs(input[digit_begin], coeff_count, modulus_at(i), destination[i]);
+                    }
+                }
+                return;
+            }
+
+            // The primes outside the digit are stored contiguously in temp
+            SEAL_ALLOCATE_GET_RNS_ITER(temp, coeff_count, base_qp_size - (digit_end - digit_begin), pool);
+            digit_convs_[digit_index]->fast_convert_array(input + digit_begin, temp, pool);
+            set_poly(temp, coeff_count, digit_begin, destination);
+            set_poly(temp + digit_begin, coeff_count, base_qp_size - digit_end, destination + digit_end);
+        }
+
+        void KSwitchTool::convert_p_to_q(ConstRNSIter input, RNSIter destination, MemoryPoolHandle pool) const
+        {
+            if (base_p_to_q_conv_)
+            {
+                base_p_to_q_conv_->fast_convert_array(input, destination, pool);
+                return;
+            }
+
+            // A single special prime is converted by modular reduction
+            size_t coeff_count = input.poly_modulus_degree();
+            const Modulus &p = (*base_p_)[0];
+            SEAL_ITERATE(iter(destination, base_q_->base()), base_q_->size(), [&](auto I) {
+                if (p.value() <= get<1>(I).value())
+                {
+                    set_uint(*input, coeff_count, get<0>(I));
+                }
+                else
+                {
+                    modulo_poly_coeffs(*input, coeff_count, get<1>(I), get<0>(I));
+                }
+            });
+        }
     } // namespace util
 } // namespace seal
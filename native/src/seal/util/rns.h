@@ -368,5 +368,112 @@ namespace seal
 
             Modulus gamma_;
         };
+
+        /**
+        Pre-computations for hybrid key switching at one level of the modulus switching chain. The primes of the
+        ciphertext modulus q are grouped into digits of digit_size consecutive primes (the last digit may be smaller),
+        and the special modulus p, which only appears in the key level, may consist of several primes.
+        */
+        class KSwitchTool
+        {
+        public:
+            /**
+            @throws std::invalid_argument if q or p is empty, digit_size is zero, or pool is uninitialized.
+            @throws std::logic_error if q and p are not coprime.
+            */
+            KSwitchTool(
+                const std::vector<Modulus> &q, const std::vector<Modulus> &p, std::size_t digit_size,
+                MemoryPoolHandle pool);
+
+            /**
+            Extends the digit with the given index of input, i.e., the components of input modulo the primes of that
+            digit, to the basis q U p by fast base conversion. The result may differ from the exact extension by a
+            small multiple of the product of the primes of the digit, which key switching tolerates.
+
+            @param[in] digit_index The index of the digit; must be less than digit_count()
+            @param[in] input Polynomial modulo q in RNS form and coefficient representation
+            @param[out] destination Polynomial modulo q U p in RNS form and coefficient representation
+            */
+            void extend_digit(
+                std::size_t digit_index, ConstRNSIter input, RNSIter destination, MemoryPoolHandle pool) const;
+
+            /**
+            Fast base conversion from p to q. The result may differ from the exact one by a small multiple of the
+            product of p.
+
+            @param[in] input Polynomial modulo p in RNS form and coefficient representation
+            @param[out] destination Polynomial modulo q in RNS form and coefficient representation
+            */
+            void convert_p_to_q(ConstRNSIter input, RNSIter destination, MemoryPoolHandle pool) const;
+
+            SEAL_NODISCARD inline std::size_t digit_size() const noexcept
+            {
+                return digit_size_;
+            }
+
+            SEAL_NODISCARD inline std::size_t digit_count() const noexcept
+            {
+                return digit_count_;
+            }
+
+            SEAL_NODISCARD inline auto base_q() const noexcept
+            {
+                return base_q_.get();
+            }
+
+            SEAL_NODISCARD inline auto base_p() const noexcept
+            {
+                return base_p_.get();
+            }
+
+            SEAL_NODISCARD inline auto inv_p_mod_q() const noexcept
+            {
+                return inv_p_mod_q_.get();
+            }
+
+            SEAL_NODISCARD inline auto half_p_mod_q() const noexcept
+            {
+                return half_p_mod_q_.get();
+            }
+
+            SEAL_NODISCARD inline auto half_p_mod_p() const noexcept
+            {
+                return half_p_mod_p_.get();
+            }
+
+        private:
+            KSwitchTool(const KSwitchTool &copy) = delete;
+
+            KSwitchTool(KSwitchTool &&source) = delete;
+
+            KSwitchTool &operator=(const KSwitchTool &assign) = delete;
+
+            KSwitchTool &operator=(KSwitchTool &&assign) = delete;
+
+            MemoryPoolHandle pool_;
+
+            std::size_t digit_size_ = 0;
+
+            std::size_t digit_count_ = 0;
+
+            Pointer<RNSBase> base_q_;
+
+            Pointer<RNSBase> base_p_;
+
+            // Base converters: digit --> (q U p) without the digit; null for digits of a single prime
+            std::vector<Pointer<BaseConverter>> digit_convs_;
+
+            // Base converter: p --> q; null if p is a single prime
+            Pointer<BaseConverter> base_p_to_q_conv_;
+
+            // prod(p)^(-1) mod q
+            Pointer<MultiplyUIntModOperand> inv_p_mod_q_;
+
+            // floor(prod(p) / 2) mod q
+            Pointer<std::uint64_t> half_p_mod_q_;
+
+            // floor(prod(p) / 2) mod p
+            Pointer<std::uint64_t> half_p_mod_p_;
+        };
     } // namespace util
 } // namespace seal
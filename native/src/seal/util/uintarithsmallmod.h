@@ -15,6 +15,13 @@ namespace seal
 {
     namespace util
     {
+        /**
+        Moduli with at most this many bits keep lazy values, which are less than 4 * modulus, within 32 bits. Products
+        of two such values then fit in 64 bits, which enables the 32-bit fast paths of the NTT and of the dyadic
+        product.
+        */
+        constexpr int small_modulus_bit_count_max = 30;
+
         /**
         Returns (operand++) mod modulus.
         Correctness: operand must be at most (2 * modulus -2) for correctness.
@@ -325,6 +332,178 @@ namespace seal
             return y.operand * x - tmp1 * p;
         }
 
+        /**
+        The 32-bit counterpart of MultiplyUIntModOperand for moduli of at most small_modulus_bit_count_max bits. The
+        quotient is floor(operand * 2^32 / modulus).
+        */
+        struct MultiplyUIntModOperand32
+        {
+            std::uint32_t operand;
+            std::uint32_t quotient;
+
+            void set_quotient(const Modulus &modulus)
+            {
+#ifdef SEAL_DEBUG
+                if (modulus.bit_count() > small_modulus_bit_count_max)
+                {
+                    throw std::invalid_argument("modulus is too large");
+                }
+                if (operand >= modulus.value())
+                {
+                    throw std::invalid_argument("input must be less than modulus");
+                }
+#endif
+                quotient = static_cast<std::uint32_t>((static_cast<std::uint64_t>(operand) << 32) / modulus.value());
+            }
+
+            void set(std::uint32_t new_operand, const Modulus &modulus)
+            {
+#ifdef SEAL_DEBUG
+                if (new_operand >= modulus.value())
+                {
+                    throw std::invalid_argument("input must be less than modulus");
+                }
+#endif
+                operand = new_operand;
+                set_quotient(modulus);
+            }
+        };
+
+        /**
+        Returns x * y mod modulus or x * y mod modulus + modulus.
+        Lazy variant of multiply_uint_mod with base 2^32 instead of 2^64.
+        Correctness: modulus should be at most small_modulus_bit_count_max bits, and y must be less than modulus.
+        */
+        SEAL_NODISCARD inline std::uint32_t multiply_uint_mod_lazy(
+            std::uint32_t x, MultiplyUIntModOperand32 y, const Modulus &modulus)
+        {
+#ifdef SEAL_DEBUG
+            if (y.operand >= modulus.value())
+            {
+                throw std::invalid_argument("operand y must be less than modulus");
+            }
+#endif
+            const std::uint32_t p = static_cast<std::uint32_t>(modulus.value());
+            std::uint32_t tmp = static_cast<std::uint32_t>((static_cast<std::uint64_t>(x) * y.quotient) >> 32);
+            return y.operand * x - tmp * p;
+        }
+
+        /**
+        Returns x * y mod modulus.
+        Variant of multiply_uint_mod with base 2^32 instead of 2^64.
+        Correctness: modulus should be at most small_modulus_bit_count_max bits, and y must be less than modulus.
+        */
+        SEAL_NODISCARD inline std::uint32_t multiply_uint_mod(
+            std::uint32_t x, MultiplyUIntModOperand32 y, const Modulus &modulus)
+        {
+            const std::uint32_t p = static_cast<std::uint32_t>(modulus.value());
+            std::uint32_t tmp = multiply_uint_mod_lazy(x, y, modulus);
+            return SEAL_COND_SELECT(tmp >= p, tmp - p, tmp);
+        }
+
+        /**
+        Returns input * 2^(-64) mod modulus or input * 2^(-64) mod modulus + modulus using Montgomery reduction, i.e.,
+        the result is in [0, 2 * modulus - 1].
+        Correctness: modulus must be odd and at most 63-bit, and input must be less than modulus * 2^64.
+        @param[in] input Should be at most 128-bit.
+        */
+        template <typename T, typename = std::enable_if_t<is_uint64_v<T>>>
+        SEAL_NODISCARD inline std::uint64_t montgomery_reduce_lazy(const T *input, const Modulus &modulus)
+        {
+#ifdef SEAL_DEBUG
+            if (!input)
+            {
+                throw std::invalid_argument("input");
+            }
+            if (!(modulus.value() & 1))
+            {
+                throw std::invalid_argument("modulus");
+            }
+#endif
+            // m is chosen so that input + m * modulus is divisible by 2^64; the low word of the sum is zero and
+            // produces a carry exactly when input[0] is non-zero.
+            unsigned long long m = static_cast<unsigned long long>(input[0]) * modulus.montgomery_inv();
+            unsigned long long tmp;
+            multiply_uint64_hw64(m, modulus.value(), &tmp);
+            return static_cast<std::uint64_t>(input[1]) + tmp + static_cast<std::uint64_t>(input[0] != 0);
+        }
+
+        /**
+        Returns input * 2^(-64) mod modulus using Montgomery reduction.
+        Correctness: Follows the condition of montgomery_reduce_lazy.
+        */
+        template <typename T, typename = std::enable_if_t<is_uint64_v<T>>>
+        SEAL_NODISCARD inline std::uint64_t montgomery_reduce(const T *input, const Modulus &modulus)
+        {
+            std::uint64_t result = montgomery_reduce_lazy(input, modulus);
+            return SEAL_COND_SELECT(result >= modulus.value(), result - modulus.value(), result);
+        }
+
+        /**
+        Returns x * y * 2^(-64) mod modulus or x * y * 2^(-64) mod modulus + modulus. If y is in Montgomery form, i.e.,
+        y = y' * 2^64 mod modulus, this is x * y' mod modulus up to one multiple of modulus.
+        Correctness: Follows the condition of montgomery_reduce_lazy for the product x * y.
+        */
+        SEAL_NODISCARD inline std::uint64_t multiply_uint_mod_montgomery_lazy(
+            std::uint64_t x, std::uint64_t y, const Modulus &modulus)
+        {
+            unsigned long long z[2];
+            multiply_uint64(x, y, z);
+            return montgomery_reduce_lazy(z, modulus);
+        }
+
+        /**
+        Returns x * y * 2^(-64) mod modulus.
+        Correctness: Follows the condition of montgomery_reduce_lazy for the product x * y.
+        */
+        SEAL_NODISCARD inline std::uint64_t multiply_uint_mod_montgomery(
+            std::uint64_t x, std::uint64_t y, const Modulus &modulus)
+        {
+            unsigned long long z[2];
+            multiply_uint64(x, y, z);
+            return montgomery_reduce(z, modulus);
+        }
+
+        /**
+        Returns the Montgomery form operand * 2^64 mod modulus.
+        Correctness: modulus must be odd and at most 63-bit.
+        */
+        SEAL_NODISCARD inline std::uint64_t to_montgomery(std::uint64_t operand, const Modulus &modulus)
+        {
+            // const_ratio()[2] holds 2^128 mod modulus
+            return multiply_uint_mod_montgomery(operand, modulus.const_ratio()[2], modulus);
+        }
+
+        /**
+        Returns operand * 2^(-64) mod modulus, i.e., converts operand from Montgomery form.
+        Correctness: modulus must be odd and at most 63-bit.
+        */
+        SEAL_NODISCARD inline std::uint64_t from_montgomery(std::uint64_t operand, const Modulus &modulus)
+        {
+            std::uint64_t input[2]{ operand, 0 };
+            return montgomery_reduce(input, modulus);
+        }
+
+        /**
+        This struct contains an operand in Montgomery form, operand * 2^64 mod modulus, for a specific modulus. It is
+        the Montgomery counterpart of MultiplyUIntModOperand.
+        */
+        struct MontgomeryOperand
+        {
+            std::uint64_t operand;
+
+            void set(std::uint64_t new_operand, const Modulus &modulus)
+            {
+#ifdef SEAL_DEBUG
+                if (new_operand >= modulus.value())
+                {
+                    throw std::invalid_argument("input must be less than modulus");
+                }
+#endif
+                operand = to_montgomery(new_operand, modulus);
+            }
+        };
+
         /**
         Returns value[0] = value mod modulus.
         Correctness: Follows the condition of barrett_reduce_128.
@@ -402,7 +402,6 @@ namespace seal
                 }
 
                 // Populate the header
-                header.compr_mode = compr_mode_type::zlib;
                 header.size = static_cast<uint64_t>(add_safe(sizeof(Serialization::SEALHeader), in.size()));
 
                 auto old_except_mask = out_stream.exceptions();
@@ -763,7 +762,6 @@ namespace seal
                 }
 
                 // Populate the header
-                header.compr_mode = compr_mode_type::zstd;
                 header.size = static_cast<uint64_t>(add_safe(sizeof(Serialization::SEALHeader), in.size()));
 
                 auto old_except_mask = out_stream.exceptions();
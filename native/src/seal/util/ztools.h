@@ -19,8 +19,8 @@ namespace seal
         {
             /**
             Compresses data in the given buffer, completes the given SEALHeader by writing in the size of the output and
-            setting the compression mode to compr_mode_type::zlib and finally writes the SEALHeader followed by the
-            compressed data in the given stream.
+            finally writes the SEALHeader followed by the compressed data in the given stream. The compression mode in
+            the SEALHeader must be set by the caller.
 
             @param[in] in The buffer to compress
             @param[in] in_size The size of the buffer to compress in bytes
@@ -40,8 +40,8 @@ namespace seal
 
             /**
             Compresses data in the given buffer, completes the given SEALHeader by writing in the size of the output and
-            setting the compression mode to compr_mode_type::zstd and finally writes the SEALHeader followed by the
-            compressed data in the given stream.
+            finally writes the SEALHeader followed by the compressed data in the given stream. The compression mode in
+            the SEALHeader must be set by the caller.
 
             @param[in] in The buffer to compress
             @param[in] in_size The size of the buffer to compress in bytes
@@ -2,6 +2,8 @@
 // Licensed under the MIT license.
 
 #include "seal/ciphertext.h"
+#include "seal/ciphertextbatch.h"
+#include "seal/compactciphertext.h"
 #include "seal/galoiskeys.h"
 #include "seal/kswitchkeys.h"
 #include "seal/plaintext.h"
@@ -9,6 +11,7 @@
 #include "seal/relinkeys.h"
 #include "seal/secretkey.h"
 #include "seal/valcheck.h"
+#include "seal/util/bitpack.h"
 #include "seal/util/common.h"
 #include "seal/util/defines.h"
 
@@ -104,6 +107,77 @@ namespace seal
         return true;
     }
 
+    bool is_metadata_valid_for(const CiphertextBatch &in, const SEALContext &context)
+    {
+        // Verify parameters
+        if (!context.parameters_set())
+        {
+            return false;
+        }
+
+        // The metadata of an empty batch is irrelevant
+        if (in.empty())
+        {
+            return true;
+        }
+
+        // Are the parameters valid for ciphertexts at a data level?
+        auto context_data_ptr = context.get_context_data(in.parms_id());
+        if (!context_data_ptr || context_data_ptr->chain_index() > context.first_context_data()->chain_index())
+        {
+            return false;
+        }
+
+        // Check that the metadata matches
+        auto &coeff_modulus = context_data_ptr->parms().coeff_modulus();
+        size_t poly_modulus_degree = context_data_ptr->parms().poly_modulus_degree();
+        if ((coeff_modulus.size() != in.coeff_modulus_size()) || (poly_modulus_degree != in.poly_modulus_degree()))
+        {
+            return false;
+        }
+
+        // Check that the ciphertext size is within right bounds
+        auto size = in.ciphertext_size();
+        if (size < SEAL_CIPHERTEXT_SIZE_MIN || size > SEAL_CIPHERTEXT_SIZE_MAX)
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    bool is_metadata_valid_for(const CompactCiphertext &in, const SEALContext &context)
+    {
+        // Verify parameters
+        if (!context.parameters_set())
+        {
+            return false;
+        }
+
+        // Are the parameters valid for a BFV ciphertext at a data level?
+        auto context_data_ptr = context.get_context_data(in.parms_id());
+        if (!context_data_ptr || context_data_ptr->chain_index() > context.first_context_data()->chain_index())
+        {
+            return false;
+        }
+        auto &parms = context_data_ptr->parms();
+        if (parms.scheme() != scheme_type::bfv || parms.poly_modulus_degree() != in.poly_modulus_degree())
+        {
+            return false;
+        }
+
+        // Check that the bit counts are within right bounds
+        for (size_t i = 0; i < 2; i++)
+        {
+            if (in.bit_count(i) < 1 || in.bit_count(i) > 64)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
     bool is_metadata_valid_for(const SecretKey &in, const SEALContext &context)
     {
         // Note: we check the underlying Plaintext and allow pure key levels in
@@ -138,11 +212,18 @@ namespace seal
             return false;
         }
 
-        size_t decomp_mod_count = context.first_context_data()->parms().coeff_modulus().size();
+        // Were the keys generated for the same keyswitching configuration?
+        if (in.special_prime_count() != context.special_prime_count() || in.dnum() != context.dnum() ||
+            in.digit_size() != context.digit_size())
+        {
+            return false;
+        }
+
+        size_t digit_count = context.dnum();
         for (auto &a : in.data())
         {
             // Check that each highest level component has right size
-            if (a.size() && (a.size() != decomp_mod_count))
+            if (a.size() && (a.size() != digit_count))
             {
                 return false;
             }
@@ -197,6 +278,35 @@ namespace seal
         return true;
     }
 
+    bool is_buffer_valid(const CiphertextBatch &in)
+    {
+        // Check that the buffer size is correct
+        if (in.empty())
+        {
+            return in.dyn_array().size() == 0;
+        }
+        if (in.dyn_array().size() !=
+            mul_safe(in.size(), in.ciphertext_size(), in.coeff_modulus_size(), in.poly_modulus_degree()))
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    bool is_buffer_valid(const CompactCiphertext &in)
+    {
+        // Check that the buffer size is correct
+        if (in.dyn_array().size() != add_safe(
+                                         get_packed_uint64_count(in.poly_modulus_degree(), in.bit_count(0)),
+                                         get_packed_uint64_count(in.poly_modulus_degree(), in.bit_count(1))))
+        {
+            return false;
+        }
+
+        return true;
+    }
+
     bool is_buffer_valid(const SecretKey &in)
     {
         return is_buffer_valid(in.data());
@@ -316,6 +426,51 @@ namespace seal
         return true;
     }
 
+    bool is_data_valid_for(const CiphertextBatch &in, const SEALContext &context)
+    {
+        // Check metadata
+        if (!is_metadata_valid_for(in, context))
+        {
+            return false;
+        }
+        if (in.empty())
+        {
+            return true;
+        }
+
+        // Check the data
+        auto context_data_ptr = context.get_context_data(in.parms_id());
+        const auto &coeff_modulus = context_data_ptr->parms().coeff_modulus();
+        size_t coeff_modulus_size = coeff_modulus.size();
+
+        const CiphertextBatch::ct_coeff_type *ptr = in.dyn_array().cbegin();
+        auto poly_count = mul_safe(in.size(), in.ciphertext_size());
+
+        for (size_t i = 0; i < poly_count; i++)
+        {
+            for (size_t j = 0; j < coeff_modulus_size; j++)
+            {
+                uint64_t modulus = coeff_modulus[j].value();
+                auto poly_modulus_degree = in.poly_modulus_degree();
+                for (; poly_modulus_degree--; ptr++)
+                {
+                    if (*ptr >= modulus)
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool is_data_valid_for(const CompactCiphertext &in, const SEALContext &context)
+    {
+        // Any packed coefficients are valid
+        return is_metadata_valid_for(in, context);
+    }
+
     bool is_data_valid_for(const SecretKey &in, const SEALContext &context)
     {
         // Check metadata
@@ -384,14 +539,8 @@ namespace seal
 
     bool is_data_valid_for(const KSwitchKeys &in, const SEALContext &context)
     {
-        // Verify parameters
-        if (!context.parameters_set())
-        {
-            return false;
-        }
-
-        // Are the parameters valid for given relinearization keys?
-        if (in.parms_id() != context.key_parms_id())
+        // Check metadata
+        if (!is_metadata_valid_for(in, context))
         {
             return false;
         }
@@ -10,6 +10,8 @@ namespace seal
 {
     class Plaintext;
     class Ciphertext;
+    class CiphertextBatch;
+    class CompactCiphertext;
     class SecretKey;
     class PublicKey;
     class KSwitchKeys;
@@ -46,6 +48,31 @@ namespace seal
     SEAL_NODISCARD bool is_metadata_valid_for(
         const Ciphertext &in, const SEALContext &context, bool allow_pure_key_levels = false);
 
+    /**
+    Check whether the given CompactCiphertext is valid for a given SEALContext.
+    If the given SEALContext is not set, the encryption parameters are invalid,
+    or the CompactCiphertext data does not match the SEALContext, this function
+    returns false. Otherwise, returns true. This function only checks the
+    metadata and not the CompactCiphertext data itself.
+
+    @param[in] in The CompactCiphertext to check
+    @param[in] context The SEALContext
+    */
+    SEAL_NODISCARD bool is_metadata_valid_for(const CompactCiphertext &in, const SEALContext &context);
+
+    /**
+    Check whether the given CiphertextBatch is valid for a given SEALContext. If
+    the given SEALContext is not set, the encryption parameters are invalid, or
+    the metadata shared by the ciphertexts in the batch does not match the
+    SEALContext, this function returns false. Otherwise, returns true. An empty
+    batch is always valid for a set SEALContext. This function only checks the
+    metadata and not the ciphertext data itself.
+
+    @param[in] in The CiphertextBatch to check
+    @param[in] context The SEALContext
+    */
+    SEAL_NODISCARD bool is_metadata_valid_for(const CiphertextBatch &in, const SEALContext &context);
+
     /**
     Check whether the given secret key is valid for a given SEALContext. If the
     given SEALContext is not set, the encryption parameters are invalid, or the
@@ -128,6 +155,26 @@ namespace seal
     */
     SEAL_NODISCARD bool is_buffer_valid(const Ciphertext &in);
 
+    /**
+    Check whether the given CompactCiphertext data buffer is valid. If the data
+    buffer does not match the metadata of the CompactCiphertext, this function
+    returns false. Otherwise, returns true. This function only checks the size
+    of the data buffer and not the CompactCiphertext data itself.
+
+    @param[in] in The CompactCiphertext to check
+    */
+    SEAL_NODISCARD bool is_buffer_valid(const CompactCiphertext &in);
+
+    /**
+    Check whether the given CiphertextBatch data buffer is valid. If the data
+    buffer does not match the metadata of the CiphertextBatch, this function
+    returns false. Otherwise, returns true. This function only checks the size
+    of the data buffer and not the ciphertext data itself.
+
+    @param[in] in The CiphertextBatch to check
+    */
+    SEAL_NODISCARD bool is_buffer_valid(const CiphertextBatch &in);
+
     /**
     Check whether the given secret key data buffer is valid for a given SEALContext.
     If the given SEALContext is not set, the encryption parameters are invalid,
@@ -207,6 +254,31 @@ namespace seal
     */
     SEAL_NODISCARD bool is_data_valid_for(const Ciphertext &in, const SEALContext &context);
 
+    /**
+    Check whether the given CompactCiphertext data and metadata are valid for a
+    given SEALContext. If the given SEALContext is not set, the encryption
+    parameters are invalid, or the CompactCiphertext data does not match the
+    SEALContext, this function returns false. Otherwise, returns true. Since
+    any packed coefficients are valid, this checks only the metadata.
+
+    @param[in] in The CompactCiphertext to check
+    @param[in] context The SEALContext
+    */
+    SEAL_NODISCARD bool is_data_valid_for(const CompactCiphertext &in, const SEALContext &context);
+
+    /**
+    Check whether the given CiphertextBatch data and metadata are valid for a
+    given SEALContext. If the given SEALContext is not set, the encryption
+    parameters are invalid, or the data of any ciphertext in the batch does not
+    match the SEALContext, this function returns false. Otherwise, returns true.
+    This function can be slow, as it checks the correctness of the entire data
+    buffer.
+
+    @param[in] in The CiphertextBatch to check
+    @param[in] context The SEALContext
+    */
+    SEAL_NODISCARD bool is_data_valid_for(const CiphertextBatch &in, const SEALContext &context);
+
     /**
     Check whether the given secret key data and metadata are valid for a given SEALContext.
     If the given SEALContext is not set, the encryption parameters are invalid,
@@ -297,6 +369,35 @@ namespace seal
         return is_buffer_valid(in) && is_data_valid_for(in, context);
     }
 
+    /**
+    Check whether the given CompactCiphertext is valid for a given SEALContext.
+    If the given SEALContext is not set, the encryption parameters are invalid,
+    or the CompactCiphertext data does not match the SEALContext, this function
+    returns false. Otherwise, returns true.
+
+    @param[in] in The CompactCiphertext to check
+    @param[in] context The SEALContext
+    */
+    SEAL_NODISCARD inline bool is_valid_for(const CompactCiphertext &in, const SEALContext &context)
+    {
+        return is_buffer_valid(in) && is_data_valid_for(in, context);
+    }
+
+    /**
+    Check whether the given CiphertextBatch is valid for a given SEALContext. If
+    the given SEALContext is not set, the encryption parameters are invalid, or
+    the data of any ciphertext in the batch does not match the SEALContext, this
+    function returns false. Otherwise, returns true. This function can be slow
+    as it checks the validity of all metadata and of the entire data buffer.
+
+    @param[in] in The CiphertextBatch to check
+    @param[in] context The SEALContext
+    */
+    SEAL_NODISCARD inline bool is_valid_for(const CiphertextBatch &in, const SEALContext &context)
+    {
+        return is_buffer_valid(in) && is_data_valid_for(in, context);
+    }
+
     /**
     Check whether the given secret key is valid for a given SEALContext. If the
     given SEALContext is not set, the encryption parameters are invalid, or the
@@ -3,10 +3,15 @@
 
 #include "seal/ciphertext.h"
 #include "seal/context.h"
+#include "seal/decryptor.h"
 #include "seal/encryptor.h"
+#include "seal/evaluator.h"
 #include "seal/keygenerator.h"
 #include "seal/memorymanager.h"
 #include "seal/modulus.h"
+#include <algorithm>
+#include <sstream>
+#include <vector>
 #include "gtest/gtest.h"
 
 using namespace seal;
@@ -126,4 +131,145 @@ namespace sealtest
             is_equal_uint(ctxt.data(), ctxt2.data(), parms.poly_modulus_degree() * parms.coeff_modulus().size() * 2));
         ASSERT_TRUE(ctxt.data() != ctxt2.data());
     }
+
+    TEST(CiphertextTest, SaveLoadPackedCiphertext)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(4096);
+        parms.set_coeff_modulus(CoeffModulus::BFVDefault(4096));
+        parms.set_plain_modulus(1024);
+        SEALContext context(parms, false, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        Encryptor encryptor(context, pk, keygen.secret_key());
+        Decryptor decryptor(context, keygen.secret_key());
+        Plaintext plain("1x^100 + 2x^3 + 3");
+
+        Ciphertext ctxt;
+        encryptor.encrypt(plain, ctxt);
+        auto compare = [&](const Ciphertext &loaded) {
+            ASSERT_TRUE(ctxt.parms_id() == loaded.parms_id());
+            ASSERT_EQ(ctxt.dyn_array().size(), loaded.dyn_array().size());
+            ASSERT_TRUE(is_equal_uint(ctxt.data(), loaded.data(), ctxt.dyn_array().size()));
+        };
+
+        vector<compr_mode_type> compr_modes{ compr_mode_type::packed };
+#ifdef SEAL_USE_ZSTD
+        compr_modes.push_back(compr_mode_type::packed_zstd);
+#endif
+        auto none_size = ctxt.save_size(compr_mode_type::none);
+        for (auto compr_mode : compr_modes)
+        {
+            // Residues take the 36 or 37 bits of their coefficient moduli instead of 64
+            stringstream stream;
+            auto out_size = ctxt.save(stream, compr_mode);
+            ASSERT_LT(out_size, none_size * 6 / 10);
+            ASSERT_LE(out_size, ctxt.save_size(compr_mode));
+            Ciphertext ctxt2;
+            ASSERT_EQ(out_size, ctxt2.load(context, stream));
+            compare(ctxt2);
+
+            vector<seal_byte> buffer(static_cast<size_t>(ctxt.save_size(compr_mode)));
+            out_size = ctxt.save(buffer.data(), buffer.size(), compr_mode);
+            Ciphertext ctxt3;
+            ASSERT_EQ(out_size, ctxt3.load(context, buffer.data(), buffer.size()));
+            compare(ctxt3);
+
+            // Seeded ciphertexts and keys use the nested serialization of DynArray as well
+            stringstream seeded_stream;
+            encryptor.encrypt_symmetric(plain).save(seeded_stream, compr_mode);
+            Plaintext decrypted;
+            ctxt2.load(context, seeded_stream);
+            decryptor.decrypt(ctxt2, decrypted);
+            ASSERT_EQ(plain, decrypted);
+
+            stringstream key_stream;
+            keygen.secret_key().save(key_stream, compr_mode);
+            SecretKey secret_key;
+            secret_key.load(context, key_stream);
+            ASSERT_TRUE(is_equal_uint(
+                keygen.secret_key().data().data(), secret_key.data().data(),
+                keygen.secret_key().data().coeff_count()));
+        }
+    }
+
+    TEST(CiphertextTest, CiphertextView)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(2048);
+        parms.set_coeff_modulus(CoeffModulus::BFVDefault(2048));
+        parms.set_plain_modulus(64);
+        SEALContext context(parms, false, sec_level_type::none);
+        size_t poly_coeff_count = parms.poly_modulus_degree() * parms.coeff_modulus().size();
+
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        Encryptor encryptor(context, pk);
+        Decryptor decryptor(context, keygen.secret_key());
+        Evaluator evaluator(context);
+
+        // A buffer with room for a ciphertext of size three
+        vector<Ciphertext::ct_coeff_type> buffer(3 * poly_coeff_count);
+        Ciphertext view(context, context.first_parms_id(), 2, buffer.data(), buffer.size());
+        ASSERT_TRUE(view.is_view());
+        ASSERT_EQ(2ULL, view.size());
+        ASSERT_FALSE(view.is_ntt_form());
+        ASSERT_EQ(buffer.data(), view.data());
+
+        Plaintext plain("1x^2 + 3");
+        encryptor.encrypt(plain, view);
+        ASSERT_EQ(buffer.data(), view.data());
+        Ciphertext owned(view);
+        ASSERT_FALSE(owned.is_view());
+
+        // Wrapping the same buffer again sees the encryption
+        Ciphertext received(context, context.first_parms_id(), 2, buffer.data(), buffer.size());
+        vector<Plaintext::pt_coeff_type> plain_buffer(parms.poly_modulus_degree());
+        Plaintext decrypted(0, plain_buffer.data(), plain_buffer.size());
+        decryptor.decrypt(received, decrypted);
+        ASSERT_EQ(plain_buffer.data(), decrypted.data());
+        ASSERT_EQ(plain.to_string(), decrypted.to_string());
+
+        // Operations write their results to the buffer
+        evaluator.multiply_inplace(view, owned);
+        evaluator.multiply_inplace(owned, owned);
+        ASSERT_EQ(buffer.data(), view.data());
+        ASSERT_EQ(3ULL, view.size());
+        ASSERT_TRUE(equal(owned.data(), owned.data() + owned.dyn_array().size(), buffer.data()));
+        decryptor.decrypt(view, decrypted);
+        ASSERT_EQ("1x^4 + 6x^2 + 9", decrypted.to_string());
+
+        // Results that do not fit in the buffer throw
+        ASSERT_THROW(evaluator.multiply_inplace(view, owned), logic_error);
+        vector<Ciphertext::ct_coeff_type> small_buffer(2 * poly_coeff_count);
+        ASSERT_THROW(
+            Ciphertext(context, context.first_parms_id(), 3, small_buffer.data(), small_buffer.size()),
+            invalid_argument);
+
+        // Loading keeps the buffer
+        stringstream stream;
+        encryptor.encrypt(plain, owned);
+        owned.save(stream);
+        view.load(context, stream);
+        ASSERT_TRUE(view.is_view());
+        ASSERT_EQ(buffer.data(), view.data());
+        ASSERT_EQ(2ULL, view.size());
+        decryptor.decrypt(view, decrypted);
+        ASSERT_EQ(plain.to_string(), decrypted.to_string());
+
+        // A failed assignment leaves the metadata of a view unchanged
+        Ciphertext small_view(context, context.first_parms_id(), 2, small_buffer.data(), small_buffer.size());
+        Ciphertext squared;
+        evaluator.square(owned, squared);
+        squared.scale() = 2.0;
+        ASSERT_THROW(small_view = squared, logic_error);
+        ASSERT_EQ(2ULL, small_view.size());
+        ASSERT_EQ(1.0, small_view.scale());
+
+        Ciphertext moved(move(view));
+        ASSERT_TRUE(moved.is_view());
+        ASSERT_EQ(buffer.data(), moved.data());
+    }
 } // namespace sealtest
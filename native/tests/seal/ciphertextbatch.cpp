@@ -0,0 +1,220 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/ciphertext.h"
+#include "seal/ciphertextbatch.h"
+#include "seal/context.h"
+#include "seal/encryptor.h"
+#include "seal/evaluator.h"
+#include "seal/keygenerator.h"
+#include "seal/modulus.h"
+#include "seal/threadpool.h"
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal;
+using namespace seal::util;
+using namespace std;
+
+namespace sealtest
+{
+    namespace
+    {
+        bool are_equal(const Ciphertext &a, const Ciphertext &b)
+        {
+            return a.parms_id() == b.parms_id() && a.size() == b.size() && a.is_ntt_form() == b.is_ntt_form() &&
+                   a.scale() == b.scale() && equal(a.data(), a.data() + a.dyn_array().size(), b.data());
+        }
+
+        SEALContext create_context(shared_ptr<ThreadPool> thread_pool = nullptr)
+        {
+            EncryptionParameters parms(scheme_type::bfv);
+            parms.set_poly_modulus_degree(128);
+            parms.set_coeff_modulus(CoeffModulus::Create(128, { 30, 30, 30 }));
+            parms.set_plain_modulus(65537);
+            return SEALContext(parms, true, sec_level_type::none, 1, 0, mod_arith_type::barrett, move(thread_pool));
+        }
+    } // namespace
+
+    TEST(CiphertextBatchTest, CiphertextBatchBasics)
+    {
+        SEALContext context = create_context();
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+
+        CiphertextBatch batch;
+        ASSERT_TRUE(batch.empty());
+        ASSERT_TRUE(is_valid_for(batch, context));
+
+        vector<Ciphertext> encrypteds(5);
+        for (size_t i = 0; i < encrypteds.size(); i++)
+        {
+            encryptor.encrypt(Plaintext(to_string(i + 1)), encrypteds[i]);
+            ASSERT_TRUE(batch.accepts(encrypteds[i]));
+            batch.push_back(encrypteds[i]);
+        }
+        ASSERT_EQ(size_t(5), batch.size());
+        ASSERT_TRUE(batch.parms_id() == context.first_parms_id());
+        ASSERT_EQ(size_t(2), batch.ciphertext_size());
+        ASSERT_EQ(size_t(5 * 2 * 128 * 2), batch.dyn_array().size());
+        ASSERT_TRUE(is_valid_for(batch, context));
+
+        Ciphertext encrypted;
+        for (size_t i = 0; i < encrypteds.size(); i++)
+        {
+            batch.get(context, i, encrypted);
+            ASSERT_TRUE(are_equal(encrypteds[i], encrypted));
+        }
+        ASSERT_THROW(batch.get(context, 5, encrypted), out_of_range);
+
+        // Views modify the batch in place
+        Ciphertext view = batch.view(context, 2);
+        ASSERT_TRUE(view.is_view());
+        evaluator.negate_inplace(view);
+        evaluator.negate_inplace(encrypteds[2]);
+        batch.get(context, 2, encrypted);
+        ASSERT_TRUE(are_equal(encrypteds[2], encrypted));
+
+        // Only ciphertexts with the same metadata are accepted
+        Ciphertext other;
+        evaluator.mod_switch_to_next(encrypteds[0], other);
+        ASSERT_FALSE(batch.accepts(other));
+        ASSERT_THROW(batch.push_back(other), invalid_argument);
+        evaluator.square(encrypteds[0], other);
+        ASSERT_FALSE(batch.accepts(other));
+        ASSERT_THROW(batch.push_back(Ciphertext()), invalid_argument);
+
+        batch.clear();
+        ASSERT_TRUE(batch.empty());
+        ASSERT_TRUE(batch.accepts(other));
+        batch.push_back(other);
+        ASSERT_EQ(size_t(3), batch.ciphertext_size());
+        batch.get(context, 0, encrypted);
+        ASSERT_TRUE(are_equal(other, encrypted));
+    }
+
+    TEST(CiphertextBatchTest, CiphertextBatchSaveLoad)
+    {
+        SEALContext context = create_context();
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        Encryptor encryptor(context, pk);
+
+        CiphertextBatch batch;
+        vector<Ciphertext> encrypteds(20);
+        streamoff separate_size = 0;
+        for (size_t i = 0; i < encrypteds.size(); i++)
+        {
+            encryptor.encrypt(Plaintext(to_string(i)), encrypteds[i]);
+            batch.push_back(encrypteds[i]);
+            separate_size += encrypteds[i].save_size(compr_mode_type::none);
+        }
+        ASSERT_LT(batch.save_size(compr_mode_type::none), separate_size);
+
+        auto test = [&](compr_mode_type compr_mode) {
+            stringstream stream;
+            auto out_size = batch.save(stream, compr_mode);
+            ASSERT_LE(out_size, batch.save_size(compr_mode));
+
+            CiphertextBatch loaded;
+            ASSERT_EQ(out_size, loaded.load(context, stream));
+            ASSERT_EQ(batch.size(), loaded.size());
+            Ciphertext encrypted;
+            for (size_t i = 0; i < encrypteds.size(); i++)
+            {
+                loaded.get(context, i, encrypted);
+                ASSERT_TRUE(are_equal(encrypteds[i], encrypted));
+            }
+        };
+        test(compr_mode_type::none);
+        test(compr_mode_type::packed);
+#ifdef SEAL_USE_ZLIB
+        test(compr_mode_type::zlib);
+        test(compr_mode_type::zlib_chunked);
+#endif
+#ifdef SEAL_USE_ZSTD
+        test(compr_mode_type::zstd);
+        test(compr_mode_type::zstd_chunked);
+#endif
+
+        // Empty batches round trip
+        stringstream stream;
+        CiphertextBatch().save(stream, compr_mode_type::none);
+        CiphertextBatch loaded;
+        loaded.load(context, stream);
+        ASSERT_TRUE(loaded.empty());
+
+        // Coefficients out of range are rejected
+        stream.str("");
+        stream.clear();
+        batch.save(stream, compr_mode_type::none);
+        string data = stream.str();
+        fill_n(data.end() - 8, 8, static_cast<char>(0xFF));
+        stringstream corrupted(data);
+        ASSERT_THROW(loaded.load(context, corrupted), logic_error);
+    }
+
+    TEST(CiphertextBatchTest, CiphertextBatchStreaming)
+    {
+        SEALContext context = create_context();
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+
+        // Switch levels in the middle of the stream
+        vector<Ciphertext> encrypteds(10);
+        for (size_t i = 0; i < encrypteds.size(); i++)
+        {
+            encryptor.encrypt(Plaintext(to_string(i)), encrypteds[i]);
+            if (i >= 7)
+            {
+                evaluator.mod_switch_to_next_inplace(encrypteds[i]);
+            }
+        }
+
+        auto test = [&](compr_mode_type compr_mode, shared_ptr<ThreadPool> thread_pool) {
+            stringstream stream;
+            CiphertextBatchWriter writer(stream, 3, compr_mode, MemoryManager::GetPool(), thread_pool);
+            for (const auto &encrypted : encrypteds)
+            {
+                writer.write(encrypted);
+            }
+            writer.flush();
+            writer.flush();
+            ASSERT_EQ(static_cast<streamoff>(stream.str().size()), writer.bytes_written());
+
+            CiphertextBatchReader reader(create_context(thread_pool), stream);
+            Ciphertext encrypted;
+            for (const auto &expected : encrypteds)
+            {
+                ASSERT_TRUE(reader.read(encrypted));
+                ASSERT_TRUE(are_equal(expected, encrypted));
+            }
+            ASSERT_FALSE(reader.read(encrypted));
+            ASSERT_FALSE(reader.read(encrypted));
+            ASSERT_EQ(writer.bytes_written(), reader.bytes_read());
+        };
+        test(compr_mode_type::none, nullptr);
+#ifdef SEAL_USE_ZLIB
+        test(compr_mode_type::zlib_chunked, make_shared<ThreadPool>(4));
+#endif
+
+        // An empty stream holds no ciphertexts
+        stringstream empty_stream;
+        CiphertextBatchReader reader(context, empty_stream);
+        Ciphertext encrypted;
+        ASSERT_FALSE(reader.read(encrypted));
+
+        stringstream stream;
+        ASSERT_THROW(CiphertextBatchWriter(stream, 0), invalid_argument);
+    }
+} // namespace sealtest
@@ -5,7 +5,9 @@
 #include "seal/context.h"
 #include "seal/keygenerator.h"
 #include "seal/modulus.h"
+#include <complex>
 #include <ctime>
+#include <random>
 #include <vector>
 #include "gtest/gtest.h"
 
@@ -341,4 +343,46 @@ namespace sealtest
             }
         }
     }
+
+    TEST(CKKSEncoderTest, FFTRadix4Test)
+    {
+        // Radix-4 transforms over the complex field must agree exactly with the radix-2 transforms
+        using ComplexArith = Arithmetic<complex<double>, complex<double>, double>;
+        DWTHandler<complex<double>, complex<double>, double> handler{ ComplexArith() };
+        mt19937_64 rng(0);
+        uniform_real_distribution<double> dist(-1.0, 1.0);
+
+        for (int logn = 1; logn <= 12; logn++)
+        {
+            size_t n = size_t(1) << logn;
+            vector<complex<double>> roots(n);
+            for (auto &r : roots)
+            {
+                r = polar(1.0, dist(rng));
+            }
+            vector<complex<double>> values(n);
+            for (auto &v : values)
+            {
+                v = complex<double>(dist(rng), dist(rng));
+            }
+            vector<complex<double>> expected(values);
+            double scalar = 0.25;
+
+            handler.transform_to_rev_radix4(values.data(), logn, roots.data(), &scalar);
+            handler.transform_to_rev(expected.data(), logn, roots.data(), &scalar);
+            ASSERT_TRUE(values == expected);
+
+            handler.transform_from_rev_radix4(values.data(), logn, roots.data(), &scalar);
+            handler.transform_from_rev(expected.data(), logn, roots.data(), &scalar);
+            ASSERT_TRUE(values == expected);
+
+            handler.transform_to_rev_radix4(values.data(), logn, roots.data());
+            handler.transform_to_rev(expected.data(), logn, roots.data());
+            ASSERT_TRUE(values == expected);
+
+            handler.transform_from_rev_radix4(values.data(), logn, roots.data());
+            handler.transform_from_rev(expected.data(), logn, roots.data());
+            ASSERT_TRUE(values == expected);
+        }
+    }
 } // namespace sealtest
@@ -0,0 +1,210 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/batchencoder.h"
+#include "seal/ciphertext.h"
+#include "seal/compactciphertext.h"
+#include "seal/context.h"
+#include "seal/decryptor.h"
+#include "seal/encryptor.h"
+#include "seal/evaluator.h"
+#include "seal/keygenerator.h"
+#include "seal/modulus.h"
+#include <sstream>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal;
+using namespace seal::util;
+using namespace std;
+
+namespace sealtest
+{
+    TEST(CompactCiphertextTest, CompactDecrypt)
+    {
+        auto test = [](const SEALContext &context, bool square) {
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            RelinKeys rlk;
+            keygen.create_relin_keys(rlk);
+            Encryptor encryptor(context, pk);
+            Decryptor decryptor(context, keygen.secret_key());
+            Evaluator evaluator(context);
+            BatchEncoder encoder(context);
+
+            vector<uint64_t> values(encoder.slot_count());
+            uint64_t t = context.first_context_data()->parms().plain_modulus().value();
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                values[i] = (i * 7919 + 13) % t;
+            }
+            Plaintext plain;
+            encoder.encode(values, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+            if (square)
+            {
+                evaluator.square_inplace(encrypted);
+                evaluator.relinearize_inplace(encrypted, rlk);
+                for (auto &value : values)
+                {
+                    value = (value * value) % t;
+                }
+            }
+            ASSERT_LT(1, decryptor.invariant_noise_budget(encrypted));
+
+            CompactCiphertext compact;
+            evaluator.compact(encrypted, compact);
+            ASSERT_TRUE(compact.parms_id() == context.last_parms_id());
+            ASSERT_LT(compact.bit_count(0), compact.bit_count(1));
+            ASSERT_TRUE(is_valid_for(compact, context));
+
+            // Round trip through serialization
+            stringstream stream;
+            compact.save(stream);
+            CompactCiphertext loaded;
+            loaded.load(context, stream);
+            ASSERT_EQ(compact.bit_count(0), loaded.bit_count(0));
+            ASSERT_EQ(compact.bit_count(1), loaded.bit_count(1));
+
+            Plaintext decrypted;
+            decryptor.decrypt(loaded, decrypted);
+            vector<uint64_t> decoded;
+            encoder.decode(decrypted, decoded);
+            ASSERT_TRUE(values == decoded);
+
+            // Much smaller than the ciphertext at the lowest level
+            Ciphertext encrypted_last;
+            evaluator.mod_switch_to(encrypted, context.last_parms_id(), encrypted_last);
+            ASSERT_LT(compact.save_size() * 2, encrypted_last.save_size(compr_mode_type::none));
+        };
+
+        {
+            EncryptionParameters parms(scheme_type::bfv);
+            parms.set_poly_modulus_degree(4096);
+            parms.set_coeff_modulus(CoeffModulus::BFVDefault(4096));
+            parms.set_plain_modulus(PlainModulus::Batching(4096, 20));
+            SEALContext context(parms, true, sec_level_type::none);
+            test(context, false);
+            test(context, true);
+        }
+        {
+            // The lowest level has two primes
+            EncryptionParameters parms(scheme_type::bfv);
+            parms.set_poly_modulus_degree(1024);
+            parms.set_coeff_modulus(CoeffModulus::Create(1024, { 40, 40, 40 }));
+            parms.set_plain_modulus(PlainModulus::Batching(1024, 17));
+            SEALContext context(parms, false, sec_level_type::none);
+            test(context, false);
+            test(context, true);
+        }
+    }
+
+    TEST(CompactCiphertextTest, CompactBitCounts)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(1024);
+        parms.set_coeff_modulus(CoeffModulus::Create(1024, { 50, 40 }));
+        parms.set_plain_modulus(PlainModulus::Batching(1024, 17));
+        SEALContext context(parms, false, sec_level_type::none);
+
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        Encryptor encryptor(context, pk);
+        Decryptor decryptor(context, keygen.secret_key());
+        Evaluator evaluator(context);
+
+        Plaintext plain("1x^1023 + 2x^5 + 3");
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+        CompactCiphertext compact;
+        Plaintext decrypted;
+
+        // Keeping all bits is lossless
+        evaluator.compact(encrypted, 50, 50, compact);
+        ASSERT_EQ(50, compact.bit_count(0));
+        ASSERT_EQ(50, compact.bit_count(1));
+        ASSERT_EQ(size_t(1024 / 64 * 100), compact.dyn_array().size());
+        decryptor.decrypt(compact, decrypted);
+        ASSERT_TRUE(plain == decrypted);
+
+        evaluator.compact(encrypted, 22, 33, compact);
+        ASSERT_EQ(22, compact.bit_count(0));
+        ASSERT_EQ(33, compact.bit_count(1));
+        ASSERT_EQ(size_t(1024 / 64 * 55), compact.dyn_array().size());
+        decryptor.decrypt(compact, decrypted);
+        ASSERT_TRUE(plain == decrypted);
+
+        // Far too few bits to decrypt correctly
+        evaluator.compact(encrypted, 4, 4, compact);
+        decryptor.decrypt(compact, decrypted);
+        ASSERT_FALSE(plain == decrypted);
+
+        ASSERT_THROW(evaluator.compact(encrypted, 0, 20, compact), invalid_argument);
+        ASSERT_THROW(evaluator.compact(encrypted, 20, 65, compact), invalid_argument);
+        ASSERT_THROW((void)compact.bit_count(2), out_of_range);
+
+        // Only ciphertexts of size 2 in coefficient form
+        Ciphertext squared;
+        evaluator.square(encrypted, squared);
+        ASSERT_THROW(evaluator.compact(squared, compact), invalid_argument);
+        evaluator.transform_to_ntt_inplace(encrypted);
+        ASSERT_THROW(evaluator.compact(encrypted, compact), invalid_argument);
+    }
+
+    TEST(CompactCiphertextTest, CompactInvalid)
+    {
+        {
+            EncryptionParameters parms(scheme_type::ckks);
+            parms.set_poly_modulus_degree(1024);
+            parms.set_coeff_modulus(CoeffModulus::Create(1024, { 40, 40 }));
+            SEALContext context(parms, false, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+
+            Ciphertext encrypted;
+            encryptor.encrypt_zero(encrypted);
+            CompactCiphertext compact;
+            ASSERT_THROW(evaluator.compact(encrypted, compact), invalid_argument);
+            ASSERT_THROW(compact.resize(context, context.first_parms_id(), 10, 20), invalid_argument);
+        }
+        {
+            EncryptionParameters parms(scheme_type::bfv);
+            parms.set_poly_modulus_degree(1024);
+            parms.set_coeff_modulus(CoeffModulus::Create(1024, { 30, 30, 30 }));
+            parms.set_plain_modulus(257);
+            SEALContext context(parms, true, sec_level_type::none);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            Encryptor encryptor(context, pk);
+            Decryptor decryptor(context, keygen.secret_key());
+            Evaluator evaluator(context);
+
+            Ciphertext encrypted;
+            encryptor.encrypt(Plaintext("1x^3 + 7"), encrypted);
+            CompactCiphertext compact;
+            evaluator.compact(encrypted, compact);
+
+            // Only data levels are valid
+            CompactCiphertext other(compact);
+            other.resize(context, context.key_parms_id(), compact.bit_count(0), compact.bit_count(1));
+            ASSERT_FALSE(is_valid_for(other, context));
+            Plaintext decrypted;
+            ASSERT_THROW(decryptor.decrypt(other, decrypted), invalid_argument);
+
+            // Corrupted bit count
+            stringstream stream;
+            compact.save(stream);
+            string data = stream.str();
+            data[sizeof(Serialization::SEALHeader) + sizeof(parms_id_type) + sizeof(uint64_t)] = 0;
+            stringstream corrupted(data);
+            ASSERT_THROW(other.load(context, corrupted), logic_error);
+        }
+    }
+} // namespace sealtest
@@ -382,6 +382,53 @@ namespace sealtest
         }
     }
 
+    TEST(ContextTest, HybridKeySwitching)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        parms.set_poly_modulus_degree(4);
+        parms.set_coeff_modulus({ 41, 137, 193, 65537 });
+
+        // One special prime and one digit per prime by default
+        SEALContext context(parms, true, sec_level_type::none);
+        ASSERT_EQ(size_t(1), context.special_prime_count());
+        ASSERT_EQ(size_t(3), context.dnum());
+        ASSERT_FALSE(!!context.key_context_data()->kswitch_tool());
+        ASSERT_EQ(size_t(1), context.digit_size());
+        ASSERT_EQ(size_t(1), context.first_context_data()->kswitch_tool()->digit_size());
+
+        // Two special primes and digits of two primes
+        context = SEALContext(parms, true, sec_level_type::none, 2);
+        ASSERT_TRUE(context.using_keyswitching());
+        ASSERT_EQ(size_t(2), context.special_prime_count());
+        ASSERT_EQ(size_t(1), context.dnum());
+        ASSERT_EQ(5617ULL, *context.first_context_data()->total_coeff_modulus());
+        ASSERT_EQ(size_t(2), context.key_context_data()->chain_index());
+        ASSERT_EQ(context.key_parms_id(), context.first_context_data()->prev_context_data()->parms_id());
+        ASSERT_EQ(size_t(1), context.last_context_data()->kswitch_tool()->digit_count());
+
+        context = SEALContext(parms, true, sec_level_type::none, 2, 2);
+        ASSERT_EQ(size_t(2), context.dnum());
+        ASSERT_EQ(size_t(1), context.digit_size());
+        ASSERT_EQ(size_t(1), context.first_context_data()->kswitch_tool()->digit_size());
+
+        context = SEALContext(parms, true, sec_level_type::none, 1, 2);
+        ASSERT_EQ(size_t(2), context.dnum());
+        ASSERT_EQ(size_t(2), context.digit_size());
+        ASSERT_EQ(size_t(2), context.first_context_data()->kswitch_tool()->digit_size());
+        ASSERT_EQ(size_t(1), context.last_context_data()->kswitch_tool()->digit_count());
+
+        // All primes special; no keyswitching
+        context = SEALContext(parms, true, sec_level_type::none, 4);
+        ASSERT_FALSE(context.using_keyswitching());
+        ASSERT_EQ(size_t(0), context.dnum());
+
+        ASSERT_THROW(
+            context = SEALContext(parms, true, sec_level_type::none, 0), invalid_argument);
+        ASSERT_THROW(
+            context = SEALContext(parms, true, sec_level_type::none, 2, 3),
+            invalid_argument);
+    }
+
     TEST(EncryptionParameterQualifiersTest, ParameterError)
     {
         auto scheme = scheme_type::bfv;
@@ -4,6 +4,7 @@
 #include "seal/dynarray.h"
 #include "seal/memorymanager.h"
 #include <sstream>
+#include <vector>
 #ifdef SEAL_USE_MSGSL
 #include "gsl/span"
 #endif
@@ -237,4 +238,51 @@ namespace sealtest
         arr = move(arr2);
         ASSERT_EQ(&static_cast<util::MemoryPool &>(arr.pool()), addr);
     }
+
+    TEST(DynArrayTest, Aliasing)
+    {
+        vector<uint64_t> buffer{ 1, 2, 3, 4, 5 };
+        auto arr = DynArray<uint64_t>::Aliasing(buffer.data(), buffer.size(), 3);
+        ASSERT_TRUE(arr.is_alias());
+        ASSERT_EQ(buffer.data(), arr.begin());
+        ASSERT_EQ(3ULL, arr.size());
+        ASSERT_EQ(5ULL, arr.capacity());
+        ASSERT_EQ(3ULL, arr[2]);
+
+        // Growing within the buffer writes to it
+        arr.resize(5);
+        ASSERT_EQ(0ULL, buffer[3]);
+        ASSERT_EQ(0ULL, buffer[4]);
+        arr[0] = 9;
+        ASSERT_EQ(9ULL, buffer[0]);
+
+        // The buffer is never reallocated
+        arr.reserve(2);
+        ASSERT_EQ(2ULL, arr.size());
+        ASSERT_EQ(5ULL, arr.capacity());
+        arr.shrink_to_fit();
+        ASSERT_EQ(buffer.data(), arr.begin());
+        ASSERT_THROW(arr.resize(6), logic_error);
+        ASSERT_THROW(arr.reserve(6), logic_error);
+
+        DynArray<uint64_t> arr2(2);
+        arr2[1] = 7;
+        arr = arr2;
+        ASSERT_EQ(buffer.data(), arr.begin());
+        ASSERT_EQ(7ULL, buffer[1]);
+
+        // Copies own their data and moves transfer the buffer
+        DynArray<uint64_t> copy(arr);
+        ASSERT_FALSE(copy.is_alias());
+        ASSERT_NE(buffer.data(), copy.begin());
+        DynArray<uint64_t> moved(move(arr));
+        ASSERT_TRUE(moved.is_alias());
+        ASSERT_EQ(buffer.data(), moved.begin());
+        moved.release();
+        ASSERT_FALSE(moved.is_alias());
+        ASSERT_EQ(7ULL, buffer[1]);
+
+        ASSERT_THROW(auto arr3 = DynArray<uint64_t>::Aliasing(nullptr, 1, 1), invalid_argument);
+        ASSERT_THROW(auto arr3 = DynArray<uint64_t>::Aliasing(buffer.data(), 2, 3), invalid_argument);
+    }
 } // namespace sealtest
@@ -0,0 +1,159 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/ckks.h"
+#include "seal/context.h"
+#include "seal/decryptor.h"
+#include "seal/encryptionzeropool.h"
+#include "seal/encryptor.h"
+#include "seal/keygenerator.h"
+#include "seal/modulus.h"
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal;
+using namespace std;
+
+namespace sealtest
+{
+    TEST(EncryptionZeroPoolTest, BFVEncrypt)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(128);
+        parms.set_coeff_modulus(CoeffModulus::Create(128, { 30, 30, 30 }));
+        parms.set_plain_modulus(257);
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        Encryptor encryptor(context, pk);
+        Decryptor decryptor(context, keygen.secret_key());
+
+        auto zero_pool = make_shared<EncryptionZeroPool>(context, pk, 4, 2);
+        ASSERT_EQ(size_t(4), zero_pool->depth());
+        ASSERT_TRUE(zero_pool->parms_id() == context.first_parms_id());
+        zero_pool->wait_until_filled();
+        ASSERT_EQ(size_t(4), zero_pool->size());
+        encryptor.set_zero_pool(zero_pool);
+        ASSERT_EQ(zero_pool, encryptor.zero_pool());
+
+        // More encryptions than the depth, some of which may compute their encryption of zero directly
+        Ciphertext encrypted;
+        Ciphertext previous;
+        Plaintext plain;
+        for (size_t i = 0; i < 10; i++)
+        {
+            Plaintext expected(to_string(i % 9 + 1) + "x^" + to_string(i + 1) + " + 3");
+            encryptor.encrypt(expected, encrypted);
+            ASSERT_TRUE(encrypted.parms_id() == context.first_parms_id());
+            ASSERT_FALSE(encrypted.is_ntt_form());
+            decryptor.decrypt(encrypted, plain);
+            ASSERT_TRUE(expected == plain);
+
+            // Each encryption of zero is used once
+            if (i)
+            {
+                ASSERT_FALSE(equal(encrypted.data(1), encrypted.data(1) + encrypted.poly_modulus_degree(),
+                    previous.data(1)));
+            }
+            previous = encrypted;
+        }
+        ASSERT_GE(size_t(10), zero_pool->miss_count());
+
+        // The pool refills in the background; a full pool serves an encryption without a miss
+        zero_pool->wait_until_filled();
+        ASSERT_EQ(size_t(4), zero_pool->size());
+        size_t miss_count = zero_pool->miss_count();
+        encryptor.encrypt_zero(encrypted);
+        ASSERT_EQ(miss_count, zero_pool->miss_count());
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_TRUE(plain.is_zero());
+
+        // Encryptions at other levels do not use the pool
+        auto last_parms_id = context.last_parms_id();
+        encryptor.encrypt_zero(last_parms_id, encrypted);
+        ASSERT_TRUE(encrypted.parms_id() == last_parms_id);
+
+        // Setting a public key detaches the pool
+        encryptor.set_public_key(pk);
+        ASSERT_EQ(nullptr, encryptor.zero_pool());
+        encryptor.set_zero_pool(zero_pool);
+        encryptor.set_zero_pool(nullptr);
+        ASSERT_EQ(nullptr, encryptor.zero_pool());
+    }
+
+    TEST(EncryptionZeroPoolTest, CKKSEncrypt)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        size_t slot_size = 32;
+        parms.set_poly_modulus_degree(2 * slot_size);
+        parms.set_coeff_modulus(CoeffModulus::Create(2 * slot_size, { 40, 40, 40, 40 }));
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        CKKSEncoder encoder(context);
+        Encryptor encryptor(context, pk);
+        Decryptor decryptor(context, keygen.secret_key());
+
+        // A pool below the highest data level
+        auto parms_id = context.first_context_data()->next_context_data()->parms_id();
+        encryptor.set_zero_pool(make_shared<EncryptionZeroPool>(context, pk, parms_id, 2));
+        encryptor.zero_pool()->wait_until_filled();
+
+        const double delta = static_cast<double>(1 << 16);
+        vector<complex<double>> input(slot_size);
+        vector<complex<double>> output;
+        for (size_t i = 0; i < slot_size; i++)
+        {
+            input[i] = static_cast<double>(i);
+        }
+        Plaintext plain;
+        Ciphertext encrypted;
+        for (size_t i = 0; i < 3; i++)
+        {
+            encoder.encode(input, parms_id, delta, plain);
+            encryptor.encrypt(plain, encrypted);
+            ASSERT_TRUE(encrypted.parms_id() == parms_id);
+            ASSERT_TRUE(encrypted.is_ntt_form());
+            decryptor.decrypt(encrypted, plain);
+            encoder.decode(plain, output);
+            for (size_t j = 0; j < slot_size; j++)
+            {
+                ASSERT_LT(abs(input[j].real() - output[j].real()), 0.5);
+            }
+        }
+    }
+
+    TEST(EncryptionZeroPoolTest, InvalidArguments)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(128);
+        parms.set_coeff_modulus(CoeffModulus::Create(128, { 30, 30 }));
+        parms.set_plain_modulus(257);
+        SEALContext context(parms, false, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+
+        ASSERT_THROW(EncryptionZeroPool(context, pk, 0), invalid_argument);
+        ASSERT_THROW(EncryptionZeroPool(context, pk, 1, 0), invalid_argument);
+        ASSERT_THROW(EncryptionZeroPool(context, pk, parms_id_zero, 1), invalid_argument);
+        ASSERT_THROW(EncryptionZeroPool(context, PublicKey(), 1), invalid_argument);
+
+        // A pool for a different public key is rejected
+        KeyGenerator other_keygen(context);
+        PublicKey other_pk;
+        other_keygen.create_public_key(other_pk);
+        auto zero_pool = make_shared<EncryptionZeroPool>(context, other_pk, 1);
+        Encryptor encryptor(context, pk);
+        ASSERT_THROW(encryptor.set_zero_pool(zero_pool), invalid_argument);
+        Encryptor symmetric_encryptor(context, keygen.secret_key());
+        ASSERT_THROW(symmetric_encryptor.set_zero_pool(zero_pool), logic_error);
+    }
+} // namespace sealtest
@@ -6,11 +6,17 @@
 #include "seal/context.h"
 #include "seal/decryptor.h"
 #include "seal/encryptor.h"
+#include "seal/evaluator.h"
 #include "seal/keygenerator.h"
 #include "seal/modulus.h"
+#include "seal/threadpool.h"
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <ctime>
+#include <memory>
+#include <vector>
 #include "gtest/gtest.h"
 
 using namespace seal;
@@ -850,4 +856,166 @@ namespace sealtest
             }
         }
     }
+
+    TEST(EncryptorTest, BFVEncryptMany)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(128);
+        parms.set_coeff_modulus(CoeffModulus::Create(128, { 30, 30, 30 }));
+        parms.set_plain_modulus(257);
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        Encryptor encryptor(context, pk);
+        Decryptor decryptor(context, keygen.secret_key());
+
+        auto test = [&](const Encryptor &test_encryptor, size_t count) {
+            vector<Plaintext> plains;
+            for (size_t i = 0; i < count; i++)
+            {
+                plains.emplace_back(to_string(i % 9 + 1) + "x^" + to_string(i % 127 + 1) + " + 3");
+            }
+            vector<Ciphertext> encrypteds(3);
+            test_encryptor.encrypt_many(plains, encrypteds);
+            ASSERT_EQ(count, encrypteds.size());
+            Plaintext plain;
+            for (size_t i = 0; i < count; i++)
+            {
+                ASSERT_TRUE(encrypteds[i].parms_id() == context.first_parms_id());
+                ASSERT_FALSE(encrypteds[i].is_ntt_form());
+                decryptor.decrypt(encrypteds[i], plain);
+                ASSERT_TRUE(plains[i] == plain);
+                if (i)
+                {
+                    ASSERT_FALSE(equal(
+                        encrypteds[i].data(1), encrypteds[i].data(1) + encrypteds[i].poly_modulus_degree(),
+                        encrypteds[i - 1].data(1)));
+                }
+            }
+        };
+        test(encryptor, 0);
+        test(encryptor, 1);
+        test(encryptor, 100);
+        SEALContext threaded_context(
+            parms, true, sec_level_type::none, 1, 0, mod_arith_type::barrett, make_shared<ThreadPool>(4));
+        test(Encryptor(threaded_context, pk), 100);
+
+        // With a fixed seed, a single plaintext is encrypted as by encrypt
+        parms.set_random_generator(make_shared<Blake2xbPRNGFactory>(prng_seed_type{ 1, 2, 3 }));
+        SEALContext seeded_context(parms, true, sec_level_type::none);
+        Encryptor seeded_encryptor(seeded_context, pk);
+        Ciphertext encrypted;
+        seeded_encryptor.encrypt(Plaintext("5x^3"), encrypted);
+        vector<Ciphertext> encrypteds;
+        seeded_encryptor.encrypt_many({ Plaintext("5x^3") }, encrypteds);
+        ASSERT_TRUE(equal(encrypted.data(), encrypted.data() + encrypted.dyn_array().size(), encrypteds[0].data()));
+
+        // Invalid plaintexts are detected before any encryption
+        vector<Plaintext> plains{ Plaintext("1"), Plaintext("1x^128") };
+        ASSERT_THROW(encryptor.encrypt_many(plains, encrypteds), invalid_argument);
+        ASSERT_EQ(size_t(1), encrypteds.size());
+        Encryptor symmetric_encryptor(context, keygen.secret_key());
+        ASSERT_THROW(symmetric_encryptor.encrypt_many({ Plaintext("1") }, encrypteds), logic_error);
+    }
+
+    TEST(EncryptorTest, CKKSEncryptMany)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        parms.set_poly_modulus_degree(128);
+        parms.set_coeff_modulus(CoeffModulus::Create(128, { 40, 40, 40, 40 }));
+        SEALContext context(
+            parms, true, sec_level_type::none, 1, 0, mod_arith_type::barrett, make_shared<ThreadPool>(3));
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        Encryptor encryptor(context, pk);
+        Decryptor decryptor(context, keygen.secret_key());
+        CKKSEncoder encoder(context);
+
+        // Plaintexts at different levels
+        vector<parms_id_type> parms_ids{ context.first_parms_id(),
+                                         context.first_context_data()->next_context_data()->parms_id(),
+                                         context.last_parms_id() };
+        vector<Plaintext> plains(30);
+        vector<double> values(encoder.slot_count());
+        for (size_t i = 0; i < plains.size(); i++)
+        {
+            fill(values.begin(), values.end(), static_cast<double>(i));
+            encoder.encode(values, parms_ids[(i / 4) % parms_ids.size()], double(1 << 20), plains[i]);
+        }
+
+        vector<Ciphertext> encrypteds;
+        encryptor.encrypt_many(plains, encrypteds);
+        Plaintext plain;
+        vector<double> decoded;
+        for (size_t i = 0; i < plains.size(); i++)
+        {
+            ASSERT_TRUE(encrypteds[i].parms_id() == plains[i].parms_id());
+            ASSERT_TRUE(encrypteds[i].is_ntt_form());
+            ASSERT_EQ(plains[i].scale(), encrypteds[i].scale());
+            decryptor.decrypt(encrypteds[i], plain);
+            encoder.decode(plain, decoded);
+            for (auto value : decoded)
+            {
+                ASSERT_NEAR(static_cast<double>(i), value, 0.01);
+            }
+        }
+
+        plains[3] = Plaintext("1");
+        ASSERT_THROW(encryptor.encrypt_many(plains, encrypteds), invalid_argument);
+    }
+
+    TEST(EncryptorTest, DecryptThreadPool)
+    {
+        // Decryption must not depend on the ThreadPool, in coefficient (BFV) and NTT (CKKS) form and for any size
+        auto test = [](const EncryptionParameters &parms) {
+            SEALContext context(parms, true, sec_level_type::none);
+            SEALContext threaded_context(
+                parms, true, sec_level_type::none, 1, 0, mod_arith_type::barrett, make_shared<ThreadPool>(3));
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            Decryptor threaded_decryptor(threaded_context, keygen.secret_key());
+
+            Plaintext plain("1x^3 + 2x^1 + 3");
+            if (parms.scheme() == scheme_type::ckks)
+            {
+                CKKSEncoder encoder(context);
+                encoder.encode(vector<double>{ 1.0, 2.0, 3.0 }, context.first_parms_id(), pow(2.0, 20), plain);
+            }
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+            Ciphertext squared;
+            evaluator.square(encrypted, squared);
+            for (const auto &ciphertext : { encrypted, squared })
+            {
+                Plaintext expected, result;
+                decryptor.decrypt(ciphertext, expected);
+                threaded_decryptor.decrypt(ciphertext, result);
+                ASSERT_TRUE(expected.parms_id() == result.parms_id());
+                ASSERT_TRUE(equal(expected.data(), expected.data() + expected.coeff_count(), result.data()));
+                if (parms.scheme() == scheme_type::bfv)
+                {
+                    ASSERT_EQ(
+                        decryptor.invariant_noise_budget(ciphertext),
+                        threaded_decryptor.invariant_noise_budget(ciphertext));
+                }
+            }
+        };
+
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(128);
+        parms.set_coeff_modulus(CoeffModulus::Create(128, { 40, 40, 40, 40 }));
+        parms.set_plain_modulus(257);
+        test(parms);
+
+        parms = EncryptionParameters(scheme_type::ckks);
+        parms.set_poly_modulus_degree(128);
+        parms.set_coeff_modulus(CoeffModulus::Create(128, { 40, 40, 40, 40 }));
+        test(parms);
+    }
 } // namespace sealtest
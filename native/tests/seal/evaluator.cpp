@@ -9,9 +9,12 @@
 #include "seal/evaluator.h"
 #include "seal/keygenerator.h"
 #include "seal/modulus.h"
+#include "seal/util/cpufeatures.h"
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <ctime>
+#include <memory>
 #include <string>
 #include "gtest/gtest.h"
 
@@ -3251,6 +3254,60 @@ namespace sealtest
         }
     }
 
+    TEST(EvaluatorTest, CKKSEncryptRotateVectorManyDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        size_t slot_size = 16;
+        parms.set_poly_modulus_degree(slot_size * 2);
+        parms.set_coeff_modulus(CoeffModulus::Create(slot_size * 2, { 40, 40, 40, 40 }));
+
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        GaloisKeys glk;
+        keygen.create_galois_keys(vector<int>{ 1, -1, 2, 4, -3 }, glk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        CKKSEncoder encoder(context);
+        const double delta = static_cast<double>(1ULL << 30);
+
+        vector<complex<double>> input(slot_size);
+        for (size_t i = 0; i < slot_size; i++)
+        {
+            input[i] = complex<double>(static_cast<double>(i), static_cast<double>(slot_size - i));
+        }
+
+        Plaintext plain;
+        Ciphertext encrypted;
+        encoder.encode(input, context.first_parms_id(), delta, plain);
+        encryptor.encrypt(plain, encrypted);
+
+        // Step 3 has no Galois key of its own and goes through the fallback
+        vector<int> steps{ 1, 2, 0, 4, -3, 3 };
+        vector<complex<double>> output(slot_size);
+        for (size_t level = 0; level < 2; level++)
+        {
+            vector<Ciphertext> rotated;
+            evaluator.rotate_vector_many(encrypted, steps, glk, rotated);
+            ASSERT_EQ(steps.size(), rotated.size());
+            for (size_t i = 0; i < steps.size(); i++)
+            {
+                ASSERT_EQ(encrypted.parms_id(), rotated[i].parms_id());
+                decryptor.decrypt(rotated[i], plain);
+                encoder.decode(plain, output);
+                size_t shift = static_cast<size_t>(steps[i] + static_cast<int>(slot_size)) % slot_size;
+                for (size_t j = 0; j < slot_size; j++)
+                {
+                    ASSERT_EQ(input[(j + shift) % slot_size].real(), round(output[j].real()));
+                    ASSERT_EQ(input[(j + shift) % slot_size].imag(), round(output[j].imag()));
+                }
+            }
+            evaluator.mod_switch_to_next_inplace(encrypted);
+        }
+    }
     TEST(EvaluatorTest, CKKSEncryptRescaleRotateDecrypt)
     {
         EncryptionParameters parms(scheme_type::ckks);
@@ -4067,6 +4124,89 @@ namespace sealtest
         batch_encoder.decode(plain, plain_vec);
         ASSERT_TRUE((plain_vec == vector<uint64_t>{ 2, 3, 4, 1, 6, 7, 8, 5 }));
     }
+    TEST(EvaluatorTest, BFVEncryptRotateRowsManyDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        Modulus plain_modulus(257);
+        parms.set_poly_modulus_degree(8);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus(CoeffModulus::Create(8, { 40, 40, 40, 40 }));
+
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        GaloisKeys glk;
+        keygen.create_galois_keys(glk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        BatchEncoder batch_encoder(context);
+
+        Plaintext plain;
+        vector<uint64_t> plain_vec{ 1, 2, 3, 4, 5, 6, 7, 8 };
+        batch_encoder.encode(plain_vec, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+
+        // Step 3 has no Galois key of its own and goes through the fallback
+        vector<int> steps{ 1, -1, 0, 2, 3, -2 };
+        auto check = [&](const Ciphertext &source) {
+            vector<Ciphertext> rotated;
+            evaluator.rotate_rows_many(source, steps, glk, rotated);
+            ASSERT_EQ(steps.size(), rotated.size());
+            for (size_t i = 0; i < steps.size(); i++)
+            {
+                Ciphertext expected;
+                evaluator.rotate_rows(source, steps[i], glk, expected);
+                ASSERT_EQ(expected.parms_id(), rotated[i].parms_id());
+
+                vector<uint64_t> expected_vec;
+                decryptor.decrypt(expected, plain);
+                batch_encoder.decode(plain, expected_vec);
+                decryptor.decrypt(rotated[i], plain);
+                batch_encoder.decode(plain, plain_vec);
+                ASSERT_TRUE(plain_vec == expected_vec);
+                ASSERT_TRUE(decryptor.invariant_noise_budget(rotated[i]) > 0);
+            }
+        };
+
+        check(encrypted);
+        evaluator.mod_switch_to_next_inplace(encrypted);
+        check(encrypted);
+
+        vector<Ciphertext> rotated;
+        evaluator.rotate_rows_many(encrypted, { 1 }, glk, rotated);
+        decryptor.decrypt(rotated[0], plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{ 2, 3, 4, 1, 6, 7, 8, 5 }));
+
+        // The source may alias a destination
+        evaluator.rotate_rows_many(rotated[0], { -1, 1 }, glk, rotated);
+        ASSERT_EQ(2, rotated.size());
+        decryptor.decrypt(rotated[0], plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{ 1, 2, 3, 4, 5, 6, 7, 8 }));
+        decryptor.decrypt(rotated[1], plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{ 3, 4, 1, 2, 7, 8, 5, 6 }));
+
+        // Views passed as destinations keep their buffers
+        vector<Ciphertext::ct_coeff_type> buffer(encrypted.dyn_array().size());
+        rotated.clear();
+        rotated.emplace_back(context, encrypted.parms_id(), 2, buffer.data(), buffer.size());
+        evaluator.rotate_rows_many(encrypted, { 1, -1 }, glk, rotated);
+        ASSERT_EQ(2, rotated.size());
+        ASSERT_TRUE(rotated[0].is_view());
+        ASSERT_EQ(buffer.data(), rotated[0].data());
+        decryptor.decrypt(rotated[0], plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{ 2, 3, 4, 1, 6, 7, 8, 5 }));
+
+        ASSERT_THROW(
+            evaluator.apply_galois_many(encrypted, vector<uint32_t>{ 2 }, glk, rotated), invalid_argument);
+    }
     TEST(EvaluatorTest, BFVEncryptModSwitchToNextDecrypt)
     {
         // The common parameters: the plaintext and the polynomial moduli
@@ -4297,4 +4437,591 @@ namespace sealtest
         ASSERT_TRUE(encrypted.parms_id() == parms_id);
         ASSERT_TRUE(plain.to_string() == "5x^64 + Ax^5");
     }
+
+    TEST(EvaluatorTest, BFVHybridKeySwitching)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        size_t poly_modulus_degree = 64;
+        parms.set_poly_modulus_degree(poly_modulus_degree);
+        parms.set_plain_modulus(PlainModulus::Batching(poly_modulus_degree, 20));
+        parms.set_coeff_modulus(CoeffModulus::Create(poly_modulus_degree, { 40, 40, 40, 40, 40, 40 }));
+
+        auto test = [&](size_t special_prime_count, size_t dnum) {
+            SEALContext context(parms, true, sec_level_type::none, special_prime_count, dnum);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            RelinKeys rlk;
+            keygen.create_relin_keys(rlk);
+            GaloisKeys glk;
+            keygen.create_galois_keys(vector<int>{ 1 }, glk);
+            ASSERT_EQ(context.dnum(), rlk.data()[0].size());
+            ASSERT_EQ(context.dnum(), glk.key(3).size());
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            BatchEncoder batch_encoder(context);
+            uint64_t t = parms.plain_modulus().value();
+
+            vector<uint64_t> values(batch_encoder.slot_count());
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                values[i] = (i * i + 7) % t;
+            }
+            Plaintext plain;
+            batch_encoder.encode(values, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+
+            size_t row_size = values.size() / 2;
+            vector<uint64_t> result;
+            while (true)
+            {
+                // A single 40-bit prime does not leave enough noise budget for a multiplication
+                if (encrypted.parms_id() != context.last_parms_id())
+                {
+                    Ciphertext squared;
+                    evaluator.square(encrypted, squared);
+                    evaluator.relinearize_inplace(squared, rlk);
+                    ASSERT_EQ(size_t(2), squared.size());
+                    decryptor.decrypt(squared, plain);
+                    batch_encoder.decode(plain, result);
+                    for (size_t i = 0; i < values.size(); i++)
+                    {
+                        ASSERT_EQ((values[i] * values[i]) % t, result[i]);
+                    }
+                }
+
+                Ciphertext rotated;
+                evaluator.rotate_rows(encrypted, 1, glk, rotated);
+                decryptor.decrypt(rotated, plain);
+                batch_encoder.decode(plain, result);
+                for (size_t i = 0; i < values.size(); i++)
+                {
+                    size_t row = i / row_size;
+                    ASSERT_EQ(values[row * row_size + (i + 1) % row_size], result[i]);
+                }
+
+                vector<Ciphertext> rotated_many;
+                evaluator.rotate_rows_many(encrypted, { 1 }, glk, rotated_many);
+                decryptor.decrypt(rotated_many[0], plain);
+                batch_encoder.decode(plain, result);
+                for (size_t i = 0; i < values.size(); i++)
+                {
+                    size_t row = i / row_size;
+                    ASSERT_EQ(values[row * row_size + (i + 1) % row_size], result[i]);
+                }
+
+                if (encrypted.parms_id() == context.last_parms_id())
+                {
+                    break;
+                }
+                evaluator.mod_switch_to_next_inplace(encrypted);
+            }
+        };
+
+        test(1, 0);
+        test(1, 2);
+        test(2, 0);
+        test(2, 1);
+        test(3, 2);
+    }
+
+    TEST(EvaluatorTest, CKKSHybridKeySwitching)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        size_t slot_size = 32;
+        parms.set_poly_modulus_degree(slot_size * 2);
+
+        // The special modulus must be at least as large as each digit to keep the key switching noise small
+        auto test = [&](size_t special_prime_count, size_t dnum) {
+            vector<int> bit_sizes{ 60, 40, 40, 40 };
+            bit_sizes.insert(bit_sizes.end(), special_prime_count, 60);
+            parms.set_coeff_modulus(CoeffModulus::Create(slot_size * 2, bit_sizes));
+            SEALContext context(parms, true, sec_level_type::none, special_prime_count, dnum);
+            KeyGenerator keygen(context);
+            PublicKey pk;
+            keygen.create_public_key(pk);
+            RelinKeys rlk;
+            keygen.create_relin_keys(rlk);
+            GaloisKeys glk;
+            keygen.create_galois_keys(vector<int>{ 1 }, glk);
+            ASSERT_EQ(context.dnum(), rlk.data()[0].size());
+
+            Encryptor encryptor(context, pk);
+            Evaluator evaluator(context);
+            Decryptor decryptor(context, keygen.secret_key());
+            CKKSEncoder encoder(context);
+            const double delta = static_cast<double>(1ULL << 40);
+
+            vector<complex<double>> input(slot_size);
+            for (size_t i = 0; i < slot_size; i++)
+            {
+                input[i] = complex<double>(static_cast<double>(i % 7) - 3.0, static_cast<double>(i % 5));
+            }
+            Plaintext plain;
+            encoder.encode(input, context.first_parms_id(), delta, plain);
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+
+            vector<complex<double>> output;
+            Ciphertext squared;
+            evaluator.square(encrypted, squared);
+            evaluator.relinearize_inplace(squared, rlk);
+            evaluator.rescale_to_next_inplace(squared);
+            decryptor.decrypt(squared, plain);
+            encoder.decode(plain, output);
+            for (size_t i = 0; i < slot_size; i++)
+            {
+                ASSERT_NEAR((input[i] * input[i]).real(), output[i].real(), 0.001);
+                ASSERT_NEAR((input[i] * input[i]).imag(), output[i].imag(), 0.001);
+            }
+
+            // Rotate at the first and at a lower level
+            for (auto &source : { encrypted, squared })
+            {
+                vector<complex<double>> expected(slot_size);
+                decryptor.decrypt(source, plain);
+                encoder.decode(plain, expected);
+
+                Ciphertext rotated;
+                evaluator.rotate_vector(source, 1, glk, rotated);
+                decryptor.decrypt(rotated, plain);
+                encoder.decode(plain, output);
+                for (size_t i = 0; i < slot_size; i++)
+                {
+                    ASSERT_NEAR(expected[(i + 1) % slot_size].real(), output[i].real(), 0.001);
+                    ASSERT_NEAR(expected[(i + 1) % slot_size].imag(), output[i].imag(), 0.001);
+                }
+            }
+        };
+
+        test(1, 0);
+        test(2, 0);
+        test(2, 2);
+        test(2, 3);
+        test(3, 1);
+    }
+
+    TEST(EvaluatorTest, BFVMontgomeryContext)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(4096);
+        parms.set_plain_modulus(PlainModulus::Batching(4096, 20));
+        parms.set_coeff_modulus(CoeffModulus::Create(4096, { 60, 60, 60 }));
+
+        SEALContext context(parms, true, sec_level_type::none, 1, 0, mod_arith_type::montgomery);
+        ASSERT_EQ(mod_arith_type::montgomery, context.mod_arith());
+
+        // The NTT keeps using Barrett reduction and the AVX2 kernels
+        auto &ntt_tables = context.first_context_data()->small_ntt_tables()[0];
+        ASSERT_EQ(util::cpu_has_avx2(), ntt_tables.use_avx2());
+
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        RelinKeys rlk;
+        keygen.create_relin_keys(rlk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        BatchEncoder encoder(context);
+
+        vector<uint64_t> values1(encoder.slot_count()), values2(encoder.slot_count());
+        for (size_t i = 0; i < encoder.slot_count(); i++)
+        {
+            values1[i] = i % 100;
+            values2[i] = (3 * i + 1) % 100;
+        }
+        Plaintext plain1, plain2, plain;
+        encoder.encode(values1, plain1);
+        encoder.encode(values2, plain2);
+        Ciphertext encrypted1, encrypted2;
+        encryptor.encrypt(plain1, encrypted1);
+        encryptor.encrypt(plain2, encrypted2);
+
+        evaluator.multiply_inplace(encrypted1, encrypted2);
+        evaluator.relinearize_inplace(encrypted1, rlk);
+        evaluator.multiply_plain_inplace(encrypted1, plain2);
+        evaluator.mod_switch_to_next_inplace(encrypted1);
+        decryptor.decrypt(encrypted1, plain);
+
+        vector<uint64_t> result;
+        encoder.decode(plain, result);
+        uint64_t t = parms.plain_modulus().value();
+        for (size_t i = 0; i < encoder.slot_count(); i++)
+        {
+            ASSERT_EQ(values1[i] * values2[i] % t * values2[i] % t, result[i]);
+        }
+    }
+
+    TEST(EvaluatorTest, CKKSMontgomeryContext)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        parms.set_poly_modulus_degree(1024);
+        // The 30-bit prime keeps Barrett reduction even in the Montgomery context
+        parms.set_coeff_modulus(CoeffModulus::Create(1024, { 60, 40, 30, 60 }));
+
+        SEALContext context(parms, true, sec_level_type::none);
+        SEALContext mont_context(parms, true, sec_level_type::none, 1, 0, mod_arith_type::montgomery);
+        ASSERT_EQ(mod_arith_type::barrett, context.mod_arith());
+        ASSERT_EQ(mod_arith_type::montgomery, mont_context.mod_arith());
+
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+
+        CKKSEncoder encoder(context);
+        Encryptor encryptor(context, pk);
+        Decryptor decryptor(context, keygen.secret_key());
+        Evaluator evaluator(context);
+        Evaluator mont_evaluator(mont_context);
+
+        size_t slot_count = encoder.slot_count();
+        vector<double> input1(slot_count), input2(slot_count);
+        for (size_t i = 0; i < slot_count; i++)
+        {
+            input1[i] = static_cast<double>(i % 7) - 3.0;
+            input2[i] = static_cast<double>(i % 5) + 0.5;
+        }
+        double scale = pow(2.0, 40);
+        Plaintext plain1, plain2;
+        encoder.encode(input1, scale, plain1);
+        encoder.encode(input2, scale, plain2);
+        Ciphertext encrypted1, encrypted2;
+        encryptor.encrypt(plain1, encrypted1);
+        encryptor.encrypt(plain2, encrypted2);
+
+        // Both contexts share the parms_id, so the results of the two evaluators must agree exactly
+        auto check_equal = [](const Ciphertext &expected, const Ciphertext &actual) {
+            ASSERT_EQ(expected.size(), actual.size());
+            ASSERT_TRUE(equal(expected.data(), expected.data() + expected.dyn_array().size(), actual.data()));
+        };
+
+        Ciphertext product, mont_product;
+        evaluator.multiply(encrypted1, encrypted2, product);
+        mont_evaluator.multiply(encrypted1, encrypted2, mont_product);
+        check_equal(product, mont_product);
+
+        // A size-3 operand takes the generic multiplication path
+        Ciphertext cube, mont_cube;
+        evaluator.multiply(product, encrypted1, cube);
+        mont_evaluator.multiply(mont_product, encrypted1, mont_cube);
+        check_equal(cube, mont_cube);
+
+        Ciphertext square, mont_square;
+        evaluator.square(encrypted1, square);
+        mont_evaluator.square(encrypted1, mont_square);
+        check_equal(square, mont_square);
+
+        Ciphertext plain_product, mont_plain_product;
+        evaluator.multiply_plain(encrypted1, plain2, plain_product);
+        mont_evaluator.multiply_plain(encrypted1, plain2, mont_plain_product);
+        check_equal(plain_product, mont_plain_product);
+
+        Plaintext plain;
+        vector<double> output;
+        decryptor.decrypt(mont_plain_product, plain);
+        encoder.decode(plain, output);
+        for (size_t i = 0; i < slot_count; i++)
+        {
+            ASSERT_NEAR(input1[i] * input2[i], output[i], 0.001);
+        }
+    }
+
+    TEST(EvaluatorTest, BFVThreadPool)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(1024);
+        parms.set_plain_modulus(PlainModulus::Batching(1024, 20));
+        parms.set_coeff_modulus(CoeffModulus::Create(1024, { 30, 30, 30, 30, 30, 30 }));
+
+        SEALContext context(parms, true, sec_level_type::none, 2);
+        SEALContext threaded_context(
+            parms, true, sec_level_type::none, 2, 0, mod_arith_type::barrett, make_shared<ThreadPool>(4));
+        ASSERT_FALSE(context.thread_pool());
+        ASSERT_EQ(size_t(4), threaded_context.thread_pool()->thread_count());
+
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        RelinKeys rlk;
+        keygen.create_relin_keys(rlk);
+        GaloisKeys glk;
+        keygen.create_galois_keys(vector<int>{ 1, 2 }, glk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Evaluator threaded_evaluator(threaded_context);
+        BatchEncoder encoder(context);
+
+        vector<uint64_t> values(encoder.slot_count());
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            values[i] = (i * 7 + 3) % 1000;
+        }
+        Plaintext plain;
+        encoder.encode(values, plain);
+        Ciphertext encrypted1, encrypted2;
+        encryptor.encrypt(plain, encrypted1);
+        encryptor.encrypt(plain, encrypted2);
+
+        auto same_data = [](const Ciphertext &a, const Ciphertext &b) {
+            return a.parms_id() == b.parms_id() && a.size() == b.size() &&
+                   equal(a.data(), a.data() + a.dyn_array().size(), b.data());
+        };
+
+        // The results must not depend on the ThreadPool or on the thread-safety of the memory pool
+        for (auto pool : { MemoryPoolHandle::New(), MemoryPoolHandle::ThreadLocal() })
+        {
+            Ciphertext expected, result;
+            evaluator.multiply(encrypted1, encrypted2, expected);
+            threaded_evaluator.multiply(encrypted1, encrypted2, result, pool);
+            ASSERT_TRUE(same_data(expected, result));
+
+            Ciphertext expected3, result3;
+            evaluator.multiply(expected, encrypted2, expected3);
+            threaded_evaluator.multiply(result, encrypted2, result3, pool);
+            ASSERT_TRUE(same_data(expected3, result3));
+
+            evaluator.relinearize_inplace(expected, rlk);
+            threaded_evaluator.relinearize_inplace(result, rlk, pool);
+            ASSERT_TRUE(same_data(expected, result));
+
+            evaluator.square(encrypted1, expected);
+            threaded_evaluator.square(encrypted1, result, pool);
+            ASSERT_TRUE(same_data(expected, result));
+
+            evaluator.multiply_plain(encrypted1, plain, expected);
+            threaded_evaluator.multiply_plain(encrypted1, plain, result, pool);
+            ASSERT_TRUE(same_data(expected, result));
+
+            evaluator.rotate_rows(encrypted1, 1, glk, expected);
+            threaded_evaluator.rotate_rows(encrypted1, 1, glk, result, pool);
+            ASSERT_TRUE(same_data(expected, result));
+
+            vector<Ciphertext> expected_many, result_many;
+            evaluator.rotate_rows_many(encrypted1, { 1, 2 }, glk, expected_many);
+            threaded_evaluator.rotate_rows_many(encrypted1, { 1, 2 }, glk, result_many, pool);
+            ASSERT_TRUE(same_data(expected_many[0], result_many[0]));
+            ASSERT_TRUE(same_data(expected_many[1], result_many[1]));
+
+            evaluator.transform_to_ntt(encrypted1, expected);
+            threaded_evaluator.transform_to_ntt(encrypted1, result);
+            ASSERT_TRUE(same_data(expected, result));
+            threaded_evaluator.transform_from_ntt_inplace(result);
+            ASSERT_TRUE(same_data(encrypted1, result));
+        }
+    }
+
+    TEST(EvaluatorTest, CKKSThreadPool)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        size_t slot_size = 512;
+        parms.set_poly_modulus_degree(slot_size * 2);
+        parms.set_coeff_modulus(CoeffModulus::Create(slot_size * 2, { 50, 40, 40, 40, 50 }));
+
+        SEALContext context(parms, true, sec_level_type::none);
+        SEALContext threaded_context(
+            parms, true, sec_level_type::none, 1, 0, mod_arith_type::barrett, make_shared<ThreadPool>(3));
+
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        RelinKeys rlk;
+        keygen.create_relin_keys(rlk);
+        GaloisKeys glk;
+        keygen.create_galois_keys(vector<int>{ 1 }, glk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Evaluator threaded_evaluator(threaded_context);
+        CKKSEncoder encoder(context);
+
+        vector<double> input(slot_size);
+        for (size_t i = 0; i < slot_size; i++)
+        {
+            input[i] = static_cast<double>(i % 17) - 8.0;
+        }
+        Plaintext plain;
+        encoder.encode(input, pow(2.0, 40), plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+
+        auto same_data = [](const Ciphertext &a, const Ciphertext &b) {
+            return a.parms_id() == b.parms_id() && a.size() == b.size() &&
+                   equal(a.data(), a.data() + a.dyn_array().size(), b.data());
+        };
+
+        Ciphertext expected, result;
+        evaluator.multiply(encrypted, encrypted, expected);
+        threaded_evaluator.multiply(encrypted, encrypted, result);
+        ASSERT_TRUE(same_data(expected, result));
+
+        evaluator.relinearize_inplace(expected, rlk);
+        threaded_evaluator.relinearize_inplace(result, rlk);
+        ASSERT_TRUE(same_data(expected, result));
+
+        evaluator.rotate_vector(encrypted, 1, glk, expected);
+        threaded_evaluator.rotate_vector(encrypted, 1, glk, result);
+        ASSERT_TRUE(same_data(expected, result));
+
+        evaluator.multiply_plain(encrypted, plain, expected);
+        threaded_evaluator.multiply_plain(encrypted, plain, result);
+        ASSERT_TRUE(same_data(expected, result));
+    }
+
+    TEST(EvaluatorTest, BFVEvaluatorWorkspace)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(1024);
+        parms.set_plain_modulus(PlainModulus::Batching(1024, 20));
+        parms.set_coeff_modulus(CoeffModulus::Create(1024, { 30, 30, 30, 30, 30, 30 }));
+
+        SEALContext context(parms, true, sec_level_type::none, 2);
+        SEALContext threaded_context(
+            parms, true, sec_level_type::none, 2, 0, mod_arith_type::barrett, make_shared<ThreadPool>(2));
+
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        RelinKeys rlk;
+        keygen.create_relin_keys(rlk);
+        GaloisKeys glk;
+        keygen.create_galois_keys(vector<int>{ 1 }, glk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        Evaluator threaded_evaluator(threaded_context);
+        BatchEncoder encoder(context);
+
+        vector<uint64_t> values(encoder.slot_count());
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            values[i] = (i * 5 + 1) % 1000;
+        }
+        Plaintext plain;
+        encoder.encode(values, plain);
+        Ciphertext encrypted1, encrypted2;
+        encryptor.encrypt(plain, encrypted1);
+        encryptor.encrypt(plain, encrypted2);
+
+        auto same_data = [](const Ciphertext &a, const Ciphertext &b) {
+            return a.parms_id() == b.parms_id() && a.size() == b.size() &&
+                   equal(a.data(), a.data() + a.dyn_array().size(), b.data());
+        };
+
+        EvaluatorWorkspace workspace(context);
+        MemoryPoolHandle pool = workspace.pool();
+        ASSERT_LT(size_t(0), pool.alloc_byte_count());
+
+        // The results must not depend on the memory pool; the outputs are allocated from the global memory pool
+        Ciphertext expected, result;
+        uint64_t total_alloc_count = 0;
+        for (int round = 0; round < 3; round++)
+        {
+            for (auto *eval : { &evaluator, &threaded_evaluator })
+            {
+                evaluator.multiply(encrypted1, encrypted2, expected);
+                eval->multiply(encrypted1, encrypted2, result, workspace);
+                ASSERT_TRUE(same_data(expected, result));
+
+                evaluator.relinearize_inplace(expected, rlk);
+                eval->relinearize_inplace(result, rlk, workspace);
+                ASSERT_TRUE(same_data(expected, result));
+
+                evaluator.square(encrypted1, expected);
+                eval->square(encrypted1, result, workspace);
+                ASSERT_TRUE(same_data(expected, result));
+
+                evaluator.rotate_rows(encrypted1, 1, glk, expected);
+                eval->rotate_rows(encrypted1, 1, glk, result, workspace);
+                ASSERT_TRUE(same_data(expected, result));
+
+                evaluator.mod_switch_to_next(encrypted1, expected);
+                eval->mod_switch_to_next(encrypted1, result, workspace);
+                ASSERT_TRUE(same_data(expected, result));
+            }
+
+            // All temporaries were released and the workspace stops growing after the first round
+            auto stats = pool.stats();
+            ASSERT_EQ(size_t(1), stats.size());
+            ASSERT_EQ(size_t(0), stats[0].live_item_count);
+            ASSERT_EQ(size_t(0), stats[0].free_item_count);
+            if (round > 1)
+            {
+                ASSERT_EQ(total_alloc_count, stats[0].total_alloc_count);
+                ASSERT_EQ(size_t(1), stats[0].alloc_count);
+            }
+            total_alloc_count = stats[0].total_alloc_count;
+        }
+
+        // A ciphertext allocated from the workspace keeps its memory reserved until it is destroyed
+        {
+            Ciphertext escaped(pool);
+            evaluator.multiply(encrypted1, encrypted2, escaped, workspace);
+            ASSERT_LT(size_t(0), pool.stats()[0].live_item_count);
+            evaluator.multiply(encrypted1, encrypted2, expected);
+            ASSERT_TRUE(same_data(expected, escaped));
+        }
+        ASSERT_EQ(size_t(0), pool.stats()[0].live_item_count);
+    }
+
+    TEST(EvaluatorTest, CKKSEvaluatorWorkspace)
+    {
+        EncryptionParameters parms(scheme_type::ckks);
+        size_t slot_size = 512;
+        parms.set_poly_modulus_degree(slot_size * 2);
+        parms.set_coeff_modulus(CoeffModulus::Create(slot_size * 2, { 50, 40, 40, 40, 50 }));
+
+        SEALContext context(parms, true, sec_level_type::none);
+
+        KeyGenerator keygen(context);
+        PublicKey pk;
+        keygen.create_public_key(pk);
+        RelinKeys rlk;
+        keygen.create_relin_keys(rlk);
+        GaloisKeys glk;
+        keygen.create_galois_keys(vector<int>{ 1 }, glk);
+
+        Encryptor encryptor(context, pk);
+        Evaluator evaluator(context);
+        CKKSEncoder encoder(context);
+
+        vector<double> input(slot_size);
+        for (size_t i = 0; i < slot_size; i++)
+        {
+            input[i] = static_cast<double>(i % 13) - 6.0;
+        }
+        Plaintext plain;
+        encoder.encode(input, pow(2.0, 40), plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+
+        auto same_data = [](const Ciphertext &a, const Ciphertext &b) {
+            return a.parms_id() == b.parms_id() && a.size() == b.size() &&
+                   equal(a.data(), a.data() + a.dyn_array().size(), b.data());
+        };
+
+        EvaluatorWorkspace workspace(context);
+        Ciphertext expected, result;
+        evaluator.multiply(encrypted, encrypted, expected);
+        evaluator.multiply(encrypted, encrypted, result, workspace);
+        ASSERT_TRUE(same_data(expected, result));
+
+        evaluator.relinearize_inplace(expected, rlk);
+        evaluator.relinearize_inplace(result, rlk, workspace);
+        ASSERT_TRUE(same_data(expected, result));
+
+        evaluator.rescale_to_next_inplace(expected);
+        evaluator.rescale_to_next_inplace(result, workspace);
+        ASSERT_TRUE(same_data(expected, result));
+
+        evaluator.rotate_vector(encrypted, 1, glk, expected);
+        evaluator.rotate_vector(encrypted, 1, glk, result, workspace);
+        ASSERT_TRUE(same_data(expected, result));
+        ASSERT_EQ(size_t(0), workspace.pool().stats()[0].live_item_count);
+    }
 } // namespace sealtest
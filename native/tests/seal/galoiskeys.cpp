@@ -1,12 +1,19 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT license.
 
+#include "seal/batchencoder.h"
 #include "seal/context.h"
+#include "seal/encryptor.h"
+#include "seal/evaluator.h"
 #include "seal/galoiskeys.h"
 #include "seal/keygenerator.h"
 #include "seal/modulus.h"
 #include "seal/util/polyarithsmallmod.h"
 #include "seal/util/uintcore.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
 #include <vector>
 #include "gtest/gtest.h"
 
@@ -203,4 +210,230 @@ namespace sealtest
             compare_kswitchkeys(keys, test_keys, secret_key, context);
         }
     }
+
+    TEST(GaloisKeysTest, GaloisKeysSaveLoadMapped)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(257);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 60, 60 }));
+        SEALContext context(parms, false, sec_level_type::none);
+        KeyGenerator keygen(context);
+        string path = ::testing::TempDir() + "galoiskeys_mapped.bin";
+
+        GaloisKeys keys;
+        GaloisKeys test_keys;
+        {
+            ofstream stream(path, ios_base::binary);
+            keys.save_mapped(stream);
+        }
+
+        // Like load, load_mapped rejects keys that are not for the key level
+        ASSERT_THROW(test_keys.load_mapped(context, path), logic_error);
+        ASSERT_FALSE(test_keys.is_mapped());
+
+        keygen.create_galois_keys(keys);
+        {
+            ofstream stream(path, ios_base::binary);
+            auto out_size = keys.save_mapped(stream);
+            ASSERT_EQ(out_size, static_cast<streamoff>(stream.tellp()));
+        }
+        test_keys.load_mapped(context, path);
+        ASSERT_TRUE(test_keys.is_mapped());
+        ASSERT_FALSE(keys.is_mapped());
+        ASSERT_TRUE(is_valid_for(test_keys, context));
+        ASSERT_EQ(keys.data().size(), test_keys.data().size());
+        ASSERT_TRUE(keys.parms_id() == test_keys.parms_id());
+        for (size_t j = 0; j < test_keys.data().size(); j++)
+        {
+            ASSERT_EQ(keys.data()[j].size(), test_keys.data()[j].size());
+            for (size_t i = 0; i < test_keys.data()[j].size(); i++)
+            {
+                auto &key = keys.data()[j][i].data();
+                auto &test_key = test_keys.data()[j][i].data();
+                ASSERT_TRUE(test_key.is_view());
+                ASSERT_EQ(0ULL, reinterpret_cast<uintptr_t>(test_key.data()) % 64);
+                ASSERT_TRUE(key.parms_id() == test_key.parms_id());
+                ASSERT_EQ(key.is_ntt_form(), test_key.is_ntt_form());
+                ASSERT_EQ(key.dyn_array().size(), test_key.dyn_array().size());
+                ASSERT_TRUE(is_equal_uint(key.data(), test_key.data(), key.dyn_array().size()));
+            }
+        }
+
+        // The mapped keys rotate exactly like the original ones
+        BatchEncoder encoder(context);
+        Encryptor encryptor(context, keygen.secret_key());
+        Evaluator evaluator(context);
+        vector<uint64_t> values(encoder.slot_count());
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            values[i] = i;
+        }
+        Plaintext plain;
+        encoder.encode(values, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt_symmetric(plain, encrypted);
+        Ciphertext expected;
+        Ciphertext rotated;
+        evaluator.rotate_rows(encrypted, 3, keys, expected);
+        evaluator.rotate_rows(encrypted, 3, test_keys, rotated);
+        ASSERT_EQ(expected.dyn_array().size(), rotated.dyn_array().size());
+        ASSERT_TRUE(is_equal_uint(expected.data(), rotated.data(), expected.dyn_array().size()));
+
+        // Copies own their data and keep working after the mapping is released
+        GaloisKeys copied_keys(test_keys);
+        ASSERT_FALSE(copied_keys.is_mapped());
+        for (auto &key_dim1 : copied_keys.data())
+        {
+            for (auto &key : key_dim1)
+            {
+                ASSERT_FALSE(key.data().is_view());
+            }
+        }
+        test_keys = GaloisKeys();
+        ASSERT_FALSE(test_keys.is_mapped());
+        evaluator.rotate_rows(encrypted, 3, copied_keys, rotated);
+        ASSERT_TRUE(is_equal_uint(expected.data(), rotated.data(), expected.dyn_array().size()));
+
+        // Files in another format are rejected
+        {
+            ofstream stream(path, ios_base::binary);
+            keys.save(stream, compr_mode_type::none);
+        }
+        ASSERT_THROW(test_keys.load_mapped(context, path), logic_error);
+        {
+            ofstream stream(path, ios_base::binary);
+        }
+        ASSERT_THROW(test_keys.load_mapped(context, path), logic_error);
+        remove(path.c_str());
+        ASSERT_THROW(test_keys.load_mapped(context, path), runtime_error);
+    }
+
+    TEST(GaloisKeysTest, GaloisKeysLoadIndexed)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(257);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 60, 60 }));
+        SEALContext context(parms, false, sec_level_type::none);
+        KeyGenerator keygen(context);
+        string path = ::testing::TempDir() + "galoiskeys_indexed.bin";
+
+        GaloisKeys keys;
+        keygen.create_galois_keys(keys);
+        {
+            ofstream stream(path, ios_base::binary);
+            keys.save_mapped(stream);
+        }
+
+        // Only the table of keys is read when loading
+        GaloisKeys test_keys;
+        test_keys.load_indexed(context, path, 1);
+        ASSERT_TRUE(test_keys.is_indexed());
+        ASSERT_FALSE(test_keys.is_mapped());
+        ASSERT_TRUE(keys.parms_id() == test_keys.parms_id());
+        ASSERT_EQ(keys.size(), test_keys.size());
+        ASSERT_TRUE(test_keys.data().empty());
+        ASSERT_EQ(keys.data().size(), test_keys.index_count());
+        ASSERT_EQ(0ULL, test_keys.resident_byte_count());
+        ASSERT_TRUE(test_keys.has_key(3));
+        ASSERT_FALSE(test_keys.has_key(5));
+        ASSERT_THROW(auto key = test_keys.acquire_key(5), invalid_argument);
+        ASSERT_THROW((void)test_keys.key(3), logic_error);
+
+        // Acquired keys are equal to the saved ones
+        auto key = test_keys.acquire_key(3);
+        size_t key_byte_count = test_keys.resident_byte_count();
+        ASSERT_NE(0ULL, key_byte_count);
+        ASSERT_EQ(keys.key(3).size(), key->size());
+        for (size_t i = 0; i < key->size(); i++)
+        {
+            auto &expected_key = keys.key(3)[i].data();
+            auto &test_key = (*key)[i].data();
+            ASSERT_TRUE(expected_key.parms_id() == test_key.parms_id());
+            ASSERT_EQ(expected_key.dyn_array().size(), test_key.dyn_array().size());
+            ASSERT_TRUE(is_equal_uint(expected_key.data(), test_key.data(), expected_key.dyn_array().size()));
+        }
+
+        // Evicted keys stay alive while they are held
+        auto other_key = test_keys.acquire_key(9);
+        ASSERT_EQ(key_byte_count, test_keys.resident_byte_count());
+        ASSERT_EQ(keys.key(3).size(), key->size());
+        key.reset();
+        other_key.reset();
+
+        // The indexed keys rotate exactly like the original ones
+        BatchEncoder encoder(context);
+        Encryptor encryptor(context, keygen.secret_key());
+        Evaluator evaluator(context);
+        vector<uint64_t> values(encoder.slot_count());
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            values[i] = i;
+        }
+        Plaintext plain;
+        encoder.encode(values, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt_symmetric(plain, encrypted);
+        Ciphertext expected;
+        Ciphertext rotated;
+        for (int steps : { 1, 3, -2, 1 })
+        {
+            evaluator.rotate_rows(encrypted, steps, keys, expected);
+            evaluator.rotate_rows(encrypted, steps, test_keys, rotated);
+            ASSERT_TRUE(is_equal_uint(expected.data(), rotated.data(), expected.dyn_array().size()));
+            ASSERT_EQ(key_byte_count, test_keys.resident_byte_count());
+        }
+        evaluator.rotate_columns(encrypted, keys, expected);
+        evaluator.rotate_columns(encrypted, test_keys, rotated);
+        ASSERT_TRUE(is_equal_uint(expected.data(), rotated.data(), expected.dyn_array().size()));
+
+        // Copies share the resident keys; indexed keys cannot be saved
+        GaloisKeys copied_keys(test_keys);
+        ASSERT_TRUE(copied_keys.is_indexed());
+        ASSERT_EQ(key_byte_count, copied_keys.resident_byte_count());
+        stringstream stream;
+        ASSERT_THROW(copied_keys.save(stream), logic_error);
+        ASSERT_THROW(copied_keys.save_mapped(stream), logic_error);
+
+        // Loading replaces the index
+        keys.save(stream);
+        copied_keys.load(context, stream);
+        ASSERT_FALSE(copied_keys.is_indexed());
+        ASSERT_EQ(0ULL, copied_keys.resident_byte_count());
+
+        // Without a bound all keys that were read stay resident
+        test_keys.load_indexed(context, path);
+        evaluator.rotate_rows(encrypted, 1, test_keys, rotated);
+        evaluator.rotate_rows(encrypted, 2, test_keys, rotated);
+        ASSERT_EQ(2 * key_byte_count, test_keys.resident_byte_count());
+
+        // Keys are read from the file whose table was loaded even if the path is replaced; only where an open file
+        // can be removed
+        if (!remove(path.c_str()))
+        {
+            {
+                ofstream file_stream(path, ios_base::binary);
+                keys.save(file_stream, compr_mode_type::none);
+            }
+            uint32_t galois_elt = static_cast<uint32_t>(2 * parms.poly_modulus_degree() - 1);
+            auto replaced_key = test_keys.acquire_key(galois_elt);
+            ASSERT_EQ(keys.key(galois_elt).size(), replaced_key->size());
+            for (size_t i = 0; i < replaced_key->size(); i++)
+            {
+                auto &expected_key = keys.key(galois_elt)[i].data();
+                auto &test_key = (*replaced_key)[i].data();
+                ASSERT_TRUE(is_equal_uint(expected_key.data(), test_key.data(), expected_key.dyn_array().size()));
+            }
+        }
+
+        // Files in another format are rejected
+        {
+            ofstream file_stream(path, ios_base::binary);
+            keys.save(file_stream, compr_mode_type::none);
+        }
+        ASSERT_THROW(test_keys.load_indexed(context, path), logic_error);
+        remove(path.c_str());
+        ASSERT_THROW(test_keys.load_indexed(context, path), runtime_error);
+    }
 } // namespace sealtest
@@ -1,12 +1,17 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT license.
 
+#include "seal/batchencoder.h"
 #include "seal/context.h"
 #include "seal/decryptor.h"
 #include "seal/encryptor.h"
 #include "seal/evaluator.h"
 #include "seal/keygenerator.h"
+#include "seal/threadpool.h"
 #include "seal/valcheck.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
 #include "gtest/gtest.h"
 
 using namespace seal;
@@ -366,4 +371,98 @@ namespace sealtest
             ASSERT_NE(pk3.data().data()[i], pk2.data().data()[i]);
         }
     }
+
+    TEST(KeyGeneratorTest, ParallelKeyGeneration)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(65537);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 40, 40, 40, 40 }));
+        parms.set_random_generator(make_shared<Blake2xbPRNGFactory>(prng_seed_type{ 1, 2, 3 }));
+        SEALContext context(parms, true, sec_level_type::none);
+        KeyGenerator keygen(context);
+
+        auto is_equal_key = [](const PublicKey &a, const PublicKey &b) {
+            auto &a_data = a.data().dyn_array();
+            auto &b_data = b.data().dyn_array();
+            return a_data.size() == b_data.size() && equal(a_data.cbegin(), a_data.cend(), b_data.cbegin());
+        };
+        auto is_equal_keys = [&](const KSwitchKeys &a, const KSwitchKeys &b) {
+            if (a.data().size() != b.data().size())
+            {
+                return false;
+            }
+            for (size_t i = 0; i < a.data().size(); i++)
+            {
+                if (a.data()[i].size() != b.data()[i].size())
+                {
+                    return false;
+                }
+                for (size_t j = 0; j < a.data()[i].size(); j++)
+                {
+                    if (!is_equal_key(a.data()[i][j], b.data()[i][j]))
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        };
+
+        RelinKeys rlk;
+        keygen.create_relin_keys(rlk);
+        GaloisKeys galk;
+        keygen.create_galois_keys(galk);
+
+        // Every component samples its own randomness
+        ASSERT_FALSE(is_equal_key(galk.key(3)[0], galk.key(3)[1]));
+        ASSERT_FALSE(is_equal_key(galk.key(3)[0], galk.key(9)[0]));
+
+        // With a fixed seed the keys do not depend on the number of threads
+        SEALContext parallel_context(
+            parms, true, sec_level_type::none, 1, 0, mod_arith_type::barrett, make_shared<ThreadPool>(4));
+        KeyGenerator parallel_keygen(parallel_context, keygen.secret_key());
+        RelinKeys parallel_rlk;
+        parallel_keygen.create_relin_keys(parallel_rlk);
+        GaloisKeys parallel_galk;
+        parallel_keygen.create_galois_keys(parallel_galk);
+        ASSERT_TRUE(is_equal_keys(rlk, parallel_rlk));
+        ASSERT_TRUE(is_equal_keys(galk, parallel_galk));
+
+        // Repeated Galois elements yield one key
+        GaloisKeys repeated_galk;
+        parallel_keygen.create_galois_keys(vector<uint32_t>{ 3, 5, 3 }, repeated_galk);
+        ASSERT_EQ(size_t(2), repeated_galk.size());
+        ASSERT_THROW(parallel_keygen.create_galois_keys(vector<uint32_t>{ 3, 4 }, repeated_galk), invalid_argument);
+
+        // The keys generated in parallel rotate and relinearize correctly
+        BatchEncoder encoder(context);
+        PublicKey pk;
+        parallel_keygen.create_public_key(pk);
+        Encryptor encryptor(context, pk);
+        Decryptor decryptor(context, keygen.secret_key());
+        Evaluator evaluator(context);
+        vector<uint64_t> values(encoder.slot_count());
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            values[i] = i;
+        }
+        Plaintext plain;
+        encoder.encode(values, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+        evaluator.rotate_rows_inplace(encrypted, 1, parallel_galk);
+        evaluator.square_inplace(encrypted);
+        evaluator.relinearize_inplace(encrypted, parallel_rlk);
+        decryptor.decrypt(encrypted, plain);
+        vector<uint64_t> result;
+        encoder.decode(plain, result);
+        size_t row_size = values.size() / 2;
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            size_t row_begin = i / row_size * row_size;
+            uint64_t value = values[row_begin + (i + 1) % row_size];
+            ASSERT_EQ(value * value % 65537, result[i]);
+        }
+    }
 } // namespace sealtest
@@ -67,4 +67,172 @@ namespace sealtest
         }
         ASSERT_EQ(1L, pool.use_count());
     }
+
+    TEST(MemoryPoolHandleTest, Stats)
+    {
+        MemoryPoolHandle pool;
+        ASSERT_TRUE(pool.stats().empty());
+
+        pool = MemoryPoolHandle::New();
+        ASSERT_TRUE(pool.stats().empty());
+        {
+            auto ptr1(allocate_uint(5, pool));
+            auto ptr2(allocate_uint(5, pool));
+            auto ptr3(allocate_uint(5, pool));
+            auto ptr4(allocate_uint(2, pool));
+            auto stats = pool.stats();
+            ASSERT_EQ(2ULL, stats.size());
+            ASSERT_EQ(5ULL * bytes_per_uint64, stats[0].item_byte_count);
+            ASSERT_EQ(3ULL, stats[0].item_count);
+            ASSERT_EQ(3ULL, stats[0].live_item_count);
+            ASSERT_EQ(0ULL, stats[0].free_item_count);
+            ASSERT_EQ(15ULL * bytes_per_uint64, stats[0].peak_byte_count);
+            ASSERT_EQ(2ULL, stats[0].alloc_count);
+            ASSERT_EQ(2ULL, stats[0].total_alloc_count);
+            ASSERT_EQ(2ULL * bytes_per_uint64, stats[1].item_byte_count);
+            ASSERT_EQ(1ULL, stats[1].live_item_count);
+
+            ptr1.release();
+            ptr2.release();
+            stats = pool.stats();
+            ASSERT_EQ(1ULL, stats[0].live_item_count);
+            ASSERT_EQ(2ULL, stats[0].free_item_count);
+        }
+        auto stats = pool.stats();
+        ASSERT_EQ(0ULL, stats[0].live_item_count);
+        ASSERT_EQ(3ULL, stats[0].free_item_count);
+        ASSERT_EQ(0ULL, stats[1].live_item_count);
+        ASSERT_EQ(1ULL, stats[1].free_item_count);
+    }
+
+    TEST(MemoryPoolHandleTest, ReleaseUnused)
+    {
+        MemoryPoolHandle pool;
+        ASSERT_EQ(0ULL, pool.release_unused());
+
+        pool = MemoryPoolHandle::New();
+        {
+            // The first item is in an allocation of its own; the other two share one
+            auto ptr1(allocate_uint(5, pool));
+            auto ptr2(allocate_uint(5, pool));
+            auto ptr3(allocate_uint(5, pool));
+            ASSERT_EQ(15ULL * bytes_per_uint64, pool.alloc_byte_count());
+            ASSERT_EQ(0ULL, pool.release_unused());
+
+            // Only the second allocation still has an item in use
+            ptr1.release();
+            ptr2.release();
+            ASSERT_EQ(5ULL * bytes_per_uint64, pool.release_unused());
+            ASSERT_EQ(10ULL * bytes_per_uint64, pool.alloc_byte_count());
+            auto stats = pool.stats();
+            ASSERT_EQ(1ULL, stats[0].alloc_count);
+            ASSERT_EQ(1ULL, stats[0].live_item_count);
+            ASSERT_EQ(1ULL, stats[0].free_item_count);
+            ASSERT_EQ(15ULL * bytes_per_uint64, stats[0].peak_byte_count);
+
+            // The free item is reused
+            ptr1 = allocate_uint(5, pool);
+            ASSERT_EQ(10ULL * bytes_per_uint64, pool.alloc_byte_count());
+        }
+        ASSERT_EQ(10ULL * bytes_per_uint64, pool.release_unused());
+        ASSERT_EQ(0ULL, pool.alloc_byte_count());
+        ASSERT_EQ(1ULL, pool.pool_count());
+
+        // The pool remains usable
+        {
+            auto ptr(allocate_uint(5, pool));
+            set_zero_uint(5, ptr.get());
+            ASSERT_EQ(5ULL * bytes_per_uint64, pool.alloc_byte_count());
+            ASSERT_EQ(3ULL, pool.stats()[0].total_alloc_count);
+        }
+    }
+
+    TEST(MemoryPoolHandleTest, ByteCountLimit)
+    {
+        MemoryPoolHandle pool;
+        ASSERT_EQ(0ULL, pool.byte_count_limit());
+        ASSERT_THROW(pool.set_byte_count_limit(1), logic_error);
+
+        pool = MemoryPoolHandle::New();
+        pool.set_byte_count_limit(10 * bytes_per_uint64);
+        ASSERT_EQ(10ULL * bytes_per_uint64, pool.byte_count_limit());
+        {
+            auto ptr(allocate_uint(5, pool));
+        }
+        ASSERT_EQ(5ULL * bytes_per_uint64, pool.alloc_byte_count());
+
+        // Exceeding the limit releases the unused allocation of 5 words
+        auto ptr(allocate_uint(8, pool));
+        ASSERT_EQ(8ULL * bytes_per_uint64, pool.alloc_byte_count());
+
+        // Memory in use is kept even if it exceeds the limit
+        auto ptr2(allocate_uint(8, pool));
+        ASSERT_EQ(24ULL * bytes_per_uint64, pool.alloc_byte_count());
+
+        pool.set_byte_count_limit(0);
+        ptr2.release();
+        auto ptr3(allocate_uint(5, pool));
+        ASSERT_EQ(29ULL * bytes_per_uint64, pool.alloc_byte_count());
+    }
+
+    TEST(MemoryPoolHandleTest, AllocPolicy)
+    {
+        ASSERT_THROW(auto pool = MemoryPoolHandle::New(false, MemoryPoolAllocPolicy{ false, -2, 0 }), invalid_argument);
+        ASSERT_THROW((void)MemoryPoolHandle().alloc_policy(), logic_error);
+
+        auto test = [](bool clear_on_destruction, const MemoryPoolAllocPolicy &alloc_policy) {
+            MemoryPoolHandle pool = MemoryPoolHandle::New(clear_on_destruction, alloc_policy);
+            ASSERT_EQ(alloc_policy.huge_pages, pool.alloc_policy().huge_pages);
+            ASSERT_EQ(alloc_policy.numa_node, pool.alloc_policy().numa_node);
+
+            // One allocation below and several above the 64 KB threshold
+            const size_t large_count = size_t(3) << 17;
+            {
+                auto small(allocate_uint(8, pool));
+                auto large1(allocate_uint(large_count, pool));
+                auto large2(allocate_uint(large_count, pool));
+                set_zero_uint(8, small.get());
+                for (size_t i = 0; i < large_count; i++)
+                {
+                    large1[i] = i;
+                    large2[i] = ~i;
+                }
+                for (size_t i = 0; i < large_count; i++)
+                {
+                    ASSERT_EQ(i, large1[i]);
+                    ASSERT_EQ(~i, large2[i]);
+                }
+#ifdef SEAL_USE_HUGE_PAGES
+                // Large allocations are mapped at huge page boundaries
+                if (alloc_policy.huge_pages || alloc_policy.numa_node >= 0)
+                {
+                    ASSERT_EQ(0ULL, reinterpret_cast<uintptr_t>(large1.get()) % (uintptr_t(1) << 21));
+                }
+#endif
+            }
+            ASSERT_EQ((8ULL + 3ULL * large_count) * bytes_per_uint64, pool.release_unused());
+            {
+                auto large(allocate_uint(large_count, pool));
+                large[large_count - 1] = 1;
+            }
+        };
+        test(false, MemoryPoolAllocPolicy{ true, -1, size_t(1) << 16 });
+        test(true, MemoryPoolAllocPolicy{ true, 0, size_t(1) << 16 });
+        test(false, MemoryPoolAllocPolicy{ false, 0, size_t(1) << 16 });
+        test(false, MemoryPoolAllocPolicy{ true, 1000, size_t(1) << 16 });
+        test(false, MemoryPoolAllocPolicy{});
+    }
+
+    TEST(MemoryPoolHandleTest, MMProfAllocPolicy)
+    {
+        MemoryPoolAllocPolicy alloc_policy;
+        alloc_policy.huge_pages = true;
+        MMProfGuard guard(make_unique<MMProfAllocPolicy>(alloc_policy));
+        MemoryPoolHandle pool = MemoryManager::GetPool();
+        ASSERT_TRUE(pool == MemoryManager::GetPool());
+        ASSERT_FALSE(pool == MemoryPoolHandle::Global());
+        ASSERT_TRUE(pool.alloc_policy().huge_pages);
+        auto ptr(allocate_uint(5, pool));
+        ASSERT_EQ(5ULL * bytes_per_uint64, pool.alloc_byte_count());
+    }
 } // namespace sealtest
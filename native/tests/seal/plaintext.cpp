@@ -206,4 +206,39 @@ namespace sealtest
             ASSERT_TRUE(plain2.is_ntt_form());
         }
     }
+
+    TEST(PlaintextTest, PlaintextView)
+    {
+        vector<Plaintext::pt_coeff_type> buffer{ 1, 2, 3, 0, 0, 0 };
+        Plaintext plain(3, buffer.data(), buffer.size());
+        ASSERT_TRUE(plain.is_view());
+        ASSERT_EQ(buffer.data(), plain.data());
+        ASSERT_EQ(3ULL, plain.coeff_count());
+        ASSERT_EQ(6ULL, plain.capacity());
+        ASSERT_EQ("3x^2 + 2x^1 + 1", plain.to_string());
+
+        plain = "1x^4 + 5";
+        ASSERT_EQ(buffer.data(), plain.data());
+        ASSERT_EQ(5ULL, buffer[0]);
+        ASSERT_EQ(1ULL, buffer[4]);
+        ASSERT_THROW(plain.resize(7), logic_error);
+
+        // Loading keeps the buffer
+        stringstream stream;
+        Plaintext("7x^1").save(stream);
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(8);
+        parms.set_coeff_modulus(CoeffModulus::Create(8, { 20 }));
+        parms.set_plain_modulus(17);
+        SEALContext context(parms, false, sec_level_type::none);
+        plain.load(context, stream);
+        ASSERT_TRUE(plain.is_view());
+        ASSERT_EQ(buffer.data(), plain.data());
+        ASSERT_EQ(7ULL, buffer[1]);
+
+        Plaintext copy(plain);
+        ASSERT_FALSE(copy.is_view());
+        ASSERT_TRUE(copy == plain);
+        ASSERT_THROW(Plaintext(7, buffer.data(), buffer.size()), invalid_argument);
+    }
 } // namespace sealtest
@@ -1,7 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT license.
 
+#include "seal/decryptor.h"
+#include "seal/encryptor.h"
 #include "seal/keygenerator.h"
+#include "seal/modulus.h"
 #include "seal/randomgen.h"
 #include <algorithm>
 #include <array>
@@ -265,6 +268,21 @@ namespace sealtest
                 ASSERT_EQ(rg->generate(), rg2->generate());
             }
         }
+        {
+            shared_ptr<UniformRandomGenerator> rg(make_unique<Aes256CtrPRNG>(seed_arr));
+            info = rg->info();
+
+            ASSERT_EQ(prng_type::aes256ctr, info.type());
+            ASSERT_TRUE(info.has_valid_prng_type());
+            ASSERT_EQ(seed_arr, info.seed());
+
+            auto rg2 = info.make_prng();
+            ASSERT_TRUE(rg2);
+            for (int i = 0; i < 100; i++)
+            {
+                ASSERT_EQ(rg->generate(), rg2->generate());
+            }
+        }
         {
             shared_ptr<UniformRandomGenerator> rg(make_unique<SequentialRandomGenerator>(seed_arr));
             info = rg->info();
@@ -302,5 +320,52 @@ namespace sealtest
             info2.load(ss);
             ASSERT_TRUE(info == info2);
         }
+        {
+            shared_ptr<UniformRandomGenerator> rg(make_unique<Aes256CtrPRNG>(seed_arr));
+            info = rg->info();
+            info.save(ss);
+            info2.load(ss);
+            ASSERT_TRUE(info == info2);
+        }
+    }
+
+    TEST(RandomGenerator, Aes256CtrPRNG)
+    {
+        // FIPS-197, Appendix C.3: the key is the first four words of the seed and the initial counter the next two
+        prng_seed_type seed{ 0x0706050403020100ULL, 0x0f0e0d0c0b0a0908ULL, 0x1716151413121110ULL,
+                             0x1f1e1d1c1b1a1918ULL, 0x7766554433221100ULL, 0xffeeddccbbaa9988ULL };
+        auto rg = Aes256CtrPRNGFactory(seed).create();
+        array<uint8_t, 32> bytes;
+        rg->generate(bytes.size(), reinterpret_cast<seal_byte *>(bytes.data()));
+        array<uint8_t, 16> expected{ 0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+                                     0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89 };
+        ASSERT_TRUE(equal(expected.begin(), expected.end(), bytes.begin()));
+        ASSERT_FALSE(equal(expected.begin(), expected.end(), bytes.begin() + 16));
+
+        // Seeded ciphertexts and keys are expanded with the same generator after loading
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(128);
+        parms.set_coeff_modulus(CoeffModulus::Create(128, { 40, 40 }));
+        parms.set_plain_modulus(257);
+        parms.set_random_generator(make_shared<Aes256CtrPRNGFactory>());
+        SEALContext context(parms, false, sec_level_type::none);
+        KeyGenerator keygen(context);
+        Encryptor encryptor(context, keygen.secret_key());
+        Decryptor decryptor(context, keygen.secret_key());
+
+        stringstream stream;
+        encryptor.encrypt_symmetric(Plaintext("1x^10 + 2x^1 + 3")).save(stream);
+        Ciphertext encrypted;
+        encrypted.load(context, stream);
+        Plaintext decrypted;
+        decryptor.decrypt(encrypted, decrypted);
+        ASSERT_EQ("1x^10 + 2x^1 + 3", decrypted.to_string());
+
+        // The seed is saved last, with the PRNG type of the random generator in the encryption parameters
+        stream.str("");
+        stream.clear();
+        encryptor.encrypt_symmetric(Plaintext("1")).save(stream, compr_mode_type::none);
+        string data = stream.str();
+        ASSERT_EQ(static_cast<char>(prng_type::aes256ctr), data[data.size() - prng_seed_byte_count - 1]);
     }
 } // namespace sealtest
@@ -190,4 +190,109 @@ namespace sealtest
             compare_kswitchkeys(keys, test_keys, secret_key, context);
         }
     }
+
+    TEST(RelinKeysTest, RelinKeysHybridConfiguration)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(1 << 6);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 40, 40, 40, 40, 40, 40 }));
+
+        // Both configurations decompose into two digits at the same key level
+        SEALContext context(parms, false, sec_level_type::none, 1, 2);
+        SEALContext other_context(parms, false, sec_level_type::none, 2);
+        ASSERT_EQ(context.key_parms_id(), other_context.key_parms_id());
+        ASSERT_EQ(context.dnum(), other_context.dnum());
+
+        KeyGenerator keygen(context);
+        RelinKeys keys;
+        keygen.create_relin_keys(keys);
+        ASSERT_EQ(size_t(1), keys.special_prime_count());
+        ASSERT_EQ(size_t(2), keys.dnum());
+        ASSERT_EQ(size_t(3), keys.digit_size());
+        ASSERT_TRUE(is_valid_for(keys, context));
+        ASSERT_FALSE(is_valid_for(keys, other_context));
+
+        stringstream stream;
+        keys.save(stream);
+        RelinKeys test_keys;
+        ASSERT_THROW(test_keys.load(other_context, stream), logic_error);
+        stream.seekg(0);
+        test_keys.load(context, stream);
+        ASSERT_EQ(keys.special_prime_count(), test_keys.special_prime_count());
+        ASSERT_EQ(keys.dnum(), test_keys.dnum());
+        ASSERT_EQ(keys.digit_size(), test_keys.digit_size());
+
+        // The same number of special primes and digits, but digits of a different size
+        parms.set_coeff_modulus(CoeffModulus::Create(64, vector<int>(9, 30)));
+        context = SEALContext(parms, false, sec_level_type::none, 4);
+        other_context = SEALContext(parms, false, sec_level_type::none, 4, 2);
+        ASSERT_EQ(context.dnum(), other_context.dnum());
+        ASSERT_NE(context.digit_size(), other_context.digit_size());
+
+        KeyGenerator other_keygen(context);
+        other_keygen.create_relin_keys(keys);
+        ASSERT_TRUE(is_valid_for(keys, context));
+        ASSERT_FALSE(is_valid_for(keys, other_context));
+    }
+
+    TEST(RelinKeysTest, RelinKeysLoadVersion37)
+    {
+        EncryptionParameters parms(scheme_type::bfv);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(1 << 6);
+        parms.set_coeff_modulus(CoeffModulus::Create(64, { 40, 40, 40, 40 }));
+        SEALContext context(parms, false, sec_level_type::none);
+        KeyGenerator keygen(context);
+        RelinKeys keys;
+        keygen.create_relin_keys(keys);
+
+        // Write the keys in the layout of Microsoft SEAL 3.7, which has no keyswitching configuration
+        stringstream members;
+        members.write(reinterpret_cast<const char *>(&keys.parms_id()), sizeof(parms_id_type));
+        uint64_t keys_dim1 = static_cast<uint64_t>(keys.data().size());
+        members.write(reinterpret_cast<const char *>(&keys_dim1), sizeof(uint64_t));
+        for (auto &key_dim1 : keys.data())
+        {
+            uint64_t keys_dim2 = static_cast<uint64_t>(key_dim1.size());
+            members.write(reinterpret_cast<const char *>(&keys_dim2), sizeof(uint64_t));
+            for (auto &key : key_dim1)
+            {
+                key.save(members, compr_mode_type::none);
+            }
+        }
+        string members_data = members.str();
+        Serialization::SEALHeader header;
+        header.version_minor = 7;
+        header.compr_mode = compr_mode_type::none;
+        header.size = static_cast<uint64_t>(sizeof(Serialization::SEALHeader) + members_data.size());
+        stringstream stream;
+        Serialization::SaveHeader(header, stream);
+        stream.write(members_data.data(), static_cast<streamsize>(members_data.size()));
+
+        // The keys get the configuration of a single special prime
+        RelinKeys test_keys;
+        test_keys.load(context, stream);
+        ASSERT_EQ(size_t(1), test_keys.special_prime_count());
+        ASSERT_EQ(size_t(3), test_keys.dnum());
+        ASSERT_EQ(size_t(1), test_keys.digit_size());
+        ASSERT_TRUE(keys.parms_id() == test_keys.parms_id());
+        ASSERT_EQ(keys.data().size(), test_keys.data().size());
+        for (size_t i = 0; i < keys.data().size(); i++)
+        {
+            ASSERT_EQ(keys.data()[i].size(), test_keys.data()[i].size());
+            for (size_t j = 0; j < keys.data()[i].size(); j++)
+            {
+                auto &expected_key = keys.data()[i][j].data();
+                auto &test_key = test_keys.data()[i][j].data();
+                ASSERT_EQ(expected_key.dyn_array().size(), test_key.dyn_array().size());
+                ASSERT_TRUE(is_equal_uint(expected_key.data(), test_key.data(), expected_key.dyn_array().size()));
+            }
+        }
+
+        // Contexts with another configuration reject the keys
+        SEALContext other_context(parms, false, sec_level_type::none, 1, 1);
+        stream.seekg(0);
+        ASSERT_THROW(test_keys.load(other_context, stream), logic_error);
+    }
 } // namespace sealtest
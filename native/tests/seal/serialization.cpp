@@ -2,11 +2,14 @@
 // Licensed under the MIT license.
 
 #include "seal/serialization.h"
+#include "seal/threadpool.h"
 #include "seal/util/defines.h"
 #include <fstream>
 #include <functional>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 #include "gtest/gtest.h"
 
 using namespace seal;
@@ -55,13 +58,22 @@ namespace sealtest
 #ifdef SEAL_USE_ZLIB
         header.compr_mode = compr_mode_type::zlib;
         ASSERT_TRUE(Serialization::IsValidHeader(header));
+        header.compr_mode = compr_mode_type::zlib_chunked;
+        ASSERT_TRUE(Serialization::IsValidHeader(header));
 #endif
 
 #ifdef SEAL_USE_ZSTD
         header.compr_mode = compr_mode_type::zstd;
         ASSERT_TRUE(Serialization::IsValidHeader(header));
+        header.compr_mode = compr_mode_type::packed_zstd;
+        ASSERT_TRUE(Serialization::IsValidHeader(header));
+        header.compr_mode = compr_mode_type::zstd_chunked;
+        ASSERT_TRUE(Serialization::IsValidHeader(header));
 #endif
 
+        header.compr_mode = compr_mode_type::packed;
+        ASSERT_TRUE(Serialization::IsValidHeader(header));
+
         Serialization::SEALHeader invalid_header;
         invalid_header.magic = 0x1212;
         ASSERT_FALSE(Serialization::IsValidHeader(invalid_header));
@@ -70,7 +82,7 @@ namespace sealtest
         invalid_header.version_major = 0x02;
         ASSERT_FALSE(Serialization::IsValidHeader(invalid_header));
         invalid_header.version_major = SEAL_VERSION_MAJOR;
-        invalid_header.compr_mode = (compr_mode_type)0x03;
+        invalid_header.compr_mode = (compr_mode_type)0x07;
         ASSERT_FALSE(Serialization::IsValidHeader(invalid_header));
     }
 
@@ -260,4 +272,93 @@ namespace sealtest
         }
 #endif
     }
+#if defined(SEAL_USE_ZLIB) || defined(SEAL_USE_ZSTD)
+    TEST(SerializationTest, SaveLoadChunked)
+    {
+        // Data of several frames, the last of which is partial
+        vector<uint64_t> values(Serialization::compr_chunk_size * 5 / 16 + 3);
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            values[i] = (i * 0x9E3779B97F4A7C15ULL) >> 28;
+        }
+        auto save_members = [&](ostream &stream) {
+            stream.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(uint64_t));
+        };
+        vector<uint64_t> loaded_values(values.size());
+        auto load_members = [&](istream &stream, SEALVersion) {
+            stream.read(reinterpret_cast<char *>(loaded_values.data()), loaded_values.size() * sizeof(uint64_t));
+        };
+        size_t members_size = values.size() * sizeof(uint64_t);
+        auto raw_size = static_cast<streamoff>(sizeof(Serialization::SEALHeader) + members_size);
+
+        vector<compr_mode_type> compr_modes;
+#ifdef SEAL_USE_ZLIB
+        compr_modes.push_back(compr_mode_type::zlib_chunked);
+#endif
+#ifdef SEAL_USE_ZSTD
+        compr_modes.push_back(compr_mode_type::zstd_chunked);
+#endif
+        for (auto compr_mode : compr_modes)
+        {
+            string expected;
+            for (size_t thread_count : { 0, 1, 4 })
+            {
+                auto thread_pool = thread_count ? make_shared<ThreadPool>(thread_count) : nullptr;
+                stringstream stream;
+                auto out_size =
+                    Serialization::Save(save_members, raw_size, stream, compr_mode, false, thread_pool.get());
+                ASSERT_LT(out_size, raw_size);
+                ASSERT_LE(
+                    out_size, static_cast<streamoff>(
+                                  sizeof(Serialization::SEALHeader) +
+                                  Serialization::ComprSizeEstimate(members_size, compr_mode)));
+
+                // The output does not depend on the ThreadPool
+                if (expected.empty())
+                {
+                    expected = stream.str();
+                }
+                ASSERT_EQ(expected, stream.str());
+
+                fill(loaded_values.begin(), loaded_values.end(), 0);
+                ASSERT_EQ(out_size, Serialization::Load(load_members, stream, false, thread_pool.get()));
+                ASSERT_EQ(values, loaded_values);
+            }
+
+            // Three frames in the frame index following the header
+            uint64_t frame_count;
+            memcpy(&frame_count, expected.data() + sizeof(Serialization::SEALHeader), sizeof(uint64_t));
+            ASSERT_EQ(3ULL, frame_count);
+
+            // Corrupted frame indices and frames are rejected
+            auto load_corrupted = [&](size_t offset, uint64_t value) {
+                string data = expected;
+                memcpy(&data[offset], &value, sizeof(uint64_t));
+                stringstream stream(data);
+                Serialization::Load(load_members, stream, false);
+            };
+            size_t index_offset = sizeof(Serialization::SEALHeader) + sizeof(uint64_t);
+            ASSERT_THROW(load_corrupted(index_offset - sizeof(uint64_t), 1ULL << 40), logic_error);
+            ASSERT_THROW(load_corrupted(index_offset, Serialization::compr_chunk_size + 1), logic_error);
+            ASSERT_THROW(load_corrupted(index_offset, Serialization::compr_chunk_size - 1), logic_error);
+            ASSERT_THROW(load_corrupted(index_offset + sizeof(uint64_t), 1), logic_error);
+        }
+
+        // Small objects take a single frame
+        test_struct st{ 3, ~0, 3.14159 }, st2;
+        using namespace placeholders;
+        for (auto compr_mode : compr_modes)
+        {
+            stringstream stream;
+            auto out_size = Serialization::Save(
+                bind(&test_struct::save_members, &st, _1), st.save_size(compr_mode), stream, compr_mode, false);
+            ASSERT_LE(out_size, st.save_size(compr_mode));
+            auto in_size = Serialization::Load(bind(&test_struct::load_members, &st2, _1), stream, false);
+            ASSERT_EQ(out_size, in_size);
+            ASSERT_EQ(st.a, st2.a);
+            ASSERT_EQ(st.b, st2.b);
+            ASSERT_EQ(st.c, st2.c);
+        }
+    }
+#endif
 } // namespace sealtest
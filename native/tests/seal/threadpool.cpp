@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/threadpool.h"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal;
+using namespace std;
+
+namespace sealtest
+{
+    TEST(ThreadPoolTest, Create)
+    {
+        ThreadPool pool0(0);
+        ASSERT_EQ(size_t(1), pool0.thread_count());
+        ThreadPool pool1(1);
+        ASSERT_EQ(size_t(1), pool1.thread_count());
+        ThreadPool pool4(4);
+        ASSERT_EQ(size_t(4), pool4.thread_count());
+    }
+
+    TEST(ThreadPoolTest, ParallelFor)
+    {
+        auto test = [](size_t thread_count) {
+            ThreadPool pool(thread_count);
+            for (size_t count : { size_t(0), size_t(1), size_t(3), size_t(100) })
+            {
+                vector<atomic<int>> visits(count);
+                for (auto &visit : visits)
+                {
+                    visit = 0;
+                }
+                pool.parallel_for(count, [&](size_t i) { visits[i]++; });
+                for (auto &visit : visits)
+                {
+                    ASSERT_EQ(1, visit);
+                }
+            }
+        };
+        test(1);
+        test(2);
+        test(8);
+    }
+
+    TEST(ThreadPoolTest, ParallelForException)
+    {
+        ThreadPool pool(4);
+        ASSERT_THROW(
+            pool.parallel_for(
+                size_t(64),
+                [](size_t i) {
+                    if (i == 17)
+                    {
+                        throw invalid_argument("i");
+                    }
+                }),
+            invalid_argument);
+
+        // The pool remains usable
+        atomic<size_t> sum{ 0 };
+        pool.parallel_for(size_t(10), [&](size_t i) { sum += i; });
+        ASSERT_EQ(size_t(45), sum);
+    }
+
+    TEST(ThreadPoolTest, ParallelForNestedAndConcurrent)
+    {
+        ThreadPool pool(4);
+        atomic<size_t> count{ 0 };
+
+        // Nested loops run serially on the calling thread
+        pool.parallel_for(size_t(8), [&](size_t) { pool.parallel_for(size_t(8), [&](size_t) { count++; }); });
+        ASSERT_EQ(size_t(64), count);
+
+        // Concurrent callers share the pool
+        count = 0;
+        vector<thread> callers;
+        for (size_t i = 0; i < 4; i++)
+        {
+            callers.emplace_back([&]() {
+                for (size_t j = 0; j < 16; j++)
+                {
+                    pool.parallel_for(size_t(32), [&](size_t) { count++; });
+                }
+            });
+        }
+        for (auto &caller : callers)
+        {
+            caller.join();
+        }
+        ASSERT_EQ(size_t(4 * 16 * 32), count);
+    }
+} // namespace sealtest
@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/util/aes.h"
+#include "seal/util/cpufeatures.h"
+#include <cstdint>
+#include <numeric>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal::util;
+using namespace std;
+
+namespace sealtest
+{
+    namespace util
+    {
+        namespace
+        {
+            vector<uint8_t> expand_test_key()
+            {
+                vector<uint8_t> key(aes256_key_byte_count);
+                iota(key.begin(), key.end(), uint8_t(0));
+                vector<uint8_t> round_keys(aes256_round_key_byte_count);
+                aes256_expand_key(key.data(), round_keys.data());
+                return round_keys;
+            }
+        } // namespace
+
+        TEST(AESTest, AES256ExpandKey)
+        {
+            // FIPS-197, Appendix A.3
+            vector<uint8_t> key{ 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae,
+                                 0xf0, 0x85, 0x7d, 0x77, 0x81, 0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61,
+                                 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+            vector<uint8_t> round_keys(aes256_round_key_byte_count);
+            aes256_expand_key(key.data(), round_keys.data());
+            ASSERT_TRUE(equal(key.begin(), key.end(), round_keys.begin()));
+            vector<uint8_t> last_round_key{ 0xfe, 0x48, 0x90, 0xd1, 0xe6, 0x18, 0x8d, 0x0b,
+                                            0x04, 0x6d, 0xf3, 0x44, 0x70, 0x6c, 0x63, 0x1e };
+            ASSERT_TRUE(equal(last_round_key.begin(), last_round_key.end(), round_keys.end() - 16));
+        }
+
+        TEST(AESTest, AES256CTR)
+        {
+            // FIPS-197, Appendix C.3: the plaintext block is the counter in little-endian order
+            auto round_keys = expand_test_key();
+            vector<uint8_t> expected{ 0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+                                      0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89 };
+            uint64_t counter[2]{ 0x7766554433221100ULL, 0xffeeddccbbaa9988ULL };
+            vector<uint8_t> block(aes_block_byte_count);
+            aes256_ctr_portable(round_keys.data(), counter, 1, block.data());
+            ASSERT_TRUE(expected == block);
+            ASSERT_EQ(0x7766554433221101ULL, counter[0]);
+            ASSERT_EQ(0xffeeddccbbaa9988ULL, counter[1]);
+
+            counter[0]--;
+            aes256_ctr(round_keys.data(), counter, 1, block.data());
+            ASSERT_TRUE(expected == block);
+
+            // The counter carries into the high word
+            counter[0] = ~uint64_t(0) - 1;
+            counter[1] = 5;
+            vector<uint8_t> stream(3 * aes_block_byte_count);
+            aes256_ctr_portable(round_keys.data(), counter, 3, stream.data());
+            ASSERT_EQ(uint64_t(1), counter[0]);
+            ASSERT_EQ(uint64_t(6), counter[1]);
+            counter[0] = 0;
+            aes256_ctr_portable(round_keys.data(), counter, 1, block.data());
+            ASSERT_TRUE(equal(block.begin(), block.end(), stream.end() - 16));
+        }
+
+        TEST(AESTest, AES256CTRDispatch)
+        {
+            // The selected kernel agrees with the portable one, including for partial groups of blocks
+            auto round_keys = expand_test_key();
+            for (size_t block_count : { 1, 7, 8, 9, 100 })
+            {
+                uint64_t counter1[2]{ ~uint64_t(0) - 3, 1 };
+                uint64_t counter2[2]{ ~uint64_t(0) - 3, 1 };
+                vector<uint8_t> stream1(block_count * aes_block_byte_count);
+                vector<uint8_t> stream2(block_count * aes_block_byte_count);
+                aes256_ctr_portable(round_keys.data(), counter1, block_count, stream1.data());
+                aes256_ctr(round_keys.data(), counter2, block_count, stream2.data());
+                ASSERT_TRUE(stream1 == stream2);
+                ASSERT_EQ(counter1[0], counter2[0]);
+                ASSERT_EQ(counter1[1], counter2[1]);
+            }
+#ifndef SEAL_USE_AES_NI
+            ASSERT_FALSE(cpu_has_aes_ni());
+#endif
+        }
+    } // namespace util
+} // namespace sealtest
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/memorymanager.h"
+#include "seal/util/bitpack.h"
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal;
+using namespace seal::util;
+using namespace std;
+
+namespace sealtest
+{
+    namespace util
+    {
+        TEST(BitPack, PackUnpackBlock)
+        {
+            mt19937_64 engine(17);
+            for (int bit_width = 0; bit_width <= 64; bit_width++)
+            {
+                uint64_t mask = bit_width == 64 ? ~uint64_t(0) : (uint64_t(1) << bit_width) - 1;
+                for (size_t count : { size_t(1), size_t(3), size_t(63), size_t(64) })
+                {
+                    vector<uint64_t> values(count);
+                    for (auto &value : values)
+                    {
+                        value = engine() & mask;
+                    }
+                    size_t packed_count = get_packed_uint64_count(count, bit_width);
+                    ASSERT_EQ((count * static_cast<size_t>(bit_width) + 63) / 64, packed_count);
+
+                    // Guard words detect writes and reads past the packed words
+                    vector<uint64_t> packed(packed_count + 1, 0xDEADBEEF);
+                    pack_uint_block(values.data(), count, bit_width, packed.data());
+                    ASSERT_EQ(0xDEADBEEFULL, packed.back());
+
+                    vector<uint64_t> unpacked(count + 1, 0xDEADBEEF);
+                    unpack_uint_block(packed.data(), count, bit_width, unpacked.data());
+                    ASSERT_EQ(0xDEADBEEFULL, unpacked.back());
+                    unpacked.pop_back();
+                    ASSERT_EQ(values, unpacked);
+                }
+            }
+        }
+
+        TEST(BitPack, SaveLoadPackedUint)
+        {
+            auto pool = MemoryManager::GetPool();
+            mt19937_64 engine(23);
+            for (size_t count : { size_t(0), size_t(1), size_t(100), size_t(1000) })
+            {
+                // Blocks of different widths, including all-zero blocks
+                vector<uint64_t> values(count);
+                for (size_t i = 0; i < count; i++)
+                {
+                    int bit_width = static_cast<int>((i / bitpack_block_uint64_count) * 13 % 65);
+                    values[i] = bit_width ? engine() >> (64 - bit_width) : 0;
+                }
+
+                stringstream stream;
+                save_packed_uint(values.data(), count, stream, pool);
+                ASSERT_LE(stream.str().size(), count * 8 + (count + 63) / 64);
+
+                vector<uint64_t> loaded(count);
+                load_packed_uint(stream, count, loaded.data(), pool);
+                ASSERT_EQ(values, loaded);
+            }
+
+            // Bit widths above 64 are rejected
+            stringstream stream;
+            stream.put(static_cast<char>(65));
+            uint64_t value = 0;
+            ASSERT_THROW(load_packed_uint(stream, 1, &value, pool), logic_error);
+        }
+    } // namespace util
+} // namespace sealtest
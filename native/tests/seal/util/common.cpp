@@ -148,6 +148,16 @@ namespace sealtest
             ASSERT_EQ(7, hamming_weight(0xFB));
         }
 
+        TEST(Common, HammingWeight64)
+        {
+            ASSERT_EQ(0, hamming_weight(uint64_t(0)));
+            ASSERT_EQ(64, hamming_weight(uint64_t(0xFFFFFFFFFFFFFFFF)));
+            ASSERT_EQ(32, hamming_weight(uint64_t(0xAAAAAAAAAAAAAAAA)));
+            ASSERT_EQ(1, hamming_weight(uint64_t(0x8000000000000000)));
+            ASSERT_EQ(21, hamming_weight(uint64_t(0x1FFFFF)));
+            ASSERT_EQ(10, hamming_weight(uint64_t(0xD6000000000006D0)));
+        }
+
         template <typename T>
         void ReverseBits32Helper()
         {
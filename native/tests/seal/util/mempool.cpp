@@ -8,7 +8,9 @@
 #include "seal/util/pointer.h"
 #include "seal/util/uintcore.h"
 #include <algorithm>
+#include <atomic>
 #include <memory>
+#include <thread>
 #include <vector>
 #include "gtest/gtest.h"
 
@@ -190,6 +192,58 @@ namespace sealtest
             }
         }
 
+        TEST(MemoryPoolTest, TestMemoryPoolMTConcurrent)
+        {
+            MemoryPoolMT pool;
+            const size_t thread_count = 8;
+            const size_t live_count = 3 * MemoryPoolHeadMT::transfer_batch_size;
+            atomic<bool> corrupted{ false };
+            vector<thread> threads;
+            for (size_t t = 0; t < thread_count; t++)
+            {
+                threads.emplace_back([&, t]() {
+                    for (size_t round = 0; round < 50; round++)
+                    {
+                        // Allocate from one or two sizes so that threads share and also do not share heads
+                        size_t word_count = 5 + (t + round) % 2;
+                        vector<Pointer<uint64_t>> live;
+                        for (size_t i = 0; i < live_count; i++)
+                        {
+                            live.emplace_back(allocate<uint64_t>(word_count, pool));
+                            fill_n(live.back().get(), word_count, (uint64_t(t) << 32) + i);
+                        }
+                        for (size_t i = 0; i < live_count; i++)
+                        {
+                            if (any_of(live[i].get(), live[i].get() + word_count, [&](uint64_t value) {
+                                    return value != (uint64_t(t) << 32) + i;
+                                }))
+                            {
+                                corrupted = true;
+                            }
+                        }
+                    }
+                });
+            }
+            for (auto &thread : threads)
+            {
+                thread.join();
+            }
+            ASSERT_FALSE(corrupted);
+            ASSERT_EQ(2ULL, pool.pool_count());
+
+            // Every allocation was returned to the pool, so allocating again must reuse the cached items instead of
+            // growing the pool
+            size_t alloc_byte_count = pool.alloc_byte_count();
+            {
+                vector<Pointer<uint64_t>> live;
+                for (size_t i = 0; i < live_count; i++)
+                {
+                    live.emplace_back(allocate<uint64_t>(5, pool));
+                }
+            }
+            ASSERT_EQ(alloc_byte_count, pool.alloc_byte_count());
+        }
+
         TEST(MemoryPoolTests, PointerTestsMT)
         {
             MemoryPool &pool = *global_variables::global_memory_pool;
@@ -457,6 +511,104 @@ namespace sealtest
             }
         }
 
+        TEST(MemoryPoolTests, ReleaseUnusedST)
+        {
+            MemoryPoolST pool;
+            {
+                Pointer<seal_byte> pointer1 = pool.get_for_byte_count(4);
+                Pointer<seal_byte> pointer2 = pool.get_for_byte_count(4);
+                Pointer<seal_byte> pointer3 = pool.get_for_byte_count(4);
+                ASSERT_EQ(12ULL, pool.alloc_byte_count());
+                ASSERT_EQ(0ULL, pool.release_unused());
+
+                pointer1.release();
+                pointer2.release();
+                ASSERT_EQ(4ULL, pool.release_unused());
+                ASSERT_EQ(8ULL, pool.alloc_byte_count());
+                auto stats = pool.stats();
+                ASSERT_EQ(1ULL, stats.size());
+                ASSERT_EQ(2ULL, stats[0].item_count);
+                ASSERT_EQ(1ULL, stats[0].live_item_count);
+                ASSERT_EQ(1ULL, stats[0].free_item_count);
+                ASSERT_EQ(1ULL, stats[0].alloc_count);
+                ASSERT_EQ(12ULL, stats[0].peak_byte_count);
+            }
+            ASSERT_EQ(8ULL, pool.release_unused());
+            ASSERT_EQ(0ULL, pool.alloc_byte_count());
+
+            pool.set_byte_count_limit(6);
+            {
+                Pointer<seal_byte> pointer = pool.get_for_byte_count(4);
+                ASSERT_EQ(4ULL, pool.alloc_byte_count());
+            }
+            Pointer<seal_byte> pointer = pool.get_for_byte_count(3);
+            ASSERT_EQ(3ULL, pool.alloc_byte_count());
+            ASSERT_EQ(3ULL, pool.stats()[0].total_alloc_count);
+        }
+
+        TEST(MemoryPoolTests, Arena)
+        {
+            MemoryPoolArena pool(100);
+            ASSERT_EQ(1ULL, pool.pool_count());
+            ASSERT_EQ(128ULL, pool.alloc_byte_count());
+            {
+                Pointer<seal_byte> pointer1 = pool.get_for_byte_count(8);
+                Pointer<seal_byte> pointer2 = pool.get_for_byte_count(40);
+                ASSERT_EQ(0ULL, reinterpret_cast<uintptr_t>(pointer1.get()) % 64);
+                ASSERT_TRUE(pointer1.get() + 64 == pointer2.get());
+
+                // The third item does not fit and goes to a new chunk
+                Pointer<uint64_t> pointer3(pool.get_for_byte_count(100), uint64_t(7));
+                ASSERT_EQ(256ULL, pool.alloc_byte_count());
+                auto stats = pool.stats();
+                ASSERT_EQ(1ULL, stats.size());
+                ASSERT_EQ(64ULL, stats[0].item_byte_count);
+                ASSERT_EQ(4ULL, stats[0].item_count);
+                ASSERT_EQ(4ULL, stats[0].live_item_count);
+                ASSERT_EQ(0ULL, stats[0].free_item_count);
+                ASSERT_EQ(2ULL, stats[0].alloc_count);
+                ASSERT_EQ(256ULL, stats[0].peak_byte_count);
+                ASSERT_EQ(0ULL, pool.release_unused());
+
+                // Items released out of order are reclaimed with the items above them
+                pointer2.release();
+                stats = pool.stats();
+                ASSERT_EQ(3ULL, stats[0].live_item_count);
+                ASSERT_EQ(1ULL, stats[0].free_item_count);
+                ASSERT_TRUE(all_of(pointer3.get(), pointer3.get() + 12, [](uint64_t value) { return value == 7; }));
+                pointer3.release();
+                stats = pool.stats();
+                ASSERT_EQ(1ULL, stats[0].live_item_count);
+                ASSERT_EQ(0ULL, stats[0].free_item_count);
+
+                // The second chunk is empty
+                ASSERT_EQ(128ULL, pool.release_unused());
+                ASSERT_EQ(128ULL, pool.alloc_byte_count());
+                Pointer<seal_byte> pointer4 = pool.get_for_byte_count(64);
+                ASSERT_TRUE(pointer1.get() + 64 == pointer4.get());
+            }
+            {
+                Pointer<seal_byte> pointer1 = pool.get_for_byte_count(128);
+                Pointer<seal_byte> pointer2 = pool.get_for_byte_count(128);
+                ASSERT_EQ(256ULL, pool.alloc_byte_count());
+                ASSERT_EQ(2ULL, pool.stats()[0].alloc_count);
+            }
+
+            // The chunks are replaced by one of the combined size once the arena is empty
+            {
+                Pointer<seal_byte> pointer = pool.get_for_byte_count(256);
+                auto stats = pool.stats();
+                ASSERT_EQ(256ULL, pool.alloc_byte_count());
+                ASSERT_EQ(1ULL, stats[0].alloc_count);
+                ASSERT_EQ(4ULL, stats[0].total_alloc_count);
+            }
+            ASSERT_EQ(256ULL, pool.release_unused());
+            ASSERT_EQ(0ULL, pool.alloc_byte_count());
+            Pointer<seal_byte> pointer = pool.get_for_byte_count(1);
+            ASSERT_EQ(64ULL, pool.alloc_byte_count());
+            ASSERT_FALSE(pool.get_for_byte_count(0).is_set());
+        }
+
         TEST(MemoryPoolTests, PointerTestsST)
         {
             MemoryPoolST pool;
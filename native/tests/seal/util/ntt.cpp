@@ -2,12 +2,14 @@
 // Licensed under the MIT license.
 
 #include "seal/modulus.h"
+#include "seal/threadpool.h"
 #include "seal/util/ntt.h"
 #include "seal/util/numth.h"
 #include "seal/util/polycore.h"
 #include <cstddef>
 #include <cstdint>
 #include <random>
+#include <vector>
 #include "gtest/gtest.h"
 
 using namespace seal;
@@ -131,5 +133,260 @@ namespace sealtest
                 ASSERT_EQ(temp[i], poly[i]);
             }
         }
+
+        TEST(NTTTablesTest, NegacyclicNTTKernelTest)
+        {
+            // Transforms selected by NTTTables (e.g., AVX2 kernels) must agree with the scalar handler; the kernels for
+            // small moduli may return a different lazy representative of the same residue
+            MemoryPoolHandle pool = MemoryPoolHandle::Global();
+            Pointer<NTTTables> tables;
+            mt19937_64 rng(0);
+
+            for (int coeff_count_power = 1; coeff_count_power <= 13; coeff_count_power++)
+            {
+                size_t coeff_count = size_t(1) << coeff_count_power;
+                for (int bit_size : { 20, 30, 31, 40, 60, 61 })
+                {
+                    Modulus modulus = get_prime(coeff_count << 1, bit_size);
+                    ASSERT_NO_THROW(tables = allocate<NTTTables>(pool, coeff_count_power, modulus, pool));
+                    auto poly(allocate_poly(coeff_count, 1, pool));
+                    auto expected(allocate_poly(coeff_count, 1, pool));
+
+                    // Lazy forward transform accepts inputs in [0, 4 * modulus)
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        poly[i] = rng() % (modulus.value() << 2);
+                        expected[i] = poly[i];
+                    }
+                    ntt_negacyclic_harvey_lazy(poly.get(), *tables);
+                    tables->ntt_handler().transform_to_rev(
+                        expected.get(), coeff_count_power, tables->get_from_root_powers());
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        ASSERT_LT(poly[i], modulus.value() << 2);
+                        if (modulus.bit_count() > small_modulus_bit_count_max)
+                        {
+                            ASSERT_EQ(expected[i], poly[i]);
+                        }
+                        else
+                        {
+                            ASSERT_EQ(expected[i] % modulus.value(), poly[i] % modulus.value());
+                        }
+                    }
+
+                    // Lazy inverse transform accepts inputs in [0, 2 * modulus)
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        poly[i] = rng() % (modulus.value() << 1);
+                        expected[i] = poly[i];
+                    }
+                    MultiplyUIntModOperand inv_degree_modulo = tables->inv_degree_modulo();
+                    inverse_ntt_negacyclic_harvey_lazy(poly.get(), *tables);
+                    tables->ntt_handler().transform_from_rev(
+                        expected.get(), coeff_count_power, tables->get_from_inv_root_powers(), &inv_degree_modulo);
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        ASSERT_LT(poly[i], modulus.value() << 1);
+                        if (modulus.bit_count() > small_modulus_bit_count_max)
+                        {
+                            ASSERT_EQ(expected[i], poly[i]);
+                        }
+                        else
+                        {
+                            ASSERT_EQ(expected[i] % modulus.value(), poly[i] % modulus.value());
+                        }
+                    }
+                }
+            }
+        }
+
+        TEST(NTTTablesTest, NegacyclicNTTRadix4Test)
+        {
+            // Radix-4 transforms must agree exactly with the radix-2 transforms
+            MemoryPoolHandle pool = MemoryPoolHandle::Global();
+            Pointer<NTTTables> tables;
+            mt19937_64 rng(0);
+
+            for (int coeff_count_power = 1; coeff_count_power <= 13; coeff_count_power++)
+            {
+                size_t coeff_count = size_t(1) << coeff_count_power;
+                Modulus modulus = get_prime(coeff_count << 1, 60);
+                ASSERT_NO_THROW(tables = allocate<NTTTables>(pool, coeff_count_power, modulus, pool));
+                auto poly(allocate_poly(coeff_count, 1, pool));
+                auto expected(allocate_poly(coeff_count, 1, pool));
+                const auto &handler = tables->ntt_handler();
+
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    poly[i] = rng() % (modulus.value() << 2);
+                    expected[i] = poly[i];
+                }
+                handler.transform_to_rev_radix4(poly.get(), coeff_count_power, tables->get_from_root_powers());
+                handler.transform_to_rev(expected.get(), coeff_count_power, tables->get_from_root_powers());
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    ASSERT_EQ(expected[i], poly[i]);
+                }
+
+                MultiplyUIntModOperand inv_degree_modulo = tables->inv_degree_modulo();
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    poly[i] = rng() % (modulus.value() << 1);
+                    expected[i] = poly[i];
+                }
+                handler.transform_from_rev_radix4(
+                    poly.get(), coeff_count_power, tables->get_from_inv_root_powers(), &inv_degree_modulo);
+                handler.transform_from_rev(
+                    expected.get(), coeff_count_power, tables->get_from_inv_root_powers(), &inv_degree_modulo);
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    ASSERT_EQ(expected[i], poly[i]);
+                }
+
+                handler.transform_from_rev_radix4(poly.get(), coeff_count_power, tables->get_from_inv_root_powers());
+                handler.transform_from_rev(expected.get(), coeff_count_power, tables->get_from_inv_root_powers());
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    ASSERT_EQ(expected[i], poly[i]);
+                }
+            }
+        }
+
+        TEST(NTTTablesTest, NegacyclicNTT32Test)
+        {
+            // Transforms of std::uint32_t buffers must agree exactly with those of std::uint64_t buffers
+            MemoryPoolHandle pool = MemoryPoolHandle::Global();
+            Pointer<NTTTables> tables;
+            mt19937_64 rng(0);
+
+            ASSERT_NO_THROW(tables = allocate<NTTTables>(pool, 4, get_prime(32, 31), pool));
+            ASSERT_FALSE(tables->supports_uint32());
+            vector<uint32_t> values(16);
+            ASSERT_THROW(ntt_negacyclic_harvey(values.data(), *tables), invalid_argument);
+            ASSERT_THROW(inverse_ntt_negacyclic_harvey(values.data(), *tables), invalid_argument);
+
+            for (int coeff_count_power = 1; coeff_count_power <= 13; coeff_count_power++)
+            {
+                size_t coeff_count = size_t(1) << coeff_count_power;
+                for (int bit_count : { 17, 30 })
+                {
+                    Modulus modulus = get_prime(coeff_count << 1, bit_count);
+                    ASSERT_NO_THROW(tables = allocate<NTTTables>(pool, coeff_count_power, modulus, pool));
+                    ASSERT_TRUE(tables->supports_uint32());
+                    auto expected(allocate_poly(coeff_count, 1, pool));
+                    values.resize(coeff_count);
+
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        expected[i] = rng() % modulus.value();
+                        values[i] = static_cast<uint32_t>(expected[i]);
+                    }
+                    ntt_negacyclic_harvey(expected.get(), *tables);
+                    ntt_negacyclic_harvey(values.data(), *tables);
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        ASSERT_EQ(expected[i], values[i]);
+                    }
+
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        expected[i] = rng() % modulus.value();
+                        values[i] = static_cast<uint32_t>(expected[i]);
+                    }
+                    inverse_ntt_negacyclic_harvey(expected.get(), *tables);
+                    inverse_ntt_negacyclic_harvey(values.data(), *tables);
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        ASSERT_EQ(expected[i], values[i]);
+                    }
+
+                    // Lazy transforms, which may run the AVX2 kernels, must agree exactly with the scalar handler
+                    const auto &handler = tables->ntt_handler32();
+                    vector<uint32_t> expected32(coeff_count);
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        values[i] = static_cast<uint32_t>(rng() % (modulus.value() << 2));
+                        expected32[i] = values[i];
+                    }
+                    ntt_negacyclic_harvey_lazy(values.data(), *tables);
+                    handler.transform_to_rev(expected32.data(), coeff_count_power, tables->get_from_root_powers32());
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        ASSERT_EQ(expected32[i], values[i]);
+                        ASSERT_GT(modulus.value() << 2, values[i]);
+                    }
+
+                    MultiplyUIntModOperand32 inv_degree_modulo = tables->inv_degree_modulo32();
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        values[i] = static_cast<uint32_t>(rng() % (modulus.value() << 1));
+                        expected32[i] = values[i];
+                    }
+                    inverse_ntt_negacyclic_harvey_lazy(values.data(), *tables);
+                    handler.transform_from_rev(
+                        expected32.data(), coeff_count_power, tables->get_from_inv_root_powers32(), &inv_degree_modulo);
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        ASSERT_EQ(expected32[i], values[i]);
+                        ASSERT_GT(modulus.value() << 1, values[i]);
+                    }
+                }
+            }
+        }
+
+        TEST(NTTTablesTest, NegacyclicNTTBatchedTest)
+        {
+            // Multi-threaded batched transforms must agree exactly with per-component transforms
+            MemoryPoolHandle pool = MemoryPoolHandle::Global();
+            Pointer<NTTTables> tables;
+            mt19937_64 rng(0);
+
+            int coeff_count_power = 6;
+            size_t coeff_count = size_t(1) << coeff_count_power;
+            size_t coeff_modulus_size = 5;
+            size_t size = 3;
+            auto moduli = get_primes(coeff_count << 1, 50, coeff_modulus_size);
+            ASSERT_NO_THROW(CreateNTTTables(coeff_count_power, moduli, tables, pool));
+
+            auto poly(allocate_poly_array(size, coeff_count, coeff_modulus_size, pool));
+            auto expected(allocate_poly_array(size, coeff_count, coeff_modulus_size, pool));
+            ThreadPool thread_pool_2(2);
+            ThreadPool thread_pool_4(4);
+            ThreadPool thread_pool_32(32);
+            for (ThreadPool *thread_pool : { static_cast<ThreadPool *>(nullptr), &thread_pool_2, &thread_pool_4,
+                                             &thread_pool_32 })
+            {
+                for (size_t i = 0; i < size * coeff_modulus_size * coeff_count; i++)
+                {
+                    poly[i] = rng() % moduli[(i / coeff_count) % coeff_modulus_size].value();
+                    expected[i] = poly[i];
+                }
+
+                PolyIter poly_iter(poly.get(), coeff_count, coeff_modulus_size);
+                PolyIter expected_iter(expected.get(), coeff_count, coeff_modulus_size);
+                ntt_negacyclic_harvey(poly_iter, size, tables.get(), thread_pool);
+                for (size_t j = 0; j < size; j++)
+                {
+                    for (size_t k = 0; k < coeff_modulus_size; k++)
+                    {
+                        ntt_negacyclic_harvey(expected_iter[j][k], tables[k]);
+                    }
+                }
+                for (size_t i = 0; i < size * coeff_modulus_size * coeff_count; i++)
+                {
+                    ASSERT_EQ(expected[i], poly[i]);
+                }
+
+                inverse_ntt_negacyclic_harvey_lazy(poly_iter[1], coeff_modulus_size, tables.get(), thread_pool);
+                for (size_t k = 0; k < coeff_modulus_size; k++)
+                {
+                    inverse_ntt_negacyclic_harvey_lazy(expected_iter[1][k], tables[k]);
+                }
+                for (size_t i = 0; i < size * coeff_modulus_size * coeff_count; i++)
+                {
+                    ASSERT_EQ(expected[i], poly[i]);
+                }
+            }
+        }
     } // namespace util
 } // namespace sealtest
@@ -7,6 +7,8 @@
 #include "seal/util/uintcore.h"
 #include <cstddef>
 #include <cstdint>
+#include <random>
+#include <vector>
 #include "gtest/gtest.h"
 
 using namespace seal;
@@ -637,6 +639,166 @@ namespace sealtest
                 ASSERT_EQ(3ULL, result[1][1][1]);
                 ASSERT_EQ(1ULL, result[1][1][2]);
             }
+            {
+                // Lazy inputs less than 4 * modulus for moduli around the 32-bit fast path threshold
+                size_t coeff_count = 256;
+                SEAL_ALLOCATE_ZERO_GET_COEFF_ITER(poly1, coeff_count, pool);
+                SEAL_ALLOCATE_ZERO_GET_COEFF_ITER(poly2, coeff_count, pool);
+                SEAL_ALLOCATE_ZERO_GET_COEFF_ITER(result, coeff_count, pool);
+                mt19937_64 rng(0);
+                for (uint64_t value : { 1073741789ULL, 2147483647ULL })
+                {
+                    Modulus mod(value);
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        poly1[i] = rng() % (value << 2);
+                        poly2[i] = rng() % (value << 2);
+                    }
+                    poly1[0] = (value << 2) - 1;
+                    poly2[0] = (value << 2) - 1;
+
+                    dyadic_product_coeffmod(poly1, poly2, coeff_count, mod, result);
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        ASSERT_EQ((poly1[i] % value) * (poly2[i] % value) % value, result[i]);
+                    }
+                }
+            }
+        }
+
+        TEST(PolyArithSmallMod, PolyCoeffMod32)
+        {
+            // The std::uint32_t kernels must agree exactly with the std::uint64_t kernels
+            MemoryPool &pool = *global_variables::global_memory_pool;
+            mt19937_64 rng(0);
+            size_t coeff_count = 64;
+            for (uint64_t modulus_value : { 13ULL, 0x3FFFFFDDULL, 0x7FFFFULL })
+            {
+                Modulus mod(modulus_value);
+                SEAL_ALLOCATE_GET_COEFF_ITER(poly1, coeff_count, pool);
+                SEAL_ALLOCATE_GET_COEFF_ITER(poly2, coeff_count, pool);
+                SEAL_ALLOCATE_GET_COEFF_ITER(expected, coeff_count, pool);
+                vector<uint32_t> poly1_32(coeff_count), poly2_32(coeff_count), result_32(coeff_count);
+
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    poly1[i] = rng() % modulus_value;
+                    poly2[i] = rng() % modulus_value;
+                    poly1_32[i] = static_cast<uint32_t>(poly1[i]);
+                    poly2_32[i] = static_cast<uint32_t>(poly2[i]);
+                }
+                add_poly_coeffmod(poly1, poly2, coeff_count, mod, expected);
+                add_poly_coeffmod(poly1_32.data(), poly2_32.data(), coeff_count, mod, result_32.data());
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    ASSERT_EQ(expected[i], result_32[i]);
+                }
+
+                sub_poly_coeffmod(poly1, poly2, coeff_count, mod, expected);
+                sub_poly_coeffmod(poly1_32.data(), poly2_32.data(), coeff_count, mod, result_32.data());
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    ASSERT_EQ(expected[i], result_32[i]);
+                }
+
+                // Dyadic products accept lazy inputs less than 4 * modulus
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    poly1[i] = rng() % (modulus_value << 2);
+                    poly2[i] = rng() % (modulus_value << 2);
+                    poly1_32[i] = static_cast<uint32_t>(poly1[i]);
+                    poly2_32[i] = static_cast<uint32_t>(poly2[i]);
+                }
+                dyadic_product_coeffmod(poly1, poly2, coeff_count, mod, expected);
+                dyadic_product_coeffmod(poly1_32.data(), poly2_32.data(), coeff_count, mod, result_32.data());
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    ASSERT_EQ(expected[i], result_32[i]);
+                }
+            }
+        }
+
+        TEST(PolyArithSmallMod, MontgomeryCoeffMod)
+        {
+            MemoryPool &pool = *global_variables::global_memory_pool;
+            {
+                SEAL_ALLOCATE_ZERO_GET_COEFF_ITER(poly1, 3, pool);
+                SEAL_ALLOCATE_ZERO_GET_COEFF_ITER(poly2, 3, pool);
+                SEAL_ALLOCATE_ZERO_GET_COEFF_ITER(result, 3, pool);
+                Modulus mod(13);
+
+                poly1[0] = 1;
+                poly1[1] = 5;
+                poly1[2] = 12;
+                poly2[0] = 2;
+                poly2[1] = 3;
+                poly2[2] = 4;
+
+                to_montgomery_coeffmod(poly1, 3, mod, result);
+                from_montgomery_coeffmod(result, 3, mod, result);
+                ASSERT_EQ(1ULL, result[0]);
+                ASSERT_EQ(5ULL, result[1]);
+                ASSERT_EQ(12ULL, result[2]);
+
+                // One operand in Montgomery form gives a product in normal form
+                to_montgomery_coeffmod(poly2, 3, mod, poly2);
+                dyadic_product_montgomery_coeffmod(poly1, poly2, 3, mod, result);
+                ASSERT_EQ(2ULL, result[0]);
+                ASSERT_EQ(2ULL, result[1]);
+                ASSERT_EQ(9ULL, result[2]);
+
+                multiply_poly_scalar_montgomery_coeffmod(poly1, 3, 3, mod, result);
+                ASSERT_EQ(3ULL, result[0]);
+                ASSERT_EQ(2ULL, result[1]);
+                ASSERT_EQ(10ULL, result[2]);
+            }
+            {
+                SEAL_ALLOCATE_ZERO_GET_POLY_ITER(poly1, 2, 3, 2, pool);
+                SEAL_ALLOCATE_ZERO_GET_POLY_ITER(poly2, 2, 3, 2, pool);
+                SEAL_ALLOCATE_ZERO_GET_POLY_ITER(expected, 2, 3, 2, pool);
+                SEAL_ALLOCATE_ZERO_GET_POLY_ITER(result, 2, 3, 2, pool);
+                vector<Modulus> mod{ 13, 2305843009211596801ULL };
+
+                for (size_t i = 0; i < 2; i++)
+                {
+                    for (size_t j = 0; j < 2; j++)
+                    {
+                        for (size_t k = 0; k < 3; k++)
+                        {
+                            poly1[i][j][k] = mod[j].value() - 1 - i - k;
+                            poly2[i][j][k] = mod[j].value() / (i + k + 2);
+                        }
+                    }
+                }
+
+                // Both operands in Montgomery form give a product in Montgomery form
+                dyadic_product_coeffmod(poly1, poly2, 2, mod, expected);
+                to_montgomery_coeffmod(poly1, 2, mod, poly1);
+                to_montgomery_coeffmod(poly2, 2, mod, poly2);
+                dyadic_product_montgomery_coeffmod(poly1, poly2, 2, mod, result);
+                from_montgomery_coeffmod(result, 2, mod, result);
+                for (size_t i = 0; i < 2; i++)
+                {
+                    for (size_t j = 0; j < 2; j++)
+                    {
+                        for (size_t k = 0; k < 3; k++)
+                        {
+                            ASSERT_EQ(expected[i][j][k], result[i][j][k]);
+                        }
+                    }
+                }
+
+                from_montgomery_coeffmod(poly1, 2, mod, poly1);
+                multiply_poly_scalar_coeffmod(poly1[1], 2, 12345, mod, expected[1]);
+                multiply_poly_scalar_montgomery_coeffmod(poly1[1], 2, 12345, mod, result[1]);
+                for (size_t j = 0; j < 2; j++)
+                {
+                    for (size_t k = 0; k < 3; k++)
+                    {
+                        ASSERT_EQ(expected[1][j][k], result[1][j][k]);
+                    }
+                }
+            }
         }
 
         TEST(PolyArithSmallMod, PolyInftyNormCoeffMod)
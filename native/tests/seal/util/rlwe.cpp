@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/encryptionparams.h"
+#include "seal/modulus.h"
+#include "seal/randomgen.h"
+#include "seal/util/common.h"
+#include "seal/util/globals.h"
+#include "seal/util/rlwe.h"
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace seal;
+using namespace seal::util;
+using namespace std;
+
+namespace sealtest
+{
+    namespace util
+    {
+        namespace
+        {
+            EncryptionParameters create_parms()
+            {
+                EncryptionParameters parms(scheme_type::bfv);
+                parms.set_poly_modulus_degree(4096);
+                parms.set_coeff_modulus(CoeffModulus::Create(4096, { 30, 40, 50 }));
+                return parms;
+            }
+
+            // Returns the signed values of a sampled polynomial, checking that all RNS components agree
+            vector<int64_t> sample_signed(
+                const EncryptionParameters &parms,
+                function<void(shared_ptr<UniformRandomGenerator>, const EncryptionParameters &, uint64_t *)> sample,
+                prng_seed_type seed)
+            {
+                size_t coeff_count = parms.poly_modulus_degree();
+                auto &coeff_modulus = parms.coeff_modulus();
+                vector<uint64_t> poly(coeff_count * coeff_modulus.size());
+                sample(Blake2xbPRNGFactory(seed).create(), parms, poly.data());
+
+                vector<int64_t> values(coeff_count);
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    uint64_t q0 = coeff_modulus[0].value();
+                    values[i] =
+                        (poly[i] > q0 / 2) ? -static_cast<int64_t>(q0 - poly[i]) : static_cast<int64_t>(poly[i]);
+                    for (size_t j = 0; j < coeff_modulus.size(); j++)
+                    {
+                        uint64_t qj = coeff_modulus[j].value();
+                        uint64_t expected = values[i] < 0 ? qj - static_cast<uint64_t>(-values[i])
+                                                          : static_cast<uint64_t>(values[i]);
+                        EXPECT_EQ(expected, poly[i + j * coeff_count]);
+                    }
+                }
+                return values;
+            }
+        } // namespace
+
+        TEST(RLWE, SamplePolyTernary)
+        {
+            auto parms = create_parms();
+            auto values = sample_signed(parms, sample_poly_ternary, { 1 });
+            vector<size_t> counts(3, 0);
+            for (auto value : values)
+            {
+                ASSERT_LE(-1, value);
+                ASSERT_GE(1, value);
+                counts[static_cast<size_t>(value + 1)]++;
+            }
+
+            // Each value occurs about 4096 / 3 = 1365 times
+            for (auto count : counts)
+            {
+                ASSERT_LT(size_t(1200), count);
+                ASSERT_GT(size_t(1530), count);
+            }
+
+            // Deterministic for a given seed
+            ASSERT_TRUE(values == sample_signed(parms, sample_poly_ternary, { 1 }));
+            ASSERT_FALSE(values == sample_signed(parms, sample_poly_ternary, { 2 }));
+        }
+
+        TEST(RLWE, SamplePolyCBD)
+        {
+            auto parms = create_parms();
+            auto values = sample_signed(parms, sample_poly_cbd, { 1 });
+
+            // Matches sampling six bytes per coefficient
+            auto prng = Blake2xbPRNGFactory({ 1 }).create();
+            double variance = 0;
+            for (auto value : values)
+            {
+                unsigned char x[6];
+                prng->generate(6, reinterpret_cast<seal_byte *>(x));
+                x[2] &= 0x1F;
+                x[5] &= 0x1F;
+                int expected = hamming_weight(x[0]) + hamming_weight(x[1]) + hamming_weight(x[2]) -
+                               hamming_weight(x[3]) - hamming_weight(x[4]) - hamming_weight(x[5]);
+                ASSERT_EQ(static_cast<int64_t>(expected), value);
+                variance += static_cast<double>(value * value);
+            }
+            variance /= static_cast<double>(values.size());
+            ASSERT_NEAR(3.2, sqrt(variance), 0.2);
+        }
+
+        TEST(RLWE, SamplePolyNormal)
+        {
+            auto parms = create_parms();
+            auto values = sample_signed(parms, sample_poly_normal, { 1 });
+            double variance = 0;
+            for (auto value : values)
+            {
+                ASSERT_GE(global_variables::noise_max_deviation, fabs(static_cast<double>(value)));
+                variance += static_cast<double>(value * value);
+            }
+            variance /= static_cast<double>(values.size());
+
+            // Rounding toward zero lowers the standard deviation slightly
+            ASSERT_LT(2.5, sqrt(variance));
+            ASSERT_GT(global_variables::noise_standard_deviation, sqrt(variance));
+        }
+    } // namespace util
+} // namespace sealtest
@@ -1071,5 +1071,129 @@ namespace sealtest
             ASSERT_TRUE((53ULL + 2ULL - in[0]) % 53ULL <= 1);
             ASSERT_TRUE((53ULL + 3ULL - in[1]) % 53ULL <= 1);
         }
+
+        TEST(KSwitchToolTest, Initialize)
+        {
+            auto pool = MemoryManager::GetPool();
+
+            ASSERT_THROW(KSwitchTool({}, { 11 }, 1, pool), invalid_argument);
+            ASSERT_THROW(KSwitchTool({ 3 }, {}, 1, pool), invalid_argument);
+            ASSERT_THROW(KSwitchTool({ 3 }, { 11 }, 0, pool), invalid_argument);
+            ASSERT_THROW(KSwitchTool({ 3, 5 }, { 15 }, 1, pool), invalid_argument);
+
+            KSwitchTool kst({ 3, 5, 7 }, { 11, 13 }, 2, pool);
+            ASSERT_EQ(2, kst.digit_size());
+            ASSERT_EQ(2, kst.digit_count());
+
+            // floor(143 / 2) = 71
+            ASSERT_EQ(71ULL % 3, kst.half_p_mod_q()[0]);
+            ASSERT_EQ(71ULL % 5, kst.half_p_mod_q()[1]);
+            ASSERT_EQ(71ULL % 7, kst.half_p_mod_q()[2]);
+            ASSERT_EQ(71ULL % 11, kst.half_p_mod_p()[0]);
+            ASSERT_EQ(71ULL % 13, kst.half_p_mod_p()[1]);
+            ASSERT_EQ(1ULL, (143ULL * kst.inv_p_mod_q()[0].operand) % 3);
+            ASSERT_EQ(1ULL, (143ULL * kst.inv_p_mod_q()[1].operand) % 5);
+            ASSERT_EQ(1ULL, (143ULL * kst.inv_p_mod_q()[2].operand) % 7);
+        }
+
+        TEST(KSwitchToolTest, ExtendDigit)
+        {
+            auto pool = MemoryManager::GetPool();
+            const vector<uint64_t> qp{ 3, 5, 7, 11, 13 };
+            const size_t coeff_count = 4;
+
+            // Values modulo 3 * 5 * 7 in RNS form
+            vector<uint64_t> values{ 0, 1, 52, 104 };
+            vector<uint64_t> in(3 * coeff_count);
+            for (size_t i = 0; i < 3; i++)
+            {
+                for (size_t j = 0; j < coeff_count; j++)
+                {
+                    in[i * coeff_count + j] = values[j] % qp[i];
+                }
+            }
+
+            KSwitchTool kst({ 3, 5, 7 }, { 11, 13 }, 2, pool);
+            vector<uint64_t> out(5 * coeff_count);
+
+            // The first digit {3, 5} is extended by fast base conversion; the result is off by at most 1 * 15
+            kst.extend_digit(0, ConstRNSIter(in.data(), coeff_count), RNSIter(out.data(), coeff_count), pool);
+            for (size_t j = 0; j < coeff_count; j++)
+            {
+                uint64_t digit = values[j] % 15;
+                bool found = false;
+                for (uint64_t u = 0; u < 2; u++)
+                {
+                    bool match = true;
+                    for (size_t i = 0; i < 5; i++)
+                    {
+                        match &= (out[i * coeff_count + j] == (digit + u * 15) % qp[i]);
+                    }
+                    found |= match;
+                }
+                ASSERT_TRUE(found);
+            }
+
+            // The second digit {7} is extended exactly
+            kst.extend_digit(1, ConstRNSIter(in.data(), coeff_count), RNSIter(out.data(), coeff_count), pool);
+            for (size_t j = 0; j < coeff_count; j++)
+            {
+                for (size_t i = 0; i < 5; i++)
+                {
+                    ASSERT_EQ((values[j] % 7) % qp[i], out[i * coeff_count + j]);
+                }
+            }
+        }
+
+        TEST(KSwitchToolTest, ConvertPToQ)
+        {
+            auto pool = MemoryManager::GetPool();
+            const size_t coeff_count = 4;
+            vector<uint64_t> values{ 0, 1, 71, 142 };
+
+            {
+                KSwitchTool kst({ 3, 5, 7 }, { 11, 13 }, 1, pool);
+                vector<uint64_t> in(2 * coeff_count);
+                for (size_t j = 0; j < coeff_count; j++)
+                {
+                    in[j] = values[j] % 11;
+                    in[coeff_count + j] = values[j] % 13;
+                }
+                vector<uint64_t> out(3 * coeff_count);
+                kst.convert_p_to_q(ConstRNSIter(in.data(), coeff_count), RNSIter(out.data(), coeff_count), pool);
+
+                // Fast base conversion is off by at most 1 * 143
+                const vector<uint64_t> q{ 3, 5, 7 };
+                for (size_t j = 0; j < coeff_count; j++)
+                {
+                    bool found = false;
+                    for (uint64_t u = 0; u < 2; u++)
+                    {
+                        bool match = true;
+                        for (size_t i = 0; i < 3; i++)
+                        {
+                            match &= (out[i * coeff_count + j] == (values[j] + u * 143) % q[i]);
+                        }
+                        found |= match;
+                    }
+                    ASSERT_TRUE(found);
+                }
+            }
+            {
+                // A single special prime is converted exactly
+                KSwitchTool kst({ 3, 5, 7 }, { 11 }, 1, pool);
+                vector<uint64_t> in(coeff_count);
+                for (size_t j = 0; j < coeff_count; j++)
+                {
+                    in[j] = values[j] % 11;
+                }
+                vector<uint64_t> out(3 * coeff_count);
+                kst.convert_p_to_q(ConstRNSIter(in.data(), coeff_count), RNSIter(out.data(), coeff_count), pool);
+                ASSERT_EQ(0ULL, out[0]);
+                ASSERT_EQ(1ULL, out[1]);
+                ASSERT_EQ((71ULL % 11) % 3, out[2]);
+                ASSERT_EQ((142ULL % 11) % 7, out[2 * coeff_count + 3]);
+            }
+        }
     } // namespace util
 } // namespace sealtest
@@ -5,6 +5,7 @@
 #include "seal/modulus.h"
 #include "seal/util/uintarithsmallmod.h"
 #include "seal/util/uintcore.h"
+#include <random>
 #include "gtest/gtest.h"
 
 using namespace seal::util;
@@ -506,5 +507,39 @@ namespace sealtest
             y.set(mod.value() - 1, mod);
             ASSERT_EQ(0ULL, multiply_add_uint_mod(mod.value() - 1, y, mod.value() - 1, mod));
         }
+
+        TEST(UIntArithSmallMod, MontgomeryMultiplyUIntMod)
+        {
+            Modulus mod(2);
+            ASSERT_EQ(0ULL, mod.montgomery_inv());
+            mod = 13;
+            ASSERT_EQ(0xFFFFFFFFFFFFFFFFULL, mod.value() * mod.montgomery_inv());
+            ASSERT_EQ(0ULL, to_montgomery(0, mod));
+            ASSERT_EQ(1ULL, from_montgomery(to_montgomery(1, mod), mod));
+            ASSERT_EQ(12ULL, from_montgomery(to_montgomery(12, mod), mod));
+            ASSERT_EQ(3ULL, multiply_uint_mod_montgomery(to_montgomery(7, mod), 6, mod));
+            MontgomeryOperand y;
+            y.set(6, mod);
+            ASSERT_EQ(to_montgomery(6, mod), y.operand);
+            ASSERT_EQ(3ULL, multiply_uint_mod_montgomery(7, y.operand, mod));
+
+            mod = 2305843009211596801ULL;
+            ASSERT_EQ(0xFFFFFFFFFFFFFFFFULL, mod.value() * mod.montgomery_inv());
+            mt19937_64 rng(0);
+            for (int i = 0; i < 1000; i++)
+            {
+                uint64_t a = rng() % mod.value();
+                uint64_t b = rng() % mod.value();
+                uint64_t expected = multiply_uint_mod(a, b, mod);
+                ASSERT_EQ(a, from_montgomery(to_montgomery(a, mod), mod));
+                y.set(b, mod);
+                ASSERT_EQ(expected, multiply_uint_mod_montgomery(a, y.operand, mod));
+
+                // Lazy inputs up to 4 * modulus give lazy outputs less than 2 * modulus
+                uint64_t lazy = multiply_uint_mod_montgomery_lazy(a + 3 * mod.value(), y.operand, mod);
+                ASSERT_LT(lazy, 2 * mod.value());
+                ASSERT_EQ(expected, barrett_reduce_64(lazy, mod));
+            }
+        }
     } // namespace util
 } // namespace sealtest